@@ -361,19 +361,17 @@ main(int argc, const char ** argv)
     sId.buildFrom(Id) ;
 
     // Matrice d'interaction, Hessien, erreur,...
-    vpMatrix Lsd;   // matrice d'interaction a la position desiree
     vpMatrix Hsd;  // hessien a la position desiree
     vpMatrix H ; // Hessien utilise pour le levenberg-Marquartd
     vpColVector error ; // Erreur I-I*
+    vpColVector LtError ; // Lsd^T (I-I*)
 
     // Compute the interaction matrix
     // link the variation of image intensity to camera motion
 
-    // here it is computed at the desired position
-    sId.interaction(Lsd) ;
-
-    // Compute the Hessian H = L^TL
-    Hsd = Lsd.AtA() ;
+    // here it is computed at the desired position.
+    // Compute the Hessian H = L^TL without building L
+    sId.interactionProduct(Hsd) ;
 
     // Compute the Hessian diagonal for the Levenberg-Marquartd
     // optimization process
@@ -449,7 +447,8 @@ main(int argc, const char ** argv)
           H = ((mu * diagHsd) + Hsd).inverseByLU();
         }
         //	compute the control law
-        e = H * Lsd.t() *error ;
+        sId.interactionProduct(error, LtError) ;
+        e = H * LtError ;
 
         v = - lambda*e;
       }
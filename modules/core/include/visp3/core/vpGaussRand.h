@@ -158,6 +158,7 @@ public:
     */
   void seed(const long seed_val) {
     x=seed_val;
+    y=0;
   }
 
   /*!
@@ -63,6 +63,14 @@
 
   \brief  Various image filter, convolution, etc...
 
+  The separable filters, the Gaussian blur and the gradients are also
+  available with a single precision output (vpImage<float>), and the Gaussian
+  blur and the Gaussian gradients with a fixed-point output (vpImage<short>
+  with 7 fractional bits, i.e. values multiplied by 128). These variants
+  filter whole rows with SSE2 when available and handle the image borders
+  outside of the inner loops, so that they are much faster than the
+  vpImage<double> ones.
+
 */
 class VISP_EXPORT vpImageFilter
 {
@@ -107,6 +115,64 @@ public:
             +112.0 *(I[r+3][c] - I[r-3][c]))/8418.0;
   }
 
+  /*!
+   Apply the 1x3 derivative filter of derivativeFilterX() to \e n contiguous
+   pixels of a row. The pixels \f$(r, c-3)\f$ to \f$(r, c+n+2)\f$ must be
+   inside the image.
+
+   \param I : Image to filter
+   \param r : coordinates (row) of the first pixel
+   \param c : coordinates (column) of the first pixel
+   \param n : number of pixels to filter
+   \param dIx : array of \e n values that receives the filtered pixels
+   \param scale : factor applied to the filtered pixels
+
+   \sa derivativeFilterYRow()
+   */
+  template<class T>
+  static void derivativeFilterXRow(const vpImage<T> &I, const unsigned int r, const unsigned int c,
+                                   const unsigned int n, double *dIx, const double scale=1.)
+  {
+    const T *cm1 = I[r] + c - 1, *cm2 = I[r] + c - 2, *cm3 = I[r] + c - 3;
+    const T *cp1 = I[r] + c + 1, *cp2 = I[r] + c + 2, *cp3 = I[r] + c + 3;
+    for (unsigned int j = 0; j < n; j++) {
+      dIx[j] = scale * ((2047.0 *(cp1[j] - cm1[j])
+                         +913.0 *(cp2[j] - cm2[j])
+                         +112.0 *(cp3[j] - cm3[j]))/8418.0);
+    }
+  }
+
+  /*!
+   Apply the 3x1 derivative filter of derivativeFilterY() to \e n contiguous
+   pixels of a row. The rows \f$r-3\f$ to \f$r+3\f$ must be inside the image.
+
+   \param I : Image to filter
+   \param r : coordinates (row) of the first pixel
+   \param c : coordinates (column) of the first pixel
+   \param n : number of pixels to filter
+   \param dIy : array of \e n values that receives the filtered pixels
+   \param scale : factor applied to the filtered pixels
+
+   \sa derivativeFilterXRow()
+   */
+  template<class T>
+  static void derivativeFilterYRow(const vpImage<T> &I, const unsigned int r, const unsigned int c,
+                                   const unsigned int n, double *dIy, const double scale=1.)
+  {
+    const T *rm1 = I[r-1] + c, *rm2 = I[r-2] + c, *rm3 = I[r-3] + c;
+    const T *rp1 = I[r+1] + c, *rp2 = I[r+2] + c, *rp3 = I[r+3] + c;
+    for (unsigned int j = 0; j < n; j++) {
+      dIy[j] = scale * ((2047.0 *(rp1[j] - rm1[j])
+                         +913.0 *(rp2[j] - rm2[j])
+                         +112.0 *(rp3[j] - rm3[j]))/8418.0);
+    }
+  }
+
+  static void derivativeFilterXRow(const vpImage<unsigned char> &I, const unsigned int r, const unsigned int c,
+                                   const unsigned int n, double *dIx, const double scale=1.);
+  static void derivativeFilterYRow(const vpImage<unsigned char> &I, const unsigned int r, const unsigned int c,
+                                   const unsigned int n, double *dIy, const double scale=1.);
+
   /*!
    Apply a 1 x size Derivative Filter in X to an image pixel.
 
@@ -184,6 +250,8 @@ public:
 
   static void filter(const vpImage<unsigned char> &I, vpImage<double>& GI, const double *filter,unsigned  int size);
   static void filter(const vpImage<double> &I, vpImage<double>& GI, const double *filter,unsigned  int size);
+  static void filter(const vpImage<unsigned char> &I, vpImage<float>& GI, const double *filter, unsigned int size);
+  static void filter(const vpImage<float> &I, vpImage<float>& GI, const double *filter, unsigned int size);
 
   static inline unsigned char filterGaussXPyramidal(const vpImage<unsigned char> &I, unsigned int i, unsigned int j)
   {
@@ -196,6 +264,8 @@ public:
 
   static void filterX(const vpImage<unsigned char> &I, vpImage<double>& dIx, const double *filter,unsigned  int size);
   static void filterX(const vpImage<double> &I, vpImage<double>& dIx, const double *filter,unsigned  int size);
+  static void filterX(const vpImage<unsigned char> &I, vpImage<float>& dIx, const double *filter, unsigned int size);
+  static void filterX(const vpImage<float> &I, vpImage<float>& dIx, const double *filter, unsigned int size);
 
   static inline double filterX(const vpImage<unsigned char> &I,
                                unsigned int r, unsigned int c,
@@ -302,6 +372,8 @@ public:
 
   static void filterY(const vpImage<unsigned char> &I, vpImage<double>& dIx, const double *filter,unsigned  int size);
   static void filterY(const vpImage<double> &I, vpImage<double>& dIx, const double *filter,unsigned  int size);
+  static void filterY(const vpImage<unsigned char> &I, vpImage<float>& dIy, const double *filter, unsigned int size);
+  static void filterY(const vpImage<float> &I, vpImage<float>& dIy, const double *filter, unsigned int size);
   static inline double filterY(const vpImage<unsigned char> &I,
                                unsigned int r, unsigned int c,
                                const double *filter,unsigned  int size)
@@ -398,6 +470,9 @@ public:
 
   static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<double>& GI, unsigned int size=7, double sigma=0., bool normalize=true);
   static void gaussianBlur(const vpImage<double> &I, vpImage<double>& GI, unsigned int size=7, double sigma=0., bool normalize=true);
+  static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<float>& GI, unsigned int size=7, double sigma=0., bool normalize=true);
+  static void gaussianBlur(const vpImage<float> &I, vpImage<float>& GI, unsigned int size=7, double sigma=0., bool normalize=true);
+  static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<short>& GI, unsigned int size=7, double sigma=0., bool normalize=true);
   /*!
    Apply a 5x5 Gaussian filter to an image pixel.
 
@@ -433,15 +508,27 @@ public:
   static void getGradX(const vpImage<unsigned char> &I, vpImage<double>& dIx);
   static void getGradX(const vpImage<unsigned char> &I, vpImage<double>& dIx, const double *filter, unsigned int size);
   static void getGradX(const vpImage<double> &I, vpImage<double>& dIx, const double *filter, unsigned int size);
+  static void getGradX(const vpImage<unsigned char> &I, vpImage<float>& dIx, const double *filter, unsigned int size);
+  static void getGradX(const vpImage<float> &I, vpImage<float>& dIx, const double *filter, unsigned int size);
   static void getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<double>& dIx, const double *gaussianKernel,
                               const double *gaussianDerivativeKernel, unsigned  int size);
+  static void getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<float>& dIx, const double *gaussianKernel,
+                              const double *gaussianDerivativeKernel, unsigned int size);
+  static void getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<short>& dIx, const double *gaussianKernel,
+                              const double *gaussianDerivativeKernel, unsigned int size);
 
   //fonction renvoyant le gradient en Y de l'image I
   static void getGradY(const vpImage<unsigned char> &I, vpImage<double>& dIy);
   static void getGradY(const vpImage<unsigned char> &I, vpImage<double>& dIy, const double *filter, unsigned int size);
   static void getGradY(const vpImage<double> &I, vpImage<double>& dIy, const double *filter, unsigned int size);
+  static void getGradY(const vpImage<unsigned char> &I, vpImage<float>& dIy, const double *filter, unsigned int size);
+  static void getGradY(const vpImage<float> &I, vpImage<float>& dIy, const double *filter, unsigned int size);
   static void getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<double>& dIy, const double *gaussianKernel,
                               const double *gaussianDerivativeKernel,unsigned  int size);
+  static void getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<float>& dIy, const double *gaussianKernel,
+                              const double *gaussianDerivativeKernel, unsigned int size);
+  static void getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<short>& dIy, const double *gaussianKernel,
+                              const double *gaussianDerivativeKernel, unsigned int size);
 };
 
 
@@ -85,6 +85,9 @@ public:
   static inline void binarise(vpImage<Type> &I,
                               Type threshold1, Type threshold2,
                               Type value1, Type value2, Type value3, const bool useLUT=true);
+  static void boxMean(const vpImage<unsigned char> &I, vpImage<float> &Imean, const unsigned int size);
+  static void boxMeanVariance(const vpImage<unsigned char> &I, vpImage<float> &Imean, vpImage<float> &Ivar,
+                              const unsigned int size);
   static void changeLUT(vpImage<unsigned char>& I,
                         unsigned char A,
                         unsigned char newA,
@@ -114,6 +117,11 @@ public:
   template<class Type>
   static void flip(vpImage<Type> &I);
 
+  template<class Type>
+  static inline Type getIntegralSum(const vpImage<Type> &II,
+                                    const unsigned int top, const unsigned int left,
+                                    const unsigned int height, const unsigned int width);
+
 
   static void imageDifference(const vpImage<unsigned char> &I1,
                               const vpImage<unsigned char> &I2,
@@ -139,6 +147,9 @@ public:
                             vpImage<unsigned char> &Ires,
                             const bool saturate=false);
 
+  static void integralImage(const vpImage<unsigned char> &I, vpImage<unsigned int> &II);
+  static void integralImage(const vpImage<unsigned char> &I, vpImage<unsigned int> &II, vpImage<double> &IIsq);
+
   template<class Type>
   static void resize(const vpImage<Type> &I,
                      vpImage<Type> &Ires,
@@ -194,6 +205,29 @@ private:
                             const float u, const float v);
 } ;
 
+/*!
+  Return the sum of the pixels of a rectangle from an integral image
+  computed by integralImage(), in constant time.
+
+  \param II : Integral image, of size (height+1)x(width+1) of the image.
+  \param top : First row of the rectangle.
+  \param left : First column of the rectangle.
+  \param height : Number of rows of the rectangle.
+  \param width : Number of columns of the rectangle.
+
+  \note With an integral image of unsigned int, the result is exact as long
+  as the sum itself fits in 32 bits, even when the integral image wraps
+  around for very large images.
+*/
+template<class Type>
+inline Type vpImageTools::getIntegralSum(const vpImage<Type> &II,
+                                         const unsigned int top, const unsigned int left,
+                                         const unsigned int height, const unsigned int width)
+{
+  const Type *a = II[top], *b = II[top + height];
+  return (Type)((b[left + width] - b[left]) - (a[left + width] - a[left]));
+}
+
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
 /*!
   Crop a region of interest (ROI) in an image.
@@ -104,6 +104,14 @@
 
   ViSP provides different state evolution models implemented in the
   vpLinearKalmanFilterInstantiation class.
+
+  When the signals are independent, i.e. when \f${\bf F}\f$, \f${\bf H}\f$,
+  \f${\bf R}\f$, \f${\bf Q}\f$ and the initial covariance are block-diagonal
+  with one block per signal, setBlockDiagonal() allows to filter each signal
+  separately. The cost of prediction() and filtering() is then linear in the
+  number of signals instead of cubic, and the results are the same since the
+  blocks outside of the diagonal remain null. The state models of
+  vpLinearKalmanFilterInstantiation enable this mode.
 */
 class VISP_EXPORT vpKalmanFilter
 {
@@ -122,6 +130,8 @@ protected :
 
   //! When set to true, print the content of internal variables during filtering() and prediction().
   bool verbose_mode;
+  //! When set to true, the signals are filtered separately.
+  bool block_diagonal;
 
 public:
   vpKalmanFilter() ;
@@ -139,6 +149,12 @@ public:
 
   // int init() { return init_done ; }
   void init(unsigned int size_state, unsigned int size_measure, unsigned int n_signal) ;
+  /*!
+    Return true if the signals are filtered separately.
+
+    \sa setBlockDiagonal()
+  */
+  bool getBlockDiagonal() const { return block_diagonal; }
   void prediction() ;
   void filtering(const vpColVector &z) ;
   /*!
@@ -163,6 +179,15 @@ public:
     filter internal values.
   */
   void verbose(bool on) { verbose_mode = on;};
+  /*!
+    Filter each signal separately. This requires the signals to be
+    independent: the matrices \f${\bf F}\f$, \f${\bf H}\f$, \f${\bf R}\f$,
+    \f${\bf Q}\f$ and \f${\bf P}_{k \mid k}\f$ have to be block-diagonal,
+    with blocks of size getStateSize() (and getMeasureSize() for the
+    measures). Only the diagonal blocks of the matrices are read and updated.
+    \param on : If true, the signals are filtered separately.
+  */
+  void setBlockDiagonal(bool on) { block_diagonal = on; }
 
 public:
   /*!
@@ -205,6 +230,8 @@ public:
   vpMatrix Pest ;
 
 protected:
+  void filteringByBlocks(const vpColVector &z);
+  void predictionByBlocks();
 
   /*!  
     Filter gain \f${\bf W}_k\f$ where \f$ {\bf W}_k = {\bf P}_{k
@@ -53,6 +53,8 @@
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpMath.h>
 
+#include <vector>
+
 /*!
   \class vpMeterPixelConversion
 
@@ -75,6 +77,13 @@ public:
                             const double &rho_m, const double &theta_m,
                             double &rho_p, double &theta_p) ;
 
+    static void convertPoints(const vpCameraParameters &cam,
+                              const double *x, const double *y,
+                              double *u, double *v, const unsigned int n);
+    static void convertPoints(const vpCameraParameters &cam,
+                              const std::vector<double> &x, const std::vector<double> &y,
+                              std::vector<vpImagePoint> &iP);
+
 /*!
 
   \brief Point coordinates conversion from normalized coordinates
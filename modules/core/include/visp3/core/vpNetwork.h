@@ -76,11 +76,37 @@
   \warning This class shouldn't be used directly. You better use vpClient and
   vpServer to simulate your network. Some exemples are provided in these classes.
 
+  Requests can be exchanged with two protocols, that have to be the same on
+  both sides of the network (see setProtocol()):
+  - vpNetwork::TEXT_PROTOCOL (default): a request is sent as a string where the
+    id and the parameters are delimited by separators. It is compatible with
+    the previous versions of ViSP but the parameters are copied in the
+    message and the received messages have to be scanned for the separators.
+  - vpNetwork::BINARY_PROTOCOL: a request is sent as a length-prefixed frame.
+    The header and the parameters are written to the socket with a single
+    scatter/gather call, without concatenating them (see
+    vpRequest::addParameterBuffer() to send an image bitmap without copying
+    it), and they are read directly in the parameters of the decoding request.
+    Optionally, each frame can be compressed with zlib (see
+    setCompressionLevel()).
+
+  Under Linux, the sockets of the receptors are monitored with epoll instead
+  of select, which scales better with the number of clients of a vpServer.
+
   \sa vpServer
   \sa vpNetwork
 */
 class VISP_EXPORT vpNetwork
 {
+public:
+  /*!
+    Protocol used to send and receive the requests.
+  */
+  typedef enum {
+    TEXT_PROTOCOL,  /*!< Requests are strings with separators. */
+    BINARY_PROTOCOL /*!< Requests are length-prefixed binary frames. */
+  } vpProtocolType;
+
 protected:
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
   struct vpReceptor{
@@ -131,12 +157,26 @@ protected:
   std::vector<vpRequest*> request_list;
   
   unsigned int            max_size_message;
+  unsigned int            max_size_frame;
   std::string             separator;
   std::string             beginning;
   std::string             end;
   std::string             param_sep;
   
   std::string             currentMessageReceived;
+  
+  //Binary protocol
+  vpProtocolType          protocol;
+  int                     compressionLevel;
+  std::vector<int>        receivedRequests;
+  std::vector<char>       receiveBuffer;
+  std::vector<char>       frameHeader;
+  std::vector<char>       compressionBuffer;
+
+  //Epoll set (Linux only)
+  int                     epollFileDescriptor;
+  std::vector<std::pair<int, unsigned short> > epollReceptors;
+  bool                    epollEmitter;
     
   struct timeval          tv;
   long                    tv_sec;
@@ -153,7 +193,14 @@ private:
   void              _receiveRequestFrom(const unsigned int &receptorEmitting);
   int               _receiveRequestOnce();
   int               _receiveRequestOnceFrom(const unsigned int &receptorEmitting);
+  int               _receiveBinaryRequestFrom(const unsigned int &receptorEmitting);
+  int               _receiveTextRequestFrom(const unsigned int &receptorEmitting);
+  int               _sendBinaryRequestTo(vpRequest &req, const unsigned int &dest);
   
+protected:
+  int               _waitForReadableSockets(const bool &withEmitter, bool &emitterReady,
+                                            std::vector<unsigned int> &readyReceptors);
+
 public:
 
                     vpNetwork();
@@ -184,6 +231,34 @@ public:
     \return Acutal max size value.
   */
   unsigned int      getMaxSizeReceivedMessage(){ return max_size_message; }
+
+  /*!
+    Get the maximum size of the parameters of a frame received with the
+    vpNetwork::BINARY_PROTOCOL.
+
+    \sa vpNetwork::setMaxSizeReceivedFrame()
+
+    \return Maximum size in bytes.
+  */
+  unsigned int      getMaxSizeReceivedFrame() const { return max_size_frame; }
+  
+  /*!
+    Get the zlib compression level of the frames sent with the binary protocol.
+
+    \sa vpNetwork::setCompressionLevel()
+
+    \return Compression level, 0 if the frames are not compressed.
+  */
+  int               getCompressionLevel() const { return compressionLevel; }
+
+  /*!
+    Get the protocol used to send and receive the requests.
+
+    \sa vpNetwork::setProtocol()
+
+    \return The protocol.
+  */
+  vpProtocolType    getProtocol() const { return protocol; }
   
   void      print(const char *id = "");
   
@@ -223,6 +298,35 @@ public:
     \param s : new maximum size value.
   */
   void              setMaxSizeReceivedMessage(const unsigned int &s){ max_size_message = s;}
+
+  /*!
+    Change the maximum size of the parameters of a frame received with the
+    vpNetwork::BINARY_PROTOCOL. The sizes given in the header of a frame are
+    checked before any allocation: if the compressed or uncompressed size of
+    the parameters is larger, the frame is considered as corrupted and the
+    connection with the sender is closed. The default value is 256 MB.
+
+    \sa vpNetwork::getMaxSizeReceivedFrame()
+
+    \param s : new maximum size in bytes.
+  */
+  void              setMaxSizeReceivedFrame(const unsigned int &s){ max_size_frame = s;}
+
+  void              setCompressionLevel(const int &level);
+
+  /*!
+    Change the protocol used to send and receive the requests. Both sides of
+    the network have to use the same protocol.
+
+    \warning The maximum size of the received messages is only used with the
+    vpNetwork::TEXT_PROTOCOL. With the vpNetwork::BINARY_PROTOCOL, a frame is
+    always entirely received, in the limit set with setMaxSizeReceivedFrame().
+
+    \sa vpNetwork::getProtocol()
+
+    \param p : vpNetwork::TEXT_PROTOCOL (default) or vpNetwork::BINARY_PROTOCOL.
+  */
+  void              setProtocol(const vpProtocolType &p){ protocol = p; }
   
   /*!
     Change the time the emitter spend to check if he receives a message from a receptor.
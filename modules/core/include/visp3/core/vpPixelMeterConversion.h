@@ -51,6 +51,8 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpImagePoint.h>
 
+#include <vector>
+
 /*!
   \class vpPixelMeterConversion
 
@@ -239,6 +241,13 @@ convertPointWithDistortion(
   y = (iP.get_v() - cam.v0)*r2*cam.inv_py ;
 }
 
+  static void convertPoints(const vpCameraParameters &cam,
+                            const double *u, const double *v,
+                            double *x, double *y, const unsigned int n);
+  static void convertPoints(const vpCameraParameters &cam,
+                            const std::vector<vpImagePoint> &iP,
+                            std::vector<double> &x, std::vector<double> &y);
+
   //! line coordinates conversion (rho,theta)
   static void convertLine(const vpCameraParameters &cam,
 		      const double &rho_p, const double &theta_p,
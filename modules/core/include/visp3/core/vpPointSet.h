@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Set of 3D points stored as a structure of arrays.
+ *
+ *****************************************************************************/
+
+#ifndef vpPointSet_H
+#define vpPointSet_H
+
+/*!
+  \file vpPointSet.h
+  \brief Set of 3D points stored as a structure of arrays.
+*/
+
+#include <list>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+
+/*!
+  \class vpPointSet
+  \ingroup group_core_geometry
+  \brief Compact set of 3D points stored as a structure of arrays.
+
+  Contrary to a container of vpPoint, where each point owns three heap
+  allocated vectors and a virtual table, the coordinates of all the points are
+  stored in contiguous arrays:
+  - the coordinates \f$(^oX, ^oY, ^oZ)\f$ in the object frame,
+  - the coordinates \f$(^cX, ^cY, ^cZ)\f$ in the camera frame,
+  - the normalized coordinates \f$(x, y)\f$ in the image plane.
+
+  changeFrame() and projection() process all the points at once (two points
+  at a time with SSE2 when available) and give the same values than
+  vpPoint::changeFrame() and vpPoint::projection() called on each point.
+  The memory is kept from one call to the other, so that a set reused in a
+  loop does not allocate memory once it has reached its final size.
+
+  \code
+#include <visp3/core/vpPointSet.h>
+
+int main()
+{
+  vpPointSet points;
+  points.addPoint(-0.1, -0.1, 0);
+  points.addPoint( 0.1, -0.1, 0);
+  points.addPoint( 0.1,  0.1, 0);
+  points.addPoint(-0.1,  0.1, 0);
+
+  vpHomogeneousMatrix cMo(0, 0, 1, 0, 0, 0);
+  points.track(cMo);
+  for (unsigned int i = 0; i < points.size(); i++)
+    std::cout << points.get_x(i) << " " << points.get_y(i) << std::endl;
+}
+  \endcode
+
+  vpPose, vpPolygon3D and vpKeyPoint accept this container.
+*/
+class VISP_EXPORT vpPointSet
+{
+public:
+  vpPointSet();
+  explicit vpPointSet(const std::vector<vpPoint> &points);
+  explicit vpPointSet(const std::list<vpPoint> &points);
+
+  void addPoint(const double oX, const double oY, const double oZ);
+  void addPoint(const vpPoint &P);
+
+  void buildFrom(const std::vector<vpPoint> &points);
+  void buildFrom(const std::list<vpPoint> &points);
+
+  void changeFrame(const vpHomogeneousMatrix &cMo);
+
+  void clear();
+
+  //! Return true if the set is empty.
+  inline bool empty() const { return m_oX.empty(); }
+
+  //! Get the point coordinates in the object frame.
+  inline double get_oX(const unsigned int i) const { return m_oX[i]; }
+  inline double get_oY(const unsigned int i) const { return m_oY[i]; }
+  inline double get_oZ(const unsigned int i) const { return m_oZ[i]; }
+  //! Get the point coordinates in the camera frame.
+  inline double get_X(const unsigned int i) const { return m_X[i]; }
+  inline double get_Y(const unsigned int i) const { return m_Y[i]; }
+  inline double get_Z(const unsigned int i) const { return m_Z[i]; }
+  //! Get the point coordinates in the image plane.
+  inline double get_x(const unsigned int i) const { return m_x[i]; }
+  inline double get_y(const unsigned int i) const { return m_y[i]; }
+
+  //! Get the arrays of coordinates in the object frame.
+  inline const double *get_oX() const { return m_oX.empty() ? NULL : &m_oX[0]; }
+  inline const double *get_oY() const { return m_oY.empty() ? NULL : &m_oY[0]; }
+  inline const double *get_oZ() const { return m_oZ.empty() ? NULL : &m_oZ[0]; }
+  //! Get the arrays of coordinates in the camera frame.
+  inline const double *get_X() const { return m_X.empty() ? NULL : &m_X[0]; }
+  inline const double *get_Y() const { return m_Y.empty() ? NULL : &m_Y[0]; }
+  inline const double *get_Z() const { return m_Z.empty() ? NULL : &m_Z[0]; }
+  //! Get the arrays of coordinates in the image plane.
+  inline const double *get_x() const { return m_x.empty() ? NULL : &m_x[0]; }
+  inline const double *get_y() const { return m_y.empty() ? NULL : &m_y[0]; }
+
+  void getPoint(const unsigned int i, vpPoint &P) const;
+  void getPoints(std::vector<vpPoint> &points) const;
+
+  void projection();
+
+  void reserve(const unsigned int n);
+  void resize(const unsigned int n);
+
+  //! Set the point coordinates in the object frame.
+  inline void setWorldCoordinates(const unsigned int i, const double oX, const double oY, const double oZ) {
+    m_oX[i] = oX; m_oY[i] = oY; m_oZ[i] = oZ;
+  }
+  //! Set the point coordinates in the camera frame.
+  inline void setCameraCoordinates(const unsigned int i, const double X, const double Y, const double Z) {
+    m_X[i] = X; m_Y[i] = Y; m_Z[i] = Z;
+  }
+  //! Set the point coordinates in the image plane.
+  inline void setImageCoordinates(const unsigned int i, const double x, const double y) {
+    m_x[i] = x; m_y[i] = y;
+  }
+
+  void swap(vpPointSet &points);
+
+  //! Return the number of points.
+  inline unsigned int size() const { return (unsigned int) m_oX.size(); }
+
+  void track(const vpHomogeneousMatrix &cMo);
+
+private:
+  std::vector<double> m_oX, m_oY, m_oZ;
+  std::vector<double> m_X, m_Y, m_Z;
+  std::vector<double> m_x, m_y;
+};
+
+#endif
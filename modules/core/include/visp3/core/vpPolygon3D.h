@@ -46,6 +46,7 @@
 #include <vector>
 
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpPointSet.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpMeterPixelConversion.h>
 
@@ -88,18 +89,15 @@ public:
   //! Distance for near clipping
   double distFarClip;
   
-private:            
-            bool          getClippedPointsFovGeneric(const vpPoint &p1, const vpPoint &p2,
-                                           vpPoint &p1Clipped, vpPoint &p2Clipped, 
-                                           unsigned int &p1ClippedInfo, unsigned int &p2ClippedInfo,
-                                           const vpColVector &normal,
-                                           const unsigned int &flag);
-
-            bool          getClippedPointsDistance(const vpPoint &p1, const vpPoint &p2,
-                                           vpPoint &p1Clipped, vpPoint &p2Clipped,
-                                           unsigned int &p1ClippedInfo, unsigned int &p2ClippedInfo,
-                                           const unsigned int &flag, const double &distance);
-    
+private:
+  //! Clipped polygon as a structure of arrays
+  vpPointSet clippedPoints;
+  //! Clipping flags of the points of the clipped polygon
+  std::vector<unsigned int> clippedFlags;
+  //! Buffers used during the clipping
+  vpPointSet clippedPointsTmp;
+  std::vector<unsigned int> clippedFlagsTmp;
+
 public: 
             vpPolygon3D() ;
             vpPolygon3D(const vpPolygon3D& mbtp) ;
@@ -177,6 +175,8 @@ public:
 
             void          getPolygonClipped(std::vector<vpPoint> &poly);
 
+            void          getPolygonClipped(vpPointSet &points, std::vector<unsigned int> &flags) const;
+
             vpPolygon3D& operator=(const vpPolygon3D& mbtp) ;
 
   /*!
@@ -52,6 +52,12 @@
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMath.h>
 #include <ctime>
+#include <vector>
+
+#if defined(VISP_HAVE_OPENMP)
+#  include <omp.h>
+#endif
+
 /*!
   \class vpRansac
   \ingroup group_core_robust
@@ -68,6 +74,31 @@
   pk at csse uwa edu au
   http://www.csse.uwa.edu.au/~pk
 
+  Trials are processed by batches: the random samples of a batch are drawn
+  sequentially, then the models are fitted and scored in parallel (OpenMP)
+  and finally the batch is reduced in the order of the trials. The number
+  of trials is adapted to the inlier ratio of the best model, and the
+  scoring of a model is stopped as soon as it cannot have more inliers than
+  the best one. The result does not depend on the number of threads and the
+  buffers are allocated once for all the trials.
+
+  The historical interface uses the static functions
+  vpTransformation::computeTransformation(),
+  vpTransformation::computeResidual() and
+  vpTransformation::degenerateConfiguration() on data stored in a
+  vpColVector. An estimator object working on its own data can also be
+  given to the second ransac() function. It has to provide the following
+  const and thread safe methods:
+  \code
+  // True if the sample ind of size s cannot be used to fit a model
+  bool degenerateConfiguration(const unsigned int *ind) const;
+  // Fit the model M to the sample ind, false if the model cannot be computed or has to be rejected.
+  // d is a buffer attached to the model that can be used to store the residuals.
+  bool fit(const unsigned int *ind, vpColVector &M, vpColVector &d) const;
+  // True if the point i is an inlier of the model M, d being the buffer filled by fit()
+  bool isInlier(const vpColVector &M, const vpColVector &d, unsigned int i, double t) const;
+  \endcode
+
   \sa vpHomography
 
  */
@@ -82,9 +113,113 @@ public:
 		      vpColVector &inliers,
 		      int consensus = 1000,
           double not_used = 0.0,
-          const int maxNbumbersOfTrials = 10000);
+          const int maxNbumbersOfTrials = 10000,
+          const int nbThreads = 1,
+          const long seed = 0);
+
+  template <class vpEstimator>
+  static bool ransac(const vpEstimator &estimator, unsigned int npts, unsigned int s, double t,
+                     vpColVector &M, std::vector<bool> &inliers, unsigned int consensus,
+                     const int maxNbumbersOfTrials, const int nbThreads, vpUniRand &random);
+
+  static double computeNbTrials(const double inlierRatio, const unsigned int s, const double p = 0.99);
+
+  template <class vpEstimator>
+  static unsigned int countInliers(const vpEstimator &estimator, const vpColVector &M, const vpColVector &d,
+                                   unsigned int npts, double t, unsigned int maxOutliers);
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+private:
+  // Estimator built on the static functions of vpTransformation
+  class vpStaticEstimator
+  {
+  public:
+    explicit vpStaticEstimator(vpColVector &data) : x(data) {}
+
+    bool degenerateConfiguration(const unsigned int *ind) const
+    {
+      return vpTransformation::degenerateConfiguration(x, const_cast<unsigned int *>(ind));
+    }
+
+    bool fit(const unsigned int *ind, vpColVector &M, vpColVector &d) const
+    {
+      try {
+        // Fit model to this random selection of data points.
+        vpTransformation::computeTransformation(x, const_cast<unsigned int *>(ind), M);
+
+        // Evaluate distances between points and model.
+        vpTransformation::computeResidual(x, M, d);
+      }
+      catch(...) {
+        return false;
+      }
+      return true;
+    }
+
+    bool isInlier(const vpColVector &, const vpColVector &d, unsigned int i, double t) const
+    {
+      return i < d.getRows() && fabs(d[i]) < t;
+    }
+
+  private:
+    vpColVector &x;
+  };
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 };
 
+/*!
+  Compute the number of trials required to pick, with probability p, at
+  least one sample free from outliers.
+
+  \param inlierRatio : Ratio of inliers in the data (between 0 and 1).
+  \param s : Size of a sample.
+  \param p : Desired probability of choosing at least one sample free from outliers.
+  \return The number of trials.
+*/
+template <class vpTransformation>
+double
+vpRansac<vpTransformation>::computeNbTrials(const double inlierRatio, const unsigned int s, const double p)
+{
+  double eps = 1e-6 ;
+  double pNoOutliers = 1 -  pow(inlierRatio, static_cast<int>(s));
+
+  pNoOutliers = vpMath::maximum(eps, pNoOutliers);  // Avoid division by -Inf
+  pNoOutliers = vpMath::minimum(1-eps, pNoOutliers);// Avoid division by 0.
+  return (log(1-p)/log(pNoOutliers));
+}
+
+/*!
+  Count the inliers of a model. The counting is stopped as soon as more than
+  \e maxOutliers outliers are found: the returned value is then lower than
+  npts - maxOutliers and the model cannot beat a model that has this number
+  of inliers.
+
+  \param estimator : Estimator used to classify the points (see vpRansac).
+  \param M : Model.
+  \param d : Buffer filled by the estimator when the model was fitted.
+  \param npts : Number of data points.
+  \param t : Distance threshold.
+  \param maxOutliers : Maximal number of outliers before the counting is stopped.
+  \return The number of inliers.
+*/
+template <class vpTransformation>
+template <class vpEstimator>
+unsigned int
+vpRansac<vpTransformation>::countInliers(const vpEstimator &estimator, const vpColVector &M, const vpColVector &d,
+                                         unsigned int npts, double t, unsigned int maxOutliers)
+{
+  unsigned int ninliers = 0, noutliers = 0;
+  for (unsigned int i = 0; i < npts; i++)
+  {
+    if (estimator.isInlier(M, d, i, t))
+      ninliers++;
+    else if (++noutliers > maxOutliers)
+      break;
+  }
+
+  return ninliers;
+}
+
 /*!
   \brief
   RANSAC - Robustly fits a model to data with the RANSAC algorithm
@@ -113,6 +248,15 @@ public:
   \param maxNbumbersOfTrials : Maximum number of trials. Even if a solution is
   not found, the method is stopped.
 
+  \param nbThreads : Number of threads used to fit and score the models when
+  OpenMP is available. 1 keeps the sequential behavior, a value lower or
+  equal to 0 lets OpenMP choose. vpTransformation::computeTransformation()
+  and vpTransformation::computeResidual() must be thread safe to use more
+  than one thread.
+
+  \param seed : Seed of the random selection of the samples. With 0 the
+  seed is initialized from the current time.
+
 */
 
 template <class vpTransformation>
@@ -123,13 +267,74 @@ vpRansac<vpTransformation>::ransac(unsigned int npts, vpColVector &x,
 				   vpColVector &inliers,
 				   int consensus,
            double not_used,
-           const int maxNbumbersOfTrials)
+           const int maxNbumbersOfTrials,
+           const int nbThreads,
+           const long seed)
 {
-  /*   bool isplanar; */
-  /*   if (s == 4) isplanar = true; */
-  /*   else isplanar = false; */
   (void)not_used;
-  double eps = 1e-6 ;
+
+  if (s<4)
+    s = 4;
+
+  vpUniRand random(seed != 0 ? seed : (long)time(NULL)) ;
+  vpStaticEstimator estimator(x);
+  std::vector<bool> bestinliers;
+  ransac(estimator, npts, s, t, M, bestinliers, (unsigned int)vpMath::maximum(consensus, 0),
+         maxNbumbersOfTrials, nbThreads, random);
+
+  if (!bestinliers.empty())   // We got a solution
+  {
+    inliers.resize(npts, false);
+    for (unsigned int i=0 ; i < npts ; i++)
+      inliers[i] = bestinliers[i] ? 1 : 0;
+  }
+  else
+  {
+    vpTRACE("ransac was unable to find a useful solution");
+    M = 0;
+  }
+
+  return true;
+}
+
+/*!
+  \brief
+  RANSAC - Robustly fits a model to data with the RANSAC algorithm, using an
+  estimator object (see vpRansac).
+
+  \param estimator : Estimator used to fit the models and classify the points.
+
+  \param npts : The number of data points.
+
+  \param s : The number of data points required to fit a model.
+
+  \param t : The distance threshold between data point and the model used to
+  decide whether a point is an inlier or not.
+
+  \param M : The model having the greatest number of inliers.
+
+  \param inliers : Inliers of the best model, empty if no model was found.
+
+  \param consensus : The trials are stopped as soon as a model has at least
+  this number of inliers.
+
+  \param maxNbumbersOfTrials : Maximum number of trials.
+
+  \param nbThreads : Number of threads used to fit and score the models when
+  OpenMP is available. 1 keeps the sequential behavior, a value lower or
+  equal to 0 lets OpenMP choose.
+
+  \param random : Random generator used to draw the samples.
+
+  \return true if a model was found, false otherwise.
+*/
+template <class vpTransformation>
+template <class vpEstimator>
+bool
+vpRansac<vpTransformation>::ransac(const vpEstimator &estimator, unsigned int npts, unsigned int s, double t,
+                                   vpColVector &M, std::vector<bool> &inliers, unsigned int consensus,
+                                   const int maxNbumbersOfTrials, const int nbThreads, vpUniRand &random)
+{
   double p = 0.99;    // Desired probability of choosing at least one sample
   // free from outliers
 
@@ -137,118 +342,131 @@ vpRansac<vpTransformation>::ransac(unsigned int npts, vpColVector &x,
   int  maxDataTrials = 1000;  // Max number of attempts to select a non-degenerate
   // data set.
 
-  if (s<4)
-    s = 4;
+  inliers.clear();
+  if (npts < s)
+    throw(vpException(vpException::dimensionError, "Not enough data points (%d) to fit a model (%d)", npts, s));
+
+  // Number of trials fitted and scored in parallel
+  int batchSize = 1;
+#if defined(VISP_HAVE_OPENMP)
+  if (nbThreads > 1)
+    batchSize = 4*nbThreads;
+  else if (nbThreads <= 0)
+    batchSize = 32;
+#else
+  (void)nbThreads;
+#endif
 
   // Sentinel value allowing detection of solution failure.
   bool solutionFind = false ;
-  vpColVector bestM ;
   int trialcount = 0;
-  int  bestscore =  -1;
+  unsigned int bestscore = 0;
+  int bestIndex = -1;
   double   N = 1;            // Dummy initialisation for number of trials.
 
-  vpUniRand random((const long)time(NULL)) ;
-  vpColVector bestinliers ;
-  unsigned int *ind = new unsigned int [s] ;
-  int numiter = 0;
-  int ninliers = 0;
-  double residual = 0.0;
-  while(( N > trialcount) && (consensus > bestscore))
-  {
-    // Select at random s datapoints to form a trial model, M.
-    // In selecting these points we have to check that they are not in
-    // a degenerate configuration.
-
-    bool degenerate = true;
-    int count = 1;
+  // Buffers reused by all the trials
+  std::vector<unsigned int> ind((size_t)batchSize*s);
+  std::vector<vpColVector> M_batch((size_t)batchSize);
+  std::vector<vpColVector> d_batch((size_t)batchSize);
+  std::vector<int> score((size_t)batchSize);
+  std::vector<bool> usedPt(npts, false);
+  vpColVector bestM, bestd;
 
-    while ( degenerate == true)
+  bool stop = false;
+  while(!stop && ( N > trialcount) && (bestIndex < 0 || consensus > bestscore))
+  {
+    // Select at random s distinct datapoints to form each trial model of the
+    // batch. The samples are drawn sequentially so that the random sequence
+    // does not depend on the number of threads. In selecting these points we
+    // have to check that they are not in a degenerate configuration.
+    for (int b = 0; b < batchSize; b++)
     {
-      // Generate s random indicies in the range 1..npts
-      for  (unsigned int i=0 ; i < s ; i++)
-        ind[i] = (unsigned int)ceil(random()*npts) -1;
+      unsigned int *ind_b = &ind[(size_t)b*s];
+      bool degenerate = true;
+      int count = 1;
 
-      // Test that these points are not a degenerate configuration.
-      degenerate = vpTransformation::degenerateConfiguration(x,ind) ;
-      //   degenerate = feval(degenfn, x(:,ind));
-
-      // Safeguard against being stuck in this loop forever
-      count = count + 1;
-
-      if (count > maxDataTrials)      {
-        delete [] ind;
-        vpERROR_TRACE("Unable to select a nondegenerate data set");
-        throw(vpException(vpException::fatalError, "Unable to select a nondegenerate data set"));
-        //return false; //Useless after a throw() function
+      while ( degenerate == true)
+      {
+        // Generate s random indicies in the range 0..npts-1
+        for  (unsigned int i=0 ; i < s ; i++) {
+          unsigned int r = (unsigned int)ceil(random()*npts) -1;
+          while (r >= npts || usedPt[r])
+            r = (unsigned int)ceil(random()*npts) -1;
+          usedPt[r] = true;
+          ind_b[i] = r;
+        }
+        for (unsigned int i=0 ; i < s ; i++)
+          usedPt[ind_b[i]] = false;
+
+        // Test that these points are not a degenerate configuration.
+        degenerate = estimator.degenerateConfiguration(ind_b) ;
+
+        // Safeguard against being stuck in this loop forever
+        count = count + 1;
+
+        if (count > maxDataTrials)      {
+          vpERROR_TRACE("Unable to select a nondegenerate data set");
+          throw(vpException(vpException::fatalError, "Unable to select a nondegenerate data set"));
+        }
       }
     }
-    // Fit model to this random selection of data points.
-    vpTransformation::computeTransformation(x,ind, M);
 
-    vpColVector d ;
-    // Evaluate distances between points and model.
-    vpTransformation::computeResidual(x, M, d) ;
+    // A model that cannot have more inliers than the best one is not fully scored
+    const unsigned int maxOutliers = npts - bestscore;
 
-    // Find the indices of points that are inliers to this model.
-    residual = 0.0;
-    ninliers =0 ;
-    for (unsigned int i=0 ; i < npts ; i++)
+    // Fit and score the models of the batch.
+#if defined(VISP_HAVE_OPENMP)
+    int nbThreadsUsed = nbThreads > 0 ? nbThreads : omp_get_max_threads();
+#pragma omp parallel for num_threads(nbThreadsUsed) if(batchSize > 1)
+#endif
+    for (int b = 0; b < batchSize; b++)
     {
-      double resid = fabs(d[i]);
-      if (resid < t)
-      {
-        inliers[i] = 1 ;
-        ninliers++ ;
-        residual += fabs(d[i]);
-      }
-      else inliers[i] = 0;
+      if (estimator.fit(&ind[(size_t)b*s], M_batch[(size_t)b], d_batch[(size_t)b]))
+        score[(size_t)b] = (int)countInliers(estimator, M_batch[(size_t)b], d_batch[(size_t)b], npts, t, maxOutliers);
+      else
+        score[(size_t)b] = -1;
     }
 
-    if (ninliers > bestscore)    // Largest set of inliers so far...
+    // Reduce the batch in the order of the trials, exactly as if the trials
+    // were processed one after the other.
+    for (int b = 0; b < batchSize; b++)
     {
-      bestscore = ninliers;  // Record data for this model
-      bestinliers = inliers;
-      bestM = M;
-      solutionFind = true ;
-
-      // Update estimate of N, the number of trials to ensure we pick,
-      // with probability p, a data set with no outliers.
-
-      double fracinliers =  (double)ninliers / (double)npts;
-
-      double pNoOutliers = 1 -  pow(fracinliers,static_cast<int>(s));
+      if (score[(size_t)b] >= 0 && (bestIndex < 0 || (unsigned int)score[(size_t)b] > bestscore))    // Largest set of inliers so far...
+      {
+        bestscore = (unsigned int)score[(size_t)b];  // Record data for this model
+        bestIndex = trialcount;
+        bestM = M_batch[(size_t)b];
+        bestd = d_batch[(size_t)b];
+        solutionFind = true ;
+
+        // Update estimate of N, the number of trials to ensure we pick,
+        // with probability p, a data set with no outliers.
+        N = computeNbTrials((double)bestscore / (double)npts, s, p);
+      }
 
-      pNoOutliers = vpMath::maximum(eps, pNoOutliers);  // Avoid division by -Inf
-      pNoOutliers = vpMath::minimum(1-eps, pNoOutliers);// Avoid division by 0.
-      N = (log(1-p)/log(pNoOutliers));
-    }
+      trialcount = trialcount+1;
+      // Safeguard against being stuck in this loop forever
+      if (trialcount >= maxTrials)
+      {
+        vpTRACE("ransac reached the maximum number of %d trials",   maxTrials);
+        stop = true;
+        break ;
+      }
 
-    trialcount = trialcount+1;
-    // Safeguard against being stuck in this loop forever
-    if (trialcount > maxTrials)
-    {
-      vpTRACE("ransac reached the maximum number of %d trials",   maxTrials);
-      break ;
+      if (( N <= trialcount) || (consensus <= bestscore))
+        break;
     }
-    numiter++;
   }
 
   if (solutionFind==true)   // We got a solution
   {
     M = bestM;
-    inliers = bestinliers;
-  }
-  else
-  {
-    vpTRACE("ransac was unable to find a useful solution");
-    M = 0;
+    inliers.resize(npts);
+    for (unsigned int i=0 ; i < npts ; i++)
+      inliers[i] = estimator.isInlier(bestM, bestd, i, t);
   }
 
-  if(ninliers > 0)
-    residual /= ninliers;
-  delete [] ind;
-
-  return true;
+  return solutionFind;
 }
 
 
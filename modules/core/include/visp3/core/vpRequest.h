@@ -108,7 +108,7 @@ void vpRequestImage::encode(){
 
   addParameterObject(&h);
   addParameterObject(&w);
-  addParameterObject(I->bitmap,h*w*sizeof(unsigned char));
+  addParameterBuffer(I->bitmap,h*w*sizeof(unsigned char)); // Not copied
 }
   
 void vpRequestImage::decode(){
@@ -123,15 +123,27 @@ void vpRequestImage::decode(){
 }
   \endcode
   
+  Contrary to addParameterObject(), addParameterBuffer() doesn't copy the
+  bitmap: it only keeps a pointer on it. With the vpNetwork::BINARY_PROTOCOL
+  the bitmap is then directly written to the socket when the request is sent.
+  On the receiver side, the parameters are read directly in listOfParams
+  without any intermediate buffer.
+
   \sa vpClient
   \sa vpServer
   \sa vpNetwork
 */
 class VISP_EXPORT vpRequest
 {
+  friend class vpNetwork;
+
 protected:
   std::string               request_id;
   std::vector<std::string>  listOfParams;
+  //! Pointers on the parameters added with addParameterBuffer(), NULL for the other ones
+  std::vector<const char *> listOfBuffers;
+  //! Size of the parameters added with addParameterBuffer()
+  std::vector<unsigned int> listOfBuffersSize;
   
 public:
                 vpRequest();
@@ -140,6 +152,7 @@ public:
   void          addParameter(char *params);
   void          addParameter(std::string &params);
   void          addParameter(std::vector<std::string> &listOfparams);
+  void          addParameterBuffer(const void *buffer, const unsigned int &sizeOfBuffer);
   template<typename T>
   void          addParameterObject(T * params, const int &sizeOfObject = sizeof(T));
   
@@ -153,7 +166,7 @@ public:
   /*!
     Clear the parameters of the request.
   */
-  void          clear(){ listOfParams.clear(); }
+  void          clear(){ listOfParams.clear(); listOfBuffers.clear(); listOfBuffersSize.clear(); }
   
   /*!
     Encode the parameters of the request (Funtion that has to be redifined).
@@ -184,6 +197,9 @@ public:
     \return ID of the request.
   */
   std::string   getId(){ return request_id; }
+
+  const char   *getParameterData(const unsigned int &i) const;
+  unsigned int  getParameterSize(const unsigned int &i) const;
   
   /*!
     Change the ID of the request.
@@ -199,7 +215,7 @@ public:
     
     \return Number of parameters.
   */
-  unsigned int  size(){ return (unsigned int)listOfParams.size(); }
+  unsigned int  size() const { return (unsigned int)listOfParams.size(); }
 };
 
 
@@ -224,13 +240,7 @@ template<typename T>
 void vpRequest::addParameterObject(T * params, const int &sizeOfObject)
 {
   if(sizeOfObject != 0){
-    char *tempS = new char [sizeOfObject];
-    memcpy((void*)tempS, (void*)params, sizeOfObject);
-    std::string returnVal(tempS, (size_t)sizeOfObject);
-  
-    listOfParams.push_back(returnVal);
-
-    delete [] tempS;
+    listOfParams.push_back(std::string((const char*)(const void*)params, (size_t)sizeOfObject));
   }
 }
 
@@ -73,13 +73,18 @@ private:
   void draw0();
 protected:
   long x;
+  long y;      // last value of the shuffle table, 0 until the table is filled
+  long T[33];  // shuffle table, kept per generator so that a seed gives a reproducible sequence
   double draw1();
 
 public:
   //! Default constructor.
   vpUniRand(const long seed = 0)
-    : a(16807), m(2147483647), q(127773), r(2836), normalizer(2147484721.0), x((seed)? seed : 739806647)
-  {}
+    : a(16807), m(2147483647), q(127773), r(2836), normalizer(2147484721.0), x((seed)? seed : 739806647), y(0)
+  {
+    for (unsigned int j = 0; j < 33; j++)
+      T[j] = 0;
+  }
 
   //! Default destructor.
   virtual ~vpUniRand() {};
@@ -47,6 +47,105 @@
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpDebug.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
+/*!
+  \brief Conversion of a set of points from normalized coordinates
+  \f$(x,y)\f$ in meter to pixel coordinates \f$(u,v)\f$.
+
+  The coordinates are given as separate arrays (structure of arrays) so that
+  two points are converted at once with SSE2 when available. The results are
+  the same than those of convertPoint() called on each point.
+
+  \param cam : camera parameters.
+  \param x : input coordinates in meter along image plane x-axis.
+  \param y : input coordinates in meter along image plane y-axis.
+  \param u : output coordinates in pixels along image horizontal axis.
+  \param v : output coordinates in pixels along image vertical axis.
+  \param n : number of points.
+
+  \sa convertPoint()
+*/
+void
+vpMeterPixelConversion::convertPoints(const vpCameraParameters &cam,
+                                      const double *x, const double *y,
+                                      double *u, double *v, const unsigned int n)
+{
+  unsigned int i = 0;
+  const bool distortion = (cam.projModel == vpCameraParameters::perspectiveProjWithDistortion);
+
+#if VISP_HAVE_SSE2
+  const __m128d v_u0 = _mm_set1_pd(cam.u0);
+  const __m128d v_v0 = _mm_set1_pd(cam.v0);
+  const __m128d v_px = _mm_set1_pd(cam.px);
+  const __m128d v_py = _mm_set1_pd(cam.py);
+
+  if (distortion) {
+    const __m128d v_one = _mm_set1_pd(1.);
+    const __m128d v_kud = _mm_set1_pd(cam.kud);
+    for (; i + 2 <= n; i += 2) {
+      __m128d v_x = _mm_loadu_pd(x + i);
+      __m128d v_y = _mm_loadu_pd(y + i);
+      __m128d v_r2 = _mm_add_pd(v_one, _mm_mul_pd(v_kud, _mm_add_pd(_mm_mul_pd(v_x, v_x), _mm_mul_pd(v_y, v_y))));
+      _mm_storeu_pd(u + i, _mm_add_pd(v_u0, _mm_mul_pd(_mm_mul_pd(v_px, v_x), v_r2)));
+      _mm_storeu_pd(v + i, _mm_add_pd(v_v0, _mm_mul_pd(_mm_mul_pd(v_py, v_y), v_r2)));
+    }
+  }
+  else {
+    for (; i + 2 <= n; i += 2) {
+      _mm_storeu_pd(u + i, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(x + i), v_px), v_u0));
+      _mm_storeu_pd(v + i, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(y + i), v_py), v_v0));
+    }
+  }
+#endif
+
+  if (distortion) {
+    for (; i < n; i++)
+      convertPointWithDistortion(cam, x[i], y[i], u[i], v[i]);
+  }
+  else {
+    for (; i < n; i++)
+      convertPointWithoutDistortion(cam, x[i], y[i], u[i], v[i]);
+  }
+}
+
+/*!
+  \brief Conversion of a set of points from normalized coordinates
+  \f$(x,y)\f$ in meter to image points.
+
+  \param cam : camera parameters.
+  \param x : input coordinates in meter along image plane x-axis.
+  \param y : input coordinates in meter along image plane y-axis.
+  \param iP : output image points, resized to the number of points.
+
+  \sa convertPoint()
+*/
+void
+vpMeterPixelConversion::convertPoints(const vpCameraParameters &cam,
+                                      const std::vector<double> &x, const std::vector<double> &y,
+                                      std::vector<vpImagePoint> &iP)
+{
+  if (x.size() != y.size()) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot convert %d x coordinates and %d y coordinates",
+                      (int)x.size(), (int)y.size())) ;
+  }
+
+  const unsigned int n = (unsigned int)x.size();
+  iP.resize(n);
+  if (n == 0)
+    return;
+
+  std::vector<double> u(n), v(n);
+  convertPoints(cam, &x[0], &y[0], &u[0], &v[0], n);
+  for (unsigned int i = 0; i < n; i++) {
+    iP[i].set_uv(u[i], v[i]);
+  }
+}
+
 //! Line coordinates conversion (rho,theta).
 void
 vpMeterPixelConversion::convertLine(const vpCameraParameters &cam,
@@ -46,6 +46,103 @@
 #include<visp3/core/vpMath.h>
 #include<visp3/core/vpDebug.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
+/*!
+  \brief Conversion of a set of points from pixel coordinates \f$(u,v)\f$
+  to normalized coordinates \f$(x,y)\f$ in meter.
+
+  The coordinates are given as separate arrays (structure of arrays) so that
+  two points are converted at once with SSE2 when available. The results are
+  the same than those of convertPoint() called on each point.
+
+  \param cam : camera parameters.
+  \param u : input coordinates in pixels along image horizontal axis.
+  \param v : input coordinates in pixels along image vertical axis.
+  \param x : output coordinates in meter along image plane x-axis.
+  \param y : output coordinates in meter along image plane y-axis.
+  \param n : number of points.
+
+  \sa convertPoint()
+*/
+void
+vpPixelMeterConversion::convertPoints(const vpCameraParameters &cam,
+                                      const double *u, const double *v,
+                                      double *x, double *y, const unsigned int n)
+{
+  unsigned int i = 0;
+  const bool distortion = (cam.projModel == vpCameraParameters::perspectiveProjWithDistortion);
+
+#if VISP_HAVE_SSE2
+  const __m128d v_u0 = _mm_set1_pd(cam.u0);
+  const __m128d v_v0 = _mm_set1_pd(cam.v0);
+  const __m128d v_inv_px = _mm_set1_pd(cam.inv_px);
+  const __m128d v_inv_py = _mm_set1_pd(cam.inv_py);
+
+  if (distortion) {
+    const __m128d v_one = _mm_set1_pd(1.);
+    const __m128d v_kdu = _mm_set1_pd(cam.kdu);
+    for (; i + 2 <= n; i += 2) {
+      __m128d v_du = _mm_sub_pd(_mm_loadu_pd(u + i), v_u0);
+      __m128d v_dv = _mm_sub_pd(_mm_loadu_pd(v + i), v_v0);
+      __m128d v_xn = _mm_mul_pd(v_du, v_inv_px);
+      __m128d v_yn = _mm_mul_pd(v_dv, v_inv_py);
+      __m128d v_r2 = _mm_add_pd(v_one, _mm_mul_pd(v_kdu, _mm_add_pd(_mm_mul_pd(v_xn, v_xn), _mm_mul_pd(v_yn, v_yn))));
+      _mm_storeu_pd(x + i, _mm_mul_pd(_mm_mul_pd(v_du, v_r2), v_inv_px));
+      _mm_storeu_pd(y + i, _mm_mul_pd(_mm_mul_pd(v_dv, v_r2), v_inv_py));
+    }
+  }
+  else {
+    for (; i + 2 <= n; i += 2) {
+      _mm_storeu_pd(x + i, _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(u + i), v_u0), v_inv_px));
+      _mm_storeu_pd(y + i, _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(v + i), v_v0), v_inv_py));
+    }
+  }
+#endif
+
+  if (distortion) {
+    for (; i < n; i++)
+      convertPointWithDistortion(cam, u[i], v[i], x[i], y[i]);
+  }
+  else {
+    for (; i < n; i++)
+      convertPointWithoutDistortion(cam, u[i], v[i], x[i], y[i]);
+  }
+}
+
+/*!
+  \brief Conversion of a set of image points from pixel coordinates to
+  normalized coordinates \f$(x,y)\f$ in meter.
+
+  \param cam : camera parameters.
+  \param iP : input image points.
+  \param x : output coordinates in meter along image plane x-axis, resized to the number of points.
+  \param y : output coordinates in meter along image plane y-axis, resized to the number of points.
+
+  \sa convertPoint()
+*/
+void
+vpPixelMeterConversion::convertPoints(const vpCameraParameters &cam,
+                                      const std::vector<vpImagePoint> &iP,
+                                      std::vector<double> &x, std::vector<double> &y)
+{
+  const unsigned int n = (unsigned int)iP.size();
+  x.resize(n);
+  y.resize(n);
+  if (n == 0)
+    return;
+
+  // Gather the coordinates in the output arrays and convert them in place
+  for (unsigned int i = 0; i < n; i++) {
+    x[i] = iP[i].get_u();
+    y[i] = iP[i].get_v();
+  }
+  convertPoints(cam, &x[0], &y[0], &x[0], &y[0], n);
+}
+
 
 //! line coordinates conversion (rho,theta)
 void
@@ -45,6 +45,278 @@
 #  include <cv.h>
 #endif
 
+#include <string.h>
+#include <vector>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
+namespace {
+  // Index of a pixel outside the image, mirrored with the conventions of
+  // vpImageFilter::filterXLeftBorder() and vpImageFilter::filterXRightBorder()
+  inline unsigned int mirrorIndex(int x, const unsigned int n)
+  {
+    if (x < 0)
+      x = -x;
+    if (x >= (int)n)
+      x = 2*(int)n - x - 1;
+    return (x < 0) ? 0 : ((x >= (int)n) ? n - 1 : (unsigned int)x);
+  }
+
+  // Coefficients of a symmetric kernel, or of an antisymmetric one for the
+  // derivative filters, in single precision
+  struct vpFloatKernel {
+    vpFloatKernel(const double *filter, const unsigned int size)
+      : half((size-1)/2), k(filter, filter + (size-1)/2 + 1) {}
+
+    unsigned int half;
+    std::vector<float> k;
+  };
+
+  // Coefficients of a kernel with 12 fractional bits. The sum of the filtered
+  // pixels is shifted by \e shift bits. The central coefficient of a
+  // normalized kernel is adjusted so that a constant image stays constant.
+  struct vpFixedPointKernel {
+    vpFixedPointKernel(const double *filter, const unsigned int size, const bool derivative, const unsigned int shift_)
+      : half((size-1)/2), shift(shift_), k((size-1)/2 + 1)
+    {
+      double sum = derivative ? 0 : filter[0];
+      int isum = 0;
+      for (unsigned int i = 0; i <= half; i++) {
+        if (std::fabs(filter[i]) >= 8.)
+          throw (vpImageException(vpImageException::incorrectInitializationError,
+                                  "Filter coefficient too large for a fixed-point filtering"));
+        k[i] = (i == 0 && derivative) ? 0 : (short)vpMath::round(filter[i] * 4096.);
+        isum += (i == 0) ? k[i] : 2*k[i];
+        if (i > 0)
+          sum += 2*filter[i];
+      }
+      if (!derivative && std::fabs(sum - 1.) < 1e-6)
+        k[0] = (short)(k[0] + 4096 - isum);
+    }
+
+    unsigned int half;
+    unsigned int shift;
+    std::vector<short> k;
+  };
+
+#if VISP_HAVE_SSE2
+  inline __m128 load4(const float *p)
+  {
+    return _mm_loadu_ps(p);
+  }
+
+  inline __m128 load4(const unsigned char *p)
+  {
+    int v;
+    memcpy(&v, p, sizeof(int));
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero));
+  }
+
+  inline __m128i load8(const short *p)
+  {
+    return _mm_loadu_si128((const __m128i *)p);
+  }
+
+  inline __m128i load8(const unsigned char *p)
+  {
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128());
+  }
+
+  // Pair of 16 bits coefficients (a, b) repeated in a register, for _mm_madd_epi16()
+  inline __m128i setPair(const short a, const short b)
+  {
+    return _mm_set1_epi32((int)((unsigned int)(unsigned short)a | ((unsigned int)(unsigned short)b << 16)));
+  }
+#endif
+
+  inline short saturate(const int v)
+  {
+    return (short)((v < -32768) ? -32768 : ((v > 32767) ? 32767 : v));
+  }
+
+  /*
+    Filter \e n pixels. The pixel j is computed from a[i][j] and b[i][j], the
+    pixels at the distance i after and before it, and from c[j] the pixel
+    itself. The kernel is symmetric, or antisymmetric when \e derivative is
+    true. A single function handles the rows and the columns: for a row,
+    a[i] and b[i] are the same pointer shifted by +i and -i.
+  */
+  template<bool derivative, class T>
+  void filterPixels(const T *c, const T *const *a, const T *const *b, float *dst, const unsigned int n,
+                    const vpFloatKernel &kernel)
+  {
+    const float *k = &kernel.k[0];
+    unsigned int j = 0;
+#if VISP_HAVE_SSE2
+    const __m128 k0 = _mm_set1_ps(k[0]);
+    for (; j + 4 <= n; j += 4) {
+      __m128 acc = derivative ? _mm_setzero_ps() : _mm_mul_ps(k0, load4(c + j));
+      for (unsigned int i = 1; i <= kernel.half; i++) {
+        const __m128 va = load4(a[i] + j), vb = load4(b[i] + j);
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(k[i]), derivative ? _mm_sub_ps(va, vb) : _mm_add_ps(va, vb)));
+      }
+      _mm_storeu_ps(dst + j, acc);
+    }
+#endif
+    for (; j < n; j++) {
+      float acc = derivative ? 0.f : k[0] * (float)c[j];
+      for (unsigned int i = 1; i <= kernel.half; i++) {
+        acc += k[i] * (derivative ? ((float)a[i][j] - (float)b[i][j]) : ((float)a[i][j] + (float)b[i][j]));
+      }
+      dst[j] = acc;
+    }
+  }
+
+  template<bool derivative, class T>
+  void filterPixels(const T *c, const T *const *a, const T *const *b, short *dst, const unsigned int n,
+                    const vpFixedPointKernel &kernel)
+  {
+    const short *k = &kernel.k[0];
+    const int rounding = 1 << (kernel.shift - 1);
+    unsigned int j = 0;
+#if VISP_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128(), vrounding = _mm_set1_epi32(rounding);
+    const __m128i vshift = _mm_cvtsi32_si128((int)kernel.shift), k0 = setPair(k[0], 0);
+    for (; j + 8 <= n; j += 8) {
+      __m128i lo = vrounding, hi = vrounding;
+      if (!derivative) {
+        const __m128i vc = load8(c + j);
+        lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(vc, zero), k0));
+        hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(vc, zero), k0));
+      }
+      for (unsigned int i = 1; i <= kernel.half; i++) {
+        const __m128i va = load8(a[i] + j), vb = load8(b[i] + j);
+        const __m128i ki = setPair(k[i], derivative ? (short)-k[i] : k[i]);
+        lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(va, vb), ki));
+        hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(va, vb), ki));
+      }
+      _mm_storeu_si128((__m128i *)(dst + j), _mm_packs_epi32(_mm_sra_epi32(lo, vshift), _mm_sra_epi32(hi, vshift)));
+    }
+#endif
+    for (; j < n; j++) {
+      int acc = rounding + (derivative ? 0 : k[0] * (int)c[j]);
+      for (unsigned int i = 1; i <= kernel.half; i++) {
+        acc += derivative ? k[i] * ((int)a[i][j] - (int)b[i][j]) : k[i] * ((int)a[i][j] + (int)b[i][j]);
+      }
+      dst[j] = saturate(acc >> kernel.shift);
+    }
+  }
+
+  // Filter of vpImageFilter::derivativeFilterX() on pixels a[i][j] and b[i][j]
+  // at the distance i after and before the pixel j. The integer sum is exact,
+  // so that the result is the same as with the floating point filter.
+  void derivativeFilterRow(const unsigned char *const *a, const unsigned char *const *b, const unsigned int n,
+                           double *d, const double scale)
+  {
+    unsigned int j = 0;
+#if VISP_HAVE_SSE2
+    const __m128i k12 = setPair(2047, 913), k3 = setPair(112, 0), zero = _mm_setzero_si128();
+    const __m128d vscale = _mm_set1_pd(scale), vdiv = _mm_set1_pd(8418.0);
+    for (; j + 8 <= n; j += 8) {
+      const __m128i d1 = _mm_sub_epi16(load8(a[1] + j), load8(b[1] + j));
+      const __m128i d2 = _mm_sub_epi16(load8(a[2] + j), load8(b[2] + j));
+      const __m128i d3 = _mm_sub_epi16(load8(a[3] + j), load8(b[3] + j));
+      const __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(d1, d2), k12),
+                                       _mm_madd_epi16(_mm_unpacklo_epi16(d3, zero), k3));
+      const __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(d1, d2), k12),
+                                       _mm_madd_epi16(_mm_unpackhi_epi16(d3, zero), k3));
+      _mm_storeu_pd(d + j, _mm_mul_pd(vscale, _mm_div_pd(_mm_cvtepi32_pd(lo), vdiv)));
+      _mm_storeu_pd(d + j + 2, _mm_mul_pd(vscale, _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(lo, 8)), vdiv)));
+      _mm_storeu_pd(d + j + 4, _mm_mul_pd(vscale, _mm_div_pd(_mm_cvtepi32_pd(hi), vdiv)));
+      _mm_storeu_pd(d + j + 6, _mm_mul_pd(vscale, _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(hi, 8)), vdiv)));
+    }
+#endif
+    for (; j < n; j++) {
+      const int sum = 2047 * ((int)a[1][j] - (int)b[1][j]) + 913 * ((int)a[2][j] - (int)b[2][j])
+          + 112 * ((int)a[3][j] - (int)b[3][j]);
+      d[j] = scale * (sum / 8418.0);
+    }
+  }
+
+  /*
+    Filter the rows of an image. The symmetric filters mirror the image
+    outside of its borders, the derivative filters set the border columns
+    to zero, as the vpImage<double> functions do.
+  */
+  template<bool derivative, class T, class U, class K>
+  void filterImageX(const vpImage<T> &I, vpImage<U> &If, const K &kernel)
+  {
+    const unsigned int h = I.getHeight(), w = I.getWidth(), half = kernel.half;
+    If.resize(h, w);
+    if (I.getSize() == 0)
+      return;
+
+    std::vector<const T *> a(half + 1), b(half + 1);
+    if (derivative) {
+      if (w <= 2*half) {
+        memset(If.bitmap, 0, I.getSize() * sizeof(U));
+        return;
+      }
+      for (unsigned int r = 0; r < h; r++) {
+        const T *c = I[r] + half;
+        for (unsigned int i = 1; i <= half; i++) {
+          a[i] = c + i;
+          b[i] = c - i;
+        }
+        memset(If[r], 0, half * sizeof(U));
+        filterPixels<true>(c, &a[0], &b[0], If[r] + half, w - 2*half, kernel);
+        memset(If[r] + w - half, 0, half * sizeof(U));
+      }
+    }
+    else {
+      // The row is copied between its mirrored borders
+      std::vector<T> row(w + 2*half);
+      const T *c = &row[half];
+      for (unsigned int i = 1; i <= half; i++) {
+        a[i] = c + i;
+        b[i] = c - i;
+      }
+      for (unsigned int r = 0; r < h; r++) {
+        for (unsigned int i = 1; i <= half; i++) {
+          row[half - i] = I[r][mirrorIndex(-(int)i, w)];
+          row[half + w - 1 + i] = I[r][mirrorIndex((int)(w - 1 + i), w)];
+        }
+        memcpy(&row[half], I[r], w * sizeof(T));
+        filterPixels<false>(c, &a[0], &b[0], If[r], w, kernel);
+      }
+    }
+  }
+
+  /*
+    Filter the columns of an image, with the same border handling than
+    filterImageX().
+  */
+  template<bool derivative, class T, class U, class K>
+  void filterImageY(const vpImage<T> &I, vpImage<U> &If, const K &kernel)
+  {
+    const unsigned int h = I.getHeight(), w = I.getWidth(), half = kernel.half;
+    If.resize(h, w);
+    if (I.getSize() == 0)
+      return;
+
+    std::vector<const T *> a(half + 1), b(half + 1);
+    if (derivative && h <= 2*half) {
+      memset(If.bitmap, 0, I.getSize() * sizeof(U));
+      return;
+    }
+    for (unsigned int r = 0; r < h; r++) {
+      if (derivative && (r < half || r >= h - half)) {
+        memset(If[r], 0, w * sizeof(U));
+        continue;
+      }
+      for (unsigned int i = 1; i <= half; i++) {
+        a[i] = I[mirrorIndex((int)(r + i), h)];
+        b[i] = I[mirrorIndex((int)r - (int)i, h)];
+      }
+      filterPixels<derivative>(I[r], &a[0], &b[0], If[r], w, kernel);
+    }
+  }
+}
+
 
 /*!
   Apply a filter to an image.
@@ -739,6 +1011,319 @@ void vpImageFilter::getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<dou
   vpImageFilter::getGradY(GIx, dIy, gaussianDerivativeKernel, size);
 }
 
+/*!
+  Apply a separable filter. The result is in single precision.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param filter : Symmetric filter kernel that should refer to a (size+1)/2 array,
+  see vpImageFilter::getGaussianKernel().
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filter(const vpImage<unsigned char> &I, vpImage<float>& GI, const double *filter, unsigned int size)
+{
+  vpImage<float> GIx;
+  filterX(I, GIx, filter, size);
+  filterY(GIx, GI, filter, size);
+}
+
+/*!
+  Apply a separable filter to a single precision image.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param filter : Symmetric filter kernel that should refer to a (size+1)/2 array,
+  see vpImageFilter::getGaussianKernel().
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filter(const vpImage<float> &I, vpImage<float>& GI, const double *filter, unsigned int size)
+{
+  vpImage<float> GIx;
+  filterX(I, GIx, filter, size);
+  filterY(GIx, GI, filter, size);
+}
+
+/*!
+  Apply a symmetric filter along the rows. The result is in single precision.
+  The image is mirrored outside of its borders as in
+  filterX(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+
+  \param I : Input image.
+  \param dIx : Filtered image.
+  \param filter : Filter kernel that should refer to a (size+1)/2 array.
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<float>& dIx, const double *filter, unsigned int size)
+{
+  filterImageX<false>(I, dIx, vpFloatKernel(filter, size));
+}
+
+/*!
+  Apply a symmetric filter along the rows of a single precision image.
+
+  \param I : Input image.
+  \param dIx : Filtered image.
+  \param filter : Filter kernel that should refer to a (size+1)/2 array.
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filterX(const vpImage<float> &I, vpImage<float>& dIx, const double *filter, unsigned int size)
+{
+  filterImageX<false>(I, dIx, vpFloatKernel(filter, size));
+}
+
+/*!
+  Apply a symmetric filter along the columns. The result is in single precision.
+  The image is mirrored outside of its borders as in
+  filterY(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+
+  \param I : Input image.
+  \param dIy : Filtered image.
+  \param filter : Filter kernel that should refer to a (size+1)/2 array.
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<float>& dIy, const double *filter, unsigned int size)
+{
+  filterImageY<false>(I, dIy, vpFloatKernel(filter, size));
+}
+
+/*!
+  Apply a symmetric filter along the columns of a single precision image.
+
+  \param I : Input image.
+  \param dIy : Filtered image.
+  \param filter : Filter kernel that should refer to a (size+1)/2 array.
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filterY(const vpImage<float> &I, vpImage<float>& dIy, const double *filter, unsigned int size)
+{
+  filterImageY<false>(I, dIy, vpFloatKernel(filter, size));
+}
+
+/*!
+  Apply a Gaussian blur to an image. The result is in single precision.
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<float>& GI, unsigned int size, double sigma, bool normalize)
+{
+  std::vector<double> fg((size+1)/2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  vpImageFilter::filter(I, GI, &fg[0], size);
+}
+
+/*!
+  Apply a Gaussian blur to a single precision image.
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<float> &I, vpImage<float>& GI, unsigned int size, double sigma, bool normalize)
+{
+  std::vector<double> fg((size+1)/2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  vpImageFilter::filter(I, GI, &fg[0], size);
+}
+
+/*!
+  Apply a Gaussian blur to an image with fixed-point arithmetic. The filtered
+  values have 7 fractional bits: they are the ones of
+  gaussianBlur(const vpImage<unsigned char> &, vpImage<double> &, unsigned int, double, bool)
+  multiplied by 128 and rounded, the kernel being itself rounded to 12 fractional bits.
+
+  \param I : Input image.
+  \param GI : Filtered image, multiplied by 128.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<short>& GI, unsigned int size, double sigma, bool normalize)
+{
+  std::vector<double> fg((size+1)/2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  vpImage<short> GIx;
+  filterImageX<false>(I, GIx, vpFixedPointKernel(&fg[0], size, false, 5));
+  filterImageY<false>(GIx, GI, vpFixedPointKernel(&fg[0], size, false, 12));
+}
+
+/*!
+  Compute the gradient along X with a derivative filter. The result is in
+  single precision and the (size-1)/2 first and last columns are set to zero.
+
+  \param I : Input image.
+  \param dIx : Gradient along X.
+  \param filter : Derivative filter kernel, see vpImageFilter::getGaussianDerivativeKernel().
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<float>& dIx, const double *filter, unsigned int size)
+{
+  filterImageX<true>(I, dIx, vpFloatKernel(filter, size));
+}
+
+/*!
+  Compute the gradient along X of a single precision image with a derivative
+  filter. The (size-1)/2 first and last columns are set to zero.
+
+  \param I : Input image.
+  \param dIx : Gradient along X.
+  \param filter : Derivative filter kernel, see vpImageFilter::getGaussianDerivativeKernel().
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::getGradX(const vpImage<float> &I, vpImage<float>& dIx, const double *filter, unsigned int size)
+{
+  filterImageX<true>(I, dIx, vpFloatKernel(filter, size));
+}
+
+/*!
+  Compute the gradient along Y with a derivative filter. The result is in
+  single precision and the (size-1)/2 first and last rows are set to zero.
+
+  \param I : Input image.
+  \param dIy : Gradient along Y.
+  \param filter : Derivative filter kernel, see vpImageFilter::getGaussianDerivativeKernel().
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<float>& dIy, const double *filter, unsigned int size)
+{
+  filterImageY<true>(I, dIy, vpFloatKernel(filter, size));
+}
+
+/*!
+  Compute the gradient along Y of a single precision image with a derivative
+  filter. The (size-1)/2 first and last rows are set to zero.
+
+  \param I : Input image.
+  \param dIy : Gradient along Y.
+  \param filter : Derivative filter kernel, see vpImageFilter::getGaussianDerivativeKernel().
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::getGradY(const vpImage<float> &I, vpImage<float>& dIy, const double *filter, unsigned int size)
+{
+  filterImageY<true>(I, dIy, vpFloatKernel(filter, size));
+}
+
+/*!
+   Compute the gradient along X after applying a gaussian filter along Y. The
+   result is in single precision.
+   \param I : Input image
+   \param dIx : Gradient along X.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+ */
+void vpImageFilter::getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<float>& dIx, const double *gaussianKernel,
+                                    const double *gaussianDerivativeKernel, unsigned int size)
+{
+  vpImage<float> GIy;
+  filterImageY<false>(I, GIy, vpFloatKernel(gaussianKernel, size));
+  filterImageX<true>(GIy, dIx, vpFloatKernel(gaussianDerivativeKernel, size));
+}
+
+/*!
+   Compute the gradient along Y after applying a gaussian filter along X. The
+   result is in single precision.
+   \param I : Input image
+   \param dIy : Gradient along Y.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+ */
+void vpImageFilter::getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<float>& dIy, const double *gaussianKernel,
+                                    const double *gaussianDerivativeKernel, unsigned int size)
+{
+  vpImage<float> GIx;
+  filterImageX<false>(I, GIx, vpFloatKernel(gaussianKernel, size));
+  filterImageY<true>(GIx, dIy, vpFloatKernel(gaussianDerivativeKernel, size));
+}
+
+/*!
+   Compute the gradient along X after applying a gaussian filter along Y, with
+   fixed-point arithmetic. The gradient has 7 fractional bits, i.e. it is
+   multiplied by 128.
+   \param I : Input image
+   \param dIx : Gradient along X, multiplied by 128.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+ */
+void vpImageFilter::getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<short>& dIx, const double *gaussianKernel,
+                                    const double *gaussianDerivativeKernel, unsigned int size)
+{
+  vpImage<short> GIy;
+  filterImageY<false>(I, GIy, vpFixedPointKernel(gaussianKernel, size, false, 5));
+  filterImageX<true>(GIy, dIx, vpFixedPointKernel(gaussianDerivativeKernel, size, true, 12));
+}
+
+/*!
+   Compute the gradient along Y after applying a gaussian filter along X, with
+   fixed-point arithmetic. The gradient has 7 fractional bits, i.e. it is
+   multiplied by 128.
+   \param I : Input image
+   \param dIy : Gradient along Y, multiplied by 128.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+ */
+void vpImageFilter::getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<short>& dIy, const double *gaussianKernel,
+                                    const double *gaussianDerivativeKernel, unsigned int size)
+{
+  vpImage<short> GIx;
+  filterImageX<false>(I, GIx, vpFixedPointKernel(gaussianKernel, size, false, 5));
+  filterImageY<true>(GIx, dIy, vpFixedPointKernel(gaussianDerivativeKernel, size, true, 12));
+}
+
+/*!
+   Apply the 1x3 derivative filter of derivativeFilterX() to \e n contiguous
+   pixels of a row. The pixels \f$(r, c-3)\f$ to \f$(r, c+n+2)\f$ must be
+   inside the image.
+
+   The coefficients of the filter are integers, so that the weighted sum of
+   the pixels is computed with integer arithmetic and divided once. The
+   result is exactly the one of the generic derivativeFilterXRow().
+
+   \param I : Image to filter
+   \param r : coordinates (row) of the first pixel
+   \param c : coordinates (column) of the first pixel
+   \param n : number of pixels to filter
+   \param dIx : array of \e n values that receives the filtered pixels
+   \param scale : factor applied to the filtered pixels
+ */
+void vpImageFilter::derivativeFilterXRow(const vpImage<unsigned char> &I, const unsigned int r, const unsigned int c,
+                                         const unsigned int n, double *dIx, const double scale)
+{
+  const unsigned char *p = I[r] + c;
+  const unsigned char *a[4] = {p, p + 1, p + 2, p + 3};
+  const unsigned char *b[4] = {p, p - 1, p - 2, p - 3};
+  derivativeFilterRow(a, b, n, dIx, scale);
+}
+
+/*!
+   Apply the 3x1 derivative filter of derivativeFilterY() to \e n contiguous
+   pixels of a row. The rows \f$r-3\f$ to \f$r+3\f$ must be inside the image.
+
+   The coefficients of the filter are integers, so that the weighted sum of
+   the pixels is computed with integer arithmetic and divided once. The
+   result is exactly the one of the generic derivativeFilterYRow().
+
+   \param I : Image to filter
+   \param r : coordinates (row) of the first pixel
+   \param c : coordinates (column) of the first pixel
+   \param n : number of pixels to filter
+   \param dIy : array of \e n values that receives the filtered pixels
+   \param scale : factor applied to the filtered pixels
+ */
+void vpImageFilter::derivativeFilterYRow(const vpImage<unsigned char> &I, const unsigned int r, const unsigned int c,
+                                         const unsigned int n, double *dIy, const double scale)
+{
+  const unsigned char *a[4] = {I[r] + c, I[r+1] + c, I[r+2] + c, I[r+3] + c};
+  const unsigned char *b[4] = {I[r] + c, I[r-1] + c, I[r-2] + c, I[r-3] + c};
+  derivativeFilterRow(a, b, n, dIy, scale);
+}
+
 //operation pour pyramide gaussienne
 void vpImageFilter::getGaussPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char>& GI)
 {
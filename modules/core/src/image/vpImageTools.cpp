@@ -37,11 +37,194 @@
 
 #include <visp3/core/vpImageTools.h>
 
+#include <vector>
+
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #  include <emmintrin.h>
 #  define VISP_HAVE_SSE2 1
 #endif
 
+#if defined(VISP_HAVE_OPENMP)
+#  include <omp.h>
+#endif
+
+// Minimal number of pixels to compute the integral images and the box
+// filters with several threads
+#define VP_IMAGE_TOOLS_PARALLEL_PIXELS 65536
+
+namespace {
+  // Add the n values of src to dst
+  inline void addRow(unsigned int *dst, const unsigned int *src, const unsigned int n)
+  {
+    unsigned int j = 0;
+#if VISP_HAVE_SSE2
+    for (; j + 4 <= n; j += 4) {
+      const __m128i v = _mm_add_epi32(_mm_loadu_si128((const __m128i *)(dst + j)),
+                                      _mm_loadu_si128((const __m128i *)(src + j)));
+      _mm_storeu_si128((__m128i *)(dst + j), v);
+    }
+#endif
+    for (; j < n; j++) {
+      dst[j] += src[j];
+    }
+  }
+
+  inline void addRow(double *dst, const double *src, const unsigned int n)
+  {
+    unsigned int j = 0;
+#if VISP_HAVE_SSE2
+    for (; j + 2 <= n; j += 2) {
+      _mm_storeu_pd(dst + j, _mm_add_pd(_mm_loadu_pd(dst + j), _mm_loadu_pd(src + j)));
+    }
+#endif
+    for (; j < n; j++) {
+      dst[j] += src[j];
+    }
+  }
+
+  // Prefix sums of a row: dst[0] = 0, dst[j+1] = src[0] + ... + src[j]
+  void prefixSumRow(const unsigned char *src, unsigned int *dst, const unsigned int n)
+  {
+    dst[0] = 0;
+    unsigned int j = 0, sum = 0;
+#if VISP_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    __m128i carry = zero;
+    for (; j + 4 <= n; j += 4) {
+      int v;
+      memcpy(&v, src + j, sizeof(int));
+      __m128i x = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero);
+      x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+      x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+      x = _mm_add_epi32(x, carry);
+      _mm_storeu_si128((__m128i *)(dst + j + 1), x);
+      carry = _mm_shuffle_epi32(x, 0xFF);
+    }
+    sum = (unsigned int)_mm_cvtsi128_si32(carry);
+#endif
+    for (; j < n; j++) {
+      sum += src[j];
+      dst[j+1] = sum;
+    }
+  }
+
+  void prefixSumSquareRow(const unsigned char *src, double *dst, const unsigned int n)
+  {
+    dst[0] = 0;
+    double sum = 0;
+    for (unsigned int j = 0; j < n; j++) {
+      sum += (double)(src[j] * src[j]);
+      dst[j+1] = sum;
+    }
+  }
+
+  /*
+    Integral images of I, and of the squared pixels of I when IIsq is not
+    NULL. The rows are first summed in parallel, then the columns are
+    accumulated by vertical stripes.
+  */
+  void computeIntegralImages(const vpImage<unsigned char> &I, vpImage<unsigned int> &II, vpImage<double> *IIsq)
+  {
+    const unsigned int h = I.getHeight(), w = I.getWidth();
+    II.resize(h + 1, w + 1);
+    memset(II[0], 0, (w + 1) * sizeof(unsigned int));
+    if (IIsq != NULL) {
+      IIsq->resize(h + 1, w + 1);
+      memset((*IIsq)[0], 0, (w + 1) * sizeof(double));
+    }
+    const bool parallel = (I.getSize() >= VP_IMAGE_TOOLS_PARALLEL_PIXELS);
+    (void)parallel;
+
+    const int nb_rows = (int)h;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for if(parallel)
+#endif
+    for (int i = 0; i < nb_rows; i++) {
+      prefixSumRow(I[(unsigned int)i], II[(unsigned int)i + 1], w);
+      if (IIsq != NULL) {
+        prefixSumSquareRow(I[(unsigned int)i], (*IIsq)[(unsigned int)i + 1], w);
+      }
+    }
+
+    const unsigned int stripe = 256;
+    const int nb_stripes = (int)((w + stripe) / stripe);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for if(parallel)
+#endif
+    for (int s = 0; s < nb_stripes; s++) {
+      const unsigned int j0 = (unsigned int)s * stripe;
+      const unsigned int n = (j0 + stripe <= w + 1) ? stripe : w + 1 - j0;
+      for (unsigned int i = 1; i <= h; i++) {
+        addRow(II[i] + j0, II[i-1] + j0, n);
+        if (IIsq != NULL) {
+          addRow((*IIsq)[i] + j0, (*IIsq)[i-1] + j0, n);
+        }
+      }
+    }
+  }
+
+  /*
+    Mean, and variance when Ivar is not NULL, of the pixels of the
+    size x size windows centered on each pixel. The windows are clipped to
+    the image, so that only the columns close to the borders need their own
+    number of pixels.
+  */
+  void computeBoxStatistics(const vpImage<unsigned char> &I, vpImage<float> &Imean, vpImage<float> *Ivar,
+                            const unsigned int size)
+  {
+    if (size % 2 != 1) {
+      throw (vpImageException(vpImageException::incorrectInitializationError, "Bad box filter size"));
+    }
+
+    vpImage<unsigned int> II;
+    vpImage<double> IIsq;
+    computeIntegralImages(I, II, (Ivar != NULL) ? &IIsq : NULL);
+
+    const unsigned int h = I.getHeight(), w = I.getWidth(), r = size / 2;
+    Imean.resize(h, w);
+    if (Ivar != NULL) {
+      Ivar->resize(h, w);
+    }
+
+    // Columns [j1, j2) of the window of each column, and inverse of their number
+    std::vector<unsigned int> j1(w), j2(w);
+    std::vector<double> inv_width(w);
+    for (unsigned int j = 0; j < w; j++) {
+      j1[j] = (j > r) ? j - r : 0;
+      j2[j] = (j + r + 1 < w) ? j + r + 1 : w;
+      inv_width[j] = 1. / (j2[j] - j1[j]);
+    }
+
+    const int nb_rows = (int)h;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for if(I.getSize() >= VP_IMAGE_TOOLS_PARALLEL_PIXELS)
+#endif
+    for (int i_ = 0; i_ < nb_rows; i_++) {
+      const unsigned int i = (unsigned int)i_;
+      const unsigned int i1 = (i > r) ? i - r : 0, i2 = (i + r + 1 < h) ? i + r + 1 : h;
+      const double inv_height = 1. / (i2 - i1);
+      const unsigned int *a = II[i1], *b = II[i2];
+      float *mean = Imean[i];
+      if (Ivar == NULL) {
+        for (unsigned int j = 0; j < w; j++) {
+          const unsigned int sum = (b[j2[j]] - b[j1[j]]) - (a[j2[j]] - a[j1[j]]);
+          mean[j] = (float)(sum * inv_height * inv_width[j]);
+        }
+      }
+      else {
+        const double *asq = IIsq[i1], *bsq = IIsq[i2];
+        float *var = (*Ivar)[i];
+        for (unsigned int j = 0; j < w; j++) {
+          const double inv_n = inv_height * inv_width[j];
+          const double m = ((b[j2[j]] - b[j1[j]]) - (a[j2[j]] - a[j1[j]])) * inv_n;
+          const double v = ((bsq[j2[j]] - bsq[j1[j]]) - (asq[j2[j]] - asq[j1[j]])) * inv_n - m * m;
+          mean[j] = (float)m;
+          var[j] = (v > 0) ? (float)v : 0.f;
+        }
+      }
+    }
+  }
+}
 
 /*!
   Change the look up table (LUT) of an image. Considering pixel gray
@@ -360,6 +543,84 @@ vpImageTools::imageSubtract(const vpImage<unsigned char> &I1,
   }
 }
 
+/*!
+  Compute the integral image, or summed-area table, of an image:
+  \f$ II(i, j) = \sum_{i' < i, j' < j} I(i', j') \f$. The integral image has
+  one more row and one more column than the image, filled with zeros, so that
+  the sum of the pixels of any rectangle is given by getIntegralSum() with
+  four accesses.
+
+  The rows are summed in parallel when OpenMP is available, and with SSE2
+  when available.
+
+  \param I : Input image.
+  \param II : Integral image of size (I.getHeight()+1)x(I.getWidth()+1).
+  The sums wrap around above \f$2^{32}\f$ (images of more than 16.8
+  Mpixels), but the sums of the rectangles given by getIntegralSum() stay
+  exact while they fit in 32 bits.
+
+  \sa boxMean(), boxMeanVariance()
+*/
+void
+vpImageTools::integralImage(const vpImage<unsigned char> &I, vpImage<unsigned int> &II)
+{
+  computeIntegralImages(I, II, NULL);
+}
+
+/*!
+  Compute the integral image of an image and the integral image of its
+  squared pixels, for instance to get the variance of any rectangle in
+  constant time.
+
+  \param I : Input image.
+  \param II : Integral image, see integralImage(const vpImage<unsigned char> &, vpImage<unsigned int> &).
+  \param IIsq : Integral image of the squared pixels, of size
+  (I.getHeight()+1)x(I.getWidth()+1). The sums are integers smaller than
+  \f$2^{53}\f$ for any image smaller than 138 Gpixels, so they are exact.
+*/
+void
+vpImageTools::integralImage(const vpImage<unsigned char> &I, vpImage<unsigned int> &II, vpImage<double> &IIsq)
+{
+  computeIntegralImages(I, II, &IIsq);
+}
+
+/*!
+  Box filter: compute the mean of the pixels of the size x size window
+  centered on each pixel, in constant time per pixel whatever the size of the
+  window thanks to the integral image. Close to the borders, the window is
+  clipped to the image.
+
+  \param I : Input image.
+  \param Imean : Local means.
+  \param size : Size of the window. This value should be odd.
+*/
+void
+vpImageTools::boxMean(const vpImage<unsigned char> &I, vpImage<float> &Imean, const unsigned int size)
+{
+  computeBoxStatistics(I, Imean, NULL, size);
+}
+
+/*!
+  Compute the mean and the variance of the pixels of the size x size window
+  centered on each pixel, in constant time per pixel whatever the size of the
+  window thanks to the integral images. Close to the borders, the window is
+  clipped to the image.
+
+  \param I : Input image.
+  \param Imean : Local means.
+  \param Ivar : Local variances.
+  \param size : Size of the window. This value should be odd.
+*/
+void
+vpImageTools::boxMeanVariance(const vpImage<unsigned char> &I, vpImage<float> &Imean, vpImage<float> &Ivar,
+                              const unsigned int size)
+{
+  computeBoxStatistics(I, Imean, &Ivar, size);
+}
+
+// Reference: http://blog.demofox.org/2015/08/15/resizing-images-with-bicubic-interpolation/
+// t is a value that goes from 0 to 1 to interpolate in a C1 continuous way across uniformly sampled data points.
+// when t is 0, this will return B.  When t is 1, this will return C. In between values will return an interpolation
 // Reference: http://blog.demofox.org/2015/08/15/resizing-images-with-bicubic-interpolation/
 // t is a value that goes from 0 to 1 to interpolate in a C1 continuous way across uniformly sampled data points.
 // when t is 0, this will return B.  When t is 1, this will return C. In between values will return an interpolation
@@ -46,6 +46,16 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(VISP_HAVE_OPENMP)
+#  include <omp.h>
+#endif
+
+//! Number of signals below which the blocks are not filtered in parallel
+#define VP_KALMAN_PARALLEL_SIGNALS 1024
 
 /*!
   Initialize the Kalman filter.
@@ -88,7 +98,7 @@ vpKalmanFilter::init(unsigned int size_state_vector, unsigned int size_measure_v
   
 */
 vpKalmanFilter::vpKalmanFilter()
-  : iter(0), size_state(0), size_measure(0), nsignal(0), verbose_mode(false),
+  : iter(0), size_state(0), size_measure(0), nsignal(0), verbose_mode(false), block_diagonal(false),
     Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I()
 {
 }
@@ -101,7 +111,7 @@ vpKalmanFilter::vpKalmanFilter()
   \param n_signal : Number of signal to filter.
 */
 vpKalmanFilter::vpKalmanFilter(unsigned int n_signal)
-  : iter(0), size_state(0), size_measure(0), nsignal(n_signal), verbose_mode(false),
+  : iter(0), size_state(0), size_measure(0), nsignal(n_signal), verbose_mode(false), block_diagonal(false),
     Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I()
 {
 }
@@ -119,7 +129,7 @@ vpKalmanFilter::vpKalmanFilter(unsigned int n_signal)
   \param n_signal : Number of signal to filter.
 */
 vpKalmanFilter::vpKalmanFilter(unsigned int size_state_vector, unsigned int size_measure_vector, unsigned int n_signal)
-  : iter(0), size_state(0), size_measure(0), nsignal(0), verbose_mode(false),
+  : iter(0), size_state(0), size_measure(0), nsignal(0), verbose_mode(false), block_diagonal(false),
     Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I()
 {
   init( size_state_vector, size_measure_vector, n_signal) ;
@@ -161,16 +171,21 @@ vpKalmanFilter::prediction()
     std::cout << "F = " << std::endl <<  F << std::endl ;
     std::cout << "Xest = "<< std::endl  << Xest << std::endl  ;  
   }
-  // Prediction
-  // Bar-Shalom  5.2.3.2
-  Xpre = F*Xest  ;
-  if (verbose_mode) {
-    std::cout << "Xpre = "<< std::endl  << Xpre << std::endl  ;
-    std::cout << "Q = "<< std::endl  << Q << std::endl  ;  
-    std::cout << "Pest " << std::endl << Pest << std::endl ;
+  if (block_diagonal) {
+    predictionByBlocks();
+  }
+  else {
+    // Prediction
+    // Bar-Shalom  5.2.3.2
+    Xpre = F*Xest  ;
+    if (verbose_mode) {
+      std::cout << "Xpre = "<< std::endl  << Xpre << std::endl  ;
+      std::cout << "Q = "<< std::endl  << Q << std::endl  ;
+      std::cout << "Pest " << std::endl << Pest << std::endl ;
+    }
+    // Bar-Shalom  5.2.3.5
+    Ppre = F*Pest*F.t() + Q ;
   }
-  // Bar-Shalom  5.2.3.5
-  Ppre = F*Pest*F.t() + Q ;
 
   // Matrice de covariance de l'erreur de prediction
   if (verbose_mode) 
@@ -213,6 +228,16 @@ vpKalmanFilter::filtering(const vpColVector &z)
 {
   if (verbose_mode)
     std::cout << "z " << std::endl << z << std::endl ;
+  if (block_diagonal) {
+    filteringByBlocks(z);
+    if (verbose_mode) {
+      std::cout << "W " << std::endl << W << std::endl ;
+      std::cout << "Pest " << std::endl << Pest << std::endl ;
+      std::cout << "Xest " << std::endl << Xest << std::endl ;
+    }
+    iter++ ;
+    return;
+  }
   // Bar-Shalom  5.2.3.11
   vpMatrix S =  H*Ppre*H.t() + R ;
   if (verbose_mode)
@@ -242,6 +267,227 @@ vpKalmanFilter::filtering(const vpColVector &z)
 }
 
 
+/*!
+  Apply the prediction equations to the diagonal blocks of the matrices, one
+  signal after the other. The operations are the same as in prediction(),
+  without the products by the null blocks outside of the diagonal.
+*/
+void
+vpKalmanFilter::predictionByBlocks()
+{
+  const unsigned int n = size_state;
+  const unsigned int N = size_state*nsignal;
+  if (Ppre.getRows() != N || Ppre.getCols() != N) {
+    Ppre.resize(N, N);
+  }
+  if (Xpre.getRows() != N) {
+    Xpre.resize(N);
+  }
+
+  const int nb_signal = (int)nsignal;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel if(nsignal >= VP_KALMAN_PARALLEL_SIGNALS)
+#endif
+  {
+    // F*Pest for the current signal
+    std::vector<double> FP(n*n);
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for
+#endif
+    for (int b = 0; b < nb_signal; b++) {
+      const unsigned int o = (unsigned int)b*n;
+      for (unsigned int i = 0; i < n; i++) {
+        const double *Fi = F[o+i] + o;
+        double x = 0;
+        for (unsigned int k = 0; k < n; k++) {
+          x += Fi[k] * Xest[o+k];
+        }
+        Xpre[o+i] = x;
+
+        for (unsigned int j = 0; j < n; j++) {
+          double s = 0;
+          for (unsigned int k = 0; k < n; k++) {
+            s += Fi[k] * Pest[o+k][o+j];
+          }
+          FP[i*n+j] = s;
+        }
+      }
+
+      for (unsigned int i = 0; i < n; i++) {
+        double *Ppre_i = Ppre[o+i] + o;
+        const double *Qi = Q[o+i] + o;
+        for (unsigned int j = 0; j < n; j++) {
+          const double *Fj = F[o+j] + o;
+          double s = 0;
+          for (unsigned int k = 0; k < n; k++) {
+            s += FP[i*n+k] * Fj[k];
+          }
+          Ppre_i[j] = s + Qi[j];
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Apply the filtering equations to the diagonal blocks of the matrices, one
+  signal after the other. The operations are the same as in filtering(),
+  without the products by the null blocks outside of the diagonal. The
+  innovation covariance of each signal is inverted separately.
+
+  \param z : Measure (or observation) \f${\bf z}_k\f$ provided at iteration \f$k\f$.
+*/
+void
+vpKalmanFilter::filteringByBlocks(const vpColVector &z)
+{
+  const unsigned int n = size_state;
+  const unsigned int m = size_measure;
+  if (z.getRows() != m*nsignal) {
+    throw(vpException(vpException::dimensionError, "Bad measure size %d instead of %d", z.getRows(), m*nsignal));
+  }
+  if (W.getRows() != n*nsignal || W.getCols() != m*nsignal) {
+    W.resize(n*nsignal, m*nsignal);
+  }
+  if (Pest.getRows() != n*nsignal || Pest.getCols() != n*nsignal) {
+    Pest.resize(n*nsignal, n*nsignal);
+  }
+
+  const int nb_signal = (int)nsignal;
+  int singular_signal = -1;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel if(nsignal >= VP_KALMAN_PARALLEL_SIGNALS)
+#endif
+  {
+    // H*Ppre, S, Ppre*H^T, W*S and the innovation for the current signal
+    std::vector<double> HP(m*n), PHt(n*m), WS(n*m), innovation(m);
+    vpMatrix S(m, m), Sinv(m, m);
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for
+#endif
+    for (int b = 0; b < nb_signal; b++) {
+      const unsigned int o = (unsigned int)b*n;
+      const unsigned int om = (unsigned int)b*m;
+
+      // Bar-Shalom  5.2.3.11
+      for (unsigned int i = 0; i < m; i++) {
+        const double *Hi = H[om+i] + o;
+        for (unsigned int j = 0; j < n; j++) {
+          double s = 0;
+          for (unsigned int k = 0; k < n; k++) {
+            s += Hi[k] * Ppre[o+k][o+j];
+          }
+          HP[i*n+j] = s;
+        }
+      }
+      for (unsigned int i = 0; i < m; i++) {
+        for (unsigned int j = 0; j < m; j++) {
+          const double *Hj = H[om+j] + o;
+          double s = 0;
+          for (unsigned int k = 0; k < n; k++) {
+            s += HP[i*n+k] * Hj[k];
+          }
+          S[i][j] = s + R[om+i][om+j];
+        }
+      }
+
+      bool singular = false;
+      if (m == 1) {
+        singular = (std::fabs(S[0][0]) < std::numeric_limits<double>::min());
+        Sinv[0][0] = 1. / S[0][0];
+      }
+      else {
+        try {
+          Sinv = S.inverseByLU();
+        }
+        catch(...) {
+          singular = true;
+        }
+      }
+      if (singular) {
+        // The exception is thrown outside of the parallel loop, for the first singular signal
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp critical
+#endif
+        if (singular_signal < 0 || b < singular_signal) {
+          singular_signal = b;
+        }
+        continue;
+      }
+
+      for (unsigned int i = 0; i < n; i++) {
+        const double *Ppre_i = Ppre[o+i] + o;
+        for (unsigned int j = 0; j < m; j++) {
+          const double *Hj = H[om+j] + o;
+          double s = 0;
+          for (unsigned int k = 0; k < n; k++) {
+            s += Ppre_i[k] * Hj[k];
+          }
+          PHt[i*m+j] = s;
+        }
+      }
+      for (unsigned int i = 0; i < n; i++) {
+        double *Wi = W[o+i] + om;
+        for (unsigned int j = 0; j < m; j++) {
+          double s = 0;
+          for (unsigned int k = 0; k < m; k++) {
+            s += PHt[i*m+k] * Sinv[k][j];
+          }
+          Wi[j] = s;
+        }
+      }
+
+      // Bar-Shalom  5.2.3.15
+      for (unsigned int i = 0; i < n; i++) {
+        const double *Wi = W[o+i] + om;
+        for (unsigned int j = 0; j < m; j++) {
+          double s = 0;
+          for (unsigned int k = 0; k < m; k++) {
+            s += Wi[k] * S[k][j];
+          }
+          WS[i*m+j] = s;
+        }
+      }
+      for (unsigned int i = 0; i < n; i++) {
+        const double *Ppre_i = Ppre[o+i] + o;
+        double *Pest_i = Pest[o+i] + o;
+        for (unsigned int j = 0; j < n; j++) {
+          const double *Wj = W[o+j] + om;
+          double s = 0;
+          for (unsigned int k = 0; k < m; k++) {
+            s += WS[i*m+k] * Wj[k];
+          }
+          Pest_i[j] = Ppre_i[j] - s;
+        }
+      }
+
+      // Bar-Shalom  5.2.3.12 5.2.3.13 5.2.3.7
+      for (unsigned int i = 0; i < m; i++) {
+        const double *Hi = H[om+i] + o;
+        double s = 0;
+        for (unsigned int k = 0; k < n; k++) {
+          s += Hi[k] * Xpre[o+k];
+        }
+        innovation[i] = z[om+i] - s;
+      }
+      for (unsigned int i = 0; i < n; i++) {
+        const double *Wi = W[o+i] + om;
+        double s = 0;
+        for (unsigned int k = 0; k < m; k++) {
+          s += Wi[k] * innovation[k];
+        }
+        Xest[o+i] = Xpre[o+i] + s;
+      }
+    }
+  }
+
+  if (singular_signal >= 0) {
+    throw(vpException(vpException::fatalError, "Cannot invert the innovation covariance of signal %d",
+                      singular_signal));
+  }
+}
+
 #if 0
 
 
@@ -302,6 +302,7 @@ vpLinearKalmanFilterInstantiation::initStateConstVel_MeasurePos(unsigned int n_s
   setStateModel(stateConstVel_MeasurePos);
 
   init(size_state, size_measure, n_signal);
+  setBlockDiagonal(true);
 
   iter = 0;
   Pest = 0;
@@ -515,6 +516,7 @@ vpLinearKalmanFilterInstantiation::initStateConstVelWithColoredNoise_MeasureVel(
   setStateModel(stateConstVelWithColoredNoise_MeasureVel);
 
   init(size_state, size_measure, n_signal);
+  setBlockDiagonal(true);
 
   iter = 0;
   Pest = 0;
@@ -738,6 +740,7 @@ vpLinearKalmanFilterInstantiation::initStateConstAccWithColoredNoise_MeasureVel(
   setStateModel(stateConstAccWithColoredNoise_MeasureVel);
 
   init(size_state, size_measure, n_signal);
+  setBlockDiagonal(true);
 
   iter = 0;
   Pest = 0;
@@ -65,9 +65,6 @@ vpUniRand::draw1()
                                   //the 33rd one is actually the first value of y.
   const long modulo = ntab-2;
 
-  static long y = 0;
-  static long T[ntab];
-
   long j; //index of T
 
   //step 0
@@ -36,6 +36,8 @@
  *****************************************************************************/
 
 #include <limits.h>
+#include <limits>
+#include <algorithm>
 
 #include <visp3/core/vpConfig.h>
 /*!
@@ -52,14 +54,16 @@
 vpPolygon3D::vpPolygon3D()
   : nbpt(0), nbCornersInsidePrev(0),
     p(NULL), polyClipped(), clippingFlag(vpPolygon3D::NO_CLIPPING),
-    distNearClip(0.001), distFarClip(100.)
+    distNearClip(0.001), distFarClip(100.), clippedPoints(), clippedFlags(),
+    clippedPointsTmp(), clippedFlagsTmp()
 {
 }
 
 vpPolygon3D::vpPolygon3D(const vpPolygon3D& mbtp)
   : nbpt(mbtp.nbpt), nbCornersInsidePrev(mbtp.nbCornersInsidePrev),
     p(NULL), polyClipped(mbtp.polyClipped), clippingFlag(mbtp.clippingFlag),
-    distNearClip(mbtp.distNearClip), distFarClip(mbtp.distFarClip)
+    distNearClip(mbtp.distNearClip), distFarClip(mbtp.distFarClip), clippedPoints(mbtp.clippedPoints),
+    clippedFlags(mbtp.clippedFlags), clippedPointsTmp(), clippedFlagsTmp()
 {
   if (p) delete [] p;
   p = new vpPoint [nbpt];
@@ -75,6 +79,8 @@ vpPolygon3D& vpPolygon3D::operator=(const vpPolygon3D& mbtp)
   clippingFlag = mbtp.clippingFlag;
   distNearClip = mbtp.distNearClip;
   distFarClip = mbtp.distFarClip;
+  clippedPoints = mbtp.clippedPoints;
+  clippedFlags = mbtp.clippedFlags;
 
   if (p) delete [] p;
   p = new vpPoint [nbpt];
@@ -154,9 +160,117 @@ vpPolygon3D::changeFrame(const vpHomogeneousMatrix &cMo)
   }
 }
 
+namespace {
+/*
+  A vertex of the polygon during the clipping is given by its coordinates
+  in the object frame followed by its coordinates in the camera frame:
+  (oX, oY, oZ, X, Y, Z).
+*/
+
+// Intersection of the edge [v1, v2] at parameter t
+void interpolateVertex(const double *v1, const double *v2, const double t, double *v)
+{
+  for (unsigned int k = 0; k < 6; k++)
+    v[k] = (v2[k] - v1[k])*t + v1[k];
+}
+
+/*
+  Clip an edge with a plane of the field of view. Return false if the edge
+  is totally outside.
+*/
+bool clipEdgeFov(double *v1, double *v2, unsigned int &v1ClippedInfo, unsigned int &v2ClippedInfo,
+                 const vpColVector &normal, const unsigned int flag, const unsigned int clippingFlag)
+{
+  if ((clippingFlag & flag) == flag) {
+    double n1 = sqrt(v1[3]*v1[3] + v1[4]*v1[4] + v1[5]*v1[5]);
+    double n2 = sqrt(v2[3]*v2[3] + v2[4]*v2[4] + v2[5]*v2[5]);
+    if (n1 < std::numeric_limits<double>::epsilon()) n1 = 1.;
+    if (n2 < std::numeric_limits<double>::epsilon()) n2 = 1.;
+    double beta1 = acos( (v1[3]/n1)*normal[0] + (v1[4]/n1)*normal[1] + (v1[5]/n1)*normal[2] );
+    double beta2 = acos( (v2[3]/n2)*normal[0] + (v2[4]/n2)*normal[1] + (v2[5]/n2)*normal[2] );
+
+    if (beta1 < M_PI / 2.0 && beta2 < M_PI / 2.0)
+      return false;
+    else if (beta1 < M_PI / 2.0 || beta2 < M_PI / 2.0) {
+      double t = -(normal[0] * v1[3] + normal[1] * v1[4] + normal[2] * v1[5]);
+      t = t / ( normal[0] * (v2[3] - v1[3]) + normal[1] * (v2[4] - v1[4]) + normal[2] * (v2[5] - v1[5]) );
+
+      double v[6];
+      interpolateVertex(v1, v2, t, v);
+
+      if (beta1 < M_PI / 2.0) {
+        v1ClippedInfo = v1ClippedInfo | flag;
+        for (unsigned int k = 0; k < 6; k++) v1[k] = v[k];
+      }
+      else {
+        v2ClippedInfo = v2ClippedInfo | flag;
+        for (unsigned int k = 0; k < 6; k++) v2[k] = v[k];
+      }
+    }
+  }
+
+  return true;
+}
+
+/*
+  Clip an edge with the near or far plane. Return false if the edge is
+  totally outside.
+*/
+bool clipEdgeDistance(double *v1, double *v2, unsigned int &v1ClippedInfo, unsigned int &v2ClippedInfo,
+                      const unsigned int flag, const double distance)
+{
+  const bool farClipping = (flag == vpPolygon3D::FAR_CLIPPING);
+  bool test1 = farClipping ? (v1[5] > distance && v2[5] > distance) : (v1[5] < distance && v2[5] < distance);
+  bool test2 = farClipping ? (v1[5] > distance || v2[5] > distance) : (v1[5] < distance || v2[5] < distance);
+  bool test3 = farClipping ? (v1[5] > distance) : (v1[5] < distance);
+
+  if (test1)
+    return false;
+
+  else if (test2) {
+    double t = (v2[5] - v1[5]);
+    t = (distance - v1[5]) / t;
+
+    double v[6];
+    interpolateVertex(v1, v2, t, v);
+    v[5] = distance;
+
+    const unsigned int info = farClipping ? vpPolygon3D::FAR_CLIPPING : vpPolygon3D::NEAR_CLIPPING;
+    if (test3) {
+      for (unsigned int k = 0; k < 6; k++) v1[k] = v[k];
+      v1ClippedInfo = v1ClippedInfo | info;
+    }
+    else {
+      for (unsigned int k = 0; k < 6; k++) v2[k] = v[k];
+      v2ClippedInfo = v2ClippedInfo | info;
+    }
+  }
+
+  return true;
+}
+
+void getVertex(const vpPointSet &points, const unsigned int i, double *v)
+{
+  v[0] = points.get_oX(i); v[1] = points.get_oY(i); v[2] = points.get_oZ(i);
+  v[3] = points.get_X(i); v[4] = points.get_Y(i); v[5] = points.get_Z(i);
+}
+
+void addVertex(vpPointSet &points, const double *v)
+{
+  points.addPoint(v[0], v[1], v[2]);
+  points.setCameraCoordinates(points.size()-1, v[3], v[4], v[5]);
+}
+}
+
 /*!
   Compute the region of interest in the image according to the used clipping.
 
+  The clipping is done on the coordinates of the corners stored as a
+  structure of arrays (see getPolygonClipped(vpPointSet &, std::vector<unsigned int> &))
+  whose memory is reused from one call to the other. The object frame
+  coordinates of the points created by the clipping are interpolated from
+  the ones of the corners.
+
   \warning If the FOV clipping is used, camera normals have to be precomputed.
   
   \param cam : camera parameters used to compute the field of view.
@@ -164,17 +278,17 @@ vpPolygon3D::changeFrame(const vpHomogeneousMatrix &cMo)
 void
 vpPolygon3D::computePolygonClipped(const vpCameraParameters &cam)
 {
-  polyClipped.clear();
   std::vector<vpColVector> fovNormals;
-  std::vector<std::pair<vpPoint,unsigned int> > polyClippedTemp;
-  std::vector<std::pair<vpPoint,unsigned int> > polyClippedTemp2;
 
   if(cam.isFovComputed() && clippingFlag > 3)
     fovNormals = cam.getFovNormals();
 
+  clippedPoints.clear();
+  clippedFlags.clear();
   for(unsigned int i = 0 ; i < nbpt ; i++){
-      p[i%nbpt].projection();
-      polyClippedTemp.push_back(std::make_pair(p[i%nbpt],vpPolygon3D::NO_CLIPPING));
+    p[i].projection();
+    clippedPoints.addPoint(p[i]);
+    clippedFlags.push_back(vpPolygon3D::NO_CLIPPING);
   }
 
   if(clippingFlag != vpPolygon3D::NO_CLIPPING) {
@@ -185,198 +299,78 @@ vpPolygon3D::computePolygonClipped(const vpCameraParameters &cam)
         if(i > vpPolygon3D::FAR_CLIPPING && !cam.isFovComputed()) // To make sure we do not compute FOV clipping if camera normals are not computed
           continue;
 
-        for(unsigned int j = 0 ; j < polyClippedTemp.size() ; j++)
+        clippedPointsTmp.clear();
+        clippedFlagsTmp.clear();
+        const unsigned int n = clippedPoints.size();
+        for(unsigned int j = 0 ; j < n ; j++)
         {
-            vpPoint p1Clipped = polyClippedTemp[j].first;
-            vpPoint p2Clipped = polyClippedTemp[(j+1)%polyClippedTemp.size()].first;
+            double v1[6], v2[6];
+            getVertex(clippedPoints, j, v1);
+            getVertex(clippedPoints, (j+1)%n, v2);
 
-            unsigned int p2ClippedInfoBefore = polyClippedTemp[(j+1)%polyClippedTemp.size()].second;
-            unsigned int p1ClippedInfo = polyClippedTemp[j].second;
-            unsigned int p2ClippedInfo = polyClippedTemp[(j+1)%polyClippedTemp.size()].second;
+            unsigned int p2ClippedInfoBefore = clippedFlags[(j+1)%n];
+            unsigned int p1ClippedInfo = clippedFlags[j];
+            unsigned int p2ClippedInfo = clippedFlags[(j+1)%n];
 
             bool problem = true;
 
             switch(i){
             case 1:
-              problem = !(vpPolygon3D::getClippedPointsDistance(p1Clipped, p2Clipped, p1Clipped, p2Clipped, p1ClippedInfo, p2ClippedInfo,
-                                                                 i, distNearClip));
+              problem = !clipEdgeDistance(v1, v2, p1ClippedInfo, p2ClippedInfo, i, distNearClip);
               break;
             case 2:
-              problem = !(vpPolygon3D::getClippedPointsDistance(p1Clipped, p2Clipped, p1Clipped, p2Clipped, p1ClippedInfo, p2ClippedInfo,
-                                                                 i, distFarClip));
+              problem = !clipEdgeDistance(v1, v2, p1ClippedInfo, p2ClippedInfo, i, distFarClip);
               break;
             case 4:
-              problem = !(vpPolygon3D::getClippedPointsFovGeneric(p1Clipped, p2Clipped, p1Clipped, p2Clipped, p1ClippedInfo, p2ClippedInfo,
-                                                          fovNormals[0], vpPolygon3D::LEFT_CLIPPING));
+              problem = !clipEdgeFov(v1, v2, p1ClippedInfo, p2ClippedInfo, fovNormals[0], vpPolygon3D::LEFT_CLIPPING, clippingFlag);
               break;
             case 8:
-              problem = !(vpPolygon3D::getClippedPointsFovGeneric(p1Clipped, p2Clipped, p1Clipped, p2Clipped, p1ClippedInfo, p2ClippedInfo,
-                                                          fovNormals[1], vpPolygon3D::RIGHT_CLIPPING));
+              problem = !clipEdgeFov(v1, v2, p1ClippedInfo, p2ClippedInfo, fovNormals[1], vpPolygon3D::RIGHT_CLIPPING, clippingFlag);
               break;
             case 16:
-              problem = !(vpPolygon3D::getClippedPointsFovGeneric(p1Clipped, p2Clipped, p1Clipped, p2Clipped, p1ClippedInfo, p2ClippedInfo,
-                                                          fovNormals[2], vpPolygon3D::UP_CLIPPING));
+              problem = !clipEdgeFov(v1, v2, p1ClippedInfo, p2ClippedInfo, fovNormals[2], vpPolygon3D::UP_CLIPPING, clippingFlag);
               break;
             case 32:
-              problem = !(vpPolygon3D::getClippedPointsFovGeneric(p1Clipped, p2Clipped, p1Clipped, p2Clipped, p1ClippedInfo, p2ClippedInfo,
-                                                          fovNormals[3], vpPolygon3D::DOWN_CLIPPING));
+              problem = !clipEdgeFov(v1, v2, p1ClippedInfo, p2ClippedInfo, fovNormals[3], vpPolygon3D::DOWN_CLIPPING, clippingFlag);
               break;
             }
 
             if(!problem)
             {
-              p1Clipped.projection();
-              polyClippedTemp2.push_back(std::make_pair(p1Clipped, p1ClippedInfo));
+              addVertex(clippedPointsTmp, v1);
+              clippedFlagsTmp.push_back(p1ClippedInfo);
 
               if(p2ClippedInfo != p2ClippedInfoBefore)
               {
-                p2Clipped.projection();
-                polyClippedTemp2.push_back(std::make_pair(p2Clipped, p2ClippedInfo));
+                addVertex(clippedPointsTmp, v2);
+                clippedFlagsTmp.push_back(p2ClippedInfo);
               }
 
               if(nbpt == 2){
                 if(p2ClippedInfo == p2ClippedInfoBefore)
                 {
-                  p2Clipped.projection();
-                  polyClippedTemp2.push_back(std::make_pair(p2Clipped, p2ClippedInfo));
+                  addVertex(clippedPointsTmp, v2);
+                  clippedFlagsTmp.push_back(p2ClippedInfo);
                 }
                 break;
               }
             }
         }
 
-        polyClippedTemp = polyClippedTemp2;
-        polyClippedTemp2.clear();
+        clippedPoints.swap(clippedPointsTmp);
+        std::swap(clippedFlags, clippedFlagsTmp);
       }
     }
   }
 
-  polyClipped = polyClippedTemp;
-}
-    
-/*!
-  Get the clipped points according to a plane equation.
-
-  \param cam : camera parameters
-  \param p1 : First extremity of the line.
-  \param p2 : Second extremity of the line.
-  \param p1Clipped : Resulting p1.
-  \param p2Clipped : Resulting p2.
-  \param p1ClippedInfo : Resulting clipping flag for p1.
-  \param p2ClippedInfo : Resulting clipping flag for p2.
-  \param A : Param A from plane equation.
-  \param B : Param B from plane equation.
-  \param C : Param C from plane equation.
-  \param D : Param D from plane equation.
-  \param flag : flag specifying the clipping used when calling this function.
-  
-  \return True if the points have been clipped, False otherwise
-*/
-bool
-vpPolygon3D::getClippedPointsFovGeneric(const vpPoint &p1, const vpPoint &p2,
-                                vpPoint &p1Clipped, vpPoint &p2Clipped, 
-                                unsigned int &p1ClippedInfo, unsigned int &p2ClippedInfo,
-                                const vpColVector &normal, const unsigned int &flag)
-{    
-  vpRowVector p1Vec(3);
-  p1Vec[0] = p1.get_X(); p1Vec[1] = p1.get_Y(); p1Vec[2] = p1.get_Z();
-  p1Vec.normalize();
-  
-  vpRowVector p2Vec(3);
-  p2Vec[0] = p2.get_X(); p2Vec[1] = p2.get_Y(); p2Vec[2] = p2.get_Z();
-  p2Vec.normalize();
-  
-  if((clippingFlag & flag) == flag){
-    double beta1 = acos( p1Vec * normal );
-    double beta2 = acos( p2Vec * normal );
-
-//    std::cout << beta1 << " && " << beta2 << std::endl;
+  clippedPoints.projection();
 
-    //    if(!(beta1 < M_PI / 2.0 && beta2 < M_PI / 2.0))
-    if(beta1 < M_PI / 2.0 && beta2 < M_PI / 2.0)
-      return false;
-    else if (beta1 < M_PI / 2.0 || beta2 < M_PI / 2.0){
-      vpPoint pClipped;
-      double t = -(normal[0] * p1.get_X() + normal[1] * p1.get_Y() + normal[2] * p1.get_Z());
-      t = t / ( normal[0] * (p2.get_X() - p1.get_X()) + normal[1] * (p2.get_Y() - p1.get_Y()) + normal[2] * (p2.get_Z() - p1.get_Z()) );
-      
-      pClipped.set_X((p2.get_X() - p1.get_X())*t + p1.get_X());
-      pClipped.set_Y((p2.get_Y() - p1.get_Y())*t + p1.get_Y());
-      pClipped.set_Z((p2.get_Z() - p1.get_Z())*t + p1.get_Z());
-      
-      if(beta1 < M_PI / 2.0){
-        p1ClippedInfo = p1ClippedInfo | flag;
-        p1Clipped = pClipped;
-      }
-      else{
-        p2ClippedInfo = p2ClippedInfo | flag;
-        p2Clipped = pClipped;
-      }
-    }
+  // Update the clipped polygon as vpPoint, reusing the already allocated points
+  polyClipped.resize(clippedPoints.size());
+  for (unsigned int i = 0; i < clippedPoints.size(); i++) {
+    clippedPoints.getPoint(i, polyClipped[i].first);
+    polyClipped[i].second = clippedFlags[i];
   }
-  
-  return true;
-}
-
-bool
-vpPolygon3D::getClippedPointsDistance(const vpPoint &p1, const vpPoint &p2,
-                               vpPoint &p1Clipped, vpPoint &p2Clipped,
-                               unsigned int &p1ClippedInfo, unsigned int &p2ClippedInfo,
-                               const unsigned int &flag, const double &distance)
-{
-    // Since p1 and p1Clipped can be the same object as well as p2 and p2Clipped
-    // to avoid a valgrind "Source and destination overlap in memcpy" error,
-    // we introduce a two temporary points.
-    vpPoint p1Clipped_, p2Clipped_;
-    p1Clipped_ = p1;
-    p2Clipped_ = p2;
-
-    p1Clipped = p1Clipped_;
-    p2Clipped = p2Clipped_;
-
-
-    bool test1 = (p1Clipped.get_Z() < distance && p2Clipped.get_Z() < distance);
-    if(flag == vpPolygon3D::FAR_CLIPPING)
-        test1 = (p1Clipped.get_Z() > distance && p2Clipped.get_Z() > distance);
-
-    bool test2 = (p1Clipped.get_Z() < distance || p2Clipped.get_Z() < distance);
-    if(flag == vpPolygon3D::FAR_CLIPPING)
-        test2 = (p1Clipped.get_Z() > distance || p2Clipped.get_Z() > distance);
-
-    bool test3 = (p1Clipped.get_Z() < distance);
-    if(flag == vpPolygon3D::FAR_CLIPPING)
-        test3 = (p1Clipped.get_Z() > distance);
-
-    if(test1)
-      return false;
-
-    else if(test2){
-      vpPoint pClippedNear;
-      double t;
-      t = (p2Clipped.get_Z() - p1Clipped.get_Z());
-      t = (distance - p1Clipped.get_Z()) / t;
-
-      pClippedNear.set_X((p2Clipped.get_X() - p1Clipped.get_X())*t + p1Clipped.get_X());
-      pClippedNear.set_Y((p2Clipped.get_Y() - p1Clipped.get_Y())*t + p1Clipped.get_Y());
-      pClippedNear.set_Z(distance);
-
-      if(test3){
-        p1Clipped = pClippedNear;
-        if(flag == vpPolygon3D::FAR_CLIPPING)
-            p1ClippedInfo = p1ClippedInfo | vpPolygon3D::FAR_CLIPPING;
-        else
-            p1ClippedInfo = p1ClippedInfo | vpPolygon3D::NEAR_CLIPPING;
-      }
-      else{
-        p2Clipped = pClippedNear;
-        if(flag == vpPolygon3D::FAR_CLIPPING)
-            p2ClippedInfo = p2ClippedInfo | vpPolygon3D::FAR_CLIPPING;
-        else
-            p2ClippedInfo = p2ClippedInfo | vpPolygon3D::NEAR_CLIPPING;
-      }
-    }
-
-    return true;
 }
 
 /*!
@@ -446,6 +440,24 @@ vpPolygon3D::getPolygonClipped(std::vector<std::pair<vpPoint,unsigned int> > &po
   poly = polyClipped;
 }
 
+/*!
+  Get the 3D clipped points and their clipping information as a structure of
+  arrays. Contrary to the other getPolygonClipped() functions, no vpPoint is
+  copied.
+
+  \warning Suppose that changeFrame() and computePolygonClipped() have already been called.
+
+  \param points : resulting points, with their coordinates in the object
+  frame, in the camera frame and in the image plane.
+  \param flags : clipping information of each point.
+*/
+void
+vpPolygon3D::getPolygonClipped(vpPointSet &points, std::vector<unsigned int> &flags) const
+{
+  points = clippedPoints;
+  flags = clippedFlags;
+}
+
 /*!
   Get the 3D clipped points.
 
@@ -38,11 +38,207 @@
 
 #include <visp3/core/vpNetwork.h>
 
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#  include <errno.h>
+#  include <limits.h>
+#  include <sys/uio.h>
+#endif
+
+#if defined(__linux__)
+#  include <sys/epoll.h>
+#endif
+
+#if defined(VISP_HAVE_ZLIB)
+#  include <zlib.h>
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace {
+  // A binary frame starts with 6 unsigned int in network byte order: magic number, flags, size of the request id,
+  // number of parameters, size of the payload and raw size of the parameters. Then come the request id, the size of
+  // each parameter and the payload, that is the concatenation of the parameters, possibly compressed.
+  const unsigned int vpFrameMagic = 0x56505246;
+  const unsigned int vpFrameHeaderSize = 6*sizeof(unsigned int);
+  const unsigned int vpFrameCompressed = 1;
+  // Upper bound of the id size and of the number of parameters, used to detect corrupted frames
+  const unsigned int vpFrameMaxTableSize = 1 << 20;
+  const unsigned int vpEpollEmitter = 0xFFFFFFFF;
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  typedef int vpSocket;
+#  if defined(IOV_MAX)
+  const size_t vpMaxIov = IOV_MAX;
+#  else
+  const size_t vpMaxIov = 16;
+#  endif
+#else
+  typedef SOCKET vpSocket;
+#endif
+
+  int sendFlags()
+  {
+#if defined(__linux__)
+    return MSG_NOSIGNAL; // Only for Linux
+#else
+    return 0;
+#endif
+  }
+
+  // Receive exactly size bytes. Return size, or the value returned by recv() if an error or a disconnection occured.
+  int recvAll(vpSocket fd, char *buffer, const unsigned int size)
+  {
+    unsigned int received = 0;
+    while(received < size){
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+      ssize_t n = recv(fd, buffer + received, size - received, 0);
+      if(n < 0 && errno == EINTR)
+        continue;
+#else
+      int n = recv(fd, buffer + received, (int)(size - received), 0);
+#endif
+      if(n <= 0)
+        return (int)n;
+      received += (unsigned int)n;
+    }
+    return (int)size;
+  }
+
+  // Receive and drop size bytes.
+  int discardAll(vpSocket fd, std::vector<char> &buffer, const unsigned int size)
+  {
+    buffer.resize(size < 65536 ? (size > 0 ? size : 1) : 65536);
+    unsigned int received = 0;
+    while(received < size){
+      unsigned int chunk = (size - received) < (unsigned int)buffer.size() ? (size - received) : (unsigned int)buffer.size();
+      int n = recvAll(fd, &buffer[0], chunk);
+      if(n <= 0)
+        return n;
+      received += chunk;
+    }
+    return (int)size;
+  }
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  // Send all the buffers with scatter/gather calls, resuming after partial writes.
+  bool sendAllv(vpSocket fd, std::vector<struct iovec> &iov)
+  {
+    size_t first = 0;
+    while(first < iov.size()){
+      struct msghdr msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = &iov[first];
+      msg.msg_iovlen = (iov.size() - first) < vpMaxIov ? (iov.size() - first) : vpMaxIov;
+      ssize_t n = sendmsg(fd, &msg, sendFlags());
+      if(n < 0 && errno == EINTR)
+        continue;
+      if(n <= 0)
+        return false;
+
+      size_t done = (size_t)n;
+      while(first < iov.size() && done >= iov[first].iov_len){
+        done -= iov[first].iov_len;
+        first++;
+      }
+      if(first < iov.size()){
+        iov[first].iov_base = (char *)iov[first].iov_base + done;
+        iov[first].iov_len -= done;
+      }
+    }
+    return true;
+  }
+
+  // Fill all the buffers with readv(), resuming after partial reads. Return the value returned by readv() if an
+  // error or a disconnection occured, 1 otherwise.
+  int recvAllv(vpSocket fd, std::vector<struct iovec> &iov)
+  {
+    size_t first = 0;
+    while(first < iov.size()){
+      int cnt = (int)((iov.size() - first) < vpMaxIov ? (iov.size() - first) : vpMaxIov);
+      ssize_t n = readv(fd, &iov[first], cnt);
+      if(n < 0 && errno == EINTR)
+        continue;
+      if(n <= 0)
+        return (int)n;
+
+      size_t done = (size_t)n;
+      while(first < iov.size() && done >= iov[first].iov_len){
+        done -= iov[first].iov_len;
+        first++;
+      }
+      if(first < iov.size()){
+        iov[first].iov_base = (char *)iov[first].iov_base + done;
+        iov[first].iov_len -= done;
+      }
+    }
+    return 1;
+  }
+#endif
+
+#if defined(VISP_HAVE_ZLIB)
+  // Compress the parameters of a request in a single zlib stream, without concatenating them.
+  // Return false if the compressed payload is not smaller than the raw one.
+  bool compressParameters(const vpRequest &req, const int level, const unsigned int rawSize,
+                          std::vector<char> &buffer, unsigned int &compressedSize)
+  {
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    if(deflateInit(&strm, level) != Z_OK)
+      return false;
+
+    buffer.resize(deflateBound(&strm, rawSize) + 64);
+    strm.next_out = (Bytef *)&buffer[0];
+    strm.avail_out = (uInt)buffer.size();
+
+    bool ok = true;
+    for(unsigned int i = 0 ; i < req.size() && ok ; i++){
+      strm.next_in = (Bytef *)const_cast<char *>(req.getParameterData(i));
+      strm.avail_in = (uInt)req.getParameterSize(i);
+      while(strm.avail_in > 0 && ok)
+        ok = (deflate(&strm, Z_NO_FLUSH) == Z_OK) && strm.avail_out > 0;
+    }
+    ok = ok && (deflate(&strm, Z_FINISH) == Z_STREAM_END);
+    compressedSize = (unsigned int)strm.total_out;
+    deflateEnd(&strm);
+
+    return ok && compressedSize < rawSize;
+  }
+
+  // Uncompress a zlib stream directly in the parameters, that are already resized.
+  bool uncompressParameters(const char *buffer, const unsigned int size, std::vector<std::string> &params)
+  {
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    if(inflateInit(&strm) != Z_OK)
+      return false;
+
+    strm.next_in = (Bytef *)const_cast<char *>(buffer);
+    strm.avail_in = (uInt)size;
+
+    bool ok = true;
+    for(size_t i = 0 ; i < params.size() && ok ; i++){
+      if(params[i].empty())
+        continue;
+      strm.next_out = (Bytef *)&params[i][0];
+      strm.avail_out = (uInt)params[i].size();
+      while(strm.avail_out > 0 && ok){
+        int ret = inflate(&strm, Z_NO_FLUSH);
+        ok = (ret == Z_OK) || (ret == Z_STREAM_END && strm.avail_out == 0);
+      }
+    }
+    inflateEnd(&strm);
+
+    return ok;
+  }
+#endif
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 vpNetwork::vpNetwork()
   : emitter(), receptor_list(), readFileDescriptor(), socketMax(0), request_list(),
-    max_size_message(999999), separator("[*@*]"), beginning("[*start*]"), end("[*end*]"),
-    param_sep("[*|*]"), currentMessageReceived(), tv(), tv_sec(0), tv_usec(10),
-    verboseMode(false)
+    max_size_message(999999), max_size_frame(1 << 28), separator("[*@*]"), beginning("[*start*]"), end("[*end*]"),
+    param_sep("[*|*]"), currentMessageReceived(), protocol(TEXT_PROTOCOL), compressionLevel(0),
+    receivedRequests(), receiveBuffer(), frameHeader(), compressionBuffer(), epollFileDescriptor(-1),
+    epollReceptors(), epollEmitter(false), tv(), tv_sec(0), tv_usec(10), verboseMode(false)
 { 
   tv.tv_sec = tv_sec;
 #if TARGET_OS_IPHONE
@@ -62,6 +258,10 @@ vpNetwork::vpNetwork()
 
 vpNetwork::~vpNetwork()
 {
+#if defined(__linux__)
+  if(epollFileDescriptor >= 0)
+    close(epollFileDescriptor);
+#endif
 #if defined(_WIN32)
   WSACleanup();
 #endif
@@ -113,6 +313,28 @@ void vpNetwork::removeDecodingRequest(const char *id)
   }
 }
 
+/*!
+  Set the zlib compression level of the frames sent with the
+  vpNetwork::BINARY_PROTOCOL. A frame is sent compressed only if it is
+  smaller than the raw frame. The receiver detects compressed frames from
+  their header.
+
+  \warning Without zlib, the frames are never compressed.
+
+  \sa vpNetwork::getCompressionLevel()
+
+  \param level : 0 to disable the compression (default), from 1 (fastest) to 9 (best compression).
+*/
+void vpNetwork::setCompressionLevel(const int &level)
+{
+  if(level < 0)
+    compressionLevel = 0;
+  else if(level > 9)
+    compressionLevel = 9;
+  else
+    compressionLevel = level;
+}
+
 /*!
   Print the receptors. 
   
@@ -200,23 +422,29 @@ int vpNetwork::sendRequestTo(vpRequest &req, const unsigned int &dest)
     return 0;
   }
   
-  std::string message = beginning + req.getId() + separator;
+  if(protocol == BINARY_PROTOCOL)
+    return _sendBinaryRequestTo(req, dest);
+
+  size_t messageSize = beginning.size() + req.getId().size() + separator.size() + end.size();
+  for(unsigned int i = 0 ; i < req.size() ; i++)
+    messageSize += param_sep.size() + req.getParameterSize(i);
+
+  std::string message;
+  message.reserve(messageSize);
+  message += beginning + req.getId() + separator;
   
   if(req.size() != 0){
-    message += req[0];
+    message.append(req.getParameterData(0), req.getParameterSize(0));
     
     for(unsigned int i = 1 ; i < req.size() ; i++){
-        message += param_sep + req[i];
+        message += param_sep;
+        message.append(req.getParameterData(i), req.getParameterSize(i));
     }
   }
   
   message += end;
   
-  int flags = 0;
-//#if ! defined(APPLE) && ! defined(SOLARIS) && ! defined(_WIN32)
-#if defined(__linux__)
-  flags = MSG_NOSIGNAL; // Only for Linux
-#endif
+  int flags = sendFlags();
 
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
   int value = (int)sendto(receptor_list[dest].socketFileDescriptorReceptor, message.c_str(), message.size(), flags,
@@ -511,6 +739,15 @@ std::vector<int> vpNetwork::_handleRequests()
 */
 int vpNetwork::_handleFirstRequest()
 {
+  if(protocol == BINARY_PROTOCOL){
+    // Binary frames are already decoded in the parameters of the request when they are received
+    if(receivedRequests.empty())
+      return -1;
+    int indRequest = receivedRequests.front();
+    receivedRequests.erase(receivedRequests.begin());
+    return indRequest;
+  }
+
   size_t indStart = currentMessageReceived.find(beginning);
   size_t indSep = currentMessageReceived.find(separator);
   size_t indEnd = currentMessageReceived.find(end);
@@ -577,7 +814,7 @@ int vpNetwork::_handleFirstRequest()
   size_t indEndParam = currentMessageReceived.find(param_sep,indDebParam);
   
   std::string param;
-  while(indEndParam != std::string::npos || indEndParam < indEnd)
+  while(indEndParam != std::string::npos && indEndParam < indEnd)
   {
     param = currentMessageReceived.substr((unsigned)indDebParam,(unsigned)(indEndParam - indDebParam));
     request_list[(unsigned)indRequest]->addParameter(param);
@@ -659,63 +896,24 @@ int vpNetwork::_receiveRequestOnce()
     return -1;
   }
   
-  tv.tv_sec = tv_sec;
-#if TARGET_OS_IPHONE
-  tv.tv_usec = (int)tv_usec;
-#else
-  tv.tv_usec = tv_usec;
-#endif
-
-  FD_ZERO(&readFileDescriptor);        
-  
-  for(unsigned int i=0; i<receptor_list.size(); i++){ 
-    if(i == 0)
-      socketMax = receptor_list[i].socketFileDescriptorReceptor;
-    
-    FD_SET((unsigned)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor); 
-    if(socketMax < receptor_list[i].socketFileDescriptorReceptor) socketMax = receptor_list[i].socketFileDescriptorReceptor; 
-  }
-
-  int value = select((int)socketMax+1,&readFileDescriptor,NULL,NULL,&tv);
-  int numbytes = 0;
+  bool emitterReady = false;
+  std::vector<unsigned int> readyReceptors;
+  int value = _waitForReadableSockets(false, emitterReady, readyReceptors);
   
   if(value == -1){
     if(verboseMode)
       vpERROR_TRACE( "Select error" );
     return -1;
   }
-  else if(value == 0){
+  else if(value == 0 || readyReceptors.empty()){
     //Timeout
     return 0;
   }
-  else{
-    for(unsigned int i=0; i<receptor_list.size(); i++){
-      if(FD_ISSET((unsigned int)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor)){
-        char *buf = new char [max_size_message];
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-        numbytes=(int)recv(receptor_list[i].socketFileDescriptorReceptor, buf, max_size_message, 0);
-#else
-        numbytes=recv((unsigned int)receptor_list[i].socketFileDescriptorReceptor, buf, (int)max_size_message, 0);
-#endif
-          
-        if(numbytes <= 0)
-        {
-          std::cout << "Disconnected : " << inet_ntoa(receptor_list[i].receptorAddress.sin_addr) << std::endl;
-          receptor_list.erase(receptor_list.begin()+(int)i);
-          delete [] buf;
-          return numbytes;
-        }
-        else if(numbytes > 0){
-          std::string returnVal(buf, (unsigned int)numbytes);
-          currentMessageReceived.append(returnVal);
-        }
-        delete [] buf;
-        break;
-      }
-    }
-  }
-  
-  return numbytes;
+
+  if(protocol == BINARY_PROTOCOL)
+    return _receiveBinaryRequestFrom(readyReceptors[0]);
+
+  return _receiveTextRequestFrom(readyReceptors[0]);
 }
 
 /*!
@@ -774,28 +972,400 @@ int vpNetwork::_receiveRequestOnceFrom(const unsigned int &receptorEmitting)
   }
   else{
     if(FD_ISSET((unsigned int)receptor_list[receptorEmitting].socketFileDescriptorReceptor,&readFileDescriptor)){
-      char *buf = new char [max_size_message];
+      if(protocol == BINARY_PROTOCOL)
+        numbytes = _receiveBinaryRequestFrom(receptorEmitting);
+      else
+        numbytes = _receiveTextRequestFrom(receptorEmitting);
+    }
+  }
+  
+  return numbytes;
+}
+
+/*!
+  Receives a message (in the limit of the Maximum message size value) from a receptor
+  which socket is readable, and append it to the current message.
+
+  \param receptorEmitting : Index of the receptor emitting the message.
+
+  \return The number of bytes received, -1 if an error occured.
+*/
+int vpNetwork::_receiveTextRequestFrom(const unsigned int &receptorEmitting)
+{
+  if(receiveBuffer.size() < max_size_message)
+    receiveBuffer.resize(max_size_message);
+
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-      numbytes=(int)recv(receptor_list[receptorEmitting].socketFileDescriptorReceptor, buf, max_size_message, 0);
+  int numbytes=(int)recv(receptor_list[receptorEmitting].socketFileDescriptorReceptor, &receiveBuffer[0], max_size_message, 0);
 #else
-      numbytes=recv((unsigned int)receptor_list[receptorEmitting].socketFileDescriptorReceptor, buf, (int)max_size_message, 0);
+  int numbytes=recv((unsigned int)receptor_list[receptorEmitting].socketFileDescriptorReceptor, &receiveBuffer[0], (int)max_size_message, 0);
 #endif
-      if(numbytes <= 0)
-      {
-        std::cout << "Disconnected : " << inet_ntoa(receptor_list[receptorEmitting].receptorAddress.sin_addr) << std::endl;
-        receptor_list.erase(receptor_list.begin()+(int)receptorEmitting);
-        delete [] buf;
-        return numbytes;
+  if(numbytes <= 0)
+  {
+    std::cout << "Disconnected : " << inet_ntoa(receptor_list[receptorEmitting].receptorAddress.sin_addr) << std::endl;
+    receptor_list.erase(receptor_list.begin()+(int)receptorEmitting);
+    return numbytes;
+  }
+
+  currentMessageReceived.append(&receiveBuffer[0], (unsigned int)numbytes);
+
+  return numbytes;
+}
+
+/*!
+  Receives an entire binary frame from a receptor which socket is readable.
+  The parameters are read directly in the decoding request corresponding to the
+  id of the frame, that is then queued to be handled.
+
+  \param receptorEmitting : Index of the receptor emitting the frame.
+
+  \return The number of bytes received, -1 if an error occured.
+*/
+int vpNetwork::_receiveBinaryRequestFrom(const unsigned int &receptorEmitting)
+{
+  vpSocket fd = receptor_list[receptorEmitting].socketFileDescriptorReceptor;
+
+  // Header
+  unsigned int header[6] = {0, 0, 0, 0, 0, 0};
+  int numbytes = recvAll(fd, (char *)(void *)header, vpFrameHeaderSize);
+  bool connected = (numbytes == (int)vpFrameHeaderSize);
+  bool valid = connected;
+  if(connected){
+    for(unsigned int k = 0 ; k < 6 ; k++)
+      header[k] = ntohl(header[k]);
+    // Sizes above the limits are considered as a corrupted or hostile stream: nothing is allocated and the
+    // connection is dropped
+    valid = (header[0] == vpFrameMagic && header[2] <= vpFrameMaxTableSize && header[3] <= vpFrameMaxTableSize
+             && header[4] <= max_size_frame && header[5] <= max_size_frame);
+  }
+
+  const unsigned int flags = header[1];
+  const unsigned int idSize = header[2];
+  const unsigned int nbParams = header[3];
+  const unsigned int payloadSize = header[4];
+  const unsigned int rawSize = header[5];
+  const unsigned int tableSize = idSize + nbParams*(unsigned int)sizeof(unsigned int);
+
+  // Request id and size of the parameters
+  int indRequest = -1;
+  if(valid){
+    receiveBuffer.resize(tableSize + 1);
+    numbytes = recvAll(fd, &receiveBuffer[0], tableSize);
+    connected = valid = (numbytes == (int)tableSize);
+  }
+  if(valid){
+    std::string id(&receiveBuffer[0], idSize);
+    for(unsigned int i = 0 ; i < request_list.size() ; i++){
+      if(id == request_list[i]->getId()){
+        indRequest = (int)i;
+        break;
+      }
+    }
+  }
+
+  // Payload
+  if(valid && indRequest == -1){
+    if(verboseMode)
+      vpTRACE("No request corresponds to the received message");
+    numbytes = discardAll(fd, receiveBuffer, payloadSize);
+    connected = valid = (numbytes == (int)payloadSize);
+    indRequest = -1;
+  }
+  else if(valid){
+    vpRequest *req = request_list[(unsigned int)indRequest];
+    req->clear();
+    req->listOfParams.resize(nbParams);
+    // The parameters can't be larger than the raw size, already checked against the frame size limit
+    unsigned int sum = 0;
+    bool sizesValid = true;
+    for(unsigned int i = 0 ; i < nbParams && sizesValid ; i++){
+      unsigned int size;
+      memcpy(&size, &receiveBuffer[idSize + i*sizeof(unsigned int)], sizeof(unsigned int));
+      size = ntohl(size);
+      sizesValid = (size <= rawSize - sum);
+      if(sizesValid){
+        sum += size;
+        req->listOfParams[i].resize(size);
       }
-      else if(numbytes > 0){
-        std::string returnVal(buf, (unsigned int)numbytes);
-        currentMessageReceived.append(returnVal);
+    }
+    valid = sizesValid && (sum == rawSize) && ((flags & vpFrameCompressed) || payloadSize == rawSize);
+
+    if(valid && (flags & vpFrameCompressed)){
+#if defined(VISP_HAVE_ZLIB)
+      compressionBuffer.resize(payloadSize + 1);
+      numbytes = recvAll(fd, &compressionBuffer[0], payloadSize);
+      connected = valid = (numbytes == (int)payloadSize);
+      if(valid && !uncompressParameters(&compressionBuffer[0], payloadSize, req->listOfParams)){
+        // The frame was entirely read, the stream is still synchronized
+        if(verboseMode)
+          vpTRACE("Cannot uncompress the received message");
+        indRequest = -1;
       }
-      delete [] buf;
+#else
+      vpTRACE("Compressed message received but zlib is not available");
+      numbytes = discardAll(fd, receiveBuffer, payloadSize);
+      connected = valid = (numbytes == (int)payloadSize);
+      indRequest = -1;
+#endif
     }
+    else if(valid){
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+      std::vector<struct iovec> iov;
+      iov.reserve(nbParams);
+      for(unsigned int i = 0 ; i < nbParams ; i++){
+        if(!req->listOfParams[i].empty()){
+          struct iovec v;
+          v.iov_base = &req->listOfParams[i][0];
+          v.iov_len = req->listOfParams[i].size();
+          iov.push_back(v);
+        }
+      }
+      numbytes = recvAllv(fd, iov);
+      connected = valid = (numbytes > 0);
+#else
+      for(unsigned int i = 0 ; i < nbParams && valid ; i++){
+        unsigned int size = (unsigned int)req->listOfParams[i].size();
+        if(size > 0){
+          numbytes = recvAll(fd, &req->listOfParams[i][0], size);
+          connected = valid = (numbytes == (int)size);
+        }
+      }
+#endif
+    }
+
+    if(!valid || indRequest == -1)
+      req->clear();
   }
-  
-  return numbytes;
+
+  if(!valid){
+    // Disconnection, or corrupted stream that can't be synchronized anymore
+    if(connected && verboseMode)
+      vpTRACE("Incorrect message");
+    std::cout << "Disconnected : " << inet_ntoa(receptor_list[receptorEmitting].receptorAddress.sin_addr) << std::endl;
+    receptor_list.erase(receptor_list.begin()+(int)receptorEmitting);
+    return (!connected && numbytes <= 0) ? numbytes : -1;
+  }
+
+  if(indRequest != -1)
+    receivedRequests.push_back(indRequest);
+
+  return (int)(vpFrameHeaderSize + tableSize + payloadSize);
+}
+
+/*!
+  Send a request to a specific receptor as a binary frame. The header and the
+  parameters are sent with a single scatter/gather call, without copying the
+  parameters added with vpRequest::addParameterBuffer().
+
+  \param req : Request to send.
+  \param dest : Index of the receptor receiving the request.
+
+  \return The number of bytes that have been sent, -1 if an error occured.
+*/
+int vpNetwork::_sendBinaryRequestTo(vpRequest &req, const unsigned int &dest)
+{
+  const std::string id = req.getId();
+  const unsigned int nbParams = req.size();
+  const unsigned int idSize = (unsigned int)id.size();
+
+  frameHeader.resize(vpFrameHeaderSize + idSize + nbParams*sizeof(unsigned int));
+  if(idSize > 0)
+    memcpy(&frameHeader[vpFrameHeaderSize], id.c_str(), idSize);
+
+  unsigned int rawSize = 0;
+  for(unsigned int i = 0 ; i < nbParams ; i++){
+    unsigned int size = htonl(req.getParameterSize(i));
+    memcpy(&frameHeader[vpFrameHeaderSize + idSize + i*sizeof(unsigned int)], &size, sizeof(unsigned int));
+    rawSize += req.getParameterSize(i);
+  }
+
+  unsigned int flags = 0;
+  unsigned int payloadSize = rawSize;
+#if defined(VISP_HAVE_ZLIB)
+  if(compressionLevel > 0 && rawSize > 0){
+    unsigned int compressedSize = 0;
+    if(compressParameters(req, compressionLevel, rawSize, compressionBuffer, compressedSize)){
+      flags |= vpFrameCompressed;
+      payloadSize = compressedSize;
+    }
+  }
+#endif
+
+  unsigned int header[6];
+  header[0] = htonl(vpFrameMagic);
+  header[1] = htonl(flags);
+  header[2] = htonl(idSize);
+  header[3] = htonl(nbParams);
+  header[4] = htonl(payloadSize);
+  header[5] = htonl(rawSize);
+  memcpy(&frameHeader[0], header, vpFrameHeaderSize);
+
+  vpSocket fd = receptor_list[dest].socketFileDescriptorReceptor;
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  std::vector<struct iovec> iov;
+  iov.reserve(nbParams + 1);
+  struct iovec v;
+  v.iov_base = &frameHeader[0];
+  v.iov_len = frameHeader.size();
+  iov.push_back(v);
+  if(flags & vpFrameCompressed){
+    v.iov_base = &compressionBuffer[0];
+    v.iov_len = payloadSize;
+    iov.push_back(v);
+  }
+  else{
+    for(unsigned int i = 0 ; i < nbParams ; i++){
+      if(req.getParameterSize(i) > 0){
+        v.iov_base = const_cast<char *>(req.getParameterData(i));
+        v.iov_len = req.getParameterSize(i);
+        iov.push_back(v);
+      }
+    }
+  }
+
+  if(!sendAllv(fd, iov)){
+    if(verboseMode)
+      vpERROR_TRACE( "Cannot send the request" );
+    return -1;
+  }
+#else
+  // No scatter/gather call, the frame is built before being sent
+  std::string frame(frameHeader.begin(), frameHeader.end());
+  frame.reserve(frameHeader.size() + payloadSize);
+  if(flags & vpFrameCompressed)
+    frame.append(&compressionBuffer[0], payloadSize);
+  else
+    for(unsigned int i = 0 ; i < nbParams ; i++)
+      frame.append(req.getParameterData(i), req.getParameterSize(i));
+
+  size_t sent = 0;
+  while(sent < frame.size()){
+    int n = ::send(fd, frame.c_str() + sent, (int)(frame.size() - sent), sendFlags());
+    if(n <= 0){
+      if(verboseMode)
+        vpERROR_TRACE( "Cannot send the request" );
+      return -1;
+    }
+    sent += (size_t)n;
+  }
+#endif
+
+  return (int)(frameHeader.size() + payloadSize);
+}
+
+/*!
+  Wait, at most the time set with setTimeoutSec() and setTimeoutUSec(), until
+  data can be read from the receptors or, if \e withEmitter is true, until a
+  connection is pending on the emitter socket.
+
+  Under Linux, the sockets are monitored with epoll. The epoll set is only
+  updated when the list of receptors changes, so that the cost of a call
+  doesn't depend on the number of receptors. Otherwise select() is used.
+
+  \param withEmitter : If true, also monitor the emitter socket.
+  \param emitterReady : True if a connection is pending on the emitter socket.
+  \param readyReceptors : Indexes of the receptors that can be read.
+
+  \return -1 if an error occured, 0 on timeout, a positive value otherwise.
+*/
+int vpNetwork::_waitForReadableSockets(const bool &withEmitter, bool &emitterReady,
+                                       std::vector<unsigned int> &readyReceptors)
+{
+  emitterReady = false;
+  readyReceptors.clear();
+
+#if defined(__linux__)
+  if(epollFileDescriptor < 0)
+    epollFileDescriptor = epoll_create(1);
+
+  if(epollFileDescriptor >= 0){
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+
+    bool changed = (epollReceptors.size() != receptor_list.size());
+    for(unsigned int i = 0 ; i < receptor_list.size() && !changed ; i++){
+      changed = (epollReceptors[i].first != receptor_list[i].socketFileDescriptorReceptor)
+          || (epollReceptors[i].second != receptor_list[i].receptorAddress.sin_port);
+    }
+    if(changed){
+      // Indexes of the receptors are stored in the events, they all have to be updated
+      for(unsigned int i = 0 ; i < epollReceptors.size() ; i++)
+        epoll_ctl(epollFileDescriptor, EPOLL_CTL_DEL, epollReceptors[i].first, &ev);
+      epollReceptors.clear();
+      for(unsigned int i = 0 ; i < receptor_list.size() ; i++){
+        ev.data.u32 = i;
+        epoll_ctl(epollFileDescriptor, EPOLL_CTL_ADD, receptor_list[i].socketFileDescriptorReceptor, &ev);
+        epollReceptors.push_back(std::make_pair(receptor_list[i].socketFileDescriptorReceptor,
+                                                receptor_list[i].receptorAddress.sin_port));
+      }
+    }
+    // The emitter is only monitored while it is waited on, otherwise a pending connection would wake up every
+    // call until it is accepted
+    if(withEmitter && !epollEmitter){
+      ev.data.u32 = vpEpollEmitter;
+      epollEmitter = (epoll_ctl(epollFileDescriptor, EPOLL_CTL_ADD, emitter.socketFileDescriptorEmitter, &ev) == 0);
+    }
+    else if(!withEmitter && epollEmitter){
+      epoll_ctl(epollFileDescriptor, EPOLL_CTL_DEL, emitter.socketFileDescriptorEmitter, &ev);
+      epollEmitter = false;
+    }
+
+    // epoll only has a millisecond resolution: a non zero timeout is rounded up so that it doesn't become a busy
+    // poll
+    int timeout = (int)(tv_sec*1000 + (tv_usec + 999)/1000);
+
+    int maxEvents = (int)receptor_list.size() + 1;
+    std::vector<struct epoll_event> events((size_t)maxEvents);
+    int value = epoll_wait(epollFileDescriptor, &events[0], maxEvents, timeout);
+    if(value < 0)
+      return (errno == EINTR) ? 0 : -1;
+
+    for(int k = 0 ; k < value ; k++){
+      if(events[(size_t)k].data.u32 == vpEpollEmitter)
+        emitterReady = withEmitter;
+      else if(events[(size_t)k].data.u32 < receptor_list.size())
+        readyReceptors.push_back(events[(size_t)k].data.u32);
+    }
+
+    return (int)readyReceptors.size() + (emitterReady ? 1 : 0);
+  }
+#endif
+
+  tv.tv_sec = tv_sec;
+#if TARGET_OS_IPHONE
+  tv.tv_usec = (int)tv_usec;
+#else
+  tv.tv_usec = tv_usec;
+#endif
+
+  FD_ZERO(&readFileDescriptor);
+
+  socketMax = 0;
+  if(withEmitter){
+    socketMax = emitter.socketFileDescriptorEmitter;
+    FD_SET((unsigned)emitter.socketFileDescriptorEmitter,&readFileDescriptor);
+  }
+
+  for(unsigned int i=0; i<receptor_list.size(); i++){
+    FD_SET((unsigned)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor);
+    if(socketMax < receptor_list[i].socketFileDescriptorReceptor) socketMax = receptor_list[i].socketFileDescriptorReceptor;
+  }
+
+  int value = select((int)socketMax+1,&readFileDescriptor,NULL,NULL,&tv);
+  if(value <= 0)
+    return value;
+
+  if(withEmitter && FD_ISSET((unsigned int)emitter.socketFileDescriptorEmitter,&readFileDescriptor))
+    emitterReady = true;
+
+  for(unsigned int i=0; i<receptor_list.size(); i++){
+    if(FD_ISSET((unsigned int)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor))
+      readyReceptors.push_back(i);
+  }
+
+  return value;
 }
 
 
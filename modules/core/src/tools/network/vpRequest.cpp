@@ -38,7 +38,7 @@
 #include <visp3/core/vpRequest.h>
 
 vpRequest::vpRequest()
-  : request_id(""), listOfParams()
+  : request_id(""), listOfParams(), listOfBuffers(), listOfBuffersSize()
 {}
 
 vpRequest::~vpRequest()
@@ -80,5 +80,61 @@ void vpRequest::addParameter(std::string &params)
 void vpRequest::addParameter(std::vector< std::string > &listOfparams)
 {  
   for(unsigned int i = 0; i < listOfparams.size() ; i++)
-    listOfparams.push_back(listOfparams[i]);
+    listOfParams.push_back(listOfparams[i]);
+}
+
+/*!
+  Add a buffer as parameter of the request, without copying it.
+
+  \warning The buffer has to stay valid and unchanged until the request is
+  sent. It is not owned by the request.
+
+  With the vpNetwork::BINARY_PROTOCOL, the buffer is directly written to the
+  socket with a scatter/gather call. With the vpNetwork::TEXT_PROTOCOL, it is
+  copied in the message like the other parameters.
+
+  \sa vpRequest::addParameterObject()
+
+  \param buffer : Pointer to the data to add.
+  \param sizeOfBuffer : Size of the data in bytes.
+*/
+void vpRequest::addParameterBuffer(const void *buffer, const unsigned int &sizeOfBuffer)
+{
+  // Parameters added before with addParameter() are not buffers
+  listOfBuffers.resize(listOfParams.size(), NULL);
+  listOfBuffersSize.resize(listOfParams.size(), 0);
+
+  listOfParams.push_back(std::string());
+  listOfBuffers.push_back((const char *)buffer);
+  listOfBuffersSize.push_back(sizeOfBuffer);
+}
+
+/*!
+  Get a pointer on the data of a parameter, either added with addParameter(),
+  addParameterObject() or addParameterBuffer().
+
+  \param i : Index of the parameter.
+
+  \return Pointer on the first byte of the parameter.
+*/
+const char *vpRequest::getParameterData(const unsigned int &i) const
+{
+  if(i < listOfBuffers.size() && listOfBuffers[i] != NULL)
+    return listOfBuffers[i];
+  return listOfParams[i].data();
+}
+
+/*!
+  Get the size in bytes of a parameter, either added with addParameter(),
+  addParameterObject() or addParameterBuffer().
+
+  \param i : Index of the parameter.
+
+  \return Size of the parameter.
+*/
+unsigned int vpRequest::getParameterSize(const unsigned int &i) const
+{
+  if(i < listOfBuffers.size() && listOfBuffers[i] != NULL)
+    return listOfBuffersSize[i];
+  return (unsigned int)listOfParams[i].size();
 }
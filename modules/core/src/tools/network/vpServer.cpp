@@ -201,28 +201,9 @@ bool vpServer::checkForConnections()
       return false;
     }
   
-  tv.tv_sec = tv_sec;
-#if TARGET_OS_IPHONE
-  tv.tv_usec = (int)tv_usec;
-#else
-  tv.tv_usec = tv_usec;
-#endif
-
-  FD_ZERO(&readFileDescriptor);         
-  
-  socketMax = emitter.socketFileDescriptorEmitter;
-  FD_SET((unsigned)emitter.socketFileDescriptorEmitter,&readFileDescriptor);
-
-  for(unsigned int i=0; i<receptor_list.size(); i++){
-    FD_SET((unsigned)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor);
-
-    if(i == 0)
-      socketMax = receptor_list[i].socketFileDescriptorReceptor;
-   
-    if(socketMax < receptor_list[i].socketFileDescriptorReceptor) socketMax = receptor_list[i].socketFileDescriptorReceptor; 
-  }
-  
-  int value = select((int)socketMax+1,&readFileDescriptor,NULL,NULL,&tv);
+  bool emitterReady = false;
+  std::vector<unsigned int> readyReceptors;
+  int value = _waitForReadableSockets(true, emitterReady, readyReceptors);
   if(value == -1){
     //vpERROR_TRACE( "vpServer::run(), select()" );
     return false;
@@ -231,7 +212,7 @@ bool vpServer::checkForConnections()
     return false;
   }
   else{
-    if(FD_ISSET((unsigned int)emitter.socketFileDescriptorEmitter,&readFileDescriptor)){
+    if(emitterReady){
       vpNetwork::vpReceptor client;
       client.receptorAddressSize = sizeof(client.receptorAddress);
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
@@ -254,8 +235,9 @@ bool vpServer::checkForConnections()
       return true;
     }
     else{
-      for(unsigned int i=0; i<receptor_list.size(); i++){
-        if(FD_ISSET((unsigned int)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor)){
+      for(unsigned int k=0; k<readyReceptors.size(); k++){
+        unsigned int i = readyReceptors[k];
+        if(i < receptor_list.size()){
           char deco;
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
           ssize_t numbytes = recv(receptor_list[i].socketFileDescriptorReceptor, &deco, 1, MSG_PEEK);
@@ -0,0 +1,284 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Set of 3D points stored as a structure of arrays.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPointSet.cpp
+  \brief Set of 3D points stored as a structure of arrays.
+*/
+
+#include <visp3/core/vpPointSet.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
+/*!
+  Default constructor that builds an empty set.
+*/
+vpPointSet::vpPointSet()
+  : m_oX(), m_oY(), m_oZ(), m_X(), m_Y(), m_Z(), m_x(), m_y()
+{
+}
+
+/*!
+  Build a set from a vector of points. See buildFrom().
+*/
+vpPointSet::vpPointSet(const std::vector<vpPoint> &points)
+  : m_oX(), m_oY(), m_oZ(), m_X(), m_Y(), m_Z(), m_x(), m_y()
+{
+  buildFrom(points);
+}
+
+/*!
+  Build a set from a list of points. See buildFrom().
+*/
+vpPointSet::vpPointSet(const std::list<vpPoint> &points)
+  : m_oX(), m_oY(), m_oZ(), m_X(), m_Y(), m_Z(), m_x(), m_y()
+{
+  buildFrom(points);
+}
+
+/*!
+  Add a point given by its coordinates in the object frame. Its coordinates
+  in the camera frame and in the image plane are set to zero.
+*/
+void vpPointSet::addPoint(const double oX, const double oY, const double oZ)
+{
+  m_oX.push_back(oX);
+  m_oY.push_back(oY);
+  m_oZ.push_back(oZ);
+  m_X.push_back(0);
+  m_Y.push_back(0);
+  m_Z.push_back(0);
+  m_x.push_back(0);
+  m_y.push_back(0);
+}
+
+/*!
+  Add a point. Its coordinates in the object frame, in the camera frame and in
+  the image plane are copied. The homogeneous coordinates are normalized.
+*/
+void vpPointSet::addPoint(const vpPoint &P)
+{
+  m_oX.push_back(P.get_oX() / P.get_oW());
+  m_oY.push_back(P.get_oY() / P.get_oW());
+  m_oZ.push_back(P.get_oZ() / P.get_oW());
+  m_X.push_back(P.get_X() / P.get_W());
+  m_Y.push_back(P.get_Y() / P.get_W());
+  m_Z.push_back(P.get_Z() / P.get_W());
+  m_x.push_back(P.get_x());
+  m_y.push_back(P.get_y());
+}
+
+/*!
+  Initialize the set from a vector of points.
+*/
+void vpPointSet::buildFrom(const std::vector<vpPoint> &points)
+{
+  clear();
+  reserve((unsigned int) points.size());
+  for (std::vector<vpPoint>::const_iterator it = points.begin(); it != points.end(); ++it) {
+    addPoint(*it);
+  }
+}
+
+/*!
+  Initialize the set from a list of points.
+*/
+void vpPointSet::buildFrom(const std::list<vpPoint> &points)
+{
+  clear();
+  reserve((unsigned int) points.size());
+  for (std::list<vpPoint>::const_iterator it = points.begin(); it != points.end(); ++it) {
+    addPoint(*it);
+  }
+}
+
+/*!
+  Compute the coordinates of all the points in the camera frame from their
+  coordinates in the object frame.
+
+  \param cMo : Transformation from camera to object frame.
+*/
+void vpPointSet::changeFrame(const vpHomogeneousMatrix &cMo)
+{
+  const unsigned int n = size();
+  if (n == 0)
+    return;
+
+  const double *oX = &m_oX[0], *oY = &m_oY[0], *oZ = &m_oZ[0];
+  double *X = &m_X[0], *Y = &m_Y[0], *Z = &m_Z[0];
+  const double r00 = cMo[0][0], r01 = cMo[0][1], r02 = cMo[0][2], tx = cMo[0][3];
+  const double r10 = cMo[1][0], r11 = cMo[1][1], r12 = cMo[1][2], ty = cMo[1][3];
+  const double r20 = cMo[2][0], r21 = cMo[2][1], r22 = cMo[2][2], tz = cMo[2][3];
+
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  const __m128d v_r00 = _mm_set1_pd(r00), v_r01 = _mm_set1_pd(r01), v_r02 = _mm_set1_pd(r02), v_tx = _mm_set1_pd(tx);
+  const __m128d v_r10 = _mm_set1_pd(r10), v_r11 = _mm_set1_pd(r11), v_r12 = _mm_set1_pd(r12), v_ty = _mm_set1_pd(ty);
+  const __m128d v_r20 = _mm_set1_pd(r20), v_r21 = _mm_set1_pd(r21), v_r22 = _mm_set1_pd(r22), v_tz = _mm_set1_pd(tz);
+  for (; i + 2 <= n; i += 2) {
+    const __m128d v_oX = _mm_loadu_pd(oX + i);
+    const __m128d v_oY = _mm_loadu_pd(oY + i);
+    const __m128d v_oZ = _mm_loadu_pd(oZ + i);
+    _mm_storeu_pd(X + i, _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(v_r00, v_oX), _mm_mul_pd(v_r01, v_oY)),
+                                               _mm_mul_pd(v_r02, v_oZ)), v_tx));
+    _mm_storeu_pd(Y + i, _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(v_r10, v_oX), _mm_mul_pd(v_r11, v_oY)),
+                                               _mm_mul_pd(v_r12, v_oZ)), v_ty));
+    _mm_storeu_pd(Z + i, _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(v_r20, v_oX), _mm_mul_pd(v_r21, v_oY)),
+                                               _mm_mul_pd(v_r22, v_oZ)), v_tz));
+  }
+#endif
+  for (; i < n; i++) {
+    X[i] = r00*oX[i] + r01*oY[i] + r02*oZ[i] + tx;
+    Y[i] = r10*oX[i] + r11*oY[i] + r12*oZ[i] + ty;
+    Z[i] = r20*oX[i] + r21*oY[i] + r22*oZ[i] + tz;
+  }
+}
+
+/*!
+  Remove all the points.
+*/
+void vpPointSet::clear()
+{
+  m_oX.clear(); m_oY.clear(); m_oZ.clear();
+  m_X.clear(); m_Y.clear(); m_Z.clear();
+  m_x.clear(); m_y.clear();
+}
+
+/*!
+  Get a point of the set.
+
+  \param i : Index of the point.
+  \param P : Point with the coordinates in the object frame, in the camera
+  frame and in the image plane of the i-th point of the set.
+*/
+void vpPointSet::getPoint(const unsigned int i, vpPoint &P) const
+{
+  if (i >= size()) {
+    throw vpException(vpException::dimensionError, "Point index %d out of range (%d points)", i, size());
+  }
+  P.setWorldCoordinates(m_oX[i], m_oY[i], m_oZ[i]);
+  P.set_X(m_X[i]);
+  P.set_Y(m_Y[i]);
+  P.set_Z(m_Z[i]);
+  P.set_W(1);
+  P.set_x(m_x[i]);
+  P.set_y(m_y[i]);
+  P.set_w(1);
+}
+
+/*!
+  Convert the set into a vector of points.
+*/
+void vpPointSet::getPoints(std::vector<vpPoint> &points) const
+{
+  points.resize(size());
+  for (unsigned int i = 0; i < size(); i++) {
+    getPoint(i, points[i]);
+  }
+}
+
+/*!
+  Perspective projection of all the points: compute their normalized
+  coordinates \f$ x = X/Z \f$, \f$ y = Y/Z \f$ from their coordinates in the
+  camera frame.
+*/
+void vpPointSet::projection()
+{
+  const unsigned int n = size();
+  if (n == 0)
+    return;
+
+  const double *X = &m_X[0], *Y = &m_Y[0], *Z = &m_Z[0];
+  double *x = &m_x[0], *y = &m_y[0];
+
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  const __m128d v_one = _mm_set1_pd(1.0);
+  for (; i + 2 <= n; i += 2) {
+    const __m128d v_d = _mm_div_pd(v_one, _mm_loadu_pd(Z + i));
+    _mm_storeu_pd(x + i, _mm_mul_pd(_mm_loadu_pd(X + i), v_d));
+    _mm_storeu_pd(y + i, _mm_mul_pd(_mm_loadu_pd(Y + i), v_d));
+  }
+#endif
+  for (; i < n; i++) {
+    const double d = 1 / Z[i];
+    x[i] = X[i] * d;
+    y[i] = Y[i] * d;
+  }
+}
+
+/*!
+  Reserve memory for n points.
+*/
+void vpPointSet::reserve(const unsigned int n)
+{
+  m_oX.reserve(n); m_oY.reserve(n); m_oZ.reserve(n);
+  m_X.reserve(n); m_Y.reserve(n); m_Z.reserve(n);
+  m_x.reserve(n); m_y.reserve(n);
+}
+
+/*!
+  Change the number of points. New points are initialized to zero.
+*/
+void vpPointSet::resize(const unsigned int n)
+{
+  m_oX.resize(n, 0); m_oY.resize(n, 0); m_oZ.resize(n, 0);
+  m_X.resize(n, 0); m_Y.resize(n, 0); m_Z.resize(n, 0);
+  m_x.resize(n, 0); m_y.resize(n, 0);
+}
+
+/*!
+  Exchange the content of two sets without copying the coordinates.
+*/
+void vpPointSet::swap(vpPointSet &points)
+{
+  m_oX.swap(points.m_oX); m_oY.swap(points.m_oY); m_oZ.swap(points.m_oZ);
+  m_X.swap(points.m_X); m_Y.swap(points.m_Y); m_Z.swap(points.m_Z);
+  m_x.swap(points.m_x); m_y.swap(points.m_y);
+}
+
+/*!
+  Compute the coordinates of all the points in the camera frame and in the
+  image plane. Same as changeFrame() followed by projection().
+
+  \param cMo : Transformation from camera to object frame.
+*/
+void vpPointSet::track(const vpHomogeneousMatrix &cMo)
+{
+  changeFrame(cMo);
+  projection();
+}
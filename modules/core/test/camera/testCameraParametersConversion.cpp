@@ -103,6 +103,40 @@ int main()
     vpTRACE("convertPoint with distortion :\n"
             "u1 - u2 = %.20f\n"
             "v1 - v2 = %.20f\n",u1 - u2,v1 - v2);
+
+    // Batched conversions must give the same results than the point by point ones
+    const unsigned int n = 101;
+    std::vector<double> u(n), v(n), x(n), y(n), u_(n), v_(n);
+    for (unsigned int i = 0; i < n; i++) {
+      u[i] = 3.1 * i;
+      v[i] = 480 - 2.3 * i;
+    }
+    vpCameraParameters cams[2] = { cam, camDist };
+    for (unsigned int c = 0; c < 2; c++) {
+      vpPixelMeterConversion::convertPoints(cams[c], &u[0], &v[0], &x[0], &y[0], n);
+      vpMeterPixelConversion::convertPoints(cams[c], &x[0], &y[0], &u_[0], &v_[0], n);
+      for (unsigned int i = 0; i < n; i++) {
+        double xi, yi, ui, vi;
+        vpPixelMeterConversion::convertPoint(cams[c], u[i], v[i], xi, yi);
+        vpMeterPixelConversion::convertPoint(cams[c], xi, yi, ui, vi);
+        if (xi != x[i] || yi != y[i] || ui != u_[i] || vi != v_[i]) {
+          vpTRACE("Error in convertPoints for point %d with camera %d", i, c);
+          return -1;
+        }
+      }
+
+      std::vector<vpImagePoint> iP;
+      std::vector<double> x_, y_;
+      vpMeterPixelConversion::convertPoints(cams[c], x, y, iP);
+      vpPixelMeterConversion::convertPoints(cams[c], iP, x_, y_);
+      for (unsigned int i = 0; i < n; i++) {
+        if (iP[i].get_u() != u_[i] || iP[i].get_v() != v_[i] || !vpMath::equal(x_[i], x[i]) || !vpMath::equal(y_[i], y[i])) {
+          vpTRACE("Error in convertPoints with vpImagePoint for point %d with camera %d", i, c);
+          return -1;
+        }
+      }
+    }
+    vpTRACE("convertPoints ok");
     return 0;
   }
   catch(vpException &e) {
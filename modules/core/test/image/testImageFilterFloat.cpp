@@ -0,0 +1,218 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the single precision and fixed-point filters of vpImageFilter.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageFilterFloat.cpp
+
+  \brief Test the single precision and fixed-point filters of vpImageFilter:
+  they have to give the results of the vpImage<double> filters, up to the
+  rounding of the output type.
+*/
+
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace {
+  template<class T>
+  double maxDifference(const vpImage<T> &I, const vpImage<double> &Iref, const double scale=1.)
+  {
+    if (I.getHeight() != Iref.getHeight() || I.getWidth() != Iref.getWidth()) {
+      return -1;
+    }
+    double diff = 0;
+    for (unsigned int i = 0; i < Iref.getSize(); i++) {
+      diff = (std::max)(diff, std::fabs(I.bitmap[i] / scale - Iref.bitmap[i]));
+    }
+    return diff;
+  }
+
+  bool check(const std::string &name, const double diff, const double tolerance)
+  {
+    if (diff < 0 || diff > tolerance) {
+      std::cerr << name << ": difference " << diff << " above " << tolerance << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    // Smooth pattern with noise, and a width that is not a multiple of the SIMD size
+    vpUniRand rng(5);
+    vpImage<unsigned char> I(241, 323);
+    vpImage<double> Id(I.getHeight(), I.getWidth());
+    vpImage<float> If(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double v = 127.5 + 100 * sin(0.05 * i) * cos(0.07 * j) + 20 * rng();
+        I[i][j] = (unsigned char)vpMath::round(v);
+        Id[i][j] = If[i][j] = (float)(v / 2);
+      }
+    }
+
+    const unsigned int sizes[3] = {3, 5, 7};
+    for (unsigned int s = 0; s < 3; s++) {
+      const unsigned int size = sizes[s];
+      double fg[4], fgd[4];
+      vpImageFilter::getGaussianKernel(fg, size);
+      vpImageFilter::getGaussianDerivativeKernel(fgd, size);
+
+      vpImage<double> ref, ref_dx, ref_dy;
+      vpImage<float> res, res_dx, res_dy;
+      vpImage<short> fixed, fixed_dx, fixed_dy;
+
+      vpImageFilter::filter(I, ref, fg, size);
+      vpImageFilter::filter(I, res, fg, size);
+      if (!check("filter", maxDifference(res, ref), 1e-3))
+        return EXIT_FAILURE;
+      vpImageFilter::filter(Id, ref, fg, size);
+      vpImageFilter::filter(If, res, fg, size);
+      if (!check("filter of a float image", maxDifference(res, ref), 1e-3))
+        return EXIT_FAILURE;
+
+      vpImageFilter::gaussianBlur(I, ref, size);
+      vpImageFilter::gaussianBlur(I, res, size);
+      if (!check("gaussianBlur", maxDifference(res, ref), 1e-3))
+        return EXIT_FAILURE;
+      vpImageFilter::gaussianBlur(Id, ref, size);
+      vpImageFilter::gaussianBlur(If, res, size);
+      if (!check("gaussianBlur of a float image", maxDifference(res, ref), 1e-3))
+        return EXIT_FAILURE;
+      vpImageFilter::gaussianBlur(I, ref, size);
+      vpImageFilter::gaussianBlur(I, fixed, size);
+      if (!check("fixed-point gaussianBlur", maxDifference(fixed, ref, 128.), 0.1))
+        return EXIT_FAILURE;
+
+      vpImageFilter::getGradX(I, ref_dx, fgd, size);
+      vpImageFilter::getGradX(I, res_dx, fgd, size);
+      vpImageFilter::getGradY(I, ref_dy, fgd, size);
+      vpImageFilter::getGradY(I, res_dy, fgd, size);
+      if (!check("getGradX", maxDifference(res_dx, ref_dx), 1e-3) ||
+          !check("getGradY", maxDifference(res_dy, ref_dy), 1e-3))
+        return EXIT_FAILURE;
+      vpImageFilter::getGradX(Id, ref_dx, fgd, size);
+      vpImageFilter::getGradX(If, res_dx, fgd, size);
+      vpImageFilter::getGradY(Id, ref_dy, fgd, size);
+      vpImageFilter::getGradY(If, res_dy, fgd, size);
+      if (!check("getGradX of a float image", maxDifference(res_dx, ref_dx), 1e-3) ||
+          !check("getGradY of a float image", maxDifference(res_dy, ref_dy), 1e-3))
+        return EXIT_FAILURE;
+
+      vpImageFilter::getGradXGauss2D(I, ref_dx, fg, fgd, size);
+      vpImageFilter::getGradXGauss2D(I, res_dx, fg, fgd, size);
+      vpImageFilter::getGradXGauss2D(I, fixed_dx, fg, fgd, size);
+      vpImageFilter::getGradYGauss2D(I, ref_dy, fg, fgd, size);
+      vpImageFilter::getGradYGauss2D(I, res_dy, fg, fgd, size);
+      vpImageFilter::getGradYGauss2D(I, fixed_dy, fg, fgd, size);
+      if (!check("getGradXGauss2D", maxDifference(res_dx, ref_dx), 1e-3) ||
+          !check("getGradYGauss2D", maxDifference(res_dy, ref_dy), 1e-3) ||
+          !check("fixed-point getGradXGauss2D", maxDifference(fixed_dx, ref_dx, 128.), 0.1) ||
+          !check("fixed-point getGradYGauss2D", maxDifference(fixed_dy, ref_dy, 128.), 0.1))
+        return EXIT_FAILURE;
+    }
+
+    // Images smaller than the kernel: a constant image has to stay constant
+    vpImage<unsigned char> Ismall(2, 3, 100);
+    vpImage<float> Ismall_f;
+    vpImage<short> Ismall_fixed;
+    vpImageFilter::gaussianBlur(Ismall, Ismall_f, 7);
+    vpImageFilter::gaussianBlur(Ismall, Ismall_fixed, 7);
+    for (unsigned int i = 0; i < Ismall.getSize(); i++) {
+      if (std::fabs(Ismall_f.bitmap[i] - 100) > 1e-3 || Ismall_fixed.bitmap[i] != 100 * 128) {
+        std::cerr << "The blur of a small constant image is not constant" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Integer row derivatives have to be exactly the generic ones
+    std::vector<double> dx(I.getWidth() - 6), dx_ref(I.getWidth() - 6);
+    std::vector<double> dy(I.getWidth() - 6), dy_ref(I.getWidth() - 6);
+    for (unsigned int i = 3; i < I.getHeight() - 3; i++) {
+      vpImageFilter::derivativeFilterXRow(I, i, 3, (unsigned int)dx.size(), &dx[0], 600.);
+      vpImageFilter::derivativeFilterXRow<unsigned char>(I, i, 3, (unsigned int)dx.size(), &dx_ref[0], 600.);
+      vpImageFilter::derivativeFilterYRow(I, i, 3, (unsigned int)dy.size(), &dy[0], 600.);
+      vpImageFilter::derivativeFilterYRow<unsigned char>(I, i, 3, (unsigned int)dy.size(), &dy_ref[0], 600.);
+      if (dx != dx_ref || dy != dy_ref) {
+        std::cerr << "The row derivatives differ at row " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Timings
+    vpImage<unsigned char> Ibig(480, 640);
+    for (unsigned int i = 0; i < Ibig.getSize(); i++) {
+      Ibig.bitmap[i] = (unsigned char)(255 * rng());
+    }
+    double fg[4], fgd[4];
+    vpImageFilter::getGaussianKernel(fg, 7);
+    vpImageFilter::getGaussianDerivativeKernel(fgd, 7);
+    vpImage<double> Gd, dIxd, dIyd;
+    vpImage<float> Gf, dIxf, dIyf;
+    vpImage<short> Gs, dIxs, dIys;
+    double t0 = vpTime::measureTimeMs();
+    for (unsigned int iter = 0; iter < 10; iter++) {
+      vpImageFilter::filter(Ibig, Gd, fg, 7);
+      vpImageFilter::getGradXGauss2D(Ibig, dIxd, fg, fgd, 7);
+      vpImageFilter::getGradYGauss2D(Ibig, dIyd, fg, fgd, 7);
+    }
+    double t1 = vpTime::measureTimeMs();
+    for (unsigned int iter = 0; iter < 10; iter++) {
+      vpImageFilter::filter(Ibig, Gf, fg, 7);
+      vpImageFilter::getGradXGauss2D(Ibig, dIxf, fg, fgd, 7);
+      vpImageFilter::getGradYGauss2D(Ibig, dIyf, fg, fgd, 7);
+    }
+    double t2 = vpTime::measureTimeMs();
+    for (unsigned int iter = 0; iter < 10; iter++) {
+      vpImageFilter::gaussianBlur(Ibig, Gs, 7);
+      vpImageFilter::getGradXGauss2D(Ibig, dIxs, fg, fgd, 7);
+      vpImageFilter::getGradYGauss2D(Ibig, dIys, fg, fgd, 7);
+    }
+    double t3 = vpTime::measureTimeMs();
+    std::cout << "640x480 blur and gradients: " << (t1 - t0) / 10 << " ms in double, " << (t2 - t1) / 10
+              << " ms in float, " << (t3 - t2) / 10 << " ms in fixed-point" << std::endl;
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testImageFilterFloat is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the integral images and the box filters.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testIntegralImage.cpp
+
+  \brief Test the integral images and the box filters of vpImageTools
+  against sums computed pixel by pixel.
+*/
+
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace {
+  // Mean and variance of a window clipped to the image, pixel by pixel
+  void windowStatistics(const vpImage<unsigned char> &I, const unsigned int i, const unsigned int j,
+                        const unsigned int r, double &mean, double &var)
+  {
+    double sum = 0, sum2 = 0, n = 0;
+    for (int k = (int)i - (int)r; k <= (int)(i + r); k++) {
+      for (int l = (int)j - (int)r; l <= (int)(j + r); l++) {
+        if (k >= 0 && k < (int)I.getHeight() && l >= 0 && l < (int)I.getWidth()) {
+          double v = I[(unsigned int)k][(unsigned int)l];
+          sum += v;
+          sum2 += v * v;
+          n++;
+        }
+      }
+    }
+    mean = sum / n;
+    var = sum2 / n - mean * mean;
+  }
+}
+
+int main()
+{
+  try {
+    vpUniRand rng(11);
+    vpImage<unsigned char> I(53, 71);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I.bitmap[i] = (unsigned char)(255 * rng());
+    }
+
+    // Integral images
+    vpImage<unsigned int> II;
+    vpImage<double> IIsq;
+    vpImageTools::integralImage(I, II, IIsq);
+    if (II.getHeight() != I.getHeight() + 1 || II.getWidth() != I.getWidth() + 1 ||
+        IIsq.getHeight() != I.getHeight() + 1 || IIsq.getWidth() != I.getWidth() + 1) {
+      std::cerr << "Bad size of the integral images" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i <= I.getHeight(); i++) {
+      for (unsigned int j = 0; j <= I.getWidth(); j++) {
+        unsigned int sum = 0;
+        double sum2 = 0;
+        for (unsigned int k = 0; k < i; k++) {
+          for (unsigned int l = 0; l < j; l++) {
+            sum += I[k][l];
+            sum2 += I[k][l] * I[k][l];
+          }
+        }
+        if (II[i][j] != sum || IIsq[i][j] != sum2) {
+          std::cerr << "Bad integral image at (" << i << ", " << j << ")" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    vpImage<unsigned int> II2;
+    vpImageTools::integralImage(I, II2);
+    if (II2 != II) {
+      std::cerr << "The integral images differ" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (vpImageTools::getIntegralSum(II, 10, 20, 5, 7) != II[15][27] - II[15][20] - II[10][27] + II[10][20]) {
+      std::cerr << "Bad rectangle sum" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Box filters, with windows larger than the image
+    const unsigned int sizes[4] = {1, 5, 31, 201};
+    for (unsigned int s = 0; s < 4; s++) {
+      vpImage<float> Imean, Imean2, Ivar;
+      vpImageTools::boxMean(I, Imean, sizes[s]);
+      vpImageTools::boxMeanVariance(I, Imean2, Ivar, sizes[s]);
+      for (unsigned int i = 0; i < I.getHeight(); i++) {
+        for (unsigned int j = 0; j < I.getWidth(); j++) {
+          double mean, var;
+          windowStatistics(I, i, j, sizes[s] / 2, mean, var);
+          if (std::fabs(Imean[i][j] - mean) > 1e-3 || std::fabs(Imean2[i][j] - mean) > 1e-3 ||
+              std::fabs(Ivar[i][j] - var) > 1e-2) {
+            std::cerr << "Bad statistics of the window of size " << sizes[s] << " at (" << i << ", " << j << ")"
+                      << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+    bool thrown = false;
+    try {
+      vpImage<float> Imean;
+      vpImageTools::boxMean(I, Imean, 4);
+    } catch(vpException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << "An even window size has been accepted" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Timings: the cost does not depend on the size of the window
+    vpImage<unsigned char> Ibig(1080, 1920);
+    for (unsigned int i = 0; i < Ibig.getSize(); i++) {
+      Ibig.bitmap[i] = (unsigned char)(255 * rng());
+    }
+    double t0 = vpTime::measureTimeMs();
+    vpImageTools::integralImage(Ibig, II);
+    double t1 = vpTime::measureTimeMs();
+    vpImage<float> Imean, Ivar;
+    vpImageTools::boxMeanVariance(Ibig, Imean, Ivar, 7);
+    double t2 = vpTime::measureTimeMs();
+    vpImageTools::boxMeanVariance(Ibig, Imean, Ivar, 63);
+    double t3 = vpTime::measureTimeMs();
+    std::cout << "1920x1080 integral image: " << t1 - t0 << " ms, mean and variance: " << t2 - t1
+              << " ms with 7x7 windows, " << t3 - t2 << " ms with 63x63 windows" << std::endl;
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testIntegralImage is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the Kalman filter of independent signals.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testKalmanBlockDiagonal.cpp
+
+  \brief Test the Kalman filter of independent signals: filtering the
+  signals separately with vpKalmanFilter::setBlockDiagonal() has to give the
+  same results as filtering them with the full matrices.
+*/
+
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpLinearKalmanFilterInstantiation.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace {
+  double maxDifference(const vpArray2D<double> &A, const vpArray2D<double> &B)
+  {
+    double diff = 0;
+    for (unsigned int i = 0; i < A.getRows(); i++) {
+      for (unsigned int j = 0; j < A.getCols(); j++) {
+        diff = (std::max)(diff, std::fabs(A[i][j] - B[i][j]));
+      }
+    }
+    return diff;
+  }
+
+  // Constant velocity of 2D points whose two coordinates are measured together
+  void initPointFilter(vpKalmanFilter &kalman, const unsigned int nsignal, const double dt)
+  {
+    kalman.init(4, 2, nsignal);
+    kalman.F = 0;
+    kalman.H = 0;
+    kalman.R = 0;
+    kalman.Q = 0;
+    for (unsigned int s = 0; s < nsignal; s++) {
+      unsigned int o = 4 * s, om = 2 * s;
+      for (unsigned int i = 0; i < 4; i++) {
+        kalman.F[o + i][o + i] = 1;
+        kalman.Q[o + i][o + i] = 1e-4 * (i + 1);
+        kalman.Pest[o + i][o + i] = 1;
+      }
+      kalman.F[o][o + 2] = kalman.F[o + 1][o + 3] = dt;
+      kalman.Q[o][o + 1] = kalman.Q[o + 1][o] = 2e-5;
+      kalman.H[om][o] = kalman.H[om + 1][o + 1] = 1;
+      kalman.R[om][om] = kalman.R[om + 1][om + 1] = 0.01 + 0.001 * s;
+      kalman.R[om][om + 1] = kalman.R[om + 1][om] = 0.002;
+    }
+  }
+}
+
+int main()
+{
+  try {
+    vpUniRand rng(3);
+
+    // State models of vpLinearKalmanFilterInstantiation, that enable the block mode
+    const unsigned int nsignal = 100;
+    vpColVector sigma_state(2 * nsignal), sigma_measure(nsignal);
+    for (unsigned int s = 0; s < nsignal; s++) {
+      sigma_state[2 * s] = 1e-4 * (1 + rng());
+      sigma_state[2 * s + 1] = 0;
+      sigma_measure[s] = 1e-2 * (1 + rng());
+    }
+    vpLinearKalmanFilterInstantiation blocks, full;
+    blocks.setStateModel(vpLinearKalmanFilterInstantiation::stateConstVel_MeasurePos);
+    blocks.initFilter(nsignal, sigma_state, sigma_measure, 0, 0.01);
+    full.setStateModel(vpLinearKalmanFilterInstantiation::stateConstVel_MeasurePos);
+    full.initFilter(nsignal, sigma_state, sigma_measure, 0, 0.01);
+    full.setBlockDiagonal(false);
+    if (!blocks.getBlockDiagonal()) {
+      std::cerr << "The block mode is not enabled" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpColVector z(nsignal);
+    double t_blocks = 0, t_full = 0;
+    for (unsigned int iter = 0; iter < 20; iter++) {
+      for (unsigned int s = 0; s < nsignal; s++) {
+        z[s] = s + 0.5 * sin(0.1 * iter + s) + 0.01 * rng();
+      }
+      double t0 = vpTime::measureTimeMs();
+      blocks.filter(z);
+      double t1 = vpTime::measureTimeMs();
+      full.filter(z);
+      double t2 = vpTime::measureTimeMs();
+      t_blocks += t1 - t0;
+      t_full += t2 - t1;
+
+      if (maxDifference(blocks.Xest, full.Xest) != 0 || maxDifference(blocks.Pest, full.Pest) != 0 ||
+          maxDifference(blocks.Xpre, full.Xpre) != 0 || maxDifference(blocks.Ppre, full.Ppre) != 0) {
+        std::cerr << "Iteration " << iter << ": the filters differ" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    std::cout << nsignal << " signals filtered in " << t_blocks / 20 << " ms (" << t_full / 20
+              << " ms with the full matrices)" << std::endl;
+
+    // Measures of size 2
+    vpKalmanFilter points_blocks, points_full;
+    initPointFilter(points_blocks, 20, 0.04);
+    initPointFilter(points_full, 20, 0.04);
+    points_blocks.setBlockDiagonal(true);
+    vpColVector zp(40);
+    for (unsigned int iter = 0; iter < 50; iter++) {
+      for (unsigned int i = 0; i < zp.getRows(); i++) {
+        zp[i] = i + 0.02 * iter + 0.01 * rng();
+      }
+      points_blocks.prediction();
+      points_full.prediction();
+      points_blocks.filtering(zp);
+      points_full.filtering(zp);
+      if (maxDifference(points_blocks.Xest, points_full.Xest) > 1e-9 ||
+          maxDifference(points_blocks.Pest, points_full.Pest) > 1e-9) {
+        std::cerr << "Iteration " << iter << ": the point filters differ" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testKalmanBlockDiagonal is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Loopback throughput benchmark of the text and binary network protocols.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testNetworkThroughput.cpp
+
+  Loopback throughput benchmark of the vpNetwork::TEXT_PROTOCOL and
+  vpNetwork::BINARY_PROTOCOL, with and without compression, streaming images
+  from a vpClient to a vpServer. A frame larger than the limit set with
+  vpNetwork::setMaxSizeReceivedFrame() has to close the connection.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpClient.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRequest.h>
+#include <visp3/core/vpServer.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpTime.h>
+
+#if defined(VISP_HAVE_PTHREAD) || defined(_WIN32)
+
+namespace {
+  class vpRequestImage : public vpRequest
+  {
+  private:
+    vpImage<unsigned char> *I;
+
+  public:
+    vpRequestImage(vpImage<unsigned char> *Im) : I(Im) { request_id = "image"; }
+    virtual ~vpRequestImage() {}
+
+    virtual void encode() {
+      clear();
+      unsigned int h = I->getHeight();
+      unsigned int w = I->getWidth();
+      addParameterObject(&h);
+      addParameterObject(&w);
+      addParameterBuffer(I->bitmap, h*w);
+    }
+
+    virtual void decode() {
+      if(listOfParams.size() == 3){
+        unsigned int h, w;
+        memcpy((void*)&h, (void*)listOfParams[0].c_str(), sizeof(unsigned int));
+        memcpy((void*)&w, (void*)listOfParams[1].c_str(), sizeof(unsigned int));
+        I->resize(h, w);
+        memcpy((void*)I->bitmap, (void*)listOfParams[2].c_str(), w*h);
+      }
+    }
+  };
+
+  struct vpBenchmarkPhase {
+    vpNetwork::vpProtocolType protocol;
+    int compressionLevel;
+    const char *name;
+  };
+
+  const vpBenchmarkPhase phases[] = {
+    { vpNetwork::TEXT_PROTOCOL, 0, "text" },
+    { vpNetwork::BINARY_PROTOCOL, 0, "binary" },
+    { vpNetwork::BINARY_PROTOCOL, 1, "binary + zlib" }
+  };
+  const unsigned int nbPhases = 3;
+  const unsigned int nbFrames = 200;
+  const unsigned int width = 640, height = 480;
+
+  struct vpServerData {
+    vpServer *server;
+    bool ok;
+  };
+
+  // Fill an image with a pattern depending on the frame index, that doesn't contain the text protocol separators
+  void fillImage(vpImage<unsigned char> &I, unsigned int frame)
+  {
+    for(unsigned int i = 0 ; i < I.getHeight() ; i++)
+      for(unsigned int j = 0 ; j < I.getWidth() ; j++)
+        I[i][j] = (unsigned char)((i/8 + j/8 + frame) % 64);
+  }
+
+  vpThread::Return serverFunction(vpThread::Args args)
+  {
+    vpServerData *data = (vpServerData *)args;
+    vpServer &server = *data->server;
+    vpImage<unsigned char> I, Iref(height, width);
+    vpRequestImage request(&I);
+    server.addDecodingRequest(&request);
+
+    while(server.getNumberOfClients() == 0)
+      server.checkForConnections();
+
+    for(unsigned int p = 0 ; p < nbPhases ; p++){
+      server.setProtocol(phases[p].protocol);
+      unsigned int received = 0;
+      while(received < nbFrames && server.getNumberOfClients() > 0){
+        // Decode the images one by one, receiveAndDecodeRequest() would only keep the last one
+        if(server.receiveAndDecodeRequestOnce() == 0){
+          fillImage(Iref, received);
+          if(!(I == Iref)){
+            std::cerr << "Bad image received with the " << phases[p].name << " protocol" << std::endl;
+            data->ok = false;
+          }
+          received++;
+        }
+      }
+      if(received != nbFrames){
+        data->ok = false;
+        return 0;
+      }
+
+      // Acknowledge the end of the phase before the client changes the protocol
+      int ack = (int)p;
+      server.send(&ack);
+    }
+
+    // A frame larger than the limit has to close the connection without being allocated
+    server.setMaxSizeReceivedFrame(width*height/2);
+    double t = vpTime::measureTimeMs();
+    while(server.getNumberOfClients() > 0 && vpTime::measureTimeMs() - t < 5000)
+      server.receiveRequestOnce();
+    if(server.getNumberOfClients() > 0){
+      std::cerr << "The client sending a too large frame was not disconnected" << std::endl;
+      data->ok = false;
+    }
+
+    return 0;
+  }
+}
+
+int main()
+{
+  try {
+    // The port of a previous run may still be in TIME_WAIT state
+    int port = 35100;
+    vpServer *server = NULL;
+    for(; port < 35110 ; port++){
+      server = new vpServer(port);
+      if(server->start())
+        break;
+      delete server;
+      server = NULL;
+    }
+    if(server == NULL){
+      std::cout << "Cannot start the server, the ports may already be used" << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    vpServerData data;
+    data.server = server;
+    data.ok = true;
+    vpThread thread((vpThread::Fn)serverFunction, (vpThread::Args)&data);
+
+    vpClient client;
+    client.setVerbose(true);
+    if(!client.connectToIP("127.0.0.1", (unsigned int)port)){
+      std::cerr << "Cannot connect to the server" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpImage<unsigned char> I(height, width);
+    vpRequestImage request(&I);
+
+    for(unsigned int p = 0 ; p < nbPhases ; p++){
+      client.setProtocol(phases[p].protocol);
+      client.setCompressionLevel(phases[p].compressionLevel);
+
+      double t = vpTime::measureTimeMs();
+      double bytes = 0;
+      for(unsigned int f = 0 ; f < nbFrames ; f++){
+        fillImage(I, f);
+        int sent = client.sendAndEncodeRequest(request);
+        if(sent <= 0){
+          std::cerr << "Cannot send the image with the " << phases[p].name << " protocol" << std::endl;
+          return EXIT_FAILURE;
+        }
+        bytes += sent;
+      }
+
+      int ack = -1;
+      while(ack != (int)p){
+        if(client.receive(&ack) < 0){
+          std::cerr << "Server disconnected" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+      t = vpTime::measureTimeMs() - t;
+
+      std::cout << phases[p].name << " protocol: " << nbFrames << " images " << width << "x" << height << " in "
+                << t << " ms, " << nbFrames / (t / 1000.) << " images/s, " << (bytes / nbFrames) / 1024.
+                << " KB/image on the wire" << std::endl;
+    }
+
+    // Too large for the server that has to drop the connection
+    client.sendAndEncodeRequest(request);
+
+    thread.join();
+    delete server;
+    if(!data.ok){
+      std::cerr << "Errors occured on the server side" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testNetworkThroughput is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+#else
+int main()
+{
+  std::cout << "This test requires pthread or Windows threads" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpPointSet against vpPoint and the clipping of vpPolygon3D.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPointSet.cpp
+
+  \brief Test vpPointSet against vpPoint and the clipping of vpPolygon3D.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPointSet.h>
+#include <visp3/core/vpPolygon3D.h>
+#include <visp3/core/vpUniRand.h>
+
+int main()
+{
+  try {
+    vpUniRand random(17);
+    vpHomogeneousMatrix cMo(0.1, -0.2, 1.5, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+
+    // Transformation and projection must give exactly the same values than vpPoint
+    std::vector<vpPoint> points;
+    for (unsigned int i = 0; i < 103; i++) {
+      points.push_back(vpPoint(random() - 0.5, random() - 0.5, random() - 0.5));
+    }
+    vpPointSet set(points);
+    set.track(cMo);
+    if (set.size() != points.size()) {
+      std::cerr << "Bad number of points: " << set.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < points.size(); i++) {
+      points[i].track(cMo);
+      if (set.get_X(i) != points[i].get_X() || set.get_Y(i) != points[i].get_Y() || set.get_Z(i) != points[i].get_Z() ||
+          set.get_x(i) != points[i].get_x() || set.get_y(i) != points[i].get_y()) {
+        std::cerr << "Point " << i << " differs from vpPoint" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    vpPoint P;
+    set.getPoint(10, P);
+    if (P.get_oX() != points[10].get_oX() || P.get_x() != points[10].get_x()) {
+      std::cerr << "Bad point returned by getPoint()" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A square partially behind the near clipping plane and outside the field of view
+    vpPolygon3D polygon;
+    polygon.setNbPoint(4);
+    polygon.addPoint(0, vpPoint(-1.0, -1.0, 0.0));
+    polygon.addPoint(1, vpPoint(1.0, -1.0, 0.0));
+    polygon.addPoint(2, vpPoint(1.0, 1.0, 0.0));
+    polygon.addPoint(3, vpPoint(-1.0, 1.0, 0.0));
+    vpHomogeneousMatrix cMp(0.2, 0.1, 1.0, vpMath::rad(60), 0.0, 0.0);
+    vpCameraParameters cam(600, 600, 320, 240);
+    polygon.setClipping(vpPolygon3D::NEAR_CLIPPING | vpPolygon3D::FOV_CLIPPING);
+    polygon.setNearClippingDistance(0.5);
+    polygon.changeFrame(cMp);
+    polygon.computePolygonClipped(cam);
+
+    std::vector<vpPoint> clipped;
+    polygon.getPolygonClipped(clipped);
+    vpPointSet clippedSet;
+    std::vector<unsigned int> flags;
+    polygon.getPolygonClipped(clippedSet, flags);
+    if (clipped.size() < 3 || clipped.size() != clippedSet.size() || flags.size() != clipped.size()) {
+      std::cerr << "Bad number of clipped points: " << clipped.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < clipped.size(); i++) {
+      if (clipped[i].get_Z() < 0.5 - 1e-9) {
+        std::cerr << "Clipped point " << i << " is in front of the near plane" << std::endl;
+        return EXIT_FAILURE;
+      }
+      // Object coordinates of the clipped points have to be consistent with the camera ones
+      vpPoint Q(clipped[i].get_oX(), clipped[i].get_oY(), clipped[i].get_oZ());
+      Q.changeFrame(cMp);
+      if (!vpMath::equal(Q.get_X(), clipped[i].get_X(), 1e-9) || !vpMath::equal(Q.get_Y(), clipped[i].get_Y(), 1e-9) ||
+          !vpMath::equal(Q.get_Z(), clipped[i].get_Z(), 1e-9)) {
+        std::cerr << "Clipped point " << i << " has inconsistent object coordinates" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (clippedSet.get_X(i) != clipped[i].get_X() || clippedSet.get_x(i) != clipped[i].get_x()) {
+        std::cerr << "vpPointSet and vpPoint clipped polygons differ" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testPointSet is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
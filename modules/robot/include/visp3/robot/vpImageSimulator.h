@@ -56,6 +56,8 @@
   You can use a colored or a gray scaled image.
   
   To avoid the aliasing especially when the camera is very near from the image plane, a bilinear interpolation can be done for every pixels which have to be filled in. By default this functionality is not used because it consumes lot of time.
+
+  The view is computed by a scanline rasterizer: for each row of the image, the range of columns where the ray of a pixel can hit the 3D rectangle is computed once, and only the pixels of this range are intersected with the plane. When ViSP is built with OpenMP, the rows are rasterized in parallel. When several images are projected with getImage(vpImage<unsigned char> &, std::list<vpImageSimulator> &, const vpCameraParameters &), a depth buffer resolves the occlusions between them.
   
   The  following example explain how to use the class.
   
@@ -197,6 +199,9 @@ class VISP_EXPORT vpImageSimulator
 
     //boolean to tell if the points in the camera frame have to be clipped
     bool needClipping;
+
+    //boolean to tell if the 3D corners define a rectangle: the texture coordinates are then enough to know if a pixel is inside the projected plane
+    bool rectangularPlan;
     
   public:
     vpImageSimulator(const vpColorPlan &col = COLORED);
@@ -299,6 +304,23 @@ class VISP_EXPORT vpImageSimulator
     
     void getRoi(const unsigned int &Iwidth, const unsigned int &Iheight, 
         const vpCameraParameters &cam, const std::vector<vpPoint> &point, vpRect &rect);
+
+    //scanline rasterization of the projected plane
+    bool getRowSpan(const vpCameraParameters &cam, const unsigned int i,
+                    unsigned int &jmin, unsigned int &jmax) const;
+    template <class Type, class TexType>
+    void rasterizeRow(const vpImage<TexType> &tex, const vpCameraParameters &cam, const unsigned int i,
+                      const unsigned int left, const unsigned int right, std::vector<vpTriangle> &triangles,
+                      Type *row, double *zRow) const;
+    template <class Type>
+    void rasterizeRow(const vpCameraParameters &cam, const unsigned int i,
+                      const unsigned int left, const unsigned int right, std::vector<vpTriangle> &triangles,
+                      Type *row, double *zRow) const;
+    template <class Type, class TexType>
+    void rasterize(vpImage<Type> &I, const vpImage<TexType> &tex, const vpCameraParameters &cam,
+                   vpMatrix *zBuffer) const;
+    template <class Type>
+    static void rasterize(vpImage<Type> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam);
 };
 
 
@@ -83,6 +83,29 @@
   \warning This class uses threading capabilities. Thus on Unix-like
   platforms, the libpthread third-party library need to be
   installed. On Windows, we use the native threading capabilities.
+
+  By default, the robot displacement is computed in a thread that runs in
+  real time: the velocity applied to the robot is integrated every
+  sampling time (see setSamplingTime()) using the time measured since the
+  previous iteration. When the lock-step mode is enabled with
+  setLockStepMode(), the thread is stopped and the simulated time is only
+  advanced by step(), without any sleep. Since the velocity is always
+  integrated over exactly one sampling time, a simulation is reproducible
+  and runs as fast as the CPU allows, which is useful to batch visual
+  servoing scenarios. The external view is then rendered once per call to
+  step(), only if the display is enabled, and the internal view only when
+  getInternalView() is called.
+
+  \code
+  vpSimulatorViper850 robot(false); // No external view
+  robot.setLockStepMode(true);
+  robot.setRobotState(vpRobot::STATE_VELOCITY_CONTROL);
+  for (unsigned int iter = 0; iter < 1000; iter++) {
+    // ... compute the velocity v from the camera pose robot.get_cMo()
+    robot.setVelocity(vpRobot::CAMERA_FRAME, v);
+    robot.step(); // Advance the simulated time by one sampling time
+  }
+  \endcode
 */
 class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, public vpRobotSimulator
 {
@@ -172,6 +195,13 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
     bool setVelocityCalled;
 
     bool verbose_;
+
+    //! Flag used to stop the thread computing the robot's displacement and advance the simulated time with step().
+    bool lockStepMode;
+    //! Simulated time in seconds since the lock-step mode was enabled.
+    double simulationTime;
+    //! True if the thread computing the robot's displacement is running.
+    bool simulationThreadRunning;
     
 //private:
 //#ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -223,6 +253,17 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
         return vpCameraParameters(size,size,I.getWidth()/2,I.getHeight()/2);
       }
     }
+    /*!
+      Return true if the lock-step mode is enabled; see setLockStepMode().
+    */
+    inline bool getLockStepMode() const { return lockStepMode; }
+
+    /*!
+      Get the simulated time in seconds since the lock-step mode was enabled;
+      see setLockStepMode() and step().
+    */
+    inline double getSimulationTime() const { return simulationTime; }
+
     /*!
       Get the external camera's position relative to the the world reference frame.
 
@@ -269,6 +310,8 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
       constantSamplingTimeMode = _constantSamplingTimeMode;
     }
 
+    void setLockStepMode(const bool lockStep);
+
     /*!
       Set the color used to display the object at the current position in the robot's camera view.
 
@@ -323,11 +366,12 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
       the velocity applied to the robot during this time.
 
       Since the wireframe simulator is threaded, the sampling time is set to vpTime::getMinTimeForUsleepCall() / 1000 seconds.
+      In lock-step mode (see setLockStepMode()) there is no such limitation.
 
     */
     inline void setSamplingTime(const double &delta_t)
     {
-      if(delta_t < static_cast<float>(vpTime::getMinTimeForUsleepCall() * 1e-3)){
+      if(!lockStepMode && delta_t < static_cast<float>(vpTime::getMinTimeForUsleepCall() * 1e-3)){
         this->delta_t_ = static_cast<float>(vpTime::getMinTimeForUsleepCall() * 1e-3);
       } else {
         this->delta_t_ = delta_t;
@@ -350,6 +394,8 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
       \param fMo_ : The pose between the object and the fixed world frame.
     */
     void set_fMo(const vpHomogeneousMatrix &fMo_) {this->fMo = fMo_;}
+
+    void step(const unsigned int nbSteps=1);
     //@}
 
   protected:
@@ -377,6 +423,11 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
     void init() {;}
     /*! Method lauched by the thread to compute the position of the robot in the articular frame. */
     virtual void updateArticularPosition() = 0;
+    virtual void integrateArticularVelocity(const double &dt);
+    virtual void updateExternalView();
+    void computeLockStep(const bool updateVelocity=true);
+    void startSimulationThread();
+    void stopSimulationThread();
     /*! Method used to check if the robot reached a joint limit. */
     virtual int isInJointLimit () = 0;
     /*! Compute the articular velocity relative to the velocity in another frame. */
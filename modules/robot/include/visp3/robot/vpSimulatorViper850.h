@@ -305,6 +305,8 @@ protected:
     int isInJointLimit (void);
     bool singularityTest(const vpColVector &q, vpMatrix &J);
     void updateArticularPosition();
+    void integrateArticularVelocity(const double &dt);
+    void updateExternalView();
     //@}      
 };
 
@@ -44,10 +44,41 @@
 #include <visp3/core/vpMatrixException.h>
 #include <visp3/core/vpPolygon3D.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #ifdef VISP_HAVE_MODULE_IO
 #  include <visp3/io/vpImageIo.h>
 #endif
 
+namespace {
+  // Conversions from the texture to the image pixels, the same as the ones
+  // that were done pixel by pixel in getImage()
+  inline void convertPixel(const unsigned char &src, unsigned char &dst)
+  {
+    dst = src;
+  }
+
+  inline void convertPixel(const vpRGBa &src, unsigned char &dst)
+  {
+    dst = (unsigned char)(0.2126 * src.R + 0.7152 * src.G + 0.0722 * src.B);
+  }
+
+  inline void convertPixel(const unsigned char &src, vpRGBa &dst)
+  {
+    dst = vpRGBa();
+    dst.R = src;
+    dst.G = src;
+    dst.B = src;
+  }
+
+  inline void convertPixel(const vpRGBa &src, vpRGBa &dst)
+  {
+    dst = src;
+  }
+}
+
 /*!
   Basic constructor.
   
@@ -63,7 +94,8 @@ vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
     euclideanNorm_u(0.), euclideanNorm_v(0.), vbase_u(), vbase_v(),
     vbase_u_optim(NULL), vbase_v_optim(NULL), Xinter_optim(NULL), listTriangle(),
     colorI(col), Ig(), Ic(), rect(), cleanPrevImage(false),
-    setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false)
+    setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false),
+    rectangularPlan(false)
 {
   for(int i=0;i<4;i++)
     X[i].resize(3);
@@ -103,7 +135,8 @@ vpImageSimulator::vpImageSimulator(const vpImageSimulator &text)
     euclideanNorm_u(0.), euclideanNorm_v(0.), vbase_u(), vbase_v(),
     vbase_u_optim(NULL), vbase_v_optim(NULL), Xinter_optim(NULL), listTriangle(),
     colorI(GRAY_SCALED), Ig(), Ic(), rect(), cleanPrevImage(false),
-    setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false)
+    setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false),
+    rectangularPlan(false)
 {
   pt.resize(4);
   for(unsigned int i=0;i<4;i++)
@@ -188,6 +221,268 @@ vpImageSimulator::operator=(const vpImageSimulator& sim)
   return *this;
 }
 
+/*!
+  Restrict the columns \f$ [jmin, jmax[ \f$ of the row \e i to the pixels
+  whose ray can hit the 3D rectangle.
+
+  Along a row, the inverse of the depth of the intersection with the plane and
+  the texture coordinates multiplied by this inverse are affine functions of
+  the normalized coordinate \e x. Being in front of the camera and having
+  texture coordinates in \f$ ]0,1[ \f$ are thus five half-lines in \e x, whose
+  intersection is computed once per row. The range is enlarged by two pixels
+  so that the exact test of rasterizeRow() decides for the pixels near the
+  borders. With a camera model with distortion, the range is not restricted.
+
+  \return false if no pixel of the row can hit the plane.
+*/
+bool
+vpImageSimulator::getRowSpan(const vpCameraParameters &cam, const unsigned int i,
+                             unsigned int &jmin, unsigned int &jmax) const
+{
+  if (cam.get_projModel() != vpCameraParameters::perspectiveProjWithoutDistortion)
+    return jmin < jmax;
+
+  double x = 0, y = 0;
+  vpPixelMeterConversion::convertPoint(cam, 0., (double)i, x, y);
+
+  // Scalar products of the first corner with the texture axes
+  double cu = 0, cv = 0;
+  for (unsigned int k = 0; k < 3; k++)
+  {
+    cu += X0_2_optim[k]*vbase_u_optim[k];
+    cv += X0_2_optim[k]*vbase_v_optim[k];
+  }
+  const double *n = normal_Cam_optim;
+  const double w0 = n[1]*y + n[2];
+  const double au = distance*vbase_u_optim[0] - cu*n[0];
+  const double bu = distance*(vbase_u_optim[1]*y + vbase_u_optim[2]) - cu*w0;
+  const double av = distance*vbase_v_optim[0] - cv*n[0];
+  const double bv = distance*(vbase_v_optim[1]*y + vbase_v_optim[2]) - cv*w0;
+  const double nu = euclideanNorm_u*euclideanNorm_u;
+  const double nv = euclideanNorm_v*euclideanNorm_v;
+
+  // a[k] x + b[k] > 0 for: 1/z, u/z, (1-u)/z, v/z and (1-v)/z, up to a positive factor
+  const double a[5] = { n[0], au, nu*n[0] - au, av, nv*n[0] - av };
+  const double b[5] = { w0, bu, nu*w0 - bu, bv, nv*w0 - bv };
+  double xmin = -std::numeric_limits<double>::max();
+  double xmax = std::numeric_limits<double>::max();
+  for (unsigned int k = 0; k < 5; k++)
+  {
+    if (a[k] > 0)
+      xmin = (std::max)(xmin, -b[k]/a[k]);
+    else if (a[k] < 0)
+      xmax = (std::min)(xmax, -b[k]/a[k]);
+  }
+
+  const double jl = xmin*cam.get_px() + cam.get_u0() - 2.;
+  const double jh = xmax*cam.get_px() + cam.get_u0() + 2.;
+  if (jl > (double)jmin)
+  {
+    if (jl >= (double)jmax)
+      return false;
+    jmin = (unsigned int)std::ceil(jl);
+  }
+  if (jh < (double)jmax - 1.)
+  {
+    if (jh < (double)jmin)
+      return false;
+    jmax = (unsigned int)std::floor(jh) + 1;
+  }
+  return jmin < jmax;
+}
+
+/*!
+  Project the texture \e tex into the pixels of the row \e i in the columns
+  \f$ [left, right[ \f$.
+
+  The depth and the texture coordinates of each pixel are computed exactly
+  like in getPixel(), but only in the range given by getRowSpan(). When the
+  plane is a rectangle which is not clipped, the texture coordinates are
+  enough to know if a pixel is inside the projected plane. Otherwise the
+  pixel is also tested against the projected triangles.
+
+  \param tex : The image which is projected.
+  \param cam : The parameters of the virtual camera.
+  \param i : The row to rasterize.
+  \param left, right : The columns to rasterize.
+  \param triangles : A copy of the projected triangles owned by the calling thread.
+  \param row : The pixels of the row \e i.
+  \param zRow : If not NULL, the depth buffer of the row \e i. A pixel is only
+  updated if its depth is lower than the one of the buffer or if the buffer is
+  negative.
+*/
+template <class Type, class TexType>
+void
+vpImageSimulator::rasterizeRow(const vpImage<TexType> &tex, const vpCameraParameters &cam, const unsigned int i,
+                               const unsigned int left, const unsigned int right, std::vector<vpTriangle> &triangles,
+                               Type *row, double *zRow) const
+{
+  unsigned int jmin = left, jmax = right;
+  if (!getRowSpan(cam, i, jmin, jmax))
+    return;
+
+  const bool testTriangles = needClipping || !rectangularPlan;
+  vpImagePoint ip;
+  for (unsigned int j = jmin; j < jmax; j++)
+  {
+    double x = 0, y = 0;
+    vpPixelMeterConversion::convertPoint(cam, (double)j, (double)i, x, y);
+    if (testTriangles)
+    {
+      ip.set_ij(y, x);
+      bool inside = false;
+      for (size_t k = 0; k < triangles.size() && !inside; k++)
+        inside = triangles[k].inTriangle(ip);
+      if (!inside)
+        continue;
+    }
+
+    double z = distance/(normal_Cam_optim[0]*x+normal_Cam_optim[1]*y+normal_Cam_optim[2]);
+    double Xinter[3] = { x*z, y*z, z };
+    double u = 0, v = 0;
+    for (unsigned int k = 0; k < 3; k++)
+    {
+      double diff = (Xinter[k]-X0_2_optim[k]);
+      u += diff*vbase_u_optim[k];
+      v += diff*vbase_v_optim[k];
+    }
+    u = u/(euclideanNorm_u*euclideanNorm_u);
+    v = v/(euclideanNorm_v*euclideanNorm_v);
+
+    if (u > 0 && v > 0 && u < 1. && v < 1.)
+    {
+      if (zRow != NULL)
+      {
+        if (!(z < zRow[j] || zRow[j] < 0))
+          continue;
+        zRow[j] = z;
+      }
+      double i2 = v*(tex.getHeight()-1);
+      double j2 = u*(tex.getWidth()-1);
+      if (interp == BILINEAR_INTERPOLATION)
+        convertPixel(tex.getValue(i2,j2), row[j]);
+      else if (interp == SIMPLE)
+        convertPixel(tex[(unsigned int)i2][(unsigned int)j2], row[j]);
+    }
+  }
+}
+
+/*!
+  Project the texture of the simulator, chosen with its color plan, into the
+  pixels of the row \e i. See rasterizeRow(const vpImage<TexType> &, const vpCameraParameters &, const unsigned int, const unsigned int, const unsigned int, std::vector<vpTriangle> &, Type *, double *) const.
+*/
+template <class Type>
+void
+vpImageSimulator::rasterizeRow(const vpCameraParameters &cam, const unsigned int i,
+                               const unsigned int left, const unsigned int right, std::vector<vpTriangle> &triangles,
+                               Type *row, double *zRow) const
+{
+  if (colorI == GRAY_SCALED)
+    rasterizeRow(Ig, cam, i, left, right, triangles, row, zRow);
+  else if (colorI == COLORED)
+    rasterizeRow(Ic, cam, i, left, right, triangles, row, zRow);
+}
+
+/*!
+  Project the texture \e tex into the region of interest \e rect of the image
+  \e I. The rows are rasterized in parallel when OpenMP is available.
+*/
+template <class Type, class TexType>
+void
+vpImageSimulator::rasterize(vpImage<Type> &I, const vpImage<TexType> &tex, const vpCameraParameters &cam,
+                            vpMatrix *zBuffer) const
+{
+  const int top = (int)rect.getTop();
+  const int bottom = (int)rect.getBottom();
+  const unsigned int left = (unsigned int)rect.getLeft();
+  const unsigned int right = (unsigned int)rect.getRight();
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    // vpTriangle::inTriangle() is not const, each thread uses its own copy
+    std::vector<vpTriangle> triangles = listTriangle;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = top; i < bottom; i++)
+    {
+      double *zRow = (zBuffer != NULL) ? (*zBuffer)[(unsigned int)i] : NULL;
+      rasterizeRow(tex, cam, (unsigned int)i, left, right, triangles, I[(unsigned int)i], zRow);
+    }
+  }
+}
+
+/*!
+  Project the visible simulators of \e list into the image \e I. Each
+  simulator is rasterized in its own region of interest, like with
+  getImage(vpImage<unsigned char> &, const vpCameraParameters &, vpMatrix &).
+  A depth buffer of one row per thread keeps, for each pixel, the nearest
+  plane that covers it. When two planes are at the same depth, the first one
+  of the list is kept. The rows are rasterized in parallel when OpenMP is
+  available.
+*/
+template <class Type>
+void
+vpImageSimulator::rasterize(vpImage<Type> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam)
+{
+  unsigned int width = I.getWidth();
+  unsigned int height = I.getHeight();
+
+  double topFinal = height+1;
+  double bottomFinal = -1;
+
+  std::vector<vpImageSimulator *> simList;
+  for(std::list<vpImageSimulator>::iterator it=list.begin(); it!=list.end(); ++it)
+  {
+    vpImageSimulator* sim = &(*it);
+    if (!sim->visible)
+      continue;
+
+    if(!sim->needClipping)
+      sim->getRoi(width,height,cam,sim->pt,sim->rect);
+    else
+      sim->getRoi(width,height,cam,sim->ptClipped,sim->rect);
+
+    if (topFinal > sim->rect.getTop()) topFinal = sim->rect.getTop();
+    if (bottomFinal < sim->rect.getBottom()) bottomFinal = sim->rect.getBottom();
+    simList.push_back(sim);
+  }
+
+  if (simList.empty() || width == 0)
+    return;
+
+  const int top = (int)topFinal;
+  const int bottom = (int)bottomFinal;
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    // vpTriangle::inTriangle() is not const, each thread uses its own copy
+    std::vector<std::vector<vpTriangle> > triangles(simList.size());
+    for (size_t k = 0; k < simList.size(); k++)
+      triangles[k] = simList[k]->listTriangle;
+    std::vector<double> zRow(width);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int i = top; i < bottom; i++)
+    {
+      std::fill(zRow.begin(), zRow.end(), -1.);
+      for (size_t k = 0; k < simList.size(); k++)
+      {
+        const vpRect &r = simList[k]->rect;
+        if (i < (int)r.getTop() || i >= (int)r.getBottom())
+          continue;
+        simList[k]->rasterizeRow(cam, (unsigned int)i, (unsigned int)r.getLeft(), (unsigned int)r.getRight(),
+                                 triangles[k], I[(unsigned int)i], &zRow[0]);
+      }
+    }
+  }
+}
+
 /*!
   Get the view of the virtual camera. Be careful, the image I is modified. The projected image is not added as an overlay!
   \param I : The image used to store the result.
@@ -222,46 +517,11 @@ vpImageSimulator::getImage(vpImage<unsigned char> &I,
       getRoi(I.getWidth(),I.getHeight(),cam,pt,rect);
     else
       getRoi(I.getWidth(),I.getHeight(),cam,ptClipped,rect);
-    
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right= rect.getRight();
-    
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
 
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++)
-    {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++)
-      {
-        double x=0,y=0;
-        ip.set_ij(i,j);
-        vpPixelMeterConversion::convertPoint(cam,ip, x,y);
-        ip.set_ij(y,x);
-        if (colorI == GRAY_SCALED)
-        {
-          unsigned char Ipixelplan = 0;
-          if(getPixel(ip,Ipixelplan))
-          {
-            *(bitmap+i*width+j)=Ipixelplan;
-            nb_point_dessine++;
-          }
-        }
-        else if (colorI == COLORED)
-        {
-          vpRGBa Ipixelplan;
-          if(getPixel(ip,Ipixelplan))
-          {
-            unsigned char pixelgrey = (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-            *(bitmap+i*width+j)=pixelgrey;
-            nb_point_dessine++;
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I, Ig, cam, NULL);
+    else if (colorI == COLORED)
+      rasterize(I, Ic, cam, NULL);
   }
 }
 
@@ -296,32 +556,7 @@ vpImageSimulator::getImage(vpImage<unsigned char> &I,
     else
       getRoi(I.getWidth(),I.getHeight(),cam,ptClipped,rect);
 
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right= rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++)
-    {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++)
-      {
-        double x=0,y=0;
-        ip.set_ij(i,j);
-        vpPixelMeterConversion::convertPoint(cam,ip, x,y);
-        ip.set_ij(y,x);
-        unsigned char Ipixelplan = 0;
-        if(getPixel(Isrc,ip,Ipixelplan))
-        {
-          *(bitmap+i*width+j)=Ipixelplan;
-          nb_point_dessine++;
-        }
-      }
-    }
+    rasterize(I, Isrc, cam, NULL);
   }
 }
 
@@ -358,54 +593,11 @@ vpImageSimulator::getImage(vpImage<unsigned char> &I,
       getRoi(I.getWidth(),I.getHeight(),cam,pt,rect);
     else
       getRoi(I.getWidth(),I.getHeight(),cam,ptClipped,rect);
-    
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right= rect.getRight();
-    
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
 
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++)
-    {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++)
-      {
-        double x=0,y=0;
-        ip.set_ij(i,j);
-        vpPixelMeterConversion::convertPoint(cam,ip, x,y);
-        ip.set_ij(y,x);
-        if (colorI == GRAY_SCALED)
-        {
-          unsigned char Ipixelplan;
-          if(getPixel(ip,Ipixelplan))
-          {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0)
-            {
-              *(bitmap+i*width+j)=Ipixelplan;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-        else if (colorI == COLORED)
-        {
-          vpRGBa Ipixelplan;
-          if(getPixel(ip,Ipixelplan))
-          {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0)
-            {
-              unsigned char pixelgrey = (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-              *(bitmap+i*width+j)=pixelgrey;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I, Ig, cam, &zBuffer);
+    else if (colorI == COLORED)
+      rasterize(I, Ic, cam, &zBuffer);
   }
 }
 
@@ -435,49 +627,11 @@ vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &cam)
       getRoi(I.getWidth(),I.getHeight(),cam,pt,rect);
     else
       getRoi(I.getWidth(),I.getHeight(),cam,ptClipped,rect);
-    
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right= rect.getRight();
-    
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
 
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++)
-    {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++)
-      {
-        double x=0,y=0;
-        ip.set_ij(i,j);
-        vpPixelMeterConversion::convertPoint(cam,ip, x,y);
-        ip.set_ij(y,x);
-        if (colorI == GRAY_SCALED)
-        {
-          unsigned char Ipixelplan;
-          if(getPixel(ip,Ipixelplan))
-          {
-            vpRGBa pixelcolor;
-            pixelcolor.R = Ipixelplan;
-            pixelcolor.G = Ipixelplan;
-            pixelcolor.B = Ipixelplan;
-            *(bitmap+i*width+j) = pixelcolor;
-            nb_point_dessine++;
-          }
-        }
-        else if (colorI == COLORED)
-        {
-          vpRGBa Ipixelplan;
-          if(getPixel(ip,Ipixelplan))
-          {
-            *(bitmap+i*width+j) = Ipixelplan;
-            nb_point_dessine++;
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I, Ig, cam, NULL);
+    else if (colorI == COLORED)
+      rasterize(I, Ic, cam, NULL);
   }
 }
 
@@ -510,33 +664,8 @@ vpImageSimulator::getImage(vpImage<vpRGBa> &I, vpImage<vpRGBa> &Isrc,
       getRoi(I.getWidth(),I.getHeight(),cam,pt,rect);
     else
       getRoi(I.getWidth(),I.getHeight(),cam,ptClipped,rect);
-    
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right= rect.getRight();
-    
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
 
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++)
-    {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++)
-      {
-        double x=0,y=0;
-        ip.set_ij(i,j);
-        vpPixelMeterConversion::convertPoint(cam,ip, x,y);
-        ip.set_ij(y,x);
-        vpRGBa Ipixelplan;
-        if(getPixel(Isrc,ip,Ipixelplan))
-        {
-          *(bitmap+i*width+j) = Ipixelplan;
-          nb_point_dessine++;
-        }
-      }
-    }
+    rasterize(I, Isrc, cam, NULL);
   }
 }
 
@@ -572,63 +701,17 @@ vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &cam,
       getRoi(I.getWidth(),I.getHeight(),cam,pt,rect);
     else
       getRoi(I.getWidth(),I.getHeight(),cam,ptClipped,rect);
-    
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right= rect.getRight();
-    
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
 
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++)
-    {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++)
-      {
-        double x=0,y=0;
-        ip.set_ij(i,j);
-        vpPixelMeterConversion::convertPoint(cam,ip, x,y);
-        ip.set_ij(y,x);
-        if (colorI == GRAY_SCALED)
-        {
-          unsigned char Ipixelplan;
-          if(getPixel(ip,Ipixelplan))
-          {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0)
-            {
-              vpRGBa pixelcolor;
-              pixelcolor.R = Ipixelplan;
-              pixelcolor.G = Ipixelplan;
-              pixelcolor.B = Ipixelplan;
-              *(bitmap+i*width+j) = pixelcolor;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-        else if (colorI == COLORED)
-        {
-          vpRGBa Ipixelplan;
-          if(getPixel(ip,Ipixelplan))
-          {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0)
-            {
-              *(bitmap+i*width+j) = Ipixelplan;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I, Ig, cam, &zBuffer);
+    else if (colorI == COLORED)
+      rasterize(I, Ic, cam, &zBuffer);
   }
 }
 
 /*!
   Get the view of the virtual camera. Be careful, the image I is modified. The projected image is not added as an overlay!
-  With this method, a list of image is projected into the image. Thus, you have to initialise a list of vpImageSimulator. Then you store them into a vpList. And finally with this method you project them into the image \f$ I \f$. The depth of the 3D scene is managed such as an image in foreground hides an image background.
+  With this method, a list of image is projected into the image. Thus, you have to initialise a list of vpImageSimulator. Then you store them into a vpList. And finally with this method you project them into the image \f$ I \f$. The depth of the 3D scene is managed such as an image in foreground hides an image background. This is done with a depth buffer: a pixel takes the value of the nearest image that covers it, and the pixels that are not covered by any image are left unchanged.
 
   The following example shows how to use the method:
 
@@ -731,106 +814,14 @@ vpImageSimulator::getImage(vpImage<unsigned char> &I,
                            std::list<vpImageSimulator> &list,
                            const vpCameraParameters &cam)
 {
-
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  unsigned int nbsimList = (unsigned int)list.size();
-
-  if (nbsimList < 1)
-    return;
-
-  vpImageSimulator** simList = new vpImageSimulator* [nbsimList];
-
-  double topFinal = height+1;;
-  double bottomFinal = -1;
-  double leftFinal = width+1;
-  double rightFinal = -1;
-
-  unsigned int unvisible = 0;
-  unsigned int indexSimu=0;
-  for(std::list<vpImageSimulator>::iterator it=list.begin(); it!=list.end(); ++it, ++indexSimu){
-    vpImageSimulator* sim = &(*it);
-    if (sim->visible)
-      simList[indexSimu] = sim;
-    else
-      unvisible++;
-  }
-  nbsimList = nbsimList - unvisible;
-
-   if (nbsimList < 1)
-   {
-     delete[] simList;
-     return;
-   }
-
-
-  for (unsigned int i = 0; i < nbsimList; i++)
-  {
-    if(!simList[i]->needClipping)
-        simList[i]->getRoi(width,height,cam,simList[i]->pt,simList[i]->rect);
-    else
-        simList[i]->getRoi(width,height,cam,simList[i]->ptClipped,simList[i]->rect);
-
-    if (topFinal > simList[i]->rect.getTop()) topFinal = simList[i]->rect.getTop();
-    if (bottomFinal < simList[i]->rect.getBottom()) bottomFinal = simList[i]->rect.getBottom();
-    if (leftFinal > simList[i]->rect.getLeft()) leftFinal = simList[i]->rect.getLeft();
-    if (rightFinal < simList[i]->rect.getRight()) rightFinal = simList[i]->rect.getRight();
-  }
-
-  double zmin = -1;
-  int indice = -1;
-  unsigned char *bitmap = I.bitmap;
-  vpImagePoint ip;
-
-  for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++)
-  {
-    for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++)
-    {
-      zmin = -1;
-      double x=0,y=0;
-      ip.set_ij(i,j);
-      vpPixelMeterConversion::convertPoint(cam,ip, x,y);
-      ip.set_ij(y,x);
-      for (int k = 0; k < (int)nbsimList; k++)
-      {
-  double z = 0;
-  if(simList[k]->getPixelDepth(ip,z))
-  {
-    if (z < zmin || zmin < 0)
-    {
-      zmin = z;
-      indice = k;
-    }
-  }
-      }
-      if (indice >= 0)
-      {
-        if (simList[indice]->colorI == GRAY_SCALED)
-        {
-    unsigned char Ipixelplan = 255;
-          simList[indice]->getPixel(ip,Ipixelplan);
-    *(bitmap+i*width+j)=Ipixelplan;
-        }
-        else if (simList[indice]->colorI == COLORED)
-        {
-    vpRGBa Ipixelplan(255,255,255);
-    simList[indice]->getPixel(ip,Ipixelplan);
-    unsigned char pixelgrey = (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-    *(bitmap+i*width+j)=pixelgrey;
-        }
-      }
-    }
-  }
-
-  delete[] simList;
+  rasterize(I, list, cam);
 }
 
 
 /*!
   Get the view of the virtual camera. Be carefull, the image I is modified. The projected image is not added as an overlay!
 
-  With this method, a list of image is projected into the image. Thus, you have to initialise a list of vpImageSimulator. Then you store them into a vpList. And finally with this method you project them into the image \f$ I \f$. The depth of the 3D scene is managed such as an image in foreground hides an image background.
+  With this method, a list of image is projected into the image. Thus, you have to initialise a list of vpImageSimulator. Then you store them into a vpList. And finally with this method you project them into the image \f$ I \f$. The depth of the 3D scene is managed such as an image in foreground hides an image background. This is done with a depth buffer: a pixel takes the value of the nearest image that covers it, and the pixels that are not covered by any image are left unchanged.
 
   The following example shows how to use the method:
 
@@ -933,103 +924,7 @@ vpImageSimulator::getImage(vpImage<vpRGBa> &I,
                            std::list<vpImageSimulator> &list,
                            const vpCameraParameters &cam)
 {
-
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  unsigned int nbsimList = (unsigned int)list.size();
-
-  if (nbsimList < 1)
-    return;
-
-  vpImageSimulator** simList = new vpImageSimulator* [nbsimList];
-
-  double topFinal = height+1;;
-  double bottomFinal = -1;
-  double leftFinal = width+1;
-  double rightFinal = -1;
-
-  unsigned int unvisible = 0;
-  unsigned int indexSimu = 0;
-  for(std::list<vpImageSimulator>::iterator it=list.begin(); it!=list.end(); ++it, ++indexSimu){
-    vpImageSimulator* sim = &(*it);
-    if (sim->visible)
-      simList[indexSimu] = sim;
-    else
-      unvisible++;
-  }
-
-  nbsimList = nbsimList - unvisible;
-
-   if (nbsimList < 1)
-   {
-     delete[] simList;
-     return;
-   }
-
-  for (unsigned int i = 0; i < nbsimList; i++)
-  {
-    if(!simList[i]->needClipping)
-        simList[i]->getRoi(width,height,cam,simList[i]->pt,simList[i]->rect);
-    else
-        simList[i]->getRoi(width,height,cam,simList[i]->ptClipped,simList[i]->rect);
-
-    if (topFinal > simList[i]->rect.getTop()) topFinal = simList[i]->rect.getTop();
-    if (bottomFinal < simList[i]->rect.getBottom()) bottomFinal = simList[i]->rect.getBottom();
-    if (leftFinal > simList[i]->rect.getLeft()) leftFinal = simList[i]->rect.getLeft();
-    if (rightFinal < simList[i]->rect.getRight()) rightFinal = simList[i]->rect.getRight();
-  }
-
-  double zmin = -1;
-  int indice = -1;
-  vpRGBa *bitmap = I.bitmap;
-  vpImagePoint ip;
-
-  for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++)
-  {
-    for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++)
-    {
-      zmin = -1;
-      double x=0,y=0;
-      ip.set_ij(i,j);
-      vpPixelMeterConversion::convertPoint(cam,ip, x,y);
-      ip.set_ij(y,x);
-      for (int k = 0; k < (int)nbsimList; k++)
-      {
-  double z = 0;
-  if(simList[k]->getPixelDepth(ip,z))
-  {
-    if (z < zmin || zmin < 0)
-    {
-      zmin = z;
-      indice = k;
-    }
-  }
-      }
-      if (indice >= 0)
-      {
-        if (simList[indice]->colorI == GRAY_SCALED)
-        {
-    unsigned char Ipixelplan = 255;
-          simList[indice]->getPixel(ip,Ipixelplan);
-    vpRGBa pixelcolor;
-    pixelcolor.R = Ipixelplan;
-    pixelcolor.G = Ipixelplan;
-    pixelcolor.B = Ipixelplan;
-    *(bitmap+i*width+j) = pixelcolor;
-        }
-        else if (simList[indice]->colorI == COLORED)
-        {
-    vpRGBa Ipixelplan(255,255,255);
-    simList[indice]->getPixel(ip,Ipixelplan);
-    //unsigned char pixelgrey = 0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B;
-    *(bitmap+i*width+j)=Ipixelplan;
-        }
-      }
-    }
-  }
-
-  delete[] simList;
+  rasterize(I, list, cam);
 }
 
 /*!
@@ -1089,6 +984,12 @@ vpImageSimulator::setCameraPosition(const vpHomogeneousMatrix &cMt_)
     vbase_v = X2[3]-X2[0];
 
     distance = vpColVector::dotProd(normal_Cam,X2[1]);
+
+    // With a rectangle, a pixel whose texture coordinates are in ]0,1[ is
+    // inside the projected plane and the triangles test can be skipped
+    vpColVector diagonal = X2[2] - X2[0] - vbase_u - vbase_v;
+    rectangularPlan = std::fabs(vpColVector::dotProd(vbase_u, vbase_v)) <= 1e-9 * euclideanNorm_u * euclideanNorm_v
+        && diagonal.euclideanNorm() <= 1e-9 * (euclideanNorm_u + euclideanNorm_v);
     
 
     if(distance < 0)
@@ -62,7 +62,8 @@ vpRobotWireFrameSimulator::vpRobotWireFrameSimulator()
     display(),
 #endif
     displayType(MODEL_3D), displayAllowed(true), constantSamplingTimeMode(false),
-    setVelocityCalled(false), verbose_(false)
+    setVelocityCalled(false), verbose_(false), lockStepMode(false), simulationTime(0),
+    simulationThreadRunning(false)
 {
   setSamplingTime(0.010);
   velocity.resize(6);
@@ -94,7 +95,8 @@ vpRobotWireFrameSimulator::vpRobotWireFrameSimulator(bool do_display)
     display(),
 #endif
     displayType(MODEL_3D), displayAllowed(do_display), constantSamplingTimeMode(false),
-    setVelocityCalled(false), verbose_(false)
+    setVelocityCalled(false), verbose_(false), lockStepMode(false), simulationTime(0),
+    simulationThreadRunning(false)
 {
   setSamplingTime(0.010);
   velocity.resize(6);
@@ -354,6 +356,160 @@ vpRobotWireFrameSimulator::getInternalView(vpImage<unsigned char> &I_)
   set_displayBusy(false);
 }
 
+/*!
+  Enable or disable the lock-step mode.
+
+  In lock-step mode, the thread that computes the robot displacement in real
+  time is stopped. The simulated time is only advanced when step() is called:
+  the velocity set with setVelocity() is then integrated over exactly one
+  sampling time, without any sleep. The simulation is thus reproducible and
+  runs as fast as possible. The positioning methods (setPosition()) also
+  advance the simulated time until the position is reached.
+
+  When the lock-step mode is disabled, the thread is restarted and the
+  simulation runs again in real time.
+
+  \param lockStep : true to enable the lock-step mode, false to come back to
+  the real time simulation.
+
+  \sa step(), getSimulationTime()
+*/
+void
+vpRobotWireFrameSimulator::setLockStepMode(const bool lockStep)
+{
+  if(lockStep == lockStepMode)
+    return;
+
+  if(lockStep){
+    stopSimulationThread();
+    simulationTime = 0;
+    lockStepMode = true;
+  }
+  else{
+    lockStepMode = false;
+    setSamplingTime(getSamplingTime()); // Restore the minimal sampling time of the thread
+    tcur = vpTime::measureTimeMs();
+    startSimulationThread();
+  }
+}
+
+/*!
+  Advance the simulated time in lock-step mode. For each step, the velocity
+  applied to the robot is integrated over one sampling time (see
+  setSamplingTime()). The external view is then updated once, if the display
+  is enabled.
+
+  \param nbSteps : Number of sampling times to simulate.
+
+  \exception vpRobotException::wrongStateError : If the lock-step mode is not
+  enabled; see setLockStepMode().
+*/
+void
+vpRobotWireFrameSimulator::step(const unsigned int nbSteps)
+{
+  if(!lockStepMode){
+    throw vpRobotException(vpRobotException::wrongStateError,
+                           "Cannot step the simulator: the lock-step mode is not enabled");
+  }
+
+  for(unsigned int i = 0; i < nbSteps; i++)
+    computeLockStep();
+
+  if(displayAllowed && nbSteps > 0)
+    updateExternalView();
+}
+
+/*!
+  Integrate the velocity applied to the robot over one sampling time,
+  without updating the external view. Used in lock-step mode.
+
+  \param updateVelocity : When true, the articular velocity is first computed
+  from the velocity set with setVelocity(). When false, the articular velocity
+  set by the positioning methods is integrated as is.
+*/
+void
+vpRobotWireFrameSimulator::computeLockStep(const bool updateVelocity)
+{
+  setVelocityCalled = false;
+  if (updateVelocity)
+    computeArticularVelocity();
+  integrateArticularVelocity(getSamplingTime());
+  simulationTime += getSamplingTime();
+}
+
+/*!
+  Update the articular position of the robot from the articular velocity
+  applied during \e dt, taking the joint limits into account.
+  Has to be redefined by the robot simulators.
+
+  \param dt : Integration time in seconds.
+*/
+void
+vpRobotWireFrameSimulator::integrateArticularVelocity(const double &/*dt*/)
+{
+  throw vpException(vpException::functionNotImplementedError,
+                    "integrateArticularVelocity() is not implemented for this robot simulator");
+}
+
+/*!
+  Update the external view of the robot. Has to be redefined by the robot
+  simulators.
+*/
+void
+vpRobotWireFrameSimulator::updateExternalView()
+{
+}
+
+/*!
+  Start the thread that computes the robot displacement in real time.
+*/
+void
+vpRobotWireFrameSimulator::startSimulationThread()
+{
+  if(simulationThreadRunning)
+    return;
+
+  robotStop = false;
+#if defined(_WIN32)
+  DWORD   dwThreadIdArray;
+  hThread = CreateThread(
+            NULL,                   // default security attributes
+            0,                      // use default stack size
+            launcher,               // thread function name
+            this,                   // argument to thread function
+            0,                      // use default creation flags
+            &dwThreadIdArray);      // returns the thread identifier
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_create(&thread, NULL, launcher, (void *)this);
+#endif
+  simulationThreadRunning = true;
+}
+
+/*!
+  Stop the thread that computes the robot displacement in real time and wait
+  for its end.
+*/
+void
+vpRobotWireFrameSimulator::stopSimulationThread()
+{
+  if(!simulationThreadRunning)
+    return;
+
+  robotStop = true;
+#if defined(_WIN32)
+#  if defined(WINRT_8_1)
+  WaitForSingleObjectEx(hThread, INFINITE, FALSE);
+#  else // pure win32
+  WaitForSingleObject(hThread, INFINITE);
+#  endif
+  CloseHandle(hThread);
+#elif defined(VISP_HAVE_PTHREAD)
+  pthread_join(thread, NULL);
+#endif
+  robotStop = false;
+  simulationThreadRunning = false;
+}
+
 /*!
   Get the pose between the object and the robot's camera.
      
@@ -85,14 +85,6 @@ vpSimulatorAfma6::vpSimulatorAfma6()
   mutex_display = CreateMutex(NULL,FALSE,NULL);
 #endif
 
-  DWORD   dwThreadIdArray;
-  hThread = CreateThread( 
-            NULL,                   // default security attributes
-            0,                      // use default stack size  
-			launcher,               // thread function name
-            this,                   // argument to thread function 
-            0,                      // use default creation flags 
-            &dwThreadIdArray);     // returns the thread identifier 
   #elif defined (VISP_HAVE_PTHREAD)
   pthread_mutex_init(&mutex_fMi, NULL);
   pthread_mutex_init(&mutex_artVel, NULL);
@@ -102,10 +94,10 @@ vpSimulatorAfma6::vpSimulatorAfma6()
   
   pthread_attr_init(&attr);
   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-  
-  pthread_create(&thread, NULL, launcher, (void *)this);
   #endif
   
+  startSimulationThread();
+
   compute_fMi();
 }
 
@@ -140,14 +132,6 @@ vpSimulatorAfma6::vpSimulatorAfma6(bool do_display)
   mutex_display = CreateMutex(NULL, FALSE, NULL);
 #endif
 
-  DWORD   dwThreadIdArray;
-  hThread = CreateThread( 
-            NULL,                   // default security attributes
-            0,                      // use default stack size  
-			launcher,               // thread function name
-            this,                   // argument to thread function 
-            0,                      // use default creation flags 
-            &dwThreadIdArray);      // returns the thread identifier 
   #elif defined(VISP_HAVE_PTHREAD)
   pthread_mutex_init(&mutex_fMi, NULL);
   pthread_mutex_init(&mutex_artVel, NULL);
@@ -157,10 +141,10 @@ vpSimulatorAfma6::vpSimulatorAfma6(bool do_display)
   
   pthread_attr_init(&attr);
   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-  
-  pthread_create(&thread, NULL, launcher, (void *)this);
   #endif
   
+  startSimulationThread();
+
   compute_fMi();
 }
 
@@ -169,15 +153,9 @@ vpSimulatorAfma6::vpSimulatorAfma6(bool do_display)
 */
 vpSimulatorAfma6::~vpSimulatorAfma6()
 {
-  robotStop = true;
+  stopSimulationThread();
   
   #if defined(_WIN32)
-#  if defined(WINRT_8_1)
-  WaitForSingleObjectEx(hThread, INFINITE, FALSE);
-#  else // pure win32
-  WaitForSingleObject(hThread, INFINITE);
-#  endif
-  CloseHandle(hThread);
   CloseHandle(mutex_fMi);
   CloseHandle(mutex_artVel);
   CloseHandle(mutex_artCoord);
@@ -185,7 +163,6 @@ vpSimulatorAfma6::~vpSimulatorAfma6()
   CloseHandle(mutex_display);
   #elif defined(VISP_HAVE_PTHREAD)
   pthread_attr_destroy(&attr);
-  pthread_join(thread, NULL);
   pthread_mutex_destroy(&mutex_fMi);
   pthread_mutex_destroy(&mutex_artVel);
   pthread_mutex_destroy(&mutex_artCoord);
@@ -538,105 +515,128 @@ vpSimulatorAfma6::updateArticularPosition()
         ellapsedTime = getSamplingTime(); // in second
       }
     
-      vpColVector articularCoordinates = get_artCoord();
-      vpColVector articularVelocities = get_artVel();
-    
-      if (jointLimit)
-      {
-        double art = articularCoordinates[jointLimitArt-1] + ellapsedTime*articularVelocities[jointLimitArt-1];
-        if (art <= _joint_min[jointLimitArt-1] || art >= _joint_max[jointLimitArt-1]) {
-          if (verbose_) {
-            std::cout << "Joint " << jointLimitArt-1
-                    << " reaches a limit: " << vpMath::deg(_joint_min[jointLimitArt-1]) << " < "
-                    << vpMath::deg(art) << " < " << vpMath::deg(_joint_max[jointLimitArt-1]) << std::endl;
-          }
+      integrateArticularVelocity(ellapsedTime);
 
-          articularVelocities = 0.0;
-        }
-        else
-          jointLimit = false;
-      }
-    
-      articularCoordinates[0] = articularCoordinates[0] + ellapsedTime*articularVelocities[0];
-      articularCoordinates[1] = articularCoordinates[1] + ellapsedTime*articularVelocities[1];
-      articularCoordinates[2] = articularCoordinates[2] + ellapsedTime*articularVelocities[2];
-      articularCoordinates[3] = articularCoordinates[3] + ellapsedTime*articularVelocities[3];
-      articularCoordinates[4] = articularCoordinates[4] + ellapsedTime*articularVelocities[4];
-      articularCoordinates[5] = articularCoordinates[5] + ellapsedTime*articularVelocities[5];
-      
-      int jl = isInJointLimit();
-      
-      if (jl != 0 && jointLimit == false)
-      {
-        if (jl < 0)
-          ellapsedTime = (_joint_min[(unsigned int)(-jl-1)] - articularCoordinates[(unsigned int)(-jl-1)])/(articularVelocities[(unsigned int)(-jl-1)]);
-        else
-          ellapsedTime = (_joint_max[(unsigned int)(jl-1)] - articularCoordinates[(unsigned int)(jl-1)])/(articularVelocities[(unsigned int)(jl-1)]);
-      
-        for (unsigned int i = 0; i < 6; i++)
-          articularCoordinates[i] = articularCoordinates[i] + ellapsedTime*articularVelocities[i];
-      
-        jointLimit = true;
-        jointLimitArt = (unsigned int)fabs((double)jl);
-      }
+      updateExternalView();
 
-      set_artCoord(articularCoordinates);
-      set_artVel(articularVelocities);
-    
-      compute_fMi();
-   
-      if (displayAllowed)
-      {
-        vpDisplay::display(I);
-        vpDisplay::displayFrame(I,getExternalCameraPosition (),cameraParam,0.2,vpColor::none, thickness_);
-        vpDisplay::displayFrame(I,getExternalCameraPosition ()*fMi[7],cameraParam,0.1,vpColor::none, thickness_);
-      }
-    
-      if (displayType == MODEL_3D && displayAllowed)
-      {
-        while (get_displayBusy()) vpTime::wait(2);
-        vpSimulatorAfma6::getExternalImage(I);
-        set_displayBusy(false);
+      vpTime::wait( tcur, 1000*getSamplingTime() );
+      tcur_1 = tcur;
+    }else{
+      vpTime::wait(tcur, vpTime::getMinTimeForUsleepCall());
+    }
+  }
+}
+
+/*!
+  Update the articular position of the robot from the articular velocity
+  applied during \e dt, and stop the robot when a joint limit is
+  reached.
+
+  \param dt : Integration time in seconds.
+*/
+void
+vpSimulatorAfma6::integrateArticularVelocity(const double &dt)
+{
+  double ellapsedTime = dt;
+
+  vpColVector articularCoordinates = get_artCoord();
+  vpColVector articularVelocities = get_artVel();
+
+  if (jointLimit)
+  {
+    double art = articularCoordinates[jointLimitArt-1] + ellapsedTime*articularVelocities[jointLimitArt-1];
+    if (art <= _joint_min[jointLimitArt-1] || art >= _joint_max[jointLimitArt-1]) {
+      if (verbose_) {
+        std::cout << "Joint " << jointLimitArt-1
+                << " reaches a limit: " << vpMath::deg(_joint_min[jointLimitArt-1]) << " < "
+                << vpMath::deg(art) << " < " << vpMath::deg(_joint_max[jointLimitArt-1]) << std::endl;
       }
-        
+
+      articularVelocities = 0.0;
+    }
+    else
+      jointLimit = false;
+  }
+
+  articularCoordinates[0] = articularCoordinates[0] + ellapsedTime*articularVelocities[0];
+  articularCoordinates[1] = articularCoordinates[1] + ellapsedTime*articularVelocities[1];
+  articularCoordinates[2] = articularCoordinates[2] + ellapsedTime*articularVelocities[2];
+  articularCoordinates[3] = articularCoordinates[3] + ellapsedTime*articularVelocities[3];
+  articularCoordinates[4] = articularCoordinates[4] + ellapsedTime*articularVelocities[4];
+  articularCoordinates[5] = articularCoordinates[5] + ellapsedTime*articularVelocities[5];
+  
+  int jl = isInJointLimit();
+  
+  if (jl != 0 && jointLimit == false)
+  {
+    if (jl < 0)
+      ellapsedTime = (_joint_min[(unsigned int)(-jl-1)] - articularCoordinates[(unsigned int)(-jl-1)])/(articularVelocities[(unsigned int)(-jl-1)]);
+    else
+      ellapsedTime = (_joint_max[(unsigned int)(jl-1)] - articularCoordinates[(unsigned int)(jl-1)])/(articularVelocities[(unsigned int)(jl-1)]);
+  
+    for (unsigned int i = 0; i < 6; i++)
+      articularCoordinates[i] = articularCoordinates[i] + ellapsedTime*articularVelocities[i];
+  
+    jointLimit = true;
+    jointLimitArt = (unsigned int)fabs((double)jl);
+  }
+
+  set_artCoord(articularCoordinates);
+  set_artVel(articularVelocities);
+
+  compute_fMi();
+}
+
+/*!
+  Display the robot in the external view, if the display is enabled.
+*/
+void
+vpSimulatorAfma6::updateExternalView()
+{
+  if (displayAllowed)
+  {
+    vpDisplay::display(I);
+    vpDisplay::displayFrame(I,getExternalCameraPosition (),cameraParam,0.2,vpColor::none, thickness_);
+    vpDisplay::displayFrame(I,getExternalCameraPosition ()*fMi[7],cameraParam,0.1,vpColor::none, thickness_);
+  }
+
+  if (displayType == MODEL_3D && displayAllowed)
+  {
+    while (get_displayBusy()) vpTime::wait(2);
+    vpSimulatorAfma6::getExternalImage(I);
+    set_displayBusy(false);
+  }
     
-      if (0/*displayType == MODEL_DH && displayAllowed*/)
-      {
-        vpHomogeneousMatrix fMit[8];
-        get_fMi(fMit);
-      
-      //vpDisplay::displayFrame(I,getExternalCameraPosition ()*fMi[6],cameraParam,0.2,vpColor::none);
 
-        vpImagePoint iP, iP_1;
-        vpPoint pt(0,0,0);
-      
-        pt.track(getExternalCameraPosition ());
-        vpMeterPixelConversion::convertPoint (cameraParam, pt.get_x(), pt.get_y(), iP_1);
-        pt.track(getExternalCameraPosition ()*fMit[0]);
-        vpMeterPixelConversion::convertPoint (cameraParam, pt.get_x(), pt.get_y(), iP);
-        vpDisplay::displayLine(I,iP_1,iP,vpColor::green, thickness_);
-        for (unsigned int k = 1; k < 7; k++)
-        {
-          pt.track(getExternalCameraPosition ()*fMit[k-1]);
-          vpMeterPixelConversion::convertPoint (cameraParam, pt.get_x(), pt.get_y(), iP_1);
-        
-          pt.track(getExternalCameraPosition ()*fMit[k]);
-          vpMeterPixelConversion::convertPoint (cameraParam, pt.get_x(), pt.get_y(), iP);
-        
-          vpDisplay::displayLine(I,iP_1,iP,vpColor::green, thickness_);
-        }
-        vpDisplay::displayCamera(I,getExternalCameraPosition ()*fMit[7],cameraParam,0.1,vpColor::green, thickness_);
-      }
+  if (0/*displayType == MODEL_DH && displayAllowed*/)
+  {
+    vpHomogeneousMatrix fMit[8];
+    get_fMi(fMit);
+  
+  //vpDisplay::displayFrame(I,getExternalCameraPosition ()*fMi[6],cameraParam,0.2,vpColor::none);
+
+    vpImagePoint iP, iP_1;
+    vpPoint pt(0,0,0);
+  
+    pt.track(getExternalCameraPosition ());
+    vpMeterPixelConversion::convertPoint (cameraParam, pt.get_x(), pt.get_y(), iP_1);
+    pt.track(getExternalCameraPosition ()*fMit[0]);
+    vpMeterPixelConversion::convertPoint (cameraParam, pt.get_x(), pt.get_y(), iP);
+    vpDisplay::displayLine(I,iP_1,iP,vpColor::green, thickness_);
+    for (unsigned int k = 1; k < 7; k++)
+    {
+      pt.track(getExternalCameraPosition ()*fMit[k-1]);
+      vpMeterPixelConversion::convertPoint (cameraParam, pt.get_x(), pt.get_y(), iP_1);
     
-      vpDisplay::flush(I);
+      pt.track(getExternalCameraPosition ()*fMit[k]);
+      vpMeterPixelConversion::convertPoint (cameraParam, pt.get_x(), pt.get_y(), iP);
     
-      
-      vpTime::wait( tcur, 1000*getSamplingTime() );
-      tcur_1 = tcur;
-    }else{
-      vpTime::wait(tcur, vpTime::getMinTimeForUsleepCall());
+      vpDisplay::displayLine(I,iP_1,iP,vpColor::green, thickness_);
     }
+    vpDisplay::displayCamera(I,getExternalCameraPosition ()*fMit[7],cameraParam,0.1,vpColor::green, thickness_);
   }
+
+  vpDisplay::flush(I);
 }
 
 /*!
@@ -1191,7 +1191,7 @@ vpSimulatorAfma6::getVelocity (const vpRobot::vpControlFrameType frame, vpColVec
 void
 vpSimulatorAfma6::getVelocity (const vpRobot::vpControlFrameType frame, vpColVector & vel, double &timestamp)
 {
-  timestamp = vpTime::measureTimeSecond();
+  timestamp = lockStepMode ? simulationTime : vpTime::measureTimeSecond();
   getVelocity(frame, vel);
 }
 
@@ -1261,7 +1261,7 @@ vpSimulatorAfma6::getVelocity (vpRobot::vpControlFrameType frame)
 vpColVector
 vpSimulatorAfma6::getVelocity (vpRobot::vpControlFrameType frame, double &timestamp)
 {
-  timestamp = vpTime::measureTimeSecond();
+  timestamp = lockStepMode ? simulationTime : vpTime::measureTimeSecond();
   vpColVector vel(6);
   getVelocity (frame, vel);
 
@@ -1421,6 +1421,8 @@ vpSimulatorAfma6::setPosition(const vpRobot::vpControlFrameType frame,const vpCo
           throw vpRobotException (vpRobotException::positionOutOfRangeError,
 			    "Position out of range.");
         }
+        if (lockStepMode)
+          computeLockStep(false);
       }while (errsqr > 1e-8 && nbSol > 0);
 
       break ;
@@ -1444,6 +1446,8 @@ vpSimulatorAfma6::setPosition(const vpRobot::vpControlFrameType frame,const vpCo
           set_velocity(error);
           break;
         }
+        if (lockStepMode)
+          computeLockStep(false);
       }while (errsqr > 1e-8);
       break ;
     }
@@ -1487,6 +1491,8 @@ vpSimulatorAfma6::setPosition(const vpRobot::vpControlFrameType frame,const vpCo
         }
         else
           vpERROR_TRACE ("Positionning error. Position unreachable");
+        if (lockStepMode)
+          computeLockStep(false);
       }while (errsqr > 1e-8 && nbSol > 0);
       break ;
     }
@@ -1777,7 +1783,7 @@ vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame, vpColVect
 void
 vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame, vpColVector &q, double &timestamp)
 {
-  timestamp = vpTime::measureTimeSecond();
+  timestamp = lockStepMode ? simulationTime : vpTime::measureTimeSecond();
   getPosition(frame, q);
 }
 
@@ -1824,7 +1830,7 @@ void
 vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame,
                                  vpPoseVector &position, double &timestamp)
 {
-  timestamp = vpTime::measureTimeSecond();
+  timestamp = lockStepMode ? simulationTime : vpTime::measureTimeSecond();
   getPosition(frame, position);
 }
 
@@ -2604,7 +2610,10 @@ vpSimulatorAfma6::setPosition(const vpHomogeneousMatrix &cdMo_, vpImage<unsigned
 		setVelocity(vpRobot::CAMERA_FRAME,vel);
 
 		// wait for it
-		vpTime::wait(t,10);
+		if (lockStepMode)
+			step();
+		else
+			vpTime::wait(t,10);
 		}
 	vel=0.;
 	set_velocity(vel);
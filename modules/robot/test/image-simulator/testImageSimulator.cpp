@@ -0,0 +1,354 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the rasterization of vpImageSimulator.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageSimulator.cpp
+
+  Test the rasterization of vpImageSimulator: the images given by the
+  different getImage() methods have to be the same as the ones obtained by
+  intersecting the ray of each pixel with the textured planes, and the depth
+  buffer of the multi-plane method has to give the same image as successive
+  calls to getImage() with a z-buffer.
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <stdlib.h>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/robot/vpImageSimulator.h>
+
+namespace {
+  // Textured plane and its pose, with the reference ray casting of a pixel
+  struct Plane {
+    vpColVector X[4];
+    vpHomogeneousMatrix cMt;
+    vpImage<vpRGBa> texture;
+
+    // Return true if the ray of the pixel (i, j) hits the plane. In that case
+    // give the depth and the texture pixel.
+    bool rayCast(const vpCameraParameters &cam, unsigned int i, unsigned int j,
+                 vpImageSimulator::vpInterpolationType interp, double &z, vpRGBa &value) const
+    {
+      vpRotationMatrix R;
+      cMt.extract(R);
+      vpColVector normal = vpColVector::crossProd(X[1]-X[0], X[3]-X[0]);
+      normal = R * (normal / normal.euclideanNorm());
+      vpColVector X2[4];
+      for (unsigned int k = 0; k < 4; k++) {
+        vpColVector XH(4);
+        for (unsigned int l = 0; l < 3; l++)
+          XH[l] = X[k][l];
+        XH[3] = 1.;
+        vpColVector cXH = cMt * XH;
+        X2[k].resize(3);
+        for (unsigned int l = 0; l < 3; l++)
+          X2[k][l] = cXH[l] / cXH[3];
+      }
+      vpColVector vbase_u = X2[1] - X2[0];
+      vpColVector vbase_v = X2[3] - X2[0];
+      double norm_u = (X[1] - X[0]).euclideanNorm();
+      double norm_v = (X[3] - X[0]).euclideanNorm();
+      double distance = vpColVector::dotProd(normal, X2[1]);
+
+      double x = 0, y = 0;
+      vpPixelMeterConversion::convertPoint(cam, (double)j, (double)i, x, y);
+      z = distance/(normal[0]*x+normal[1]*y+normal[2]);
+      double Xinter[3] = { x*z, y*z, z };
+      double u = 0, v = 0;
+      for (unsigned int k = 0; k < 3; k++) {
+        double diff = (Xinter[k]-X2[0][k]);
+        u += diff*vbase_u[k];
+        v += diff*vbase_v[k];
+      }
+      u = u/(norm_u*norm_u);
+      v = v/(norm_v*norm_v);
+      if (!(u > 0 && v > 0 && u < 1. && v < 1.))
+        return false;
+
+      double i2 = v*(texture.getHeight()-1);
+      double j2 = u*(texture.getWidth()-1);
+      if (interp == vpImageSimulator::BILINEAR_INTERPOLATION)
+        value = texture.getValue(i2, j2);
+      else
+        value = texture[(unsigned int)i2][(unsigned int)j2];
+      return true;
+    }
+
+    // Region of interest of the plane in an image of size width x height
+    void getRoi(const vpCameraParameters &cam, unsigned int width, unsigned int height,
+                unsigned int &top, unsigned int &bottom, unsigned int &left, unsigned int &right) const
+    {
+      double vmin = height+1, vmax = -1, umin = width+1, umax = -1;
+      for (unsigned int k = 0; k < 4; k++) {
+        vpPoint P(X[k][0], X[k][1], X[k][2]);
+        P.track(cMt);
+        double u, v;
+        vpMeterPixelConversion::convertPoint(cam, P.get_x(), P.get_y(), u, v);
+        vmin = std::min(vmin, v);
+        vmax = std::max(vmax, v);
+        umin = std::min(umin, u);
+        umax = std::max(umax, u);
+      }
+      top = (unsigned int)vpMath::maximum(0., vpMath::minimum(vmin, height - 1.));
+      bottom = (unsigned int)vpMath::maximum(0., vpMath::minimum(vmax, height - 1.));
+      left = (unsigned int)vpMath::maximum(0., vpMath::minimum(umin, width - 1.));
+      right = (unsigned int)vpMath::maximum(0., vpMath::minimum(umax, width - 1.));
+    }
+
+    void init(vpImageSimulator &sim, vpImageSimulator::vpInterpolationType interp) const
+    {
+      vpColVector corners[4];
+      for (unsigned int k = 0; k < 4; k++)
+        corners[k] = X[k];
+      sim.init(texture, corners);
+      sim.setInterpolationType(interp);
+      sim.setCameraPosition(cMt);
+    }
+  };
+
+  Plane createPlane(double width, double height, const vpHomogeneousMatrix &cMt, unsigned int seed)
+  {
+    Plane plane;
+    double corners[4][2] = { {-1, -1}, {1, -1}, {1, 1}, {-1, 1} };
+    for (unsigned int k = 0; k < 4; k++) {
+      plane.X[k].resize(3);
+      plane.X[k][0] = corners[k][0] * width / 2;
+      plane.X[k][1] = corners[k][1] * height / 2;
+      plane.X[k][2] = 0;
+    }
+    plane.cMt = cMt;
+    plane.texture.resize(64, 96);
+    for (unsigned int i = 0; i < plane.texture.getHeight(); i++) {
+      for (unsigned int j = 0; j < plane.texture.getWidth(); j++) {
+        plane.texture[i][j] = vpRGBa((unsigned char)((i * 7 + j * 3 + seed * 50) % 256),
+                                     (unsigned char)((i * j + seed * 20) % 256),
+                                     (unsigned char)(((i / 8 + j / 8) % 2) * 200 + seed));
+      }
+    }
+    return plane;
+  }
+
+  unsigned char toGrey(const vpRGBa &rgba)
+  {
+    return (unsigned char)(0.2126 * rgba.R + 0.7152 * rgba.G + 0.0722 * rgba.B);
+  }
+
+  // Reference image of a list of planes, the nearest plane being kept. Like
+  // vpImageSimulator, a plane is only drawn in its region of interest.
+  void rayCast(const std::vector<Plane> &planes, const vpCameraParameters &cam,
+               vpImageSimulator::vpInterpolationType interp, vpImage<vpRGBa> &I)
+  {
+    vpImage<double> zBuffer(I.getHeight(), I.getWidth(), -1);
+    for (size_t k = 0; k < planes.size(); k++) {
+      unsigned int top, bottom, left, right;
+      planes[k].getRoi(cam, I.getWidth(), I.getHeight(), top, bottom, left, right);
+      for (unsigned int i = top; i < bottom; i++) {
+        for (unsigned int j = left; j < right; j++) {
+          double z;
+          vpRGBa value;
+          if (planes[k].rayCast(cam, i, j, interp, z, value) && (z < zBuffer[i][j] || zBuffer[i][j] < 0)) {
+            zBuffer[i][j] = z;
+            I[i][j] = value;
+          }
+        }
+      }
+    }
+  }
+
+  bool compare(const vpImage<vpRGBa> &I, const vpImage<vpRGBa> &Iref, const std::string &name)
+  {
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        const vpRGBa &a = I[i][j], &b = Iref[i][j];
+        if (a.R != b.R || a.G != b.G || a.B != b.B || a.A != b.A) {
+          std::cerr << name << ": bad pixel (" << i << ", " << j << ")" << std::endl;
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool compare(const vpImage<unsigned char> &I, const vpImage<vpRGBa> &Iref, const std::string &name)
+  {
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        if (I[i][j] != toGrey(Iref[i][j])) {
+          std::cerr << name << ": bad pixel (" << i << ", " << j << ")" << std::endl;
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool testSinglePlane(const vpCameraParameters &cam, vpImageSimulator::vpInterpolationType interp)
+  {
+    std::vector<Plane> planes;
+    planes.push_back(createPlane(0.4, 0.3, vpHomogeneousMatrix(0.02, -0.03, 0.6, vpMath::rad(20), vpMath::rad(-35), vpMath::rad(15)), 1));
+
+    vpImage<vpRGBa> Iref(240, 320, vpRGBa(10, 20, 30));
+    rayCast(planes, cam, interp, Iref);
+
+    vpImageSimulator sim(vpImageSimulator::COLORED);
+    planes[0].init(sim, interp);
+
+    vpImage<vpRGBa> I(240, 320, vpRGBa(10, 20, 30));
+    sim.getImage(I, cam);
+    if (!compare(I, Iref, "getImage(vpRGBa)"))
+      return false;
+
+    vpImage<unsigned char> Ig(240, 320, toGrey(vpRGBa(10, 20, 30)));
+    sim.getImage(Ig, cam);
+    if (!compare(Ig, Iref, "getImage(unsigned char)"))
+      return false;
+
+    vpImage<vpRGBa> Isrc = planes[0].texture;
+    I = vpRGBa(10, 20, 30);
+    sim.getImage(I, Isrc, cam);
+    if (!compare(I, Iref, "getImage(vpRGBa, Isrc)"))
+      return false;
+
+    return true;
+  }
+
+  bool testSeveralPlanes(const vpCameraParameters &cam, vpImageSimulator::vpInterpolationType interp)
+  {
+    std::vector<Plane> planes;
+    // A plane seen from behind is not visible
+    planes.push_back(createPlane(0.5, 0.5, vpHomogeneousMatrix(0, 0, 0.5, vpMath::rad(180), 0, 0), 0));
+    planes.push_back(createPlane(0.6, 0.4, vpHomogeneousMatrix(0, 0, 1.0, vpMath::rad(10), vpMath::rad(20), 0), 1));
+    planes.push_back(createPlane(0.3, 0.3, vpHomogeneousMatrix(0.05, 0.02, 0.7, vpMath::rad(-30), 0, vpMath::rad(40)), 2));
+    planes.push_back(createPlane(0.4, 0.2, vpHomogeneousMatrix(-0.1, 0.05, 0.8, 0, vpMath::rad(60), 0), 3));
+    planes.push_back(createPlane(2.0, 2.0, vpHomogeneousMatrix(0, 0, 1.5, 0, 0, 0), 4));
+
+    vpImage<vpRGBa> Iref(240, 320, vpRGBa(10, 20, 30));
+    rayCast(std::vector<Plane>(planes.begin() + 1, planes.end()), cam, interp, Iref);
+
+    std::list<vpImageSimulator> listSim;
+    for (size_t k = 0; k < planes.size(); k++) {
+      vpImageSimulator sim(vpImageSimulator::COLORED);
+      planes[k].init(sim, interp);
+      listSim.push_back(sim);
+    }
+
+    vpImage<vpRGBa> I(240, 320, vpRGBa(10, 20, 30));
+    double t = vpTime::measureTimeMs();
+    vpImageSimulator::getImage(I, listSim, cam);
+    std::cout << "getImage() with " << planes.size() << " planes: " << vpTime::measureTimeMs() - t << " ms" << std::endl;
+    if (!compare(I, Iref, "getImage(vpRGBa, list)"))
+      return false;
+
+    vpImage<unsigned char> Ig(240, 320, toGrey(vpRGBa(10, 20, 30)));
+    vpImageSimulator::getImage(Ig, listSim, cam);
+    if (!compare(Ig, Iref, "getImage(unsigned char, list)"))
+      return false;
+
+    // Successive calls with a z-buffer give the same image
+    vpMatrix zBuffer(240, 320);
+    zBuffer = -1;
+    I = vpRGBa(10, 20, 30);
+    for (std::list<vpImageSimulator>::iterator it = listSim.begin(); it != listSim.end(); ++it)
+      it->getImage(I, cam, zBuffer);
+    if (!compare(I, Iref, "getImage(vpRGBa, zBuffer)"))
+      return false;
+
+    zBuffer = -1;
+    Ig = toGrey(vpRGBa(10, 20, 30));
+    for (std::list<vpImageSimulator>::iterator it = listSim.begin(); it != listSim.end(); ++it)
+      it->getImage(Ig, cam, zBuffer);
+    if (!compare(Ig, Iref, "getImage(unsigned char, zBuffer)"))
+      return false;
+
+    return true;
+  }
+  // A plane which goes behind the camera is clipped: the drawn pixels have to
+  // be the ones of the ray casting
+  bool testClippedPlane(const vpCameraParameters &cam, vpImageSimulator::vpInterpolationType interp)
+  {
+    Plane plane = createPlane(4., 4., vpHomogeneousMatrix(0, 0.3, 1.0, vpMath::rad(-80), 0, 0), 5);
+    vpImageSimulator sim(vpImageSimulator::COLORED);
+    plane.init(sim, interp);
+
+    const vpRGBa background(0, 0, 255);
+    vpImage<vpRGBa> I(240, 320, background);
+    sim.getImage(I, cam);
+
+    unsigned int nbDrawn = 0;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        if (I[i][j].B == background.B)
+          continue;
+        double z;
+        vpRGBa value;
+        if (!plane.rayCast(cam, i, j, interp, z, value) || value.R != I[i][j].R || value.G != I[i][j].G
+            || value.B != I[i][j].B) {
+          std::cerr << "Clipped plane: bad pixel (" << i << ", " << j << ")" << std::endl;
+          return false;
+        }
+        nbDrawn++;
+      }
+    }
+    if (nbDrawn < I.getSize() / 4) {
+      std::cerr << "Clipped plane: only " << nbDrawn << " pixels are drawn" << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    vpCameraParameters cam(300, 310, 158, 123);
+    vpImageSimulator::vpInterpolationType interps[2] = { vpImageSimulator::SIMPLE,
+                                                         vpImageSimulator::BILINEAR_INTERPOLATION };
+    for (unsigned int k = 0; k < 2; k++) {
+      if (!testSinglePlane(cam, interps[k]) || !testSeveralPlanes(cam, interps[k]) || !testClippedPlane(cam, interps[k]))
+        return EXIT_FAILURE;
+    }
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testImageSimulator is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
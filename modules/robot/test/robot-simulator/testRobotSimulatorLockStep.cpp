@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the lock-step mode of the Afma6 and Viper850 robot simulators.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testRobotSimulatorLockStep.cpp
+
+  Test the lock-step mode of the Afma6 and Viper850 robot simulators: two
+  identical position based visual servoing runs have to give exactly the same
+  trajectory, the simulated time only depends on the number of steps and the
+  positioning methods have to advance the simulated time.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/robot/vpSimulatorAfma6.h>
+#include <visp3/robot/vpSimulatorViper850.h>
+
+#if defined(VISP_HAVE_MODULE_GUI) && ((defined(_WIN32) && !defined(WINRT_8_0)) || defined(VISP_HAVE_PTHREAD))
+
+namespace {
+  const unsigned int nbIterations = 300;
+  const double samplingTime = 0.01;
+  const double lambda = 2.;
+
+  void initRobot(vpSimulatorAfma6 &robot)
+  {
+    robot.init(vpAfma6::TOOL_CCMOP, vpCameraParameters::perspectiveProjWithoutDistortion);
+  }
+
+  void initRobot(vpSimulatorViper850 &robot)
+  {
+    robot.init(vpViper850::TOOL_PTGREY_FLEA2_CAMERA, vpCameraParameters::perspectiveProjWithoutDistortion);
+  }
+
+  // Position based visual servoing in lock-step mode. Return the camera trajectory and the simulated time.
+  template <class Robot>
+  void servo(std::vector<vpHomogeneousMatrix> &trajectory, double &simulationTime)
+  {
+    Robot robot(false);
+    robot.setLockStepMode(true);
+    robot.setSamplingTime(samplingTime);
+    initRobot(robot);
+    robot.setRobotState(vpRobot::STATE_VELOCITY_CONTROL);
+    robot.initScene(vpWireFrameSimulator::PLATE, vpWireFrameSimulator::D_STANDARD);
+    robot.initialiseObjectRelativeToCamera(vpHomogeneousMatrix(0.1, -0.1, 0.7, vpMath::rad(10), vpMath::rad(-10), vpMath::rad(20)));
+
+    vpHomogeneousMatrix cdMo(0.0, 0.0, 0.8, 0.0, 0.0, 0.0);
+    trajectory.clear();
+    for (unsigned int iter = 0; iter < nbIterations; iter++) {
+      vpHomogeneousMatrix cdMc = cdMo * robot.get_cMo().inverse();
+      vpRotationMatrix cdRc;
+      vpTranslationVector cdTc;
+      cdMc.extract(cdRc);
+      cdMc.extract(cdTc);
+      vpThetaUVector cdTUc(cdRc);
+      vpTranslationVector vt = cdRc.t() * cdTc;
+
+      vpColVector v(6);
+      for (unsigned int i = 0; i < 3; i++) {
+        v[i] = -lambda * vt[i];
+        v[i + 3] = -lambda * cdTUc[i];
+      }
+      robot.setVelocity(vpRobot::CAMERA_FRAME, v);
+      robot.step();
+      trajectory.push_back(robot.get_cMo());
+    }
+
+    double timestamp;
+    vpColVector q;
+    robot.getPosition(vpRobot::ARTICULAR_FRAME, q, timestamp);
+    if (timestamp != robot.getSimulationTime()) {
+      throw vpException(vpException::fatalError, "Bad timestamp in lock-step mode");
+    }
+    simulationTime = robot.getSimulationTime();
+
+    // Positioning in the articular frame has to advance the simulated time
+    robot.setRobotState(vpRobot::STATE_POSITION_CONTROL);
+    vpColVector qd = q;
+    qd[0] += vpMath::rad(5);
+    robot.setPosition(vpRobot::ARTICULAR_FRAME, qd);
+    robot.getPosition(vpRobot::ARTICULAR_FRAME, q);
+    if ((q - qd).sumSquare() > 1e-4 || robot.getSimulationTime() <= simulationTime) {
+      throw vpException(vpException::fatalError, "Positioning failed in lock-step mode");
+    }
+  }
+
+  template <class Robot>
+  bool test(const std::string &name)
+  {
+    std::vector<vpHomogeneousMatrix> trajectory1, trajectory2;
+    double time1, time2;
+
+    double t = vpTime::measureTimeMs();
+    servo<Robot>(trajectory1, time1);
+    t = vpTime::measureTimeMs() - t;
+    servo<Robot>(trajectory2, time2);
+
+    std::cout << name << ": " << nbIterations << " steps (" << time1 << " s of simulated time) computed in "
+              << t << " ms" << std::endl;
+
+    if (!vpMath::equal(time1, nbIterations * samplingTime, 1e-9) || time1 != time2) {
+      std::cerr << name << ": bad simulated time: " << time1 << " " << time2 << std::endl;
+      return false;
+    }
+
+    for (unsigned int i = 0; i < nbIterations; i++) {
+      for (unsigned int r = 0; r < 4; r++) {
+        for (unsigned int c = 0; c < 4; c++) {
+          if (trajectory1[i][r][c] != trajectory2[i][r][c]) {
+            std::cerr << name << ": the trajectories differ at iteration " << i << std::endl;
+            return false;
+          }
+        }
+      }
+    }
+
+    // The servo has to converge
+    vpHomogeneousMatrix cdMo(0.0, 0.0, 0.8, 0.0, 0.0, 0.0);
+    vpTranslationVector error = (cdMo * trajectory1.back().inverse()).getTranslationVector();
+    if (error.euclideanNorm() > 0.01) {
+      std::cerr << name << ": the visual servoing did not converge: " << error.t() << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    if (!test<vpSimulatorAfma6>("Afma6") || !test<vpSimulatorViper850>("Viper850")) {
+      return EXIT_FAILURE;
+    }
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testRobotSimulatorLockStep is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+#else
+int main()
+{
+  std::cout << "This test requires the gui module and threading capabilities" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
@@ -300,6 +300,8 @@ public:
   virtual void setMovingEdge(const vpMe &me);
   virtual void setMovingEdge(const std::string &cameraName, const vpMe &me);
 
+  virtual void setNbThreads(const int nbThreads);
+
   virtual void setNearClippingDistance(const double &dist);
   virtual void setNearClippingDistance(const std::string &cameraName, const double &dist);
 
@@ -323,6 +323,8 @@ class VISP_EXPORT vpMbEdgeTracker: public virtual vpMbTracker
     vpColVector m_weightedError_edge;
     //! Robust
     vpRobust m_robust_edge;
+    //! Number of threads used to track the moving edges
+    int m_nbThreads;
 
 
 public:
@@ -354,7 +356,17 @@ public:
   */
   virtual inline vpMe getMovingEdge() const { return this->me;}
 
+  void getMovingEdgeCounters(unsigned int &nb_reinit, unsigned int &nb_sampling,
+                             unsigned int &nb_reused_sampling) const;
+
   virtual unsigned int getNbPoints(const unsigned int level=0) const;
+
+  /*!
+    Return the number of threads used to track the moving edges.
+
+    \sa setNbThreads()
+  */
+  inline int getNbThreads() const { return m_nbThreads; }
   
   /*!
     Return the scales levels used for the tracking. 
@@ -386,6 +398,7 @@ public:
 		  const bool verbose=false);
   void reInitModel(const vpImage<unsigned char>& I, const char* cad_name, const vpHomogeneousMatrix& cMo,
 		  const bool verbose=false);
+  void resetMovingEdgeCounters();
   void resetTracker();
   
   /*!
@@ -466,6 +479,20 @@ public:
   
   void setMovingEdge(const vpMe &me);
 
+  /*!
+    Set the number of threads used to track the moving edges of the visible
+    lines, cylinders and circles. With a value lower or equal to 0, OpenMP
+    chooses the number of threads. Without OpenMP, the features are always
+    tracked sequentially.
+
+    The tracking results do not depend on the number of threads. The moving
+    edges must however not be displayed while they are tracked (see
+    vpMeSite::setDisplay()) when more than one thread is used.
+
+    \param nbThreads : Number of threads. Default value is 0.
+  */
+  virtual void setNbThreads(const int nbThreads) { m_nbThreads = nbThreads; }
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix& cdMo);
   
   void setScales(const std::vector<bool>& _scales);
@@ -42,6 +42,7 @@
 #define vpMbHiddenFaces_HH
 
 #include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/mbt/vpMbtPolygon.h>
@@ -51,6 +52,7 @@
   #include <visp3/ar/vpAROgre.h>
 #endif
 
+#include <algorithm>
 #include <vector>
 #include <limits>
 
@@ -61,6 +63,16 @@
 
   \ingroup group_mbt_faces
 
+  When Ogre is not used, the visibility test relies on the angle between the
+  normal of each face and the line of sight. To avoid testing every face of
+  large models, the oriented faces are grouped in a bounding volume hierarchy
+  built from their coordinates in the object frame: each node bounds the
+  centroids of its faces with a sphere and their normals with a cone. A whole
+  node is skipped when the angle test fails for every face it may contain, the
+  other faces being tested one by one as before. The result is the same as the
+  per-face test, except that the coordinates in the camera frame of the
+  skipped faces are not updated. The hierarchy is built the first time the
+  visibility is computed after polygons have been added with addPolygon().
  */
 template<class PolygonType = vpMbtPolygon>
 class vpMbHiddenFaces
@@ -72,6 +84,54 @@ class vpMbHiddenFaces
   unsigned int nbVisiblePolygon;
   vpMbScanLine scanlineRender;
 
+  //! Node of the bounding volume hierarchy of the oriented faces.
+  struct vpFaceCluster {
+    //! Center of the sphere bounding the face centroids (object frame).
+    double center[3];
+    //! Radius of the sphere bounding the face centroids.
+    double radius;
+    //! Axis of the cone bounding the face normals (object frame).
+    double axis[3];
+    //! Half-angle of the cone bounding the face normals.
+    double coneAngle;
+    //! Range of the inverse of the number of points of the faces.
+    double minInvNbPoint, maxInvNbPoint;
+    //! Faces of the node, as a range of faceClusterIndexes.
+    unsigned int first, count;
+    //! Children of the node, -1 for a leaf.
+    int left, right;
+  };
+
+  //! Compare the faces according to one coordinate of their centroid.
+  struct vpCentroidLess {
+    vpCentroidLess(const std::vector<double> &centroids, const unsigned int axis) : centroids(centroids), axis(axis) {}
+    bool operator()(const unsigned int a, const unsigned int b) const
+    {
+      return centroids[3*a + axis] < centroids[3*b + axis];
+    }
+    const std::vector<double> &centroids;
+    unsigned int axis;
+  };
+
+  //! Nodes of the bounding volume hierarchy.
+  std::vector<vpFaceCluster> faceClusters;
+  //! Roots of the hierarchy, one per main direction of the face normals.
+  std::vector<unsigned int> faceClusterRoots;
+  //! Indexes of the oriented faces, ordered so that each node is a range.
+  std::vector<unsigned int> faceClusterIndexes;
+  //! Faces that are not part of the hierarchy and are always tested.
+  std::vector<unsigned int> unclusteredFaces;
+  //! Centroid, normal and number of points of the oriented faces (object frame).
+  std::vector<double> faceCentroids, faceNormals;
+  std::vector<unsigned int> faceNbPoints;
+  //! True if the hierarchy corresponds to the current polygons.
+  bool faceClustersUpToDate;
+
+  int buildFaceCluster(const unsigned int first, const unsigned int count);
+  void buildFaceClusters();
+  bool isFaceClusterHidden(const vpFaceCluster &cluster, const double cameraPos[3], const double zAxis[3],
+                           const double angle) const;
+
 #ifdef VISP_HAVE_OGRE
   vpImage<unsigned char> ogreBackground;
   bool ogreInitialised;
@@ -259,7 +319,8 @@ class vpMbHiddenFaces
 */
 template<class PolygonType>
 vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces()
-  : Lpol(), nbVisiblePolygon(0), scanlineRender()
+  : Lpol(), nbVisiblePolygon(0), scanlineRender(), faceClusters(), faceClusterRoots(), faceClusterIndexes(),
+    unclusteredFaces(), faceCentroids(), faceNormals(), faceNbPoints(), faceClustersUpToDate(false)
 {
 #ifdef VISP_HAVE_OGRE
   ogreInitialised = false;
@@ -325,6 +386,7 @@ vpMbHiddenFaces<PolygonType>::addPolygon(PolygonType *p)
   for(unsigned int i = 0; i < p->nbpt; i++)
     p_new->p[i]= p->p[i];
   Lpol.push_back(p_new);
+  faceClustersUpToDate = false;
 }
 
 /*!
@@ -335,6 +397,7 @@ void
 vpMbHiddenFaces<PolygonType>::reset()
 {
   nbVisiblePolygon = 0;
+  faceClustersUpToDate = false;
   for(unsigned int i = 0 ; i < Lpol.size() ; i++){
     if (Lpol[i]!=NULL){
       delete Lpol[i];
@@ -475,14 +538,255 @@ vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneousMatrix &cMo,
 #endif
   }
 
-  for (unsigned int i = 0; i < Lpol.size(); i++){
-    //std::cout << "Calling poly: " << i << std::endl;
-    if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, I, cam, cameraPos, i))
+  // A face cannot be visible nor appearing when the angle between its normal
+  // and the line of sight is above this angle. The margin covers the rounding
+  // differences between the object and the camera frame computations.
+  double hiddenAngle = (std::max)(angleAppears, angleDisappears) + vpMath::rad(1) + 1e-6;
+
+  if (useOgre || hiddenAngle >= M_PI) {
+    for (unsigned int i = 0; i < Lpol.size(); i++){
+      //std::cout << "Calling poly: " << i << std::endl;
+      if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, I, cam, cameraPos, i))
+        nbVisiblePolygon ++;
+    }
+    return nbVisiblePolygon;
+  }
+
+  if (!faceClustersUpToDate)
+    buildFaceClusters();
+
+  // Position of the camera and Z axis of the camera frame in the object frame
+  double cameraPosition[3], zAxis[3];
+  for (unsigned int j = 0; j < 3; j++) {
+    cameraPosition[j] = -(cMo[0][j] * cMo[0][3] + cMo[1][j] * cMo[1][3] + cMo[2][j] * cMo[2][3]);
+    zAxis[j] = cMo[2][j];
+  }
+
+  std::vector<unsigned int> stack(faceClusterRoots);
+  while (!stack.empty()) {
+    const vpFaceCluster &cluster = faceClusters[stack.back()];
+    stack.pop_back();
+
+    if (isFaceClusterHidden(cluster, cameraPosition, zAxis, hiddenAngle)) {
+      for (unsigned int k = cluster.first; k < cluster.first + cluster.count; k++) {
+        PolygonType *poly = Lpol[faceClusterIndexes[k]];
+        poly->isappearing = false;
+        if (poly->isvisible)
+          changed = true;
+        poly->isvisible = false;
+      }
+    }
+    else if (cluster.left < 0) {
+      for (unsigned int k = cluster.first; k < cluster.first + cluster.count; k++) {
+        if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, I, cam, cameraPos, faceClusterIndexes[k]))
+          nbVisiblePolygon ++;
+      }
+    }
+    else {
+      stack.push_back((unsigned int)cluster.left);
+      stack.push_back((unsigned int)cluster.right);
+    }
+  }
+
+  for (size_t k = 0; k < unclusteredFaces.size(); k++) {
+    if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, I, cam, cameraPos, unclusteredFaces[k]))
       nbVisiblePolygon ++;
   }
+
   return nbVisiblePolygon;
 }
 
+/*!
+  Build the bounding volume hierarchy of the oriented faces.
+
+  The faces with at least three points, an orientation and a valid normal are
+  split in six groups according to the main direction of their normal, and a
+  hierarchy is built over each group by splitting the faces at the median of
+  their centroids. The other faces are always tested one by one.
+*/
+template<class PolygonType>
+void
+vpMbHiddenFaces<PolygonType>::buildFaceClusters()
+{
+  faceClusters.clear();
+  faceClusterRoots.clear();
+  faceClusterIndexes.clear();
+  unclusteredFaces.clear();
+  faceCentroids.assign(3*Lpol.size(), 0.);
+  faceNormals.assign(3*Lpol.size(), 0.);
+  faceNbPoints.assign(Lpol.size(), 0);
+
+  std::vector<unsigned int> groups[6];
+  for (unsigned int i = 0; i < Lpol.size(); i++) {
+    PolygonType *poly = Lpol[i];
+    unsigned int nbpt = poly->getNbPoint();
+    if (nbpt <= 2 || !poly->hasOrientation) {
+      unclusteredFaces.push_back(i);
+      continue;
+    }
+
+    // Newell's method, as in vpMbtPolygon::isVisible()
+    double *normal = &faceNormals[3*i];
+    double *centroid = &faceCentroids[3*i];
+    for (unsigned int j = 0; j < nbpt; j++) {
+      vpPoint &current = poly->p[j];
+      vpPoint &next = poly->p[(j+1) % nbpt];
+      normal[0] += (current.get_oY() - next.get_oY()) * (current.get_oZ() + next.get_oZ());
+      normal[1] += (current.get_oZ() - next.get_oZ()) * (current.get_oX() + next.get_oX());
+      normal[2] += (current.get_oX() - next.get_oX()) * (current.get_oY() + next.get_oY());
+      centroid[0] += current.get_oX();
+      centroid[1] += current.get_oY();
+      centroid[2] += current.get_oZ();
+    }
+    for (unsigned int j = 0; j < 3; j++)
+      centroid[j] /= (double)nbpt;
+
+    // The normal of a degenerated face is not normalized by vpMbtPolygon::isVisible()
+    double norm = sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+    if (!(norm > 1e-6)) {
+      unclusteredFaces.push_back(i);
+      continue;
+    }
+    unsigned int mainAxis = 0;
+    for (unsigned int j = 0; j < 3; j++) {
+      normal[j] /= norm;
+      if (std::fabs(normal[j]) > std::fabs(normal[mainAxis]))
+        mainAxis = j;
+    }
+    faceNbPoints[i] = nbpt;
+    groups[2*mainAxis + (normal[mainAxis] < 0 ? 1 : 0)].push_back(i);
+  }
+
+  for (unsigned int g = 0; g < 6; g++) {
+    if (groups[g].empty())
+      continue;
+    unsigned int first = (unsigned int)faceClusterIndexes.size();
+    faceClusterIndexes.insert(faceClusterIndexes.end(), groups[g].begin(), groups[g].end());
+    faceClusterRoots.push_back((unsigned int)buildFaceCluster(first, (unsigned int)groups[g].size()));
+  }
+
+  faceClustersUpToDate = true;
+}
+
+/*!
+  Build a node of the bounding volume hierarchy and its children.
+
+  \param first : Position of the first face of the node in faceClusterIndexes.
+  \param count : Number of faces of the node.
+
+  
+eturn Index of the node in faceClusters.
+*/
+template<class PolygonType>
+int
+vpMbHiddenFaces<PolygonType>::buildFaceCluster(const unsigned int first, const unsigned int count)
+{
+  const unsigned int maxLeafSize = 8;
+
+  vpFaceCluster cluster;
+  double minCoord[3], maxCoord[3], sumNormal[3] = {0., 0., 0.};
+  for (unsigned int j = 0; j < 3; j++) {
+    minCoord[j] = std::numeric_limits<double>::max();
+    maxCoord[j] = -std::numeric_limits<double>::max();
+  }
+  cluster.minInvNbPoint = 1.;
+  cluster.maxInvNbPoint = 0.;
+  for (unsigned int k = first; k < first + count; k++) {
+    unsigned int i = faceClusterIndexes[k];
+    for (unsigned int j = 0; j < 3; j++) {
+      minCoord[j] = (std::min)(minCoord[j], faceCentroids[3*i + j]);
+      maxCoord[j] = (std::max)(maxCoord[j], faceCentroids[3*i + j]);
+      sumNormal[j] += faceNormals[3*i + j];
+    }
+    double invNbPoint = 1. / (double)faceNbPoints[i];
+    cluster.minInvNbPoint = (std::min)(cluster.minInvNbPoint, invNbPoint);
+    cluster.maxInvNbPoint = (std::max)(cluster.maxInvNbPoint, invNbPoint);
+  }
+
+  unsigned int splitAxis = 0;
+  for (unsigned int j = 0; j < 3; j++) {
+    cluster.center[j] = 0.5 * (minCoord[j] + maxCoord[j]);
+    if (maxCoord[j] - minCoord[j] > maxCoord[splitAxis] - minCoord[splitAxis])
+      splitAxis = j;
+  }
+
+  double norm = sqrt(sumNormal[0]*sumNormal[0] + sumNormal[1]*sumNormal[1] + sumNormal[2]*sumNormal[2]);
+  cluster.coneAngle = norm > 1e-6 * count ? 0. : M_PI;
+  cluster.radius = 0.;
+  for (unsigned int j = 0; j < 3; j++)
+    cluster.axis[j] = norm > 1e-6 * count ? sumNormal[j] / norm : 0.;
+  for (unsigned int k = first; k < first + count; k++) {
+    unsigned int i = faceClusterIndexes[k];
+    const double *centroid = &faceCentroids[3*i];
+    const double *normal = &faceNormals[3*i];
+    double d[3] = {centroid[0] - cluster.center[0], centroid[1] - cluster.center[1], centroid[2] - cluster.center[2]};
+    cluster.radius = (std::max)(cluster.radius, sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]));
+    if (cluster.coneAngle < M_PI) {
+      double cosAngle = cluster.axis[0]*normal[0] + cluster.axis[1]*normal[1] + cluster.axis[2]*normal[2];
+      cluster.coneAngle = (std::max)(cluster.coneAngle, acos((std::max)(-1., (std::min)(1., cosAngle))));
+    }
+  }
+  // Margin for the rounding errors on the centroids
+  cluster.radius = cluster.radius * (1. + 1e-9) + 1e-12;
+
+  cluster.first = first;
+  cluster.count = count;
+  cluster.left = cluster.right = -1;
+
+  int index = (int)faceClusters.size();
+  faceClusters.push_back(cluster);
+
+  if (count > maxLeafSize) {
+    unsigned int half = count / 2;
+    std::vector<unsigned int>::iterator begin = faceClusterIndexes.begin() + first;
+    std::nth_element(begin, begin + half, begin + count, vpCentroidLess(faceCentroids, splitAxis));
+    int left = buildFaceCluster(first, half);
+    int right = buildFaceCluster(first + half, count - half);
+    faceClusters[(size_t)index].left = left;
+    faceClusters[(size_t)index].right = right;
+  }
+
+  return index;
+}
+
+/*!
+  Check if the angle between the normal and the line of sight is above a
+  given angle for all the faces of a node of the bounding volume hierarchy.
+
+  As in vpMbtPolygon::isVisible(), the line of sight of a face goes through
+  its centroid shifted by 1/nbpt along the Z axis of the camera frame.
+
+  \param cluster : Node of the hierarchy.
+  \param cameraPos : Position of the camera in the object frame.
+  \param zAxis : Z axis of the camera frame expressed in the object frame.
+  \param angle : Angle to test.
+
+  
+eturn True if all the faces of the node are hidden.
+*/
+template<class PolygonType>
+bool
+vpMbHiddenFaces<PolygonType>::isFaceClusterHidden(const vpFaceCluster &cluster, const double cameraPos[3],
+                                                  const double zAxis[3], const double angle) const
+{
+  if (cluster.coneAngle >= M_PI)
+    return false;
+
+  double shift = 0.5 * (cluster.minInvNbPoint + cluster.maxInvNbPoint);
+  double radius = cluster.radius + 0.5 * (cluster.maxInvNbPoint - cluster.minInvNbPoint);
+  double d[3];
+  for (unsigned int j = 0; j < 3; j++)
+    d[j] = cameraPos[j] - cluster.center[j] - shift * zAxis[j];
+  double dist = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+  // Keep away from the camera, where the line of sight is not normalized
+  if (dist - radius <= 1e-6)
+    return false;
+
+  double cosAngle = (cluster.axis[0]*d[0] + cluster.axis[1]*d[1] + cluster.axis[2]*d[2]) / dist;
+  double minAngle = acos((std::max)(-1., (std::min)(1., cosAngle))) - cluster.coneAngle - asin(radius / dist);
+  return minAngle > angle;
+}
+
 /*!
   Compute the visibility of a given face index.
 
@@ -512,7 +816,7 @@ vpMbHiddenFaces<PolygonType>::computeVisibility(const vpHomogeneousMatrix &cMo,
 {
   (void) not_used;
   unsigned int i = index;
-  Lpol[i]->changeFrame(cMo);
+  // The frame change is done by vpMbtPolygon::isVisible()
   Lpol[i]->isappearing = false;
 
   //Commented because we need to compute visibility
@@ -63,6 +63,7 @@
 #include <visp3/core/vpRGBa.h>
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/mbt/vpMbtCompiledModel.h>
 #include <visp3/mbt/vpMbtPolygon.h>
 #include <visp3/mbt/vpMbHiddenFaces.h>
 #include <visp3/core/vpPolygon.h>
@@ -392,6 +393,8 @@ public:
   virtual void loadModel(const char *modelFile, const bool verbose=false);
   virtual void loadModel(const std::string &modelFile, const bool verbose=false);
 
+  void saveCompiledModel(const std::string &modelFile, const std::string &compiledFile, const bool verbose=false);
+
   /*!
     Set the angle used to test polygons appearance.
     If the angle between the normal of the polygon and the line going
@@ -655,6 +658,9 @@ protected:
                                           const vpMatrix &L_true, const vpMatrix &LVJ_true, const vpColVector &error);
 
   void computeJTR(const vpMatrix& J, const vpColVector& R, vpColVector& JTR) const;
+  void computeNormalEquations(const vpMatrix &L, const vpColVector &R, vpMatrix &LTL, vpColVector &LTR) const;
+  void computeNormalEquations(const vpMatrix &L, const vpColVector &R, const vpMatrix &J, vpMatrix &LTL,
+                              vpColVector &LTR) const;
 
   virtual void computeVVSCheckLevenbergMarquardt(const unsigned int iter, vpColVector &error, const vpColVector &m_error_prev, const vpHomogeneousMatrix &cMoPrev,
                                                  double &mu, bool &reStartFromLastIncrement, vpColVector * const w=NULL, const vpColVector * const m_w_prev=NULL);
@@ -716,6 +722,12 @@ protected:
   virtual void loadVRMLModel(const std::string& modelFile);
   virtual void loadCAOModel(const std::string& modelFile, std::vector<std::string>& vectorOfModelFilename, int& startIdFace,
                             const bool verbose=false, const bool parent=true);
+  void compileCAOModel(const std::string& modelFile, vpMbtCompiledModel &model,
+                       std::vector<std::string>& vectorOfModelFilename, int& startIdFace,
+                       const bool verbose=false, const bool parent=true);
+  void getPrimitiveParameters(std::map<std::string, std::string> &mapOfParams, const std::string &thresholdName,
+                              vpMbtCompiledModel::vpPrimitive &primitive);
+  void loadCompiledModel(const vpMbtCompiledModel &model, int &startIdFace);
 
   void removeComment(std::ifstream& fileId);
 
@@ -0,0 +1,205 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compiled CAO model used by the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtCompiledModel.h
+ \brief Compiled CAO model used by the model-based tracker.
+*/
+
+#ifndef vpMbtCompiledModel_HH
+#define vpMbtCompiledModel_HH
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpMbtCompiledModel
+  \ingroup group_mbt_faces
+
+  \brief Parsed content of a CAO model file and of the files it includes.
+
+  A compiled model holds the deduplicated 3D points of the model and the list
+  of its primitives (faces defined by lines or by points, single segments,
+  cylinders and circles) in the order and with the face ids the CAO parser of
+  vpMbTracker creates them. The optional parameters of each primitive (name,
+  LOD flag and LOD threshold) are kept as they appear in the file, so that a
+  compiled model does not depend on the settings of the tracker that loads it.
+
+  A compiled model can be saved in a binary file with save() and read back
+  with load(), which reads the whole file at once. vpMbTracker::loadModel()
+  accepts such files (extension .bin) and vpMbTracker::saveCompiledModel()
+  creates them from a .cao file.
+
+  An in-memory cache of compiled models, keyed by the absolute path of the
+  main .cao file, can also be enabled with setCacheEnabled(). A cached model
+  is reused as long as the modification time and the size of all the files it
+  was built from are unchanged. It is useful when several trackers load the
+  same model, as vpMbEdgeMultiTracker does for each camera.
+*/
+class VISP_EXPORT vpMbtCompiledModel
+{
+public:
+  //! Kind of primitive stored in a compiled model.
+  typedef enum {
+    FACE_FROM_LINES,   /*!< Face described by a list of lines. */
+    FACE_FROM_CORNERS, /*!< Face described by a list of points. */
+    SEGMENT,           /*!< Line that does not belong to a face. */
+    CYLINDER,          /*!< Cylinder described by two points and a radius. */
+    CIRCLE             /*!< Circle described by three points and a radius. */
+  } vpPrimitiveType;
+
+  //! Primitive of a compiled model.
+  struct vpPrimitive {
+    vpPrimitive()
+      : type(FACE_FROM_CORNERS), idFace(0), firstIndex(0), nbIndex(0), radius(0.), name(),
+        hasUseLod(false), useLod(false), hasThreshold(false), threshold(0.) {}
+
+    //! Kind of primitive.
+    vpPrimitiveType type;
+    //! Id of the (first) face created for this primitive, relative to the first face of the model.
+    int idFace;
+    //! Position of the first point index of the primitive in getIndexes().
+    unsigned int firstIndex;
+    //! Number of point indexes of the primitive.
+    unsigned int nbIndex;
+    //! Radius of a cylinder or a circle.
+    double radius;
+    //! Name of the primitive.
+    std::string name;
+    //! True if the useLod parameter is set in the file.
+    bool hasUseLod;
+    //! Value of the useLod parameter.
+    bool useLod;
+    //! True if the minimum line length or polygon area threshold is set in the file.
+    bool hasThreshold;
+    //! Value of the minimum line length or polygon area threshold.
+    double threshold;
+  };
+
+  //! File the compiled model has been built from.
+  struct vpSourceFile {
+    vpSourceFile() : path(), mtime(0), size(0) {}
+
+    //! Absolute path of the file.
+    std::string path;
+    //! Last modification time of the file.
+    long long mtime;
+    //! Size of the file in bytes.
+    long long size;
+  };
+
+  vpMbtCompiledModel();
+
+  unsigned int addPoint(const double x, const double y, const double z);
+  void addPrimitive(const vpPrimitive &primitive, const std::vector<unsigned int> &indexes);
+  void addSourceFile(const std::string &path);
+
+  void clear();
+
+  /*!
+    Return the id of the first face that follows the model, relative to the
+    first face of the model.
+  */
+  inline int getEndIdFace() const { return m_endIdFace; }
+  /*!
+    Return the point indexes of the primitives.
+  */
+  inline const std::vector<unsigned int> &getIndexes() const { return m_indexes; }
+  //! Return the number of points declared in the CAO files.
+  inline unsigned int getNbPoints() const { return m_nbPoints; }
+  //! Return the number of lines declared in the CAO files.
+  inline unsigned int getNbLines() const { return m_nbLines; }
+  //! Return the number of faces defined by lines declared in the CAO files.
+  inline unsigned int getNbPolygonLines() const { return m_nbPolygonLines; }
+  //! Return the number of faces defined by points declared in the CAO files.
+  inline unsigned int getNbPolygonPoints() const { return m_nbPolygonPoints; }
+  //! Return the number of cylinders declared in the CAO files.
+  inline unsigned int getNbCylinders() const { return m_nbCylinders; }
+  //! Return the number of circles declared in the CAO files.
+  inline unsigned int getNbCircles() const { return m_nbCircles; }
+  /*!
+    Return the coordinates of the deduplicated points, stored as x, y, z
+    triplets expressed in the object frame.
+  */
+  inline const std::vector<double> &getPoints() const { return m_points; }
+  //! Return the primitives in the order they have to be added to the tracker.
+  inline const std::vector<vpPrimitive> &getPrimitives() const { return m_primitives; }
+  //! Return the files the model has been built from, the main file first.
+  inline const std::vector<vpSourceFile> &getSourceFiles() const { return m_sourceFiles; }
+
+  void increaseCounters(const unsigned int nbPoints, const unsigned int nbLines, const unsigned int nbPolygonLines,
+                        const unsigned int nbPolygonPoints, const unsigned int nbCylinders, const unsigned int nbCircles);
+
+  bool isUpToDate() const;
+
+  void load(const std::string &filename);
+  void save(const std::string &filename) const;
+
+  /*!
+    Set the id of the first face that follows the model.
+  */
+  inline void setEndIdFace(const int endIdFace) { m_endIdFace = endIdFace; }
+
+  static void clearCache();
+  static bool getCache(const std::string &modelFile, vpMbtCompiledModel &model);
+  static bool isCacheEnabled();
+  static void setCacheEnabled(const bool enable);
+  static void setCache(const std::string &modelFile, const vpMbtCompiledModel &model);
+
+private:
+  //! Coordinates of the points (x, y, z).
+  std::vector<double> m_points;
+  //! Point indexes of the primitives.
+  std::vector<unsigned int> m_indexes;
+  //! Primitives of the model.
+  std::vector<vpPrimitive> m_primitives;
+  //! Files used to build the model.
+  std::vector<vpSourceFile> m_sourceFiles;
+  //! Id of the first face following the model.
+  int m_endIdFace;
+  //! Counters of the primitives declared in the CAO files.
+  unsigned int m_nbPoints;
+  unsigned int m_nbLines;
+  unsigned int m_nbPolygonLines;
+  unsigned int m_nbPolygonPoints;
+  unsigned int m_nbCylinders;
+  unsigned int m_nbCircles;
+  //! Index of each point, used to deduplicate the points while building the model.
+  std::map<std::vector<double>, unsigned int> m_pointIndex;
+};
+
+#endif
@@ -75,6 +75,14 @@ class VISP_EXPORT vpMbtDistanceLine
     vpFeatureLine featureline;
     //! Polygon describing the line
     vpMbtPolygon poly;
+    //! Moving edges released by resetMovingEdge(), reused by the next initialization
+    std::vector<vpMbtMeLine*> melinePool;
+    //! Number of reinitializations of the moving edges
+    unsigned int nbReinit;
+    //! Number of samplings of the moving edges
+    unsigned int nbSampling;
+    //! Number of times the sites of a previous sampling have been reused
+    unsigned int nbReusedSampling;
     
   public: 
     //! Use scanline rendering
@@ -160,6 +168,8 @@ class VISP_EXPORT vpMbtDistanceLine
      \return The mean weight of the line.
     */
     inline double getMeanWeight() const {return wmean;}
+
+    void getMovingEdgeCounters(unsigned int &nb_reinit, unsigned int &nb_sampling, unsigned int &nb_reused_sampling) const;
     
     /*!
       Get the name of the line.
@@ -194,6 +204,9 @@ class VISP_EXPORT vpMbtDistanceLine
     inline bool isVisible() const {return isvisible; }
     
     void reinitMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo);
+
+    void resetMovingEdge();
+    void resetMovingEdgeCounters();
     
     /*!
      Set the camera paramters.
@@ -248,6 +261,7 @@ class VISP_EXPORT vpMbtDistanceLine
 
   private:
     void project(const vpHomogeneousMatrix &cMo);
+    void updateMovingEdgeCounters(vpMbtMeLine *melinePt);
 };
 
 #endif
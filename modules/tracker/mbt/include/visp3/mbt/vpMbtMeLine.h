@@ -49,6 +49,8 @@
 #include <visp3/me/vpMe.h>
 #include <visp3/me/vpMeTracker.h>
 
+#include <vector>
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 /*!
@@ -65,16 +67,27 @@ class VISP_EXPORT vpMbtMeLine : public vpMeTracker
     double delta ,delta_1;
     int sign;
     double a,b,c;
+    //! Sites of the last sampling, see vpMe::setSampleReuseThreshold()
+    std::vector<vpMeSite> samples;
+    //! Extremities of the line and size of the image at the last sampling
+    vpMeSite samplesExt[2];
+    unsigned int samplesRows, samplesCols;
   
   public: 
     int imin, imax;
     int jmin, jmax;
     double expecteddensity;
+    //! Number of times the line has been sampled
+    unsigned int nbSampling;
+    //! Number of times the sites of a previous sampling have been reused
+    unsigned int nbReusedSampling;
   
   public:  
     vpMbtMeLine();
     ~vpMbtMeLine();
 
+    void clearSamples();
+
     void computeProjectionError(const vpImage<unsigned char>& _I, double &_sumErrorRad, unsigned int &_nbFeatures);
     
     void display(const vpImage<unsigned char>& /*I*/, vpColor /*col*/) {;}
@@ -117,6 +130,7 @@ class VISP_EXPORT vpMbtMeLine : public vpMeTracker
     void suppressPoints(const vpImage<unsigned char> &I);
     void reSample(const vpImage<unsigned char>&image);
     void reSample(const vpImage<unsigned char>&image, vpImagePoint ip1, vpImagePoint ip2);
+    bool reuseSamples(const vpImage<unsigned char> &I);
     void updateDelta();
 };
 
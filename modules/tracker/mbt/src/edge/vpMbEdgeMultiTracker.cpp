@@ -281,7 +281,6 @@ void vpMbEdgeMultiTracker::computeVVS(std::map<std::string, const vpImage<unsign
     if (!reStartFromLastIncrement) {
       computeVVSWeights();
 
-      L_true = m_L_edgeMulti;
       vpVelocityTwistMatrix cVo;
 
       if (computeCovariance) {
@@ -394,16 +393,14 @@ void vpMbEdgeMultiTracker::computeVVSFirstPhasePoseEstimation(const unsigned int
   vpColVector LTR;
 
   if(isoJoIdentity_){
-      LTL = m_L_edgeMulti.AtA();
-      computeJTR(m_L_edgeMulti, m_weightedError_edgeMulti, LTR);
+      computeNormalEquations(m_L_edgeMulti, m_weightedError_edgeMulti, LTL, LTR);
       v = -0.7*LTL.pseudoInverse(LTL.getRows()*std::numeric_limits<double>::epsilon())*LTR;
   }
   else{
       cVo.buildFrom(cMo);
-      vpMatrix LVJ = (m_L_edgeMulti*cVo*oJo);
-      vpMatrix LVJTLVJ = (LVJ).AtA();
+      vpMatrix LVJTLVJ;
       vpColVector LVJTR;
-      computeJTR(LVJ, m_weightedError_edgeMulti, LVJTR);
+      computeNormalEquations(m_L_edgeMulti, m_weightedError_edgeMulti, cVo*oJo, LVJTLVJ, LVJTR);
       v = -0.7*LVJTLVJ.pseudoInverse(LVJTLVJ.getRows()*std::numeric_limits<double>::epsilon())*LVJTR;
       v = cVo * v;
   }
@@ -2355,6 +2352,23 @@ void vpMbEdgeMultiTracker::setMovingEdge(const std::string &cameraName, const vp
   }
 }
 
+/*!
+  Set the number of threads used by each camera to track the moving edges.
+  With a value lower or equal to 0, OpenMP chooses the number of threads.
+
+  \param nbThreads : Number of threads.
+
+  \sa vpMbEdgeTracker::setNbThreads()
+*/
+void vpMbEdgeMultiTracker::setNbThreads(const int nbThreads) {
+  for(std::map<std::string, vpMbEdgeTracker *>::const_iterator it = m_mapOfEdgeTrackers.begin();
+      it != m_mapOfEdgeTrackers.end(); ++it) {
+    it->second->setNbThreads(nbThreads);
+  }
+
+  m_nbThreads = nbThreads;
+}
+
 /*!
   Set the near distance for clipping.
 
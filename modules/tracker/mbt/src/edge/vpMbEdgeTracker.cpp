@@ -62,6 +62,10 @@
 #include <float.h>
 #include <map>
 
+#if defined(VISP_HAVE_OPENMP)
+#  include <omp.h>
+#endif
+
 
 /*!
   Basic constructor
@@ -72,7 +76,7 @@ vpMbEdgeTracker::vpMbEdgeTracker()
     Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0),
     m_factor(), m_robustLines(), m_robustCylinders(), m_robustCircles(),
     m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(), m_errorCylinders(), m_errorCircles(),
-    m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(), m_robust_edge()
+    m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(), m_robust_edge(), m_nbThreads(0)
 {
   angleAppears = vpMath::rad(89);
   angleDisappears = vpMath::rad(89);
@@ -232,7 +236,6 @@ vpMbEdgeTracker::computeVVS(const vpImage<unsigned char>& _I, const unsigned int
     if(!reStartFromLastIncrement) {
       computeVVSWeights();
 
-      L_true = m_L_edge;
       vpVelocityTwistMatrix cVo;
 
       if (computeCovariance) {
@@ -327,14 +330,14 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
         }
       }
 
-      std::list<vpMeSite>::const_iterator itListLine;
+      std::vector<vpMeSite>::const_iterator itListLine;
 
       unsigned int indexFeature = 0;
 
       for(unsigned int a = 0 ; a < l->meline.size() ; a++)
       {
         if (iter == 0 && l->meline[a] != NULL)
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
         for (unsigned int i=0 ; i < l->nbFeature[a] ; i++)
         {
@@ -410,11 +413,11 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
       cy->computeInteractionMatrixError(cMo, _I);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if (iter == 0 && (cy->meline1 != NULL || cy->meline2 != NULL)){
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
       }
 
       for(unsigned int i=0 ; i < cy->nbFeature ; i++){
@@ -516,9 +519,9 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
       ci->computeInteractionMatrixError(cMo);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (iter == 0 && (ci->meEllipse != NULL)) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
       }
 
       for(unsigned int i=0 ; i < ci->nbFeature ; i++){
@@ -611,10 +614,10 @@ vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char>& I, con
 
       unsigned int indexFeature = 0;
       for(unsigned int a = 0 ; a < l->meline.size(); a++){
-        std::list<vpMeSite>::const_iterator itListLine;
+        std::vector<vpMeSite>::const_iterator itListLine;
         if (l->meline[a] != NULL)
         {
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i=0 ; i < l->nbFeature[a] ; i++){
               m_factor[n+i] = fac;
@@ -634,11 +637,11 @@ vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char>& I, con
       cy = *it;
       cy->computeInteractionMatrixError(cMo, I);
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if ((cy->meline1 != NULL || cy->meline2 != NULL)){
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
 
         double fac = 1.0;
         for(unsigned int i=0 ; i < cy->nbFeature ; i++){
@@ -664,9 +667,9 @@ vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char>& I, con
       ci = *it;
       ci->computeInteractionMatrixError(cMo);
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (ci->meEllipse != NULL) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
         double fac = 1.0;
 
         for(unsigned int i=0 ; i < ci->nbFeature ; i++){
@@ -733,16 +736,14 @@ vpMbEdgeTracker::computeVVSFirstPhasePoseEstimation(const unsigned int iter, boo
   vpColVector LTR;
 
   if(isoJoIdentity_){
-      LTL = m_L_edge.AtA();
-      computeJTR(m_L_edge, m_weightedError_edge, LTR);
+      computeNormalEquations(m_L_edge, m_weightedError_edge, LTL, LTR);
       v = -0.7*LTL.pseudoInverse(LTL.getRows()*std::numeric_limits<double>::epsilon())*LTR;
   }
   else{
       cVo.buildFrom(cMo);
-      vpMatrix LVJ = (m_L_edge*cVo*oJo);
-      vpMatrix LVJTLVJ = (LVJ).AtA();
+      vpMatrix LVJTLVJ;
       vpColVector LVJTR;
-      computeJTR(LVJ, m_weightedError_edge, LVJTR);
+      computeNormalEquations(m_L_edge, m_weightedError_edge, cVo*oJo, LVJTLVJ, LVJTR);
       v = -0.7*LVJTLVJ.pseudoInverse(LVJTLVJ.getRows()*std::numeric_limits<double>::epsilon())*LVJTR;
       v = cVo * v;
   }
@@ -970,7 +971,7 @@ vpMbEdgeTracker::testTracking()
       for(unsigned int a = 0 ; a < l->meline.size() ; a++){
         if(l->meline[a] != NULL){
           nbExpectedPoint += (int)l->meline[a]->expecteddensity;
-          for(std::list<vpMeSite>::const_iterator itme=l->meline[a]->getMeList().begin(); itme!=l->meline[a]->getMeList().end(); ++itme){
+          for(std::vector<vpMeSite>::const_iterator itme=l->meline[a]->getMeSites().begin(); itme!=l->meline[a]->getMeSites().end(); ++itme){
             vpMeSite pix = *itme;
             if (pix.getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoint++;
             else nbBadPoint++;
@@ -985,13 +986,13 @@ vpMbEdgeTracker::testTracking()
     if ((cy->meline1 !=NULL && cy->meline2 != NULL) && cy->isVisible() && cy->isTracked())
     {
       nbExpectedPoint += (int)cy->meline1->expecteddensity;
-      for(std::list<vpMeSite>::const_iterator itme1=cy->meline1->getMeList().begin(); itme1!=cy->meline1->getMeList().end(); ++itme1){
+      for(std::vector<vpMeSite>::const_iterator itme1=cy->meline1->getMeSites().begin(); itme1!=cy->meline1->getMeSites().end(); ++itme1){
         vpMeSite pix = *itme1;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoint++;
         else nbBadPoint++;
       }
       nbExpectedPoint += (int)cy->meline2->expecteddensity;
-      for(std::list<vpMeSite>::const_iterator itme2=cy->meline2->getMeList().begin(); itme2!=cy->meline2->getMeList().end(); ++itme2){
+      for(std::vector<vpMeSite>::const_iterator itme2=cy->meline2->getMeSites().begin(); itme2!=cy->meline2->getMeSites().end(); ++itme2){
         vpMeSite pix = *itme2;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoint++;
         else nbBadPoint++;
@@ -1004,7 +1005,7 @@ vpMbEdgeTracker::testTracking()
     if (ci->isVisible() && ci->isTracked() && ci->meEllipse !=NULL)
     {
       nbExpectedPoint += ci->meEllipse->getExpectedDensity();
-      for(std::list<vpMeSite>::const_iterator itme=ci->meEllipse->getMeList().begin(); itme!=ci->meEllipse->getMeList().end(); ++itme){
+      for(std::vector<vpMeSite>::const_iterator itme=ci->meEllipse->getMeSites().begin(); itme!=ci->meEllipse->getMeSites().end(); ++itme){
         vpMeSite pix = *itme;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoint++;
         else nbBadPoint++;
@@ -1482,12 +1483,7 @@ vpMbEdgeTracker::initMovingEdge(const vpImage<unsigned char> &I, const vpHomogen
     else
     {
       l->setVisible(false);
-      for(unsigned int a = 0 ; a < l->meline.size() ; a++){
-        if (l->meline[a] != NULL) delete l->meline[a];
-        l->nbFeature[a] = 0;
-      }
-      l->nbFeatureTotal = 0;
-      l->meline.clear();
+      l->resetMovingEdge();
     }
   }
 
@@ -1564,39 +1560,69 @@ vpMbEdgeTracker::initMovingEdge(const vpImage<unsigned char> &I, const vpHomogen
 
 /*!
   Track the moving edges in the image.
-  
+
+  The visible features only read the image and modify their own moving edges,
+  so that they are tracked in parallel when OpenMP is available (see
+  setNbThreads()). The moving edges that have to be created are initialized
+  first and sequentially, since their initialization temporarily modifies the
+  moving edges parameters shared by all the features.
+
   \param I : the image.
 */
 void
 vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
 {
+  std::vector<vpMbtDistanceLine *> trackedLines;
   for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[scaleLevel].begin(); it!=lines[scaleLevel].end(); ++it){
     vpMbtDistanceLine *l = *it;
     if(l->isVisible() && l->isTracked()){
       if(l->meline.size() == 0){
         l->initMovingEdge(I, cMo);
       }
-      l->trackMovingEdge(I, cMo);
+      trackedLines.push_back(l);
     }
   }
 
+  std::vector<vpMbtDistanceCylinder *> trackedCylinders;
   for(std::list<vpMbtDistanceCylinder*>::const_iterator it=cylinders[scaleLevel].begin(); it!=cylinders[scaleLevel].end(); ++it){
     vpMbtDistanceCylinder *cy = *it;
     if(cy->isVisible() && cy->isTracked()) {
-        if(cy->meline1 == NULL || cy->meline2 == NULL){
-          cy->initMovingEdge(I, cMo);
-        }
-        cy->trackMovingEdge(I, cMo);
+      if(cy->meline1 == NULL || cy->meline2 == NULL){
+        cy->initMovingEdge(I, cMo);
+      }
+      trackedCylinders.push_back(cy);
     }
   }
 
+  std::vector<vpMbtDistanceCircle *> trackedCircles;
   for(std::list<vpMbtDistanceCircle*>::const_iterator it=circles[scaleLevel].begin(); it!=circles[scaleLevel].end(); ++it){
     vpMbtDistanceCircle *ci = *it;
     if(ci->isVisible() && ci->isTracked()){
       if(ci->meEllipse == NULL){
         ci->initMovingEdge(I, cMo);
       }
-      ci->trackMovingEdge(I, cMo);
+      trackedCircles.push_back(ci);
+    }
+  }
+
+  // The features catch their own tracking errors, so that nothing has to be
+  // merged after the loop and the result does not depend on the scheduling
+  const int nbLines = (int)trackedLines.size();
+  const int nbCylinders = (int)trackedCylinders.size();
+  const int nbFeatures = nbLines + nbCylinders + (int)trackedCircles.size();
+#if defined(VISP_HAVE_OPENMP)
+  const int nbThreads = m_nbThreads > 0 ? m_nbThreads : omp_get_max_threads();
+  #pragma omp parallel for schedule(dynamic, 1) num_threads(nbThreads) if(nbThreads > 1 && nbFeatures > 1)
+#endif
+  for(int i = 0; i < nbFeatures; i++){
+    if(i < nbLines){
+      trackedLines[(size_t)i]->trackMovingEdge(I, cMo);
+    }
+    else if(i < nbLines + nbCylinders){
+      trackedCylinders[(size_t)(i - nbLines)]->trackMovingEdge(I, cMo);
+    }
+    else{
+      trackedCircles[(size_t)(i - nbLines - nbCylinders)]->trackMovingEdge(I, cMo);
     }
   }
 }
@@ -1657,8 +1683,8 @@ vpMbEdgeTracker::updateMovingEdgeWeights() {
       for(unsigned int a = 0 ; a < l->meline.size() ; a++)
       {
         if (l->nbFeature[a] > 0) {
-          std::list<vpMeSite>::iterator itListLine;
-          itListLine = l->meline[a]->getMeList().begin();
+          std::vector<vpMeSite>::iterator itListLine;
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i=0 ; i < l->nbFeature[a] ; i++){
             wmean += m_w_edge[n+indexLine];
@@ -1694,12 +1720,12 @@ vpMbEdgeTracker::updateMovingEdgeWeights() {
     if((*it)->isTracked()){
       cy = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCyl1;
-      std::list<vpMeSite>::iterator itListCyl2;
+      std::vector<vpMeSite>::iterator itListCyl1;
+      std::vector<vpMeSite>::iterator itListCyl2;
 
       if (cy->nbFeature > 0){
-        itListCyl1 = cy->meline1->getMeList().begin();
-        itListCyl2 = cy->meline2->getMeList().begin();
+        itListCyl1 = cy->meline1->getMeSites().begin();
+        itListCyl2 = cy->meline2->getMeSites().begin();
 
         for(unsigned int i=0 ; i < cy->nbFeaturel1 ; i++){
           wmean += m_w_edge[n+i];
@@ -1759,10 +1785,10 @@ vpMbEdgeTracker::updateMovingEdgeWeights() {
     if((*it)->isTracked()){
       ci = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCir;
+      std::vector<vpMeSite>::iterator itListCir;
 
       if (ci->nbFeature > 0){
-        itListCir = ci->meEllipse->getMeList().begin();
+        itListCir = ci->meEllipse->getMeSites().begin();
       }
 
       wmean = 0;
@@ -1839,15 +1865,7 @@ vpMbEdgeTracker::resetMovingEdge(){
   for (unsigned int i = 0; i < scales.size(); i += 1){
     if (scales[i]) {
       for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[i].begin(); it!=lines[i].end(); ++it){
-        for(unsigned int a = 0 ; a < (*it)->meline.size() ; a++){
-          if((*it)->meline[a] != NULL){
-            delete (*it)->meline[a];
-            (*it)->meline[a] = NULL;
-          }
-          (*it)->meline.clear();
-          (*it)->nbFeature.clear();
-          (*it)->nbFeatureTotal = 0;
-        }
+        (*it)->resetMovingEdge();
       }
 
       for(std::list<vpMbtDistanceCylinder*>::const_iterator it=cylinders[i].begin(); it!=cylinders[i].end(); ++it){
@@ -2466,7 +2484,7 @@ vpMbEdgeTracker::getNbPoints(const unsigned int level) const
     {
       for(unsigned int a = 0 ; a < l->meline.size() ; a++){
         if(l->nbFeature[a] != 0)
-          for(std::list<vpMeSite>::const_iterator itme=l->meline[a]->getMeList().begin(); itme!=l->meline[a]->getMeList().end(); ++itme){
+          for(std::vector<vpMeSite>::const_iterator itme=l->meline[a]->getMeSites().begin(); itme!=l->meline[a]->getMeSites().end(); ++itme){
             if (itme->getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoints++;
           }
       }
@@ -2478,10 +2496,10 @@ vpMbEdgeTracker::getNbPoints(const unsigned int level) const
     cy = *it;
     if (cy->isVisible() && cy->isTracked() && (cy->meline1 != NULL || cy->meline2 != NULL))
     {
-      for(std::list<vpMeSite>::const_iterator itme1=cy->meline1->getMeList().begin(); itme1!=cy->meline1->getMeList().end(); ++itme1){
+      for(std::vector<vpMeSite>::const_iterator itme1=cy->meline1->getMeSites().begin(); itme1!=cy->meline1->getMeSites().end(); ++itme1){
         if (itme1->getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoints++;
       }
-      for(std::list<vpMeSite>::const_iterator itme2=cy->meline2->getMeList().begin(); itme2!=cy->meline2->getMeList().end(); ++itme2){
+      for(std::vector<vpMeSite>::const_iterator itme2=cy->meline2->getMeSites().begin(); itme2!=cy->meline2->getMeSites().end(); ++itme2){
         if (itme2->getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoints++;
       }
     }
@@ -2492,7 +2510,7 @@ vpMbEdgeTracker::getNbPoints(const unsigned int level) const
     ci = *it;
     if (ci->isVisible() && ci->isTracked() && ci->meEllipse != NULL)
     {
-      for(std::list<vpMeSite>::const_iterator itme=ci->meEllipse->getMeList().begin(); itme!=ci->meEllipse->getMeList().end(); ++itme){
+      for(std::vector<vpMeSite>::const_iterator itme=ci->meEllipse->getMeSites().begin(); itme!=ci->meEllipse->getMeSites().end(); ++itme){
         if (itme->getState() == vpMeSite::NO_SUPPRESSION) nbGoodPoints++;
       }
     }
@@ -2736,6 +2754,57 @@ vpMbEdgeTracker::getLline(std::list<vpMbtDistanceLine *>& linesList, const unsig
   linesList = lines[level];
 }
 
+/*!
+  Get the counters of the moving edges of the lines of all the levels, since
+  the lines have been created or resetMovingEdgeCounters() has been called.
+
+  A high number of reinitializations or of samplings compared to the number of
+  tracked images indicates that the moving edges are often sampled again,
+  which is costly. Setting vpMe::setSampleReuseThreshold() allows to reuse
+  the sites of a previous sampling when the lines do not move too much.
+
+  \param nb_reinit : Number of reinitializations of the lines.
+  \param nb_sampling : Number of times the moving edges have been sampled along a line.
+  \param nb_reused_sampling : Number of times the moving edges of a previous
+  sampling have been reused instead of sampling the line again.
+
+  \sa vpMbtDistanceLine::getMovingEdgeCounters()
+*/
+void
+vpMbEdgeTracker::getMovingEdgeCounters(unsigned int &nb_reinit, unsigned int &nb_sampling,
+                                       unsigned int &nb_reused_sampling) const
+{
+  nb_reinit = 0;
+  nb_sampling = 0;
+  nb_reused_sampling = 0;
+  for (unsigned int i = 0; i < scales.size(); i += 1){
+    if(scales[i]){
+      for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[i].begin(); it!=lines[i].end(); ++it){
+        unsigned int reinit, sampling, reused_sampling;
+        (*it)->getMovingEdgeCounters(reinit, sampling, reused_sampling);
+        nb_reinit += reinit;
+        nb_sampling += sampling;
+        nb_reused_sampling += reused_sampling;
+      }
+    }
+  }
+}
+
+/*!
+  Reset the counters returned by getMovingEdgeCounters().
+*/
+void
+vpMbEdgeTracker::resetMovingEdgeCounters()
+{
+  for (unsigned int i = 0; i < scales.size(); i += 1){
+    if(scales[i]){
+      for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[i].begin(); it!=lines[i].end(); ++it){
+        (*it)->resetMovingEdgeCounters();
+      }
+    }
+  }
+}
+
 
 /*!
   Get the list of the cylinders tracked for the specified level. Each cylinder
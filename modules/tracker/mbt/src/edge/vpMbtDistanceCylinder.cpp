@@ -311,8 +311,8 @@ vpMbtDistanceCylinder::trackMovingEdge(const vpImage<unsigned char> &I, const vp
     }
 
     // Update the number of features
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
   }
 }
@@ -412,8 +412,8 @@ vpMbtDistanceCylinder::updateMovingEdge(const vpImage<unsigned char> &I, const v
     }
 
     // Update the numbers of features
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
   }
 }
@@ -604,8 +604,8 @@ void
 vpMbtDistanceCylinder::initInteractionMatrixError()
 {
   if (isvisible) {
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
     L.resize(nbFeature, 6);
     error.resize(nbFeature);
@@ -668,7 +668,7 @@ vpMbtDistanceCylinder::computeInteractionMatrixError(const vpHomogeneousMatrix &
 
     vpMeSite p;
     unsigned int j =0;
-    for(std::list<vpMeSite>::const_iterator it=meline1->getMeList().begin(); it!=meline1->getMeList().end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=meline1->getMeSites().begin(); it!=meline1->getMeSites().end(); ++it){
       double x = (double)it->j;
       double y = (double)it->i;
 
@@ -690,7 +690,7 @@ vpMbtDistanceCylinder::computeInteractionMatrixError(const vpHomogeneousMatrix &
       j++;
     }
 
-    for(std::list<vpMeSite>::const_iterator it=meline2->getMeList().begin(); it!=meline2->getMeList().end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=meline2->getMeSites().begin(); it!=meline2->getMeSites().end(); ++it){
       double x = (double)it->j;
       double y = (double)it->i;
 
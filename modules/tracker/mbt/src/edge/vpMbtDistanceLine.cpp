@@ -57,7 +57,8 @@ void buildLine(vpPoint &P1, vpPoint &P2, vpPoint &P3, vpPoint &P4, vpLine &L);
 */
 vpMbtDistanceLine::vpMbtDistanceLine()
   : name(), index(0), cam(), me(NULL), isTrackedLine(true), isTrackedLineWithVisibility(true),
-    wmean(1), featureline(), poly(), useScanLine(false), meline(), line(NULL), p1(NULL), p2(NULL), L(),
+    wmean(1), featureline(), poly(), melinePool(), nbReinit(0), nbSampling(0), nbReusedSampling(0),
+    useScanLine(false), meline(), line(NULL), p1(NULL), p2(NULL), L(),
     error(), nbFeature(), nbFeatureTotal(0), Reinit(false), hiddenface(NULL), Lindex_polygon(),
     Lindex_polygon_tracked(), isvisible(false)
 {
@@ -75,6 +76,11 @@ vpMbtDistanceLine::~vpMbtDistanceLine()
     if (meline[i] != NULL) delete meline[i];
 
   meline.clear();
+
+  for(unsigned int i = 0 ; i < melinePool.size() ; i++)
+    if (melinePool[i] != NULL) delete melinePool[i];
+
+  melinePool.clear();
 }
 
 /*!
@@ -299,8 +305,15 @@ vpMbtDistanceLine::setMovingEdge(vpMe *_me)
 //      nbFeature[i] = 0;
       meline[i]->reset();
       meline[i]->setMe(me);
+      meline[i]->clearSamples();
     }
 
+  // The released moving edges were sampled with the previous parameters
+  for(unsigned int i = 0 ; i < melinePool.size() ; i++)
+    if (melinePool[i] != NULL) delete melinePool[i];
+
+  melinePool.clear();
+
 //  nbFeatureTotal = 0;
 }
 
@@ -316,13 +329,7 @@ vpMbtDistanceLine::setMovingEdge(vpMe *_me)
 bool
 vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo)
 {
-  for(unsigned int i = 0 ; i < meline.size() ; i++){
-    if (meline[i] != NULL) delete meline[i];
-  }
-
-  meline.clear();
-  nbFeature.clear();
-  nbFeatureTotal = 0;
+  resetMovingEdge();
 
   if(isvisible)
   {
@@ -381,7 +388,15 @@ vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vpHomog
         vpMeterPixelConversion::convertPoint(cam,linesLst[i].first.get_x(),linesLst[i].first.get_y(),ip1);
         vpMeterPixelConversion::convertPoint(cam,linesLst[i].second.get_x(),linesLst[i].second.get_y(),ip2);
 
-        vpMbtMeLine *melinePt = new vpMbtMeLine;
+        // Reuse the moving edges released for the same part of the line
+        vpMbtMeLine *melinePt = NULL;
+        if (i < melinePool.size() && melinePool[i] != NULL) {
+          melinePt = melinePool[i];
+          melinePool[i] = NULL;
+        }
+        else {
+          melinePt = new vpMbtMeLine;
+        }
         melinePt->setMe(me);
 
         //    meline[i]->setDisplay(vpMeSite::RANGE_RESULT);
@@ -394,13 +409,15 @@ vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vpHomog
         try
         {
           melinePt->initTracking(I,ip1,ip2,rho,theta);
+          updateMovingEdgeCounters(melinePt);
           meline.push_back(melinePt);
-  //        nbFeature.push_back((unsigned int) melinePt->getMeList().size());
+  //        nbFeature.push_back((unsigned int) melinePt->getMeSites().size());
   //        nbFeatureTotal += nbFeature.back();
         }
         catch(...)
         {
           //vpTRACE("the line can't be initialized");
+          updateMovingEdgeCounters(melinePt);
           delete melinePt;
           isvisible = false;
           return false;
@@ -454,19 +471,13 @@ vpMbtDistanceLine::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomo
       nbFeatureTotal = 0;
       for(unsigned int i = 0 ; i < meline.size() ; i++){
         meline[i]->track(I);
-        nbFeature.push_back((unsigned int) meline[i]->getMeList().size());
-        nbFeatureTotal += (unsigned int) meline[i]->getMeList().size();
+        nbFeature.push_back((unsigned int) meline[i]->getMeSites().size());
+        nbFeatureTotal += (unsigned int) meline[i]->getMeSites().size();
       }
     }
     catch(...)
     {
-      for(unsigned int i = 0 ; i < meline.size() ; i++){
-        if (meline[i] != NULL) delete meline[i];
-      }
-
-      nbFeature.clear();
-      meline.clear();
-      nbFeatureTotal = 0;
+      resetMovingEdge();
       Reinit = true;
       isvisible = false;
     }
@@ -504,13 +515,7 @@ vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHom
       }
 
       if(linesLst.size() != meline.size() || linesLst.size() == 0){
-        for(unsigned int i = 0 ; i < meline.size() ; i++){
-          if (meline[i] != NULL) delete meline[i];
-        }
-
-        meline.clear();
-        nbFeature.clear();
-        nbFeatureTotal = 0;
+        resetMovingEdge();
         isvisible = false;
         Reinit = true;
       }
@@ -554,31 +559,21 @@ vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHom
             if (ip1.get_i()<ip2.get_i()) { meline[i]->imin = (int)ip1.get_i()-marge ; meline[i]->imax = (int)ip2.get_i()+marge ; } else{ meline[i]->imin = (int)ip2.get_i()-marge ; meline[i]->imax = (int)ip1.get_i()+marge ; }
 
               meline[i]->updateParameters(I,ip1,ip2,rho,theta);
-              nbFeature[i] = (unsigned int)meline[i]->getMeList().size();
+              updateMovingEdgeCounters(meline[i]);
+              nbFeature[i] = (unsigned int)meline[i]->getMeSites().size();
               nbFeatureTotal += nbFeature[i];
           }
         }
         catch(...)
         {
-          for(unsigned int j = 0 ; j < meline.size() ; j++){
-            if (meline[j] != NULL) delete meline[j];
-          }
-
-          meline.clear();
-          nbFeature.clear();
-          nbFeatureTotal = 0;
+          resetMovingEdge();
           isvisible = false;
           Reinit = true;
         }
       }
     }
     else{
-      for(unsigned int i = 0 ; i < meline.size() ; i++){
-        if (meline[i] != NULL) delete meline[i];
-      }
-      nbFeature.clear();
-      meline.clear();
-      nbFeatureTotal = 0;
+      resetMovingEdge();
       isvisible = false;
     }
   }
@@ -596,18 +591,79 @@ vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHom
 void
 vpMbtDistanceLine::reinitMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo)
 {
+  nbReinit++;
+  resetMovingEdge();
+
+  if (initMovingEdge(I,cMo) == false)
+    Reinit = true;
+
+  Reinit = false;
+}
+
+/*!
+  Remove the moving edges of the line. They are kept to be reused by the next
+  initialization, see vpMe::setSampleReuseThreshold().
+*/
+void
+vpMbtDistanceLine::resetMovingEdge()
+{
+  if (melinePool.size() < meline.size())
+    melinePool.resize(meline.size(), NULL);
+
   for(unsigned int i = 0 ; i < meline.size() ; i++){
-    if (meline[i] != NULL) delete meline[i];
+    if (meline[i] != NULL){
+      if (melinePool[i] != NULL) delete melinePool[i];
+      melinePool[i] = meline[i];
+    }
   }
 
-  nbFeature.clear();
   meline.clear();
+  nbFeature.clear();
   nbFeatureTotal = 0;
+}
 
-  if (initMovingEdge(I,cMo) == false)
-    Reinit = true;
+/*!
+  Get the counters of the moving edges of the line since the creation of the
+  line or the last call to resetMovingEdgeCounters().
+
+  \param nb_reinit : Number of reinitializations of the line, see reinitMovingEdge().
+  \param nb_sampling : Number of times the moving edges have been sampled
+  along the line, when they are initialized or when too many of them are lost.
+  \param nb_reused_sampling : Number of times the moving edges of a previous
+  sampling have been reused instead, see vpMe::setSampleReuseThreshold().
+*/
+void
+vpMbtDistanceLine::getMovingEdgeCounters(unsigned int &nb_reinit, unsigned int &nb_sampling,
+                                         unsigned int &nb_reused_sampling) const
+{
+  nb_reinit = nbReinit;
+  nb_sampling = nbSampling;
+  nb_reused_sampling = nbReusedSampling;
+}
 
-  Reinit = false;
+/*!
+  Reset the counters returned by getMovingEdgeCounters().
+*/
+void
+vpMbtDistanceLine::resetMovingEdgeCounters()
+{
+  nbReinit = 0;
+  nbSampling = 0;
+  nbReusedSampling = 0;
+}
+
+/*!
+  Add the samplings done by a moving edge line to the counters of the line.
+
+  \param melinePt : The moving edge line.
+*/
+void
+vpMbtDistanceLine::updateMovingEdgeCounters(vpMbtMeLine *melinePt)
+{
+  nbSampling += melinePt->nbSampling;
+  nbReusedSampling += melinePt->nbReusedSampling;
+  melinePt->nbSampling = 0;
+  melinePt->nbReusedSampling = 0;
 }
 
 
@@ -757,7 +813,7 @@ vpMbtDistanceLine::initInteractionMatrixError()
     for(unsigned int i = 0 ; i < meline.size() ; i++) {
       nbFeature[i] = 0;
       //To be consistent with nbFeature[i] = 0
-      std::list<vpMeSite>& me_site_list = meline[i]->getMeList();
+      std::vector<vpMeSite>& me_site_list = meline[i]->getMeSites();
       me_site_list.clear();
     }
     nbFeatureTotal = 0;
@@ -798,7 +854,7 @@ vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix &cMo)
     unsigned int j =0;
 
     for(unsigned int i = 0 ; i < meline.size() ; i++){
-      for(std::list<vpMeSite>::const_iterator it=meline[i]->getMeList().begin(); it!=meline[i]->getMeList().end(); ++it){
+      for(std::vector<vpMeSite>::const_iterator it=meline[i]->getMeSites().begin(); it!=meline[i]->getMeSites().end(); ++it){
         x = (double)it->j;
         y = (double)it->i;
 
@@ -837,7 +893,7 @@ vpMbtDistanceLine::closeToImageBorder(const vpImage<unsigned char>& I, const uns
   if (isvisible){
 
     for(unsigned int i = 0 ; i < meline.size() ; i++){
-      for(std::list<vpMeSite>::const_iterator it=meline[i]->getMeList().begin(); it!=meline[i]->getMeList().end(); ++it){
+      for(std::vector<vpMeSite>::const_iterator it=meline[i]->getMeSites().begin(); it!=meline[i]->getMeSites().end(); ++it){
         int i_ = it->i;
         int j_ = it->j;
 
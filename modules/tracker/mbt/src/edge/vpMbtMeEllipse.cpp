@@ -85,7 +85,7 @@ vpMbtMeEllipse::vpMbtMeEllipse(const vpMbtMeEllipse &meellipse)
 */
 vpMbtMeEllipse::~vpMbtMeEllipse()
 {
-  list.clear();
+  meSites.clear();
 }
 
 /*!
@@ -196,7 +196,8 @@ vpMbtMeEllipse::computeProjectionError(const vpImage<unsigned char>& _I, double
   int height = (int) _I.getHeight();
   int width = (int) _I.getWidth();
 
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
     double iSite = it->ifloat;
     double jSite = it->jfloat;
 
@@ -318,7 +319,9 @@ vpMbtMeEllipse::sample(const vpImage<unsigned char> & I)
   expecteddensity = 0;//nb_points_to_track;
 
   // Delete old list
-  list.clear();
+  std::vector<vpMeSite> &sites = getMeSites();
+  sites.clear();
+  sites.reserve((size_t)(std::max)(nb_points_to_track, 0));
 
   // sample positions
   double k = 0;
@@ -346,7 +349,7 @@ vpMbtMeEllipse::sample(const vpImage<unsigned char> & I)
       pix.setDisplay(selectDisplay);
       pix.setState(vpMeSite::NO_SUPPRESSION);
 
-      list.push_back(pix);
+      sites.push_back(pix);
       expecteddensity ++;
     }
     k += incr;
@@ -395,9 +398,9 @@ vpMbtMeEllipse::reSample(const vpImage<unsigned char>  &I)
 void
 vpMbtMeEllipse::updateTheta()
 {
-  vpMeSite p_me;
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
-    p_me = *it;
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::iterator it=sites.begin(); it!=sites.end(); ++it){
+    vpMeSite &p_me = *it;
     vpImagePoint iP;
     iP.set_i(p_me.ifloat);
     iP.set_j(p_me.jfloat);
@@ -408,7 +411,6 @@ vpMbtMeEllipse::updateTheta()
         - M_PI/2;
 
     p_me.alpha = theta;
-    *it = p_me;
   }
 }
 
@@ -418,14 +420,7 @@ vpMbtMeEllipse::updateTheta()
 void
 vpMbtMeEllipse::suppressPoints()
 {
-  // Loop through list of sites to track
-  for(std::list<vpMeSite>::iterator itList=list.begin(); itList!=list.end();){
-    vpMeSite s = *itList;//current reference pixel
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      itList = list.erase(itList);
-    else
-      ++itList;
-  }
+  vpMeTracker::suppressPoints();
 }
 
 /*!
@@ -45,7 +45,7 @@
 */
 #include <cmath>    // std::fabs
 #include <limits>   // numeric_limits
-#include <algorithm>    // (std::min)
+#include <algorithm>    // (std::min), std::stable_sort
 
 #include <visp3/mbt/vpMbtMeLine.h>
 #include <visp3/core/vpTrackingException.h>
@@ -65,8 +65,8 @@ normalizeAngle(double &delta)
 */
 vpMbtMeLine::vpMbtMeLine()
   : rho(0.), theta(0.), theta_1(M_PI/2), delta(0.), delta_1(0), sign(1),
-    a(0.), b(0.), c(0.), imin(0), imax(0), jmin(0), jmax(0),
-    expecteddensity(0.)
+    a(0.), b(0.), c(0.), samples(), samplesRows(0), samplesCols(0), imin(0), imax(0), jmin(0), jmax(0),
+    expecteddensity(0.), nbSampling(0), nbReusedSampling(0)
 {
 }
 
@@ -75,7 +75,17 @@ vpMbtMeLine::vpMbtMeLine()
 */
 vpMbtMeLine::~vpMbtMeLine()
 {
-  list.clear();
+  meSites.clear();
+}
+
+/*!
+  Forget the sites of the last sampling, so that the next initialization
+  samples the line again. To call when the moving edge parameters change.
+*/
+void
+vpMbtMeLine::clearSamples()
+{
+  samples.clear();
 }
 
 /*!
@@ -117,8 +127,9 @@ vpMbtMeLine::initTracking(const vpImage<unsigned char> &I, const vpImagePoint &i
     normalizeAngle(delta);
     delta_1 = delta;
 
-    sample(I);
-    expecteddensity = (double)list.size();
+    if (!reuseSamples(I))
+      sample(I);
+    expecteddensity = (double)getMeSites().size();
 
     vpMeTracker::track(I);
   }
@@ -167,7 +178,9 @@ vpMbtMeLine::sample(const vpImage<unsigned char>& I)
   double js = PExt[1].jfloat;
 
   // Delete old list
-  list.clear();
+  std::vector<vpMeSite> &sites = getMeSites();
+  sites.clear();
+  sites.reserve((size_t)vpMath::round(n_sample) + 1);
 
   // sample positions at i*me->getSampleStep() interval along the
   // line_p, starting at PSiteExt[0]
@@ -192,15 +205,62 @@ vpMbtMeLine::sample(const vpImage<unsigned char>& I)
 	      vpDisplay::displayCross(I, ip, 2, vpColor::blue);
       }
 
-      list.push_back(pix);
+      sites.push_back(pix);
     }
     is += stepi;
     js += stepj;
 
   }
 
+  nbSampling++;
+  if (me->getSampleReuseThreshold() > 0) {
+    samples = sites;
+    samplesExt[0] = PExt[0];
+    samplesExt[1] = PExt[1];
+    samplesRows = I.getHeight();
+    samplesCols = I.getWidth();
+  }
+  else {
+    samples.clear();
+  }
+
   vpCDEBUG(1) << "end vpMeLine::sample() : ";
-  vpCDEBUG(1) << list.size() << " point inserted in the list " << std::endl;
+  vpCDEBUG(1) << sites.size() << " point inserted in the list " << std::endl;
+}
+
+/*!
+  Reuse the sites of the last sampling instead of sampling the line again,
+  when the extremities of the line moved less than
+  vpMe::getSampleReuseThreshold() pixels since this sampling. The sites keep
+  their last position and get the current orientation of the line.
+
+  \param I : Image in which the line appears.
+
+  \return true if the sites have been reused, false if the line has to be sampled.
+*/
+bool
+vpMbtMeLine::reuseSamples(const vpImage<unsigned char> &I)
+{
+  double threshold = me->getSampleReuseThreshold();
+  if (threshold <= 0 || samples.empty() || samplesRows != I.getHeight() || samplesCols != I.getWidth())
+    return false;
+
+  for (unsigned int k = 0; k < 2; k++) {
+    double di = PExt[k].ifloat - samplesExt[k].ifloat;
+    double dj = PExt[k].jfloat - samplesExt[k].jfloat;
+    if (di*di + dj*dj >= threshold*threshold)
+      return false;
+  }
+
+  std::vector<vpMeSite> &sites = getMeSites();
+  sites = samples;
+  for (std::vector<vpMeSite>::iterator it = sites.begin(); it != sites.end(); ++it) {
+    it->alpha = delta;
+    it->setState(vpMeSite::NO_SUPPRESSION);
+  }
+  nbReusedSampling++;
+
+  return true;
 }
 
 
@@ -212,8 +272,9 @@ vpMbtMeLine::sample(const vpImage<unsigned char>& I)
 void
 vpMbtMeLine::suppressPoints(const vpImage<unsigned char> & I)
 {
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ){
-    vpMeSite s = *it;//current reference pixel
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::iterator it=sites.begin(); it!=sites.end(); ++it){
+    vpMeSite &s = *it;//current reference pixel
 
     if (fabs(sin(theta)) > 0.9) // Vertical line management
     {
@@ -244,12 +305,9 @@ vpMbtMeLine::suppressPoints(const vpImage<unsigned char> & I)
     {
       s.setState(vpMeSite::TOO_NEAR);
     }
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      it = list.erase(it);
-    else
-      ++it;
   }
+
+  vpMeTracker::suppressPoints();
 }
 
 
@@ -296,6 +354,7 @@ vpMbtMeLine::seekExtremities(const vpImage<unsigned char> &I)
   unsigned int  memory_range = me->getRange();
   me->setRange(1);
 
+  std::vector<vpMeSite> &sites = getMeSites();
   for (int i=0 ; i < 3 ; i++)
   {
     P.ifloat = P.ifloat + di*sample_step ; P.i = (int)P.ifloat;
@@ -312,7 +371,7 @@ vpMbtMeLine::seekExtremities(const vpImage<unsigned char> &I)
 
       if (P.getState() == vpMeSite::NO_SUPPRESSION)
       {
-        list.push_back(P);
+        sites.push_back(P);
         if (vpDEBUG_ENABLE(3)) vpDisplay::displayCross(I,P.i,P.j, 5, vpColor::green);
       }
       else
@@ -339,7 +398,7 @@ vpMbtMeLine::seekExtremities(const vpImage<unsigned char> &I)
 
       if (P.getState() == vpMeSite::NO_SUPPRESSION)
       {
-        list.push_back(P);
+        sites.push_back(P);
         if (vpDEBUG_ENABLE(3)) vpDisplay::displayCross(I,P.i,P.j, 5, vpColor::green);
       }
       else
@@ -468,8 +527,9 @@ vpMbtMeLine::computeProjectionError(const vpImage<unsigned char>& _I, double &_s
 
   double offset = std::floor(filterX.getRows() / 2.0f);
 
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
-    if(iter != 0 && iter+1 != list.size()){
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
+    if(iter != 0 && iter+1 != sites.size()){
       double gradientX = 0;
       double gradientY = 0;
 
@@ -556,7 +616,7 @@ vpMbtMeLine::reSample(const vpImage<unsigned char> &I)
     double delta_new = delta;
     delta = delta_1;
     sample(I);
-    expecteddensity = (double)list.size();
+    expecteddensity = (double)getMeSites().size();
     delta = delta_new;
     //  2. On appelle ce qui n'est pas specifique
     {
@@ -581,7 +641,7 @@ vpMbtMeLine::reSample(const vpImage<unsigned char> &I)
 void
 vpMbtMeLine::reSample(const vpImage<unsigned char> &I, vpImagePoint ip1, vpImagePoint ip2)
 {
-  size_t n = list.size();
+  size_t n = getMeSites().size();
 
   if ((double)n<0.5*expecteddensity /*&& n > 0*/) // n is always > 0
   {
@@ -591,8 +651,9 @@ vpMbtMeLine::reSample(const vpImage<unsigned char> &I, vpImagePoint ip1, vpImage
     PExt[0].jfloat = (float)ip1.get_j();
     PExt[1].ifloat = (float)ip2.get_i();
     PExt[1].jfloat = (float)ip2.get_j();
-    sample(I);
-    expecteddensity = (double)list.size();
+    if (!reuseSamples(I))
+      sample(I);
+    expecteddensity = (double)getMeSites().size();
     delta = delta_new;
     vpMeTracker::track(I);
   }
@@ -604,8 +665,6 @@ vpMbtMeLine::reSample(const vpImage<unsigned char> &I, vpImagePoint ip1, vpImage
 void
 vpMbtMeLine::updateDelta()
 {
-  vpMeSite p_me;
-
   double diff = 0;
 
   //if(fabs(theta) == M_PI )
@@ -623,11 +682,10 @@ vpMbtMeLine::updateDelta()
   delta = - theta + M_PI/2.0;
   normalizeAngle(delta);
 
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
-    p_me = *it;
-    p_me.alpha = delta;
-    p_me.mask_sign = sign;
-    *it = p_me;
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::iterator it=sites.begin(); it!=sites.end(); ++it){
+    it->alpha = delta;
+    it->mask_sign = sign;
   }
   delta_1 = delta;
 }
@@ -729,8 +787,9 @@ vpMbtMeLine::setExtremities()
   double j_max = -1;
 
   // Loop through list of sites to track
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
-    vpMeSite s = *it;//current reference pixel
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
+    const vpMeSite &s = *it;//current reference pixel
     if (s.ifloat < i_min)
     {
       i_min = s.ifloat;
@@ -744,7 +803,7 @@ vpMbtMeLine::setExtremities()
     }
   }
 
-  if ( ! list.empty() )
+  if ( ! sites.empty() )
   {
     PExt[0].ifloat = i_min;
     PExt[0].jfloat = j_min;
@@ -754,8 +813,8 @@ vpMbtMeLine::setExtremities()
 
   if (fabs(i_min-i_max) < 25)
   {
-    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
-      vpMeSite s = *it;//current reference pixel
+    for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
+      const vpMeSite &s = *it;//current reference pixel
       if (s.jfloat < j_min)
       {
         i_min = s.ifloat;
@@ -769,7 +828,7 @@ vpMbtMeLine::setExtremities()
       }
     }
 
-    if (! list.empty())
+    if (! sites.empty())
     {
       PExt[0].ifloat = i_min;
       PExt[0].jfloat = j_min;
@@ -807,7 +866,8 @@ vpMbtMeLine::bubbleSortI()
     }
   }
 #endif
-  list.sort(sortByI);
+  std::vector<vpMeSite> &sites = getMeSites();
+  std::stable_sort(sites.begin(), sites.end(), sortByI);
 }
 
 
@@ -834,7 +894,8 @@ vpMbtMeLine::bubbleSortJ()
     }
   }
 #endif
-  list.sort(sortByJ);
+  std::vector<vpMeSite> &sites = getMeSites();
+  std::stable_sort(sites.begin(), sites.end(), sortByJ);
 }
 
 #endif
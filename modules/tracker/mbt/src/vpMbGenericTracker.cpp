@@ -2777,6 +2777,23 @@ void vpMbGenericTracker::setMovingEdge(const std::map<std::string, vpMe> &mapOfM
   }
 }
 
+/*!
+  Set the number of threads used to track the moving edges. With a value
+  lower or equal to 0, OpenMP chooses the number of threads.
+
+  \param nbThreads : Number of threads.
+
+  \note This function will set the new parameter for all the cameras.
+
+  \sa vpMbEdgeTracker::setNbThreads()
+*/
+void vpMbGenericTracker::setNbThreads(const int nbThreads) {
+  for(std::map<std::string, TrackerWrapper*>::const_iterator it = m_mapOfTrackers.begin(); it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setNbThreads(nbThreads);
+  }
+}
+
 /*!
   Set the near distance for clipping.
 
@@ -71,6 +71,11 @@
 #include <visp3/core/vpIoTools.h>
 #include <visp3/core/vpTrackingException.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
 #ifdef VISP_HAVE_COIN3D
 //Inventor includes
 #include <Inventor/nodes/SoSeparator.h>
@@ -97,14 +102,24 @@ namespace {
     Structure to store info about segment in CAO model files.
    */
   struct SegmentInfo {
-    SegmentInfo() : extremities(), name(), useLod(false), minLineLengthThresh(0.) {}
+    SegmentInfo() : extremities(), primitive() {}
 
-    std::vector<vpPoint> extremities;
-    std::string name;
-    bool useLod;
-    double minLineLengthThresh;
+    std::vector<unsigned int> extremities;
+    vpMbtCompiledModel::vpPrimitive primitive;
   };
 
+  /*!
+    Print the number of primitives declared in the CAO files of a model.
+   */
+  void printModelSummary(const vpMbtCompiledModel &model) {
+    std::cout << "> " << model.getNbPoints() << " points" << std::endl;
+    std::cout << "> " << model.getNbLines() << " lines" << std::endl;
+    std::cout << "> " << model.getNbPolygonLines() << " polygon lines" << std::endl;
+    std::cout << "> " << model.getNbPolygonPoints() << " polygon points" << std::endl;
+    std::cout << "> " << model.getNbCylinders() << " cylinders" << std::endl;
+    std::cout << "> " << model.getNbCircles() << " circles" << std::endl;
+  }
+
   /*!
     Structure to store info about a polygon face represented by a vpPolygon and by a list of vpPoint
     representing the corners of the polygon face in 3D.
@@ -1059,11 +1074,17 @@ int main()
 }
   \endcode
 
+  A binary file created by saveCompiledModel() from a CAO file can also be
+  loaded (.bin extension). It is faster to load than the CAO file since it
+  does not need to be parsed. When the in-memory cache of compiled models is
+  enabled with vpMbtCompiledModel::setCacheEnabled(), a CAO file that has
+  already been loaded and that has not been modified since is not parsed again.
+
   \throw vpException::ioError if the file cannot be open, or if its extension is
-  not wrl or cao.
+  not wrl, cao or bin.
 
   \param modelFile : the file containing the the 3D model description.
-  The extension of this file is either .wrl or .cao.
+  The extension of this file is either .wrl, .cao or .bin.
   \param verbose : verbose option to print additional information when loading CAO model files which include other
   CAO model files.
 */
@@ -1090,11 +1111,17 @@ int main()
 }
   \endcode
 
+  A binary file created by saveCompiledModel() from a CAO file can also be
+  loaded (.bin extension). It is faster to load than the CAO file since it
+  does not need to be parsed. When the in-memory cache of compiled models is
+  enabled with vpMbtCompiledModel::setCacheEnabled(), a CAO file that has
+  already been loaded and that has not been modified since is not parsed again.
+
   \throw vpException::ioError if the file cannot be open, or if its extension is
-  not wrl or cao.
+  not wrl, cao or bin.
 
   \param modelFile : the file containing the the 3D model description.
-  The extension of this file is either .wrl or .cao.
+  The extension of this file is either .wrl, .cao or .bin.
   \param verbose : verbose option to print additional information when loading CAO model files which include other
   CAO model files.
 */
@@ -1107,7 +1134,22 @@ vpMbTracker::loadModel(const std::string& modelFile, const bool verbose)
     it = modelFile.end();
     if((*(it-1) == 'o' && *(it-2) == 'a' && *(it-3) == 'c' && *(it-4) == '.') ||
        (*(it-1) == 'O' && *(it-2) == 'A' && *(it-3) == 'C' && *(it-4) == '.') ){
-      std::vector<std::string> vectorOfModelFilename;
+      std::string absoluteModelFile = vpIoTools::getAbsolutePathname(modelFile);
+      vpMbtCompiledModel model;
+      if (vpMbtCompiledModel::getCache(absoluteModelFile, model)) {
+        if(verbose) {
+          std::cout << "Model file : " << modelFile << " (cached)" << std::endl;
+        }
+        printModelSummary(model);
+      }
+      else {
+        std::vector<std::string> vectorOfModelFilename;
+        int endIdFace = 0;
+        compileCAOModel(modelFile, model, vectorOfModelFilename, endIdFace, verbose, true);
+        model.setEndIdFace(endIdFace);
+        vpMbtCompiledModel::setCache(absoluteModelFile, model);
+      }
+
       int startIdFace = (int)faces.size();
       nbPoints = 0;
       nbLines = 0;
@@ -1115,14 +1157,32 @@ vpMbTracker::loadModel(const std::string& modelFile, const bool verbose)
       nbPolygonPoints = 0;
       nbCylinders = 0;
       nbCircles = 0;
-      loadCAOModel(modelFile, vectorOfModelFilename, startIdFace, verbose, true);
+      loadCompiledModel(model, startIdFace);
+    }
+    else if((*(it-1) == 'n' && *(it-2) == 'i' && *(it-3) == 'b' && *(it-4) == '.') ||
+            (*(it-1) == 'N' && *(it-2) == 'I' && *(it-3) == 'B' && *(it-4) == '.') ){
+      vpMbtCompiledModel model;
+      model.load(modelFile);
+      if(verbose) {
+        std::cout << "Compiled model file : " << modelFile << std::endl;
+      }
+      printModelSummary(model);
+
+      int startIdFace = (int)faces.size();
+      nbPoints = 0;
+      nbLines = 0;
+      nbPolygonLines = 0;
+      nbPolygonPoints = 0;
+      nbCylinders = 0;
+      nbCircles = 0;
+      loadCompiledModel(model, startIdFace);
     }
     else if((*(it-1) == 'l' && *(it-2) == 'r' && *(it-3) == 'w' && *(it-4) == '.') ||
             (*(it-1) == 'L' && *(it-2) == 'R' && *(it-3) == 'W' && *(it-4) == '.') ){
       loadVRMLModel(modelFile);
     }
     else{
-      throw vpException(vpException::ioError, "Error: File %s doesn't contain a cao or wrl model", modelFile.c_str());
+      throw vpException(vpException::ioError, "Error: File %s doesn't contain a cao, bin or wrl model", modelFile.c_str());
     }
   }
   else{
@@ -1133,6 +1193,35 @@ vpMbTracker::loadModel(const std::string& modelFile, const bool verbose)
   this->modelFileName = modelFile;
 }
 
+/*!
+  Parse a CAO model file and the files it includes, and save the result in a
+  binary file that can then be loaded with loadModel(). The compiled file
+  keeps the optional parameters of the primitives as they are given in the CAO
+  file: the LOD settings of the tracker are applied when the compiled file is
+  loaded. The tracker is not modified.
+
+  \param modelFile : The *.cao file containing the 3D model description.
+  \param compiledFile : The binary file to create, with a .bin extension.
+  \param verbose : verbose option to print additional information when parsing CAO model files which include other
+  CAO model files.
+
+  \throw vpException::ioError if a file cannot be read or written.
+*/
+void
+vpMbTracker::saveCompiledModel(const std::string& modelFile, const std::string& compiledFile, const bool verbose)
+{
+  if(!vpIoTools::checkFilename(modelFile)) {
+    throw vpException(vpException::ioError, "Error: File %s doesn't exist", modelFile.c_str());
+  }
+
+  vpMbtCompiledModel model;
+  std::vector<std::string> vectorOfModelFilename;
+  int endIdFace = 0;
+  compileCAOModel(modelFile, model, vectorOfModelFilename, endIdFace, verbose, true);
+  model.setEndIdFace(endIdFace);
+  model.save(compiledFile);
+}
+
 
 /*!
   Load the 3D model of the object from a vrml file. Only LineSet and FaceSet are
@@ -1212,6 +1301,115 @@ vpMbTracker::loadVRMLModel(const std::string& modelFile)
 #endif
 }
 
+/*!
+  Add the faces, lines, cylinders and circles of a compiled model to the
+  tracker. The optional parameters that are not given in the model are set
+  from the current LOD settings of the tracker.
+
+  \param model : The compiled model.
+  \param startIdFace : Id of the first face of the model. It is increased by the
+  number of face ids used by the model.
+*/
+void
+vpMbTracker::loadCompiledModel(const vpMbtCompiledModel &model, int &startIdFace)
+{
+  const std::vector<double> &coordinates = model.getPoints();
+  const std::vector<unsigned int> &indexes = model.getIndexes();
+  const std::vector<vpMbtCompiledModel::vpPrimitive> &primitives = model.getPrimitives();
+
+  std::vector<vpPoint> points(coordinates.size() / 3);
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i].setWorldCoordinates(coordinates[3*i], coordinates[3*i+1], coordinates[3*i+2]);
+  }
+
+  const bool defaultUseLod = !applyLodSettingInConfig ? useLodGeneral : false;
+  const double defaultMinLineLengthThreshold = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
+  const double defaultMinPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
+
+  std::vector<vpPoint> corners;
+  for (std::vector<vpMbtCompiledModel::vpPrimitive>::const_iterator it = primitives.begin(); it != primitives.end(); ++it) {
+    corners.resize(it->nbIndex);
+    for (unsigned int i = 0; i < it->nbIndex; i++) {
+      corners[i] = points[indexes[it->firstIndex + i]];
+    }
+
+    const int idFace = startIdFace + it->idFace;
+    const bool useLod = it->hasUseLod ? it->useLod : defaultUseLod;
+
+    switch (it->type) {
+    case vpMbtCompiledModel::FACE_FROM_LINES:
+      addPolygon(corners, idFace, it->name, useLod, it->hasThreshold ? it->threshold : defaultMinPolygonAreaThreshold,
+                 minLineLengthThresholdGeneral);
+      initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      break;
+
+    case vpMbtCompiledModel::FACE_FROM_CORNERS:
+      addPolygon(corners, idFace, it->name, useLod, it->hasThreshold ? it->threshold : defaultMinPolygonAreaThreshold,
+                 minLineLengthThresholdGeneral);
+      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      break;
+
+    case vpMbtCompiledModel::SEGMENT:
+      addPolygon(corners, idFace, it->name, useLod, minPolygonAreaThresholdGeneral,
+                 it->hasThreshold ? it->threshold : defaultMinLineLengthThreshold);
+      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      break;
+
+    case vpMbtCompiledModel::CYLINDER: {
+      const double minLineLengthThreshold = it->hasThreshold ? it->threshold : defaultMinLineLengthThreshold;
+      addPolygon(corners[0], corners[1], idFace, it->name, useLod, minLineLengthThreshold);
+
+      std::vector<std::vector<vpPoint> > listFaces;
+      createCylinderBBox(corners[0], corners[1], it->radius, listFaces);
+      addPolygon(listFaces, idFace + 1, it->name, useLod, minLineLengthThreshold);
+
+      initCylinder(corners[0], corners[1], it->radius, idFace, it->name);
+      break;
+    }
+
+    case vpMbtCompiledModel::CIRCLE:
+      addPolygon(corners[0], corners[1], corners[2], it->radius, idFace, it->name, useLod,
+                 it->hasThreshold ? it->threshold : defaultMinPolygonAreaThreshold);
+      initCircle(corners[0], corners[1], corners[2], it->radius, idFace, it->name);
+      break;
+    }
+  }
+
+  startIdFace += model.getEndIdFace();
+
+  nbPoints += model.getNbPoints();
+  nbLines += model.getNbLines();
+  nbPolygonLines += model.getNbPolygonLines();
+  nbPolygonPoints += model.getNbPolygonPoints();
+  nbCylinders += model.getNbCylinders();
+  nbCircles += model.getNbCircles();
+}
+
+/*!
+  Set the optional parameters of a primitive from the parameters parsed at the
+  end of a line of a CAO file.
+
+  \param mapOfParams : Parameters returned by parseParameters().
+  \param thresholdName : Name of the LOD threshold parameter of the primitive
+  (minLineLengthThreshold or minPolygonAreaThreshold).
+  \param primitive : The primitive to update.
+*/
+void vpMbTracker::getPrimitiveParameters(std::map<std::string, std::string> &mapOfParams,
+                                         const std::string &thresholdName,
+                                         vpMbtCompiledModel::vpPrimitive &primitive) {
+  if(mapOfParams.find("name") != mapOfParams.end()) {
+    primitive.name = mapOfParams["name"];
+  }
+  if(mapOfParams.find(thresholdName) != mapOfParams.end()) {
+    primitive.hasThreshold = true;
+    primitive.threshold = std::atof(mapOfParams[thresholdName].c_str());
+  }
+  if(mapOfParams.find("useLod") != mapOfParams.end()) {
+    primitive.hasUseLod = true;
+    primitive.useLod = parseBoolean(mapOfParams["useLod"]);
+  }
+}
+
 void vpMbTracker::removeComment(std::ifstream& fileId) {
   char c;
 
@@ -1317,6 +1515,9 @@ std::map<std::string, std::string> vpMbTracker::parseParameters(std::string& end
   0.5 0 1 2 // radius, index center point, index 2 other points on the plane containing the circle
   \endcode
 
+  The file is first parsed by compileCAOModel() and the resulting model is then
+  added to the tracker by loadCompiledModel().
+
   \param modelFile : Full name of the main *.cao file containing the model.
   \param vectorOfModelFilename : A vector of *.cao files.
   \param startIdFace : Current Id of the face.
@@ -1328,6 +1529,33 @@ void
 vpMbTracker::loadCAOModel(const std::string& modelFile,
                           std::vector<std::string>& vectorOfModelFilename, int& startIdFace,
                           const bool verbose, const bool parent) {
+  vpMbtCompiledModel model;
+  int endIdFace = 0;
+  compileCAOModel(modelFile, model, vectorOfModelFilename, endIdFace, verbose, parent);
+  model.setEndIdFace(endIdFace);
+
+  loadCompiledModel(model, startIdFace);
+}
+
+/*!
+  Parse a *.cao file and the files it includes, without modifying the tracker.
+  The format of the file is described in loadCAOModel().
+
+  The face ids stored in the compiled model start from the value of \e startIdFace
+  given for the main file, usually 0.
+
+  \param modelFile : Full name of the main *.cao file containing the model.
+  \param model : The parsed model. The primitives of \e modelFile are appended to it.
+  \param vectorOfModelFilename : A vector of *.cao files.
+  \param startIdFace : Current Id of the face, relative to the first face of the model.
+  \param verbose : If true, will print additional information with CAO model files which include other CAO model files.
+  \param parent : This parameter is set to true when parsing a parent CAO model file, and false when parsing an included
+  CAO model file.
+*/
+void
+vpMbTracker::compileCAOModel(const std::string& modelFile, vpMbtCompiledModel &model,
+                             std::vector<std::string>& vectorOfModelFilename, int& startIdFace,
+                             const bool verbose, const bool parent) {
   std::ifstream fileId;
   fileId.exceptions(std::ifstream::failbit | std::ifstream::eofbit);
   fileId.open(modelFile.c_str(), std::ifstream::in);
@@ -1340,6 +1568,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       std::cout << "Model file : " << modelFile << std::endl;
   }
   vectorOfModelFilename.push_back(modelFile);
+  model.addSourceFile(vpIoTools::getAbsolutePathname(modelFile));
 
   try {
     char c;
@@ -1404,7 +1633,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
 
         if (!cyclic) {
           if (vpIoTools::checkFilename(headerPath)) {
-            loadCAOModel(headerPath, vectorOfModelFilename, startIdFace, verbose, false);
+            compileCAOModel(headerPath, model, vectorOfModelFilename, startIdFace, verbose, false);
           } else {
             throw vpException(vpException::ioError, "file cannot be open");
           }
@@ -1427,7 +1656,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
     fileId >> caoNbrPoint;
     fileId.ignore(256, '\n'); // skip the rest of the line
 
-    nbPoints += caoNbrPoint;
+    model.increaseCounters(caoNbrPoint, 0, 0, 0, 0, 0);
     if(verbose || vectorOfModelFilename.size() == 1) {
       std::cout << "> " << caoNbrPoint << " points" << std::endl;
     }
@@ -1441,7 +1670,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       throw vpException(vpException::badValue,
                         "in vpMbTracker::loadCAOModel() -> no points are defined");
     }
-    vpPoint *caoPoints = new vpPoint[caoNbrPoint];
+    std::vector<unsigned int> caoPoints(caoNbrPoint);
 
     double x; // 3D coordinates
     double y;
@@ -1464,7 +1693,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
 
       fileId.ignore(256, '\n'); // skip the rest of the line
 
-      caoPoints[k].setWorldCoordinates(x, y, z);
+      caoPoints[k] = model.addPoint(x, y, z);
     }
 
 
@@ -1478,20 +1707,18 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
     fileId >> caoNbrLine;
     fileId.ignore(256, '\n'); // skip the rest of the line
 
-    nbLines += caoNbrLine;
-    unsigned int *caoLinePoints = NULL;
+    model.increaseCounters(0, caoNbrLine, 0, 0, 0, 0);
+    std::vector<unsigned int> caoLinePoints;
     if(verbose || vectorOfModelFilename.size() == 1) {
       std::cout << "> " << caoNbrLine << " lines" << std::endl;
     }
 
     if (caoNbrLine > 100000) {
-      delete[] caoPoints;
       throw vpException(vpException::badValue,
                         "Exceed the max number of lines in the CAO model.");
     }
 
-    if (caoNbrLine > 0)
-      caoLinePoints = new unsigned int[2 * caoNbrLine];
+    caoLinePoints.resize(2 * caoNbrLine);
 
     unsigned int index1, index2;
     //Initialization of idFace with startIdFace for dealing with recursive load in header
@@ -1510,32 +1737,16 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       std::string endLine(buffer);
       std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-      std::string segmentName = "";
-      double minLineLengthThresh = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
-      bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-      if(mapOfParams.find("name") != mapOfParams.end()) {
-        segmentName = mapOfParams["name"];
-      }
-      if(mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
-        minLineLengthThresh = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
-      }
-      if(mapOfParams.find("useLod") != mapOfParams.end()) {
-        useLod = parseBoolean(mapOfParams["useLod"]);
-      }
-
       SegmentInfo segmentInfo;
-      segmentInfo.name = segmentName;
-      segmentInfo.useLod = useLod;
-      segmentInfo.minLineLengthThresh = minLineLengthThresh;
+      segmentInfo.primitive.type = vpMbtCompiledModel::SEGMENT;
+      getPrimitiveParameters(mapOfParams, "minLineLengthThreshold", segmentInfo.primitive);
 
       caoLinePoints[2 * k] = index1;
       caoLinePoints[2 * k + 1] = index2;
 
       if (index1 < caoNbrPoint && index2 < caoNbrPoint) {
-        std::vector<vpPoint> extremities;
-        extremities.push_back(caoPoints[index1]);
-        extremities.push_back(caoPoints[index2]);
-        segmentInfo.extremities = extremities;
+        segmentInfo.extremities.push_back(caoPoints[index1]);
+        segmentInfo.extremities.push_back(caoPoints[index2]);
 
         std::pair<unsigned int, unsigned int> key(index1, index2);
 
@@ -1556,14 +1767,12 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
     fileId >> caoNbrPolygonLine;
     fileId.ignore(256, '\n'); // skip the rest of the line
 
-    nbPolygonLines += caoNbrPolygonLine;
+    model.increaseCounters(0, 0, caoNbrPolygonLine, 0, 0, 0);
     if(verbose || vectorOfModelFilename.size() == 1) {
       std::cout << "> " << caoNbrPolygonLine << " polygon lines" << std::endl;
     }
 
     if (caoNbrPolygonLine > 100000) {
-      delete[] caoPoints;
-      delete[] caoLinePoints;
       throw vpException(vpException::badValue,
                         "Exceed the max number of polygon lines.");
     }
@@ -1574,7 +1783,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
 
       unsigned int nbLinePol;
       fileId >> nbLinePol;
-      std::vector<vpPoint> corners;
+      std::vector<unsigned int> corners;
       if (nbLinePol > 100000) {
         throw vpException(vpException::badValue, "Exceed the max number of lines.");
       }
@@ -1585,6 +1794,9 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
         if(index >= caoNbrLine) {
           throw vpException(vpException::badValue, "Exceed the max number of lines.");
         }
+        if(caoLinePoints[2 * index] >= caoNbrPoint || caoLinePoints[2 * index + 1] >= caoNbrPoint) {
+          throw vpException(vpException::badValue, "Exceed the max number of points.");
+        }
         corners.push_back(caoPoints[caoLinePoints[2 * index]]);
         corners.push_back(caoPoints[caoLinePoints[2 * index + 1]]);
 
@@ -1600,30 +1812,19 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       std::string endLine(buffer);
       std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-      std::string polygonName = "";
-      bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-      double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
-      if(mapOfParams.find("name") != mapOfParams.end()) {
-        polygonName = mapOfParams["name"];
-      }
-      if(mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-        minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
-      }
-      if(mapOfParams.find("useLod") != mapOfParams.end()) {
-        useLod = parseBoolean(mapOfParams["useLod"]);
-      }
-
-      addPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-      initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      vpMbtCompiledModel::vpPrimitive primitive;
+      primitive.type = vpMbtCompiledModel::FACE_FROM_LINES;
+      primitive.idFace = idFace++;
+      getPrimitiveParameters(mapOfParams, "minPolygonAreaThreshold", primitive);
+      model.addPrimitive(primitive, corners);
     }
 
     //Add the segments which were not already added in the face segment case
-    for(std::map<std::pair<unsigned int, unsigned int>, SegmentInfo >::const_iterator it =
+    for(std::map<std::pair<unsigned int, unsigned int>, SegmentInfo >::iterator it =
         segmentTemporaryMap.begin(); it != segmentTemporaryMap.end(); ++it) {
       if(std::find(faceSegmentKeyVector.begin(), faceSegmentKeyVector.end(), it->first) == faceSegmentKeyVector.end()) {
-        addPolygon(it->second.extremities, idFace++, it->second.name, it->second.useLod, minPolygonAreaThresholdGeneral,
-                   it->second.minLineLengthThresh);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+        it->second.primitive.idFace = idFace++;
+        model.addPrimitive(it->second.primitive, it->second.extremities);
       }
     }
 
@@ -1636,7 +1837,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
     fileId >> caoNbrPolygonPoint;
     fileId.ignore(256, '\n'); // skip the rest of the line
 
-    nbPolygonPoints += caoNbrPolygonPoint;
+    model.increaseCounters(0, 0, 0, caoNbrPolygonPoint, 0, 0);
     if(verbose || vectorOfModelFilename.size() == 1) {
       std::cout << "> " << caoNbrPolygonPoint << " polygon points"
                 << std::endl;
@@ -1656,7 +1857,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
         throw vpException(vpException::badValue,
                           "Exceed the max number of points.");
       }
-      std::vector<vpPoint> corners;
+      std::vector<unsigned int> corners;
       for (unsigned int n = 0; n < nbPointPol; n++) {
         fileId >> index;
         if (index > caoNbrPoint - 1) {
@@ -1674,22 +1875,11 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       std::string endLine(buffer);
       std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-      std::string polygonName = "";
-      bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-      double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
-      if(mapOfParams.find("name") != mapOfParams.end()) {
-        polygonName = mapOfParams["name"];
-      }
-      if(mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-        minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
-      }
-      if(mapOfParams.find("useLod") != mapOfParams.end()) {
-        useLod = parseBoolean(mapOfParams["useLod"]);
-      }
-
-
-      addPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      vpMbtCompiledModel::vpPrimitive primitive;
+      primitive.type = vpMbtCompiledModel::FACE_FROM_CORNERS;
+      primitive.idFace = idFace++;
+      getPrimitiveParameters(mapOfParams, "minPolygonAreaThreshold", primitive);
+      model.addPrimitive(primitive, corners);
     }
 
     //////////////////////////Read the cylinder declaration part//////////////////////////
@@ -1698,8 +1888,6 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       removeComment(fileId);
 
       if (fileId.eof()) { // check if not at the end of the file (for old style files)
-        delete[] caoPoints;
-        delete[] caoLinePoints;
         return;
       }
 
@@ -1707,7 +1895,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       fileId >> caoNbCylinder;
       fileId.ignore(256, '\n'); // skip the rest of the line
 
-      nbCylinders += caoNbCylinder;
+      model.increaseCounters(0, 0, 0, 0, caoNbCylinder, 0);
       if(verbose || vectorOfModelFilename.size() == 1) {
         std::cout << "> " << caoNbCylinder << " cylinders" << std::endl;
       }
@@ -1733,28 +1921,23 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
         std::string endLine(buffer);
         std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-        std::string polygonName = "";
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        double minLineLengthThreshold = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
-        if(mapOfParams.find("name") != mapOfParams.end()) {
-          polygonName = mapOfParams["name"];
-        }
-        if(mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
-          minLineLengthThreshold = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
-        }
-        if(mapOfParams.find("useLod") != mapOfParams.end()) {
-          useLod = parseBoolean(mapOfParams["useLod"]);
+        if (indexP1 >= caoNbrPoint || indexP2 >= caoNbrPoint) {
+          throw vpException(vpException::badValue,
+                            "Exceed the max number of points.");
         }
 
-        int idRevolutionAxis = idFace;
-        addPolygon(caoPoints[indexP1], caoPoints[indexP2], idFace++, polygonName, useLod, minLineLengthThreshold);
-
-        std::vector<std::vector<vpPoint> > listFaces;
-        createCylinderBBox(caoPoints[indexP1], caoPoints[indexP2], radius,listFaces);
-        addPolygon(listFaces, idFace, polygonName, useLod, minLineLengthThreshold);
-        idFace+=4;
-
-        initCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
+        vpMbtCompiledModel::vpPrimitive primitive;
+        primitive.type = vpMbtCompiledModel::CYLINDER;
+        primitive.radius = radius;
+        // The revolution axis and the 4 faces of the bounding box
+        primitive.idFace = idFace;
+        idFace += 5;
+        getPrimitiveParameters(mapOfParams, "minLineLengthThreshold", primitive);
+
+        std::vector<unsigned int> extremities;
+        extremities.push_back(caoPoints[indexP1]);
+        extremities.push_back(caoPoints[indexP2]);
+        model.addPrimitive(primitive, extremities);
       }
 
     } catch (...) {
@@ -1770,8 +1953,6 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       removeComment(fileId);
 
       if (fileId.eof()) { // check if not at the end of the file (for old style files)
-        delete[] caoPoints;
-        delete[] caoLinePoints;
         return;
       }
 
@@ -1779,7 +1960,7 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
       fileId >> caoNbCircle;
       fileId.ignore(256, '\n'); // skip the rest of the line
 
-      nbCircles += caoNbCircle;
+      model.increaseCounters(0, 0, 0, 0, 0, caoNbCircle);
       if(verbose || vectorOfModelFilename.size() == 1) {
         std::cout << "> " << caoNbCircle << " circles" << std::endl;
       }
@@ -1806,24 +1987,22 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
         std::string endLine(buffer);
         std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-        std::string polygonName = "";
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
-        if(mapOfParams.find("name") != mapOfParams.end()) {
-          polygonName = mapOfParams["name"];
-        }
-        if(mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-          minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
-        }
-        if(mapOfParams.find("useLod") != mapOfParams.end()) {
-          useLod = parseBoolean(mapOfParams["useLod"]);
+        if (indexP1 >= caoNbrPoint || indexP2 >= caoNbrPoint || indexP3 >= caoNbrPoint) {
+          throw vpException(vpException::badValue,
+                            "Exceed the max number of points.");
         }
 
-        addPolygon(caoPoints[indexP1], caoPoints[indexP2],
-                   caoPoints[indexP3], radius, idFace, polygonName, useLod, minPolygonAreaThreshold);
-
-        initCircle(caoPoints[indexP1], caoPoints[indexP2],
-                   caoPoints[indexP3], radius, idFace++, polygonName);
+        vpMbtCompiledModel::vpPrimitive primitive;
+        primitive.type = vpMbtCompiledModel::CIRCLE;
+        primitive.radius = radius;
+        primitive.idFace = idFace++;
+        getPrimitiveParameters(mapOfParams, "minPolygonAreaThreshold", primitive);
+
+        std::vector<unsigned int> circlePoints;
+        circlePoints.push_back(caoPoints[indexP1]);
+        circlePoints.push_back(caoPoints[indexP2]);
+        circlePoints.push_back(caoPoints[indexP3]);
+        model.addPrimitive(primitive, circlePoints);
       }
 
     } catch (...) {
@@ -1834,25 +2013,17 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
 
     startIdFace = idFace;
 
-    delete[] caoPoints;
-    delete[] caoLinePoints;
-
     if(vectorOfModelFilename.size() > 1 && parent) {
       if(verbose) {
         std::cout << "Global information for " << vpIoTools::getName(modelFile) << " :" << std::endl;
-        std::cout << "Total nb of points : " << nbPoints << std::endl;
-        std::cout << "Total nb of lines : " << nbLines << std::endl;
-        std::cout << "Total nb of polygon lines : " << nbPolygonLines << std::endl;
-        std::cout << "Total nb of polygon points : " << nbPolygonPoints << std::endl;
-        std::cout << "Total nb of cylinders : " << nbCylinders << std::endl;
-        std::cout << "Total nb of circles : " << nbCircles << std::endl;
+        std::cout << "Total nb of points : " << model.getNbPoints() << std::endl;
+        std::cout << "Total nb of lines : " << model.getNbLines() << std::endl;
+        std::cout << "Total nb of polygon lines : " << model.getNbPolygonLines() << std::endl;
+        std::cout << "Total nb of polygon points : " << model.getNbPolygonPoints() << std::endl;
+        std::cout << "Total nb of cylinders : " << model.getNbCylinders() << std::endl;
+        std::cout << "Total nb of circles : " << model.getNbCircles() << std::endl;
       } else {
-        std::cout << "> " << nbPoints << " points" << std::endl;
-        std::cout << "> " << nbLines << " lines" << std::endl;
-        std::cout << "> " << nbPolygonLines << " polygon lines" << std::endl;
-        std::cout << "> " << nbPolygonPoints << " polygon points" << std::endl;
-        std::cout << "> " << nbCylinders << " cylinders" << std::endl;
-        std::cout << "> " << nbCircles << " circles" << std::endl;
+        printModelSummary(model);
       }
     }
   } catch (...) {
@@ -2445,6 +2616,124 @@ vpMbTracker::computeJTR(const vpMatrix& interaction, const vpColVector& error, v
   }
 }
 
+/*!
+  Compute the normal equations \f$ L^T L \f$ and \f$ L^T R \f$ in a single
+  pass over the rows of the interaction matrix, instead of one pass per
+  coefficient as with vpMatrix::AtA() and computeJTR(). Only the upper part of
+  \f$ L^T L \f$ is accumulated, the lower part is obtained by symmetry. The
+  coefficients are summed in the same order as with vpMatrix::AtA() and
+  computeJTR(), which gives the same results.
+
+  \throw vpMatrixException::incorrectMatrixSizeError if the sizes of the
+  matrices do not allow the computation.
+
+  \param L : The interaction matrix (size Nx6), with the weights already applied.
+  \param R : The weighted residu vector (size Nx1).
+  \param LTL : The resulting 6x6 matrix \f$ L^T L \f$.
+  \param LTR : The resulting 6x1 vector \f$ L^T R \f$.
+*/
+void
+vpMbTracker::computeNormalEquations(const vpMatrix &L, const vpColVector &R, vpMatrix &LTL, vpColVector &LTR) const
+{
+  if (L.getRows() != R.getRows() || L.getCols() != 6) {
+    throw vpMatrixException(vpMatrixException::incorrectMatrixSizeError,
+                            "Incorrect matrices size in computeNormalEquations.");
+  }
+
+  const unsigned int N = L.getRows();
+  double ltl[6][6], ltr[6];
+
+#if VISP_HAVE_SSE2
+  // Row k of LTL is accumulated from the pair of columns that contains k
+  __m128d s00 = _mm_setzero_pd(), s01 = _mm_setzero_pd(), s02 = _mm_setzero_pd();
+  __m128d s10 = _mm_setzero_pd(), s11 = _mm_setzero_pd(), s12 = _mm_setzero_pd();
+  __m128d s21 = _mm_setzero_pd(), s22 = _mm_setzero_pd(), s31 = _mm_setzero_pd(), s32 = _mm_setzero_pd();
+  __m128d s42 = _mm_setzero_pd(), s52 = _mm_setzero_pd();
+  __m128d r0 = _mm_setzero_pd(), r1 = _mm_setzero_pd(), r2 = _mm_setzero_pd();
+  for (unsigned int i = 0; i < N; i++) {
+    const double *l = L[i];
+    const __m128d p0 = _mm_loadu_pd(l), p1 = _mm_loadu_pd(l + 2), p2 = _mm_loadu_pd(l + 4);
+    __m128d b = _mm_set1_pd(l[0]);
+    s00 = _mm_add_pd(s00, _mm_mul_pd(b, p0));
+    s01 = _mm_add_pd(s01, _mm_mul_pd(b, p1));
+    s02 = _mm_add_pd(s02, _mm_mul_pd(b, p2));
+    b = _mm_set1_pd(l[1]);
+    s10 = _mm_add_pd(s10, _mm_mul_pd(b, p0));
+    s11 = _mm_add_pd(s11, _mm_mul_pd(b, p1));
+    s12 = _mm_add_pd(s12, _mm_mul_pd(b, p2));
+    b = _mm_set1_pd(l[2]);
+    s21 = _mm_add_pd(s21, _mm_mul_pd(b, p1));
+    s22 = _mm_add_pd(s22, _mm_mul_pd(b, p2));
+    b = _mm_set1_pd(l[3]);
+    s31 = _mm_add_pd(s31, _mm_mul_pd(b, p1));
+    s32 = _mm_add_pd(s32, _mm_mul_pd(b, p2));
+    s42 = _mm_add_pd(s42, _mm_mul_pd(_mm_set1_pd(l[4]), p2));
+    s52 = _mm_add_pd(s52, _mm_mul_pd(_mm_set1_pd(l[5]), p2));
+    b = _mm_set1_pd(R[i]);
+    r0 = _mm_add_pd(r0, _mm_mul_pd(b, p0));
+    r1 = _mm_add_pd(r1, _mm_mul_pd(b, p1));
+    r2 = _mm_add_pd(r2, _mm_mul_pd(b, p2));
+  }
+  _mm_storeu_pd(&ltl[0][0], s00); _mm_storeu_pd(&ltl[0][2], s01); _mm_storeu_pd(&ltl[0][4], s02);
+  _mm_storeu_pd(&ltl[1][0], s10); _mm_storeu_pd(&ltl[1][2], s11); _mm_storeu_pd(&ltl[1][4], s12);
+  _mm_storeu_pd(&ltl[2][2], s21); _mm_storeu_pd(&ltl[2][4], s22);
+  _mm_storeu_pd(&ltl[3][2], s31); _mm_storeu_pd(&ltl[3][4], s32);
+  _mm_storeu_pd(&ltl[4][4], s42);
+  _mm_storeu_pd(&ltl[5][4], s52);
+  _mm_storeu_pd(&ltr[0], r0); _mm_storeu_pd(&ltr[2], r1); _mm_storeu_pd(&ltr[4], r2);
+#else
+  for (unsigned int k = 0; k < 6; k++) {
+    for (unsigned int j = k; j < 6; j++) {
+      ltl[k][j] = 0;
+    }
+    ltr[k] = 0;
+  }
+  for (unsigned int i = 0; i < N; i++) {
+    const double *l = L[i];
+    for (unsigned int k = 0; k < 6; k++) {
+      for (unsigned int j = k; j < 6; j++) {
+        ltl[k][j] += l[k] * l[j];
+      }
+      ltr[k] += l[k] * R[i];
+    }
+  }
+#endif
+
+  LTL.resize(6, 6, false);
+  LTR.resize(6, false);
+  for (unsigned int k = 0; k < 6; k++) {
+    for (unsigned int j = k; j < 6; j++) {
+      LTL[k][j] = LTL[j][k] = ltl[k][j];
+    }
+    LTR[k] = ltr[k];
+  }
+}
+
+/*!
+  Compute the normal equations \f$ (L J)^T L J \f$ and \f$ (L J)^T R \f$ of
+  the interaction matrix projected with the 6x6 matrix J, as
+  \f$ J^T (L^T L) J \f$ and \f$ J^T (L^T R) \f$. This avoids computing the
+  Nx6 matrix \f$ L J \f$.
+
+  \param L : The interaction matrix (size Nx6), with the weights already applied.
+  \param R : The weighted residu vector (size Nx1).
+  \param J : The 6x6 projection matrix.
+  \param LTL : The resulting 6x6 matrix \f$ (L J)^T L J \f$.
+  \param LTR : The resulting 6x1 vector \f$ (L J)^T R \f$.
+*/
+void
+vpMbTracker::computeNormalEquations(const vpMatrix &L, const vpColVector &R, const vpMatrix &J, vpMatrix &LTL,
+                                    vpColVector &LTR) const
+{
+  vpMatrix LTL_;
+  vpColVector LTR_;
+  computeNormalEquations(L, R, LTL_, LTR_);
+
+  vpMatrix JT = J.t();
+  LTL = JT * LTL_ * J;
+  LTR = JT * LTR_;
+}
+
 void
 vpMbTracker::computeVVSCheckLevenbergMarquardt(const unsigned int iter, vpColVector &error, const vpColVector &m_error_prev, const vpHomogeneousMatrix &cMoPrev,
                                                double &mu, bool &reStartFromLastIncrement, vpColVector * const w, const vpColVector * const m_w_prev) {
@@ -2470,8 +2759,7 @@ vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsigned
                                       const vpColVector &error, vpColVector &error_prev, vpColVector &LTR, double &mu, vpColVector &v,
                                       const vpColVector * const w, vpColVector * const m_w_prev) {
   if (isoJoIdentity_) {
-      LTL = L.AtA();
-      computeJTR(L, R, LTR);
+      computeNormalEquations(L, R, LTL, LTR);
 
       switch (m_optimizationMethod) {
         case vpMbTracker::LEVENBERG_MARQUARDT_OPT:
@@ -2497,10 +2785,9 @@ vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsigned
   } else {
       vpVelocityTwistMatrix cVo;
       cVo.buildFrom(cMo);
-      vpMatrix LVJ = (L*cVo*oJo);
-      vpMatrix LVJTLVJ = (LVJ).AtA();
+      vpMatrix LVJTLVJ;
       vpColVector LVJTR;
-      computeJTR(LVJ, R, LVJTR);
+      computeNormalEquations(L, R, cVo*oJo, LVJTLVJ, LVJTR);
 
       switch (m_optimizationMethod) {
         case vpMbTracker::LEVENBERG_MARQUARDT_OPT:
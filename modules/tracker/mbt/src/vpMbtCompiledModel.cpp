@@ -0,0 +1,529 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compiled CAO model used by the model-based tracker.
+ *
+ *****************************************************************************/
+
+#include <fstream>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMutex.h>
+#include <visp3/mbt/vpMbtCompiledModel.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace {
+  const char compiledModelMagic[8] = { 'V', 'P', 'M', 'B', 'T', 'C', 'A', 'O' };
+  const unsigned int compiledModelVersion = 1;
+  const unsigned int compiledModelByteOrder = 0x01020304;
+
+  //! In-memory cache of the compiled models, keyed by the absolute path of the main file.
+  std::map<std::string, vpMbtCompiledModel> compiledModelCache;
+  bool compiledModelCacheEnabled = false;
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  vpMutex compiledModelCacheMutex;
+#endif
+
+  bool getFileInfo(const std::string &path, long long &mtime, long long &size)
+  {
+#if defined(_WIN32)
+    struct _stat stbuf;
+    if (_stat(path.c_str(), &stbuf) != 0) {
+      return false;
+    }
+#else
+    struct stat stbuf;
+    if (stat(path.c_str(), &stbuf) != 0) {
+      return false;
+    }
+#endif
+    mtime = (long long)stbuf.st_mtime;
+    size = (long long)stbuf.st_size;
+    return true;
+  }
+
+  class vpBinaryWriter {
+  public:
+    vpBinaryWriter() : m_buffer() {}
+
+    template<typename T> void write(const T &value)
+    {
+      const char *ptr = reinterpret_cast<const char *>(&value);
+      m_buffer.insert(m_buffer.end(), ptr, ptr + sizeof(T));
+    }
+
+    template<typename T> void write(const std::vector<T> &values)
+    {
+      write((unsigned int)values.size());
+      if (!values.empty()) {
+        const char *ptr = reinterpret_cast<const char *>(&values[0]);
+        m_buffer.insert(m_buffer.end(), ptr, ptr + values.size() * sizeof(T));
+      }
+    }
+
+    void write(const std::string &str)
+    {
+      write((unsigned int)str.size());
+      m_buffer.insert(m_buffer.end(), str.begin(), str.end());
+    }
+
+    const std::vector<char> &buffer() const { return m_buffer; }
+
+  private:
+    std::vector<char> m_buffer;
+  };
+
+  class vpBinaryReader {
+  public:
+    vpBinaryReader(const std::vector<char> &buffer, const std::string &filename)
+      : m_buffer(buffer), m_pos(0), m_filename(filename) {}
+
+    template<typename T> void read(T &value)
+    {
+      check(sizeof(T));
+      memcpy(&value, &m_buffer[m_pos], sizeof(T));
+      m_pos += sizeof(T);
+    }
+
+    template<typename T> void read(std::vector<T> &values)
+    {
+      unsigned int size;
+      read(size);
+      check((size_t)size * sizeof(T));
+      values.resize(size);
+      if (size > 0) {
+        memcpy(&values[0], &m_buffer[m_pos], size * sizeof(T));
+      }
+      m_pos += (size_t)size * sizeof(T);
+    }
+
+    void read(std::string &str)
+    {
+      unsigned int size;
+      read(size);
+      check(size);
+      str.assign(m_buffer.begin() + (std::ptrdiff_t)m_pos, m_buffer.begin() + (std::ptrdiff_t)(m_pos + size));
+      m_pos += size;
+    }
+
+  private:
+    void check(const size_t size) const
+    {
+      if (size > m_buffer.size() - m_pos) {
+        throw vpException(vpException::badValue, "Truncated compiled model file %s", m_filename.c_str());
+      }
+    }
+
+    const std::vector<char> &m_buffer;
+    size_t m_pos;
+    std::string m_filename;
+  };
+}
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor that creates an empty model.
+*/
+vpMbtCompiledModel::vpMbtCompiledModel()
+  : m_points(), m_indexes(), m_primitives(), m_sourceFiles(), m_endIdFace(0), m_nbPoints(0), m_nbLines(0),
+    m_nbPolygonLines(0), m_nbPolygonPoints(0), m_nbCylinders(0), m_nbCircles(0), m_pointIndex()
+{
+}
+
+/*!
+  Add a point to the model and return its index. A point identical to a
+  point previously added with this method is not duplicated.
+
+  \param x, y, z : Coordinates of the point in the object frame.
+*/
+unsigned int vpMbtCompiledModel::addPoint(const double x, const double y, const double z)
+{
+  std::vector<double> key(3);
+  key[0] = x;
+  key[1] = y;
+  key[2] = z;
+
+  std::map<std::vector<double>, unsigned int>::const_iterator it = m_pointIndex.find(key);
+  if (it != m_pointIndex.end()) {
+    return it->second;
+  }
+
+  unsigned int index = (unsigned int)(m_points.size() / 3);
+  m_points.insert(m_points.end(), key.begin(), key.end());
+  m_pointIndex[key] = index;
+  return index;
+}
+
+/*!
+  Add a primitive to the model.
+
+  \param primitive : Primitive to add. Its \e firstIndex and \e nbIndex fields
+  are set by this method.
+  \param indexes : Indexes of the points of the primitive, as returned by addPoint().
+*/
+void vpMbtCompiledModel::addPrimitive(const vpPrimitive &primitive, const std::vector<unsigned int> &indexes)
+{
+  m_primitives.push_back(primitive);
+  m_primitives.back().firstIndex = (unsigned int)m_indexes.size();
+  m_primitives.back().nbIndex = (unsigned int)indexes.size();
+  m_indexes.insert(m_indexes.end(), indexes.begin(), indexes.end());
+}
+
+/*!
+  Record a file the model is built from, with its current modification time
+  and size.
+
+  \throw vpException::ioError if the file cannot be accessed.
+*/
+void vpMbtCompiledModel::addSourceFile(const std::string &path)
+{
+  vpSourceFile file;
+  file.path = path;
+  if (!getFileInfo(path, file.mtime, file.size)) {
+    throw vpException(vpException::ioError, "Cannot access the model file %s", path.c_str());
+  }
+  m_sourceFiles.push_back(file);
+}
+
+/*!
+  Remove all the points, primitives and source files of the model.
+*/
+void vpMbtCompiledModel::clear()
+{
+  *this = vpMbtCompiledModel();
+}
+
+/*!
+  Increase the counters of the primitives declared in the CAO files.
+*/
+void vpMbtCompiledModel::increaseCounters(const unsigned int nbPoints, const unsigned int nbLines,
+                                          const unsigned int nbPolygonLines, const unsigned int nbPolygonPoints,
+                                          const unsigned int nbCylinders, const unsigned int nbCircles)
+{
+  m_nbPoints += nbPoints;
+  m_nbLines += nbLines;
+  m_nbPolygonLines += nbPolygonLines;
+  m_nbPolygonPoints += nbPolygonPoints;
+  m_nbCylinders += nbCylinders;
+  m_nbCircles += nbCircles;
+}
+
+/*!
+  Return true if all the files the model has been built from still exist and
+  have the same modification time and size. The modification time has a
+  resolution of one second.
+*/
+bool vpMbtCompiledModel::isUpToDate() const
+{
+  if (m_sourceFiles.empty()) {
+    return false;
+  }
+
+  for (std::vector<vpSourceFile>::const_iterator it = m_sourceFiles.begin(); it != m_sourceFiles.end(); ++it) {
+    long long mtime, size;
+    if (!getFileInfo(it->path, mtime, size) || mtime != it->mtime || size != it->size) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*!
+  Load a model saved with save(). The file is read at once and its content is
+  checked before being used.
+
+  \throw vpException::ioError if the file cannot be read.
+  \throw vpException::badValue if the file is not a valid compiled model.
+*/
+void vpMbtCompiledModel::load(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot open the compiled model file %s", filename.c_str());
+  }
+
+  file.seekg(0, std::ios::end);
+  std::streamoff length = file.tellg();
+  file.seekg(0, std::ios::beg);
+  if (length < 0) {
+    throw vpException(vpException::ioError, "Cannot read the compiled model file %s", filename.c_str());
+  }
+
+  std::vector<char> buffer((size_t)length);
+  if (length > 0 && !file.read(&buffer[0], length)) {
+    throw vpException(vpException::ioError, "Cannot read the compiled model file %s", filename.c_str());
+  }
+  file.close();
+
+  vpBinaryReader reader(buffer, filename);
+  char magic[sizeof(compiledModelMagic)];
+  for (size_t i = 0; i < sizeof(magic); i++) {
+    reader.read(magic[i]);
+  }
+  if (memcmp(magic, compiledModelMagic, sizeof(magic)) != 0) {
+    throw vpException(vpException::badValue, "%s is not a compiled model file", filename.c_str());
+  }
+
+  unsigned int version, byteOrder;
+  reader.read(version);
+  reader.read(byteOrder);
+  if (version != compiledModelVersion) {
+    throw vpException(vpException::badValue, "Unsupported version %u of the compiled model file %s", version,
+                      filename.c_str());
+  }
+  if (byteOrder != compiledModelByteOrder) {
+    throw vpException(vpException::badValue, "The compiled model file %s has been created on an other architecture",
+                      filename.c_str());
+  }
+
+  vpMbtCompiledModel model;
+  reader.read(model.m_endIdFace);
+  reader.read(model.m_nbPoints);
+  reader.read(model.m_nbLines);
+  reader.read(model.m_nbPolygonLines);
+  reader.read(model.m_nbPolygonPoints);
+  reader.read(model.m_nbCylinders);
+  reader.read(model.m_nbCircles);
+
+  unsigned int nbFiles;
+  reader.read(nbFiles);
+  for (unsigned int i = 0; i < nbFiles; i++) {
+    vpSourceFile sourceFile;
+    reader.read(sourceFile.path);
+    reader.read(sourceFile.mtime);
+    reader.read(sourceFile.size);
+    model.m_sourceFiles.push_back(sourceFile);
+  }
+
+  reader.read(model.m_points);
+  reader.read(model.m_indexes);
+  if (model.m_points.size() % 3 != 0) {
+    throw vpException(vpException::badValue, "Bad number of coordinates in the compiled model file %s",
+                      filename.c_str());
+  }
+  unsigned int nbPoints = (unsigned int)(model.m_points.size() / 3);
+  for (size_t i = 0; i < model.m_indexes.size(); i++) {
+    if (model.m_indexes[i] >= nbPoints) {
+      throw vpException(vpException::badValue, "Bad point index in the compiled model file %s", filename.c_str());
+    }
+  }
+
+  unsigned int nbPrimitives;
+  reader.read(nbPrimitives);
+  for (unsigned int i = 0; i < nbPrimitives; i++) {
+    vpPrimitive primitive;
+    unsigned int type;
+    unsigned char hasUseLod, useLod, hasThreshold;
+    reader.read(type);
+    reader.read(primitive.idFace);
+    reader.read(primitive.firstIndex);
+    reader.read(primitive.nbIndex);
+    reader.read(primitive.radius);
+    reader.read(hasUseLod);
+    reader.read(useLod);
+    reader.read(hasThreshold);
+    reader.read(primitive.threshold);
+    reader.read(primitive.name);
+
+    unsigned int expectedNbIndex;
+    switch (type) {
+    case SEGMENT:
+    case CYLINDER:
+      expectedNbIndex = 2;
+      break;
+    case CIRCLE:
+      expectedNbIndex = 3;
+      break;
+    case FACE_FROM_LINES:
+    case FACE_FROM_CORNERS:
+      expectedNbIndex = primitive.nbIndex;
+      break;
+    default:
+      throw vpException(vpException::badValue, "Bad primitive type in the compiled model file %s", filename.c_str());
+    }
+    if (primitive.nbIndex != expectedNbIndex || primitive.firstIndex > model.m_indexes.size() ||
+        primitive.nbIndex > model.m_indexes.size() - primitive.firstIndex) {
+      throw vpException(vpException::badValue, "Bad primitive in the compiled model file %s", filename.c_str());
+    }
+
+    primitive.type = (vpPrimitiveType)type;
+    primitive.hasUseLod = hasUseLod != 0;
+    primitive.useLod = useLod != 0;
+    primitive.hasThreshold = hasThreshold != 0;
+    model.m_primitives.push_back(primitive);
+  }
+
+  *this = model;
+}
+
+/*!
+  Save the model in a binary file that can be read back with load(). The file
+  uses the byte order of the machine that creates it.
+
+  \throw vpException::ioError if the file cannot be written.
+*/
+void vpMbtCompiledModel::save(const std::string &filename) const
+{
+  vpBinaryWriter writer;
+  for (size_t i = 0; i < sizeof(compiledModelMagic); i++) {
+    writer.write(compiledModelMagic[i]);
+  }
+  writer.write(compiledModelVersion);
+  writer.write(compiledModelByteOrder);
+
+  writer.write(m_endIdFace);
+  writer.write(m_nbPoints);
+  writer.write(m_nbLines);
+  writer.write(m_nbPolygonLines);
+  writer.write(m_nbPolygonPoints);
+  writer.write(m_nbCylinders);
+  writer.write(m_nbCircles);
+
+  writer.write((unsigned int)m_sourceFiles.size());
+  for (std::vector<vpSourceFile>::const_iterator it = m_sourceFiles.begin(); it != m_sourceFiles.end(); ++it) {
+    writer.write(it->path);
+    writer.write(it->mtime);
+    writer.write(it->size);
+  }
+
+  writer.write(m_points);
+  writer.write(m_indexes);
+
+  writer.write((unsigned int)m_primitives.size());
+  for (std::vector<vpPrimitive>::const_iterator it = m_primitives.begin(); it != m_primitives.end(); ++it) {
+    writer.write((unsigned int)it->type);
+    writer.write(it->idFace);
+    writer.write(it->firstIndex);
+    writer.write(it->nbIndex);
+    writer.write(it->radius);
+    writer.write((unsigned char)it->hasUseLod);
+    writer.write((unsigned char)it->useLod);
+    writer.write((unsigned char)it->hasThreshold);
+    writer.write(it->threshold);
+    writer.write(it->name);
+  }
+
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot create the compiled model file %s", filename.c_str());
+  }
+  const std::vector<char> &buffer = writer.buffer();
+  if (!file.write(&buffer[0], (std::streamsize)buffer.size())) {
+    throw vpException(vpException::ioError, "Cannot write the compiled model file %s", filename.c_str());
+  }
+}
+
+/*!
+  Remove all the models of the in-memory cache.
+*/
+void vpMbtCompiledModel::clearCache()
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  vpMutex::vpScopedLock lock(compiledModelCacheMutex);
+#endif
+  compiledModelCache.clear();
+}
+
+/*!
+  Get a model from the in-memory cache.
+
+  \param modelFile : Absolute path of the main .cao file.
+  \param model : The cached model, if any.
+  \return true if the cache is enabled and holds an up to date model for \e modelFile.
+*/
+bool vpMbtCompiledModel::getCache(const std::string &modelFile, vpMbtCompiledModel &model)
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  vpMutex::vpScopedLock lock(compiledModelCacheMutex);
+#endif
+  if (!compiledModelCacheEnabled) {
+    return false;
+  }
+
+  std::map<std::string, vpMbtCompiledModel>::iterator it = compiledModelCache.find(modelFile);
+  if (it == compiledModelCache.end()) {
+    return false;
+  }
+  if (!it->second.isUpToDate()) {
+    compiledModelCache.erase(it);
+    return false;
+  }
+
+  model = it->second;
+  return true;
+}
+
+/*!
+  Return true if the in-memory cache of compiled models is enabled.
+*/
+bool vpMbtCompiledModel::isCacheEnabled()
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  vpMutex::vpScopedLock lock(compiledModelCacheMutex);
+#endif
+  return compiledModelCacheEnabled;
+}
+
+/*!
+  Enable or disable the in-memory cache of compiled models. The cache is
+  disabled by default. Disabling the cache also empties it.
+*/
+void vpMbtCompiledModel::setCacheEnabled(const bool enable)
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  vpMutex::vpScopedLock lock(compiledModelCacheMutex);
+#endif
+  compiledModelCacheEnabled = enable;
+  if (!enable) {
+    compiledModelCache.clear();
+  }
+}
+
+/*!
+  Store a model in the in-memory cache, if the cache is enabled.
+
+  \param modelFile : Absolute path of the main .cao file.
+  \param model : The model built from \e modelFile.
+*/
+void vpMbtCompiledModel::setCache(const std::string &modelFile, const vpMbtCompiledModel &model)
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  vpMutex::vpScopedLock lock(compiledModelCacheMutex);
+#endif
+  if (compiledModelCacheEnabled) {
+    compiledModelCache[modelFile] = model;
+  }
+}
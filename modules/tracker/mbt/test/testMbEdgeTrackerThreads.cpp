@@ -0,0 +1,155 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the parallel tracking of the moving edges of the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbEdgeTrackerThreads.cpp
+
+  Test the parallel tracking of the moving edges of the model-based tracker:
+  the moving edges obtained with several threads have to be the same as the
+  ones obtained when the features are tracked sequentially. The poses are
+  compared with a small tolerance, since the vectorized linear algebra may
+  round differently from one tracker instance to the other.
+*/
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+
+namespace {
+  // Bright square with a dark disk in its center, translated by (di, dj) pixels
+  void buildImage(vpImage<unsigned char> &I, const int di, const int dj)
+  {
+    I.resize(240, 320, 50);
+    for (int i = 60; i < 180; i++) {
+      for (int j = 100; j < 220; j++) {
+        int r = i - 120, c = j - 160;
+        I[(unsigned int)(i + di)][(unsigned int)(j + dj)] = (r * r + c * c < 24 * 24) ? 100 : 200;
+      }
+    }
+  }
+
+  void initTracker(vpMbEdgeTracker &tracker, const std::string &modelFile, const vpImage<unsigned char> &I,
+                   const int nbThreads)
+  {
+    vpMe me;
+    me.setMaskSize(5);
+    me.setMaskNumber(180);
+    me.setRange(8);
+    me.setThreshold(1000);
+    me.setMu1(0.5);
+    me.setMu2(0.5);
+    me.setSampleStep(4);
+    tracker.setMovingEdge(me);
+    tracker.setNbThreads(nbThreads);
+    tracker.setCameraParameters(vpCameraParameters(600, 600, 160, 120));
+    tracker.loadModel(modelFile);
+    tracker.initFromPose(I, vpHomogeneousMatrix(0.001, -0.001, 0.5, 0, 0, 0));
+  }
+
+  bool compare(const vpMbEdgeTracker &tracker1, const vpMbEdgeTracker &tracker2, const unsigned int iter)
+  {
+    vpHomogeneousMatrix cMo1, cMo2;
+    tracker1.getPose(cMo1);
+    tracker2.getPose(cMo2);
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 4; j++) {
+        if (std::fabs(cMo1[i][j] - cMo2[i][j]) > 1e-9) {
+          std::cerr << "Iteration " << iter << ": the poses differ" << std::endl;
+          return false;
+        }
+      }
+    }
+    if (tracker1.getNbPoints() != tracker2.getNbPoints()) {
+      std::cerr << "Iteration " << iter << ": " << tracker2.getNbPoints() << " moving edges instead of "
+                << tracker1.getNbPoints() << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string directory = "C:/temp";
+#else
+    std::string directory = "/tmp";
+#endif
+    directory = vpIoTools::createFilePath(directory, "visp_testMbEdgeTrackerThreads");
+    if (!vpIoTools::checkDirectory(directory)) {
+      vpIoTools::makeDirectory(directory);
+    }
+
+    // Square with a circle in its center
+    std::string modelFile = vpIoTools::createFilePath(directory, "square.cao");
+    {
+      std::ofstream file(modelFile.c_str());
+      file << "V1\n7\n-0.05 -0.05 0\n-0.05 0.05 0\n0.05 0.05 0\n0.05 -0.05 0\n0 0 0\n0.02 0 0\n0 0.02 0\n"
+           << "0\n0\n1\n4 0 1 2 3\n0\n1\n0.02 4 5 6\n";
+    }
+
+    vpImage<unsigned char> I;
+    buildImage(I, 0, 0);
+
+    vpMbEdgeTracker sequential, parallel;
+    initTracker(sequential, modelFile, I, 1);
+    initTracker(parallel, modelFile, I, 4);
+    if (parallel.getNbThreads() != 4) {
+      std::cerr << "Bad number of threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    for (unsigned int iter = 0; iter < 10; iter++) {
+      buildImage(I, (int)(iter % 4), (int)iter / 2);
+      sequential.track(I);
+      parallel.track(I);
+      if (!compare(sequential, parallel, iter)) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    vpIoTools::remove(directory);
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testMbEdgeTrackerThreads is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
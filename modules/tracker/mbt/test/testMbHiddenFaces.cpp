@@ -0,0 +1,221 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the visibility of the faces of the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbHiddenFaces.cpp
+
+  Test the visibility of the faces of the model-based tracker: the visibility
+  computed by vpMbHiddenFaces::setVisible(), which skips groups of hidden
+  faces, has to be the same as the one obtained by testing each face.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbHiddenFaces.h>
+
+namespace {
+  void addFace(vpMbHiddenFaces<vpMbtPolygon> &faces, const std::vector<vpPoint> &points, const bool hasOrientation = true)
+  {
+    vpMbtPolygon polygon;
+    polygon.setIndex((int)faces.size());
+    polygon.setNbPoint((unsigned int)points.size());
+    for (unsigned int i = 0; i < points.size(); i++) {
+      polygon.addPoint(i, points[i]);
+    }
+    polygon.hasOrientation = hasOrientation;
+    faces.addPolygon(&polygon);
+  }
+
+  vpPoint spherePoint(const double radius, const double theta, const double phi, const double x)
+  {
+    return vpPoint(x + radius * sin(theta) * cos(phi), radius * sin(theta) * sin(phi), radius * cos(theta));
+  }
+
+  // Tessellated sphere with outward faces, a box and a few faces that are not oriented
+  void buildModel(vpMbHiddenFaces<vpMbtPolygon> &faces)
+  {
+    const unsigned int nbRings = 30, nbSectors = 60;
+    const double radius = 0.2;
+    for (unsigned int r = 0; r < nbRings; r++) {
+      double theta1 = M_PI * r / nbRings, theta2 = M_PI * (r + 1) / nbRings;
+      for (unsigned int s = 0; s < nbSectors; s++) {
+        double phi1 = 2 * M_PI * s / nbSectors, phi2 = 2 * M_PI * (s + 1) / nbSectors;
+        std::vector<vpPoint> points;
+        points.push_back(spherePoint(radius, theta1, phi1, 0));
+        points.push_back(spherePoint(radius, theta2, phi1, 0));
+        if (r + 1 < nbRings) {
+          points.push_back(spherePoint(radius, theta2, phi2, 0));
+        }
+        if (r > 0) {
+          points.push_back(spherePoint(radius, theta1, phi2, 0));
+        }
+        addFace(faces, points);
+      }
+    }
+
+    // Box
+    const double a = 0.1, x = 0.5;
+    const double corners[8][3] = {{-a, -a, -a}, {a, -a, -a}, {a, a, -a}, {-a, a, -a},
+                                  {-a, -a, a},  {a, -a, a},  {a, a, a},  {-a, a, a}};
+    const unsigned int boxFaces[6][4] = {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4},
+                                         {2, 3, 7, 6}, {1, 2, 6, 5}, {0, 4, 7, 3}};
+    for (unsigned int f = 0; f < 6; f++) {
+      std::vector<vpPoint> points;
+      for (unsigned int i = 0; i < 4; i++) {
+        const double *c = corners[boxFaces[f][i]];
+        points.push_back(vpPoint(x + c[0], c[1], c[2]));
+      }
+      addFace(faces, points);
+    }
+
+    // Line, face without orientation and degenerated face
+    std::vector<vpPoint> points;
+    points.push_back(vpPoint(-0.5, 0, 0));
+    points.push_back(vpPoint(-0.5, 0.1, 0));
+    addFace(faces, points);
+    points.push_back(vpPoint(-0.4, 0.1, 0));
+    addFace(faces, points, false);
+    points[2] = vpPoint(-0.5, 0.2, 0);
+    addFace(faces, points);
+  }
+
+  vpHomogeneousMatrix randomPose(vpUniRand &rng)
+  {
+    // Camera looking at a random point of the model from a random position
+    vpColVector target(3), position(3);
+    for (unsigned int i = 0; i < 3; i++) {
+      target[i] = 0.6 * rng() - 0.3;
+      position[i] = 2 * rng() - 1;
+    }
+    position = target + position.normalize() * (0.3 + 2.5 * rng());
+
+    vpColVector z = (target - position).normalize();
+    vpColVector up(3);
+    up[0] = rng() - 0.5;
+    up[1] = rng() - 0.5;
+    up[2] = rng() - 0.5;
+    vpColVector x = vpColVector::crossProd(up, z).normalize();
+    vpColVector y = vpColVector::crossProd(z, x);
+
+    vpHomogeneousMatrix oMc;
+    for (unsigned int i = 0; i < 3; i++) {
+      oMc[i][0] = x[i];
+      oMc[i][1] = y[i];
+      oMc[i][2] = z[i];
+      oMc[i][3] = position[i];
+    }
+    return oMc.inverse();
+  }
+
+  unsigned int setVisibleReference(vpMbHiddenFaces<vpMbtPolygon> &faces, const vpHomogeneousMatrix &cMo,
+                                   const double angleAppears, const double angleDisappears, bool &changed)
+  {
+    vpImage<unsigned char> I;
+    vpCameraParameters cam;
+    vpTranslationVector cameraPos;
+    changed = false;
+    unsigned int nbVisible = 0;
+    for (unsigned int i = 0; i < faces.size(); i++) {
+      if (faces.computeVisibility(cMo, angleAppears, angleDisappears, changed, false, false, I, cam, cameraPos, i)) {
+        nbVisible++;
+      }
+    }
+    return nbVisible;
+  }
+
+  bool compare(vpMbHiddenFaces<vpMbtPolygon> &faces1, vpMbHiddenFaces<vpMbtPolygon> &faces2)
+  {
+    for (unsigned int i = 0; i < faces1.size(); i++) {
+      if (faces1.isVisible(i) != faces2.isVisible(i) || faces1.isAppearing(i) != faces2.isAppearing(i)) {
+        std::cerr << "The visibility of face " << i << " differs" << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    vpMbHiddenFaces<vpMbtPolygon> faces, reference;
+    buildModel(faces);
+    buildModel(reference);
+
+    const double angles[3][2] = {{89, 89}, {89, 75}, {60, 85}};
+    vpUniRand rng(42);
+    double t = 0, tReference = 0;
+    unsigned int nbChanges = 0, nbVisible = 0;
+    for (unsigned int iter = 0; iter < 600; iter++) {
+      vpHomogeneousMatrix cMo = randomPose(rng);
+      double angleAppears = vpMath::rad(angles[iter % 3][0]);
+      double angleDisappears = vpMath::rad(angles[iter % 3][1]);
+
+      bool changed, changedReference;
+      double t0 = vpTime::measureTimeMs();
+      unsigned int nb = faces.setVisible(cMo, angleAppears, angleDisappears, changed);
+      double t1 = vpTime::measureTimeMs();
+      unsigned int nbReference = setVisibleReference(reference, cMo, angleAppears, angleDisappears, changedReference);
+      double t2 = vpTime::measureTimeMs();
+      t += t1 - t0;
+      tReference += t2 - t1;
+
+      if (nb != nbReference || changed != changedReference) {
+        std::cerr << "Iteration " << iter << ": " << nb << " visible faces instead of " << nbReference
+                  << ", changed: " << changed << " instead of " << changedReference << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (!compare(faces, reference)) {
+        std::cerr << "Iteration " << iter << " failed" << std::endl;
+        return EXIT_FAILURE;
+      }
+      nbChanges += changed ? 1 : 0;
+      nbVisible += nb;
+    }
+
+    std::cout << faces.size() << " faces, " << nbVisible / 600 << " visible faces on average, " << nbChanges
+              << " changes" << std::endl;
+    std::cout << "Visibility computed in " << t << " ms (" << tReference << " ms when testing each face)" << std::endl;
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testMbHiddenFaces is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
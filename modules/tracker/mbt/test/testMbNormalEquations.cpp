@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the computation of the normal equations of the model-based trackers.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbNormalEquations.cpp
+
+  Test the computation of the normal equations of the model-based trackers:
+  the matrices accumulated row by row have to be the same as the ones given
+  by vpMatrix::AtA() and vpMbTracker::computeJTR().
+*/
+
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+
+namespace {
+  class vpMbEdgeTrackerTest : public vpMbEdgeTracker {
+  public:
+    using vpMbTracker::computeJTR;
+    using vpMbTracker::computeNormalEquations;
+  };
+
+  double maxDifference(const vpArray2D<double> &A, const vpArray2D<double> &B)
+  {
+    double diff = 0;
+    for (unsigned int i = 0; i < A.getRows(); i++) {
+      for (unsigned int j = 0; j < A.getCols(); j++) {
+        diff = (std::max)(diff, std::fabs(A[i][j] - B[i][j]));
+      }
+    }
+    return diff;
+  }
+}
+
+int main()
+{
+  try {
+    vpMbEdgeTrackerTest tracker;
+    vpUniRand rng(17);
+
+    const unsigned int sizes[4] = {1, 7, 100, 5000};
+    for (unsigned int n = 0; n < 4; n++) {
+      vpMatrix L(sizes[n], 6);
+      vpColVector R(sizes[n]);
+      for (unsigned int i = 0; i < L.getRows(); i++) {
+        for (unsigned int j = 0; j < 6; j++) {
+          L[i][j] = 2 * rng() - 1;
+        }
+        R[i] = 2 * rng() - 1;
+      }
+
+      vpMatrix LTL, LTL_ref = L.AtA();
+      vpColVector LTR, LTR_ref;
+      tracker.computeJTR(L, R, LTR_ref);
+      tracker.computeNormalEquations(L, R, LTL, LTR);
+      if (maxDifference(LTL, LTL_ref) != 0 || maxDifference(LTR, LTR_ref) != 0) {
+        std::cerr << "The normal equations differ for " << sizes[n] << " rows" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // Projected interaction matrix
+      vpMatrix J(6, 6);
+      for (unsigned int i = 0; i < 6; i++) {
+        for (unsigned int j = 0; j < 6; j++) {
+          J[i][j] = 2 * rng() - 1;
+        }
+      }
+      vpMatrix LJ = L * J;
+      vpColVector LJTR_ref;
+      tracker.computeJTR(LJ, R, LJTR_ref);
+      tracker.computeNormalEquations(L, R, J, LTL, LTR);
+      double scale = (std::max)(1.0, (double)sizes[n]);
+      if (maxDifference(LTL, LJ.AtA()) > 1e-12 * scale || maxDifference(LTR, LJTR_ref) > 1e-12 * scale) {
+        std::cerr << "The projected normal equations differ for " << sizes[n] << " rows" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Bad sizes
+    bool thrown = false;
+    try {
+      vpMatrix LTL;
+      vpColVector LTR;
+      tracker.computeNormalEquations(vpMatrix(10, 6), vpColVector(9), LTL, LTR);
+    } catch(vpException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << "Bad sizes have been accepted" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Timings
+    vpMatrix L(5000, 6);
+    vpColVector R(5000);
+    for (unsigned int i = 0; i < L.getRows(); i++) {
+      for (unsigned int j = 0; j < 6; j++) {
+        L[i][j] = 2 * rng() - 1;
+      }
+      R[i] = 2 * rng() - 1;
+    }
+    vpMatrix LTL;
+    vpColVector LTR;
+    double t0 = vpTime::measureTimeMs();
+    for (unsigned int iter = 0; iter < 100; iter++) {
+      L.AtA(LTL);
+      tracker.computeJTR(L, R, LTR);
+    }
+    double t1 = vpTime::measureTimeMs();
+    for (unsigned int iter = 0; iter < 100; iter++) {
+      tracker.computeNormalEquations(L, R, LTL, LTR);
+    }
+    double t2 = vpTime::measureTimeMs();
+    std::cout << "5000x6 normal equations: " << (t2 - t1) / 100 << " ms (" << (t1 - t0) / 100
+              << " ms with AtA() and computeJTR())" << std::endl;
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testMbNormalEquations is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
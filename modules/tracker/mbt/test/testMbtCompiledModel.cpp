@@ -0,0 +1,297 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the compiled CAO models of the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtCompiledModel.cpp
+
+  Test the compiled CAO models of the model-based tracker: a model loaded from
+  a .cao file, from a compiled .bin file or from the in-memory cache has to
+  give the same faces, lines, cylinders and circles.
+*/
+
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+
+namespace {
+  void writeFile(const std::string &filename, const std::string &content)
+  {
+    std::ofstream file(filename.c_str());
+    file << content;
+  }
+
+  void writeModel(const std::string &directory, const bool modifiedPart)
+  {
+    writeFile(vpIoTools::createFilePath(directory, "main.cao"),
+              "V1\n"
+              "# Included model\n"
+              "load(\"part.cao\")\n"
+              "# 3D points\n"
+              "9\n"
+              "0 0 0\n"
+              "0.1 0 0\n"
+              "0.1 0.1 0\n"
+              "0 0.1 0\n"
+              "0 0 0 # duplicated point\n"
+              "0 0 0.2\n"
+              "0.05 0.05 0\n"
+              "0.08 0.05 0\n"
+              "0.05 0.08 0\n"
+              "# 3D lines\n"
+              "6\n"
+              "0 1\n"
+              "1 2\n"
+              "2 3\n"
+              "3 4\n"
+              "0 5 name=\"pole\" useLod=true minLineLengthThreshold=20\n"
+              "2 5\n"
+              "# Faces from 3D lines\n"
+              "1\n"
+              "4 0 1 2 3 name=\"bottom\" minPolygonAreaThreshold=100\n"
+              "# Faces from 3D points\n"
+              "2\n"
+              "3 0 1 5 useLod=false\n"
+              "3 1 2 5 name=\"side\"\n"
+              "# 3D cylinders\n"
+              "1\n"
+              "0 5 0.02 name=\"cylinder\" minLineLengthThreshold=10\n"
+              "# 3D circles\n"
+              "1\n"
+              "0.03 6 7 8 name=\"circle\" useLod=true\n");
+
+    if (modifiedPart) {
+      writeFile(vpIoTools::createFilePath(directory, "part.cao"),
+                "V1\n"
+                "3\n"
+                "0.2 0 0\n"
+                "0.3 0 0\n"
+                "0.3 0.1 0\n"
+                "0\n"
+                "0\n"
+                "1\n"
+                "3 0 1 2 name=\"modified\"\n"
+                "0\n"
+                "0\n");
+    }
+    else {
+      writeFile(vpIoTools::createFilePath(directory, "part.cao"),
+                "V1\n"
+                "4\n"
+                "0.2 0 0\n"
+                "0.3 0 0\n"
+                "0.3 0.1 0\n"
+                "0.2 0.1 0\n"
+                "0\n"
+                "0\n"
+                "1\n"
+                "4 0 1 2 3 name=\"part\"\n"
+                "0\n"
+                "0\n");
+    }
+  }
+
+  class vpMbEdgeTrackerTest : public vpMbEdgeTracker {
+  public:
+    bool compare(vpMbEdgeTrackerTest &tracker, const std::string &name)
+    {
+      std::vector<vpMbtPolygon *> &polygons1 = faces.getPolygon();
+      std::vector<vpMbtPolygon *> &polygons2 = tracker.faces.getPolygon();
+      if (polygons1.size() != polygons2.size()) {
+        std::cerr << name << ": bad number of faces " << polygons1.size() << " " << polygons2.size() << std::endl;
+        return false;
+      }
+
+      for (size_t i = 0; i < polygons1.size(); i++) {
+        vpMbtPolygon *p1 = polygons1[i];
+        vpMbtPolygon *p2 = polygons2[i];
+        if (p1->getIndex() != p2->getIndex() || p1->getName() != p2->getName() || p1->useLod != p2->useLod ||
+            p1->minLineLengthThresh != p2->minLineLengthThresh ||
+            p1->minPolygonAreaThresh != p2->minPolygonAreaThresh || p1->getNbPoint() != p2->getNbPoint()) {
+          std::cerr << name << ": face " << i << " differs" << std::endl;
+          return false;
+        }
+        for (unsigned int j = 0; j < p1->getNbPoint(); j++) {
+          vpPoint &P1 = p1->getPoint(j);
+          vpPoint &P2 = p2->getPoint(j);
+          if (P1.get_oX() != P2.get_oX() || P1.get_oY() != P2.get_oY() || P1.get_oZ() != P2.get_oZ()) {
+            std::cerr << name << ": point " << j << " of face " << i << " differs" << std::endl;
+            return false;
+          }
+        }
+      }
+
+      std::list<vpMbtDistanceLine *> lines1, lines2;
+      std::list<vpMbtDistanceCylinder *> cylinders1, cylinders2;
+      std::list<vpMbtDistanceCircle *> circles1, circles2;
+      getLline(lines1);
+      tracker.getLline(lines2);
+      getLcylinder(cylinders1);
+      tracker.getLcylinder(cylinders2);
+      getLcircle(circles1);
+      tracker.getLcircle(circles2);
+      if (lines1.size() != lines2.size() || cylinders1.size() != cylinders2.size() ||
+          circles1.size() != circles2.size()) {
+        std::cerr << name << ": bad number of features" << std::endl;
+        return false;
+      }
+
+      for (std::list<vpMbtDistanceLine *>::const_iterator it1 = lines1.begin(), it2 = lines2.begin();
+           it1 != lines1.end(); ++it1, ++it2) {
+        if ((*it1)->getName() != (*it2)->getName() || (*it1)->Lindex_polygon != (*it2)->Lindex_polygon) {
+          std::cerr << name << ": line " << (*it1)->getName() << " differs" << std::endl;
+          return false;
+        }
+      }
+
+      if (nbPoints != tracker.nbPoints || nbLines != tracker.nbLines || nbPolygonLines != tracker.nbPolygonLines ||
+          nbPolygonPoints != tracker.nbPolygonPoints || nbCylinders != tracker.nbCylinders ||
+          nbCircles != tracker.nbCircles) {
+        std::cerr << name << ": bad number of primitives" << std::endl;
+        return false;
+      }
+
+      return true;
+    }
+
+    std::string getFaceName(const unsigned int index) { return faces.getPolygon()[index]->getName(); }
+    unsigned int getNbFaces() { return (unsigned int)faces.getPolygon().size(); }
+  };
+}
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string directory = "C:/temp";
+#else
+    std::string directory = "/tmp";
+#endif
+    directory = vpIoTools::createFilePath(directory, "visp_testMbtCompiledModel");
+    if (!vpIoTools::checkDirectory(directory)) {
+      vpIoTools::makeDirectory(directory);
+    }
+    std::string caoFile = vpIoTools::createFilePath(directory, "main.cao");
+    std::string binFile = vpIoTools::createFilePath(directory, "main.bin");
+
+    writeModel(directory, false);
+
+    // Reference: the CAO file is parsed
+    vpMbEdgeTrackerTest reference;
+    reference.loadModel(caoFile);
+    if (reference.getNbFaces() != 12) {
+      std::cerr << "Bad number of faces: " << reference.getNbFaces() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Compiled binary file
+    vpMbEdgeTrackerTest compiler;
+    compiler.saveCompiledModel(caoFile, binFile);
+    if (compiler.getNbFaces() != 0) {
+      std::cerr << "saveCompiledModel() modified the tracker" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpMbEdgeTrackerTest compiled;
+    compiled.loadModel(binFile);
+    if (!reference.compare(compiled, "Compiled model")) {
+      return EXIT_FAILURE;
+    }
+
+    // Two models loaded in the same tracker use different face ids
+    vpMbEdgeTrackerTest twice, twiceCompiled;
+    twice.loadModel(caoFile);
+    twice.loadModel(caoFile);
+    twiceCompiled.loadModel(binFile);
+    twiceCompiled.loadModel(binFile);
+    if (!twice.compare(twiceCompiled, "Model loaded twice")) {
+      return EXIT_FAILURE;
+    }
+
+    // In-memory cache
+    vpMbtCompiledModel::setCacheEnabled(true);
+    vpMbEdgeTrackerTest cached1, cached2;
+    cached1.loadModel(caoFile);
+    cached2.loadModel(caoFile);
+    if (!reference.compare(cached1, "Cache miss") || !reference.compare(cached2, "Cache hit")) {
+      return EXIT_FAILURE;
+    }
+
+    // A modified included file invalidates the cache
+    writeModel(directory, true);
+    vpMbEdgeTrackerTest modified;
+    modified.loadModel(caoFile);
+    vpMbtCompiledModel::setCacheEnabled(false);
+    vpMbEdgeTrackerTest modifiedReference;
+    modifiedReference.loadModel(caoFile);
+    if (!modifiedReference.compare(modified, "Modified model")) {
+      return EXIT_FAILURE;
+    }
+    if (modified.getFaceName(0) != "modified") {
+      std::cerr << "The cache has not been invalidated" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A truncated compiled file is rejected
+    std::vector<char> buffer;
+    {
+      std::ifstream file(binFile.c_str(), std::ios::in | std::ios::binary);
+      buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream file(binFile.c_str(), std::ios::out | std::ios::binary);
+      file.write(&buffer[0], (std::streamsize)buffer.size() / 2);
+    }
+    bool rejected = false;
+    try {
+      vpMbEdgeTrackerTest truncated;
+      truncated.loadModel(binFile);
+    } catch(vpException &) {
+      rejected = true;
+    }
+    if (!rejected) {
+      std::cerr << "A truncated compiled model has been accepted" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testMbtCompiledModel is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
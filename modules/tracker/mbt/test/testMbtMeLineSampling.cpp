@@ -0,0 +1,216 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the reuse of the moving edges sampled along the lines of the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbtMeLineSampling.cpp
+
+  Test the reuse of the moving edges sampled along the lines of the
+  model-based tracker: the sites of a previous sampling are reused only when
+  the extremities of the line moved less than vpMe::getSampleReuseThreshold(),
+  and the edge tracker counts the samplings of its lines.
+*/
+
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+#include <visp3/mbt/vpMbtMeLine.h>
+
+namespace {
+  const unsigned int width = 320, height = 240;
+
+  // Bright square on a dark background, seen by a camera 0.5 meter away
+  void buildImage(vpImage<unsigned char> &I)
+  {
+    I.resize(height, width, 50);
+    for (unsigned int i = 60; i < 180; i++) {
+      for (unsigned int j = 100; j < 220; j++) {
+        I[i][j] = 200;
+      }
+    }
+  }
+
+  void initMe(vpMe &me)
+  {
+    me.setMaskSize(5);
+    me.setMaskNumber(180);
+    me.setRange(8);
+    me.setThreshold(1000);
+    me.setMu1(0.5);
+    me.setMu2(0.5);
+    me.setSampleStep(4);
+  }
+
+  // Vertical line close to the left border of the square
+  void initLine(vpMbtMeLine &line, const vpImage<unsigned char> &I, const double j)
+  {
+    line.imin = 0;
+    line.imax = (int)height;
+    line.jmin = 0;
+    line.jmax = (int)width;
+    line.setInitRange(0);
+    line.initTracking(I, vpImagePoint(70, j), vpImagePoint(170, j), j, M_PI / 2);
+  }
+
+  bool testMeLine(const vpImage<unsigned char> &I)
+  {
+    vpMe me;
+    initMe(me);
+    me.setSampleReuseThreshold(2);
+
+    vpMbtMeLine line;
+    line.setMe(&me);
+    initLine(line, I, 101);
+    std::list<vpMeSite> sites = line.getMeList();
+    if (line.nbSampling != 1 || line.nbReusedSampling != 0 || sites.empty()) {
+      std::cerr << "The line has not been sampled" << std::endl;
+      return false;
+    }
+
+    // The line moved less than the threshold: the sites are reused
+    initLine(line, I, 102);
+    if (line.nbSampling != 1 || line.nbReusedSampling != 1 || line.getMeList().size() != sites.size()) {
+      std::cerr << "The sites have not been reused" << std::endl;
+      return false;
+    }
+    for (std::list<vpMeSite>::const_iterator it1 = sites.begin(), it2 = line.getMeList().begin(); it1 != sites.end();
+         ++it1, ++it2) {
+      if (it1->getState() == vpMeSite::NO_SUPPRESSION && (it2->getState() != vpMeSite::NO_SUPPRESSION ||
+                                                          it1->i != it2->i || it1->j != it2->j)) {
+        std::cerr << "A reused site lost the edge" << std::endl;
+        return false;
+      }
+    }
+
+    // The line moved more than the threshold: it is sampled again
+    initLine(line, I, 106);
+    if (line.nbSampling != 2 || line.nbReusedSampling != 1) {
+      std::cerr << "The line has not been sampled again" << std::endl;
+      return false;
+    }
+
+    // The reuse is disabled by default
+    vpMe me2;
+    initMe(me2);
+    vpMbtMeLine line2;
+    line2.setMe(&me2);
+    initLine(line2, I, 101);
+    initLine(line2, I, 101);
+    if (line2.nbSampling != 2 || line2.nbReusedSampling != 0) {
+      std::cerr << "The sites have been reused while disabled" << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+
+  bool testEdgeTracker(const vpImage<unsigned char> &I, const std::string &directory)
+  {
+    std::string modelFile = vpIoTools::createFilePath(directory, "square.cao");
+    {
+      std::ofstream file(modelFile.c_str());
+      file << "V1\n4\n-0.05 -0.05 0\n-0.05 0.05 0\n0.05 0.05 0\n0.05 -0.05 0\n0\n0\n1\n4 0 1 2 3\n0\n0\n";
+    }
+
+    vpMbEdgeTracker tracker;
+    vpMe me;
+    initMe(me);
+    me.setSampleReuseThreshold(2);
+    tracker.setMovingEdge(me);
+    tracker.setCameraParameters(vpCameraParameters(600, 600, 160, 120));
+    tracker.loadModel(modelFile);
+    vpHomogeneousMatrix cMo(0.001, -0.001, 0.5, 0, 0, 0);
+    tracker.initFromPose(I, cMo);
+
+    unsigned int nb_reinit, nb_sampling, nb_reused_sampling;
+    tracker.getMovingEdgeCounters(nb_reinit, nb_sampling, nb_reused_sampling);
+    if (nb_sampling != 4) {
+      std::cerr << "Bad number of samplings after the initialization: " << nb_sampling << std::endl;
+      return false;
+    }
+    tracker.resetMovingEdgeCounters();
+
+    for (unsigned int iter = 0; iter < 10; iter++) {
+      tracker.track(I);
+    }
+    tracker.getPose(cMo);
+    vpTranslationVector t = cMo.getTranslationVector();
+    if (std::fabs(t[0]) > 1e-3 || std::fabs(t[1]) > 1e-3 || std::fabs(t[2] - 0.5) > 5e-3) {
+      std::cerr << "Bad pose: " << t.t() << std::endl;
+      return false;
+    }
+
+    tracker.getMovingEdgeCounters(nb_reinit, nb_sampling, nb_reused_sampling);
+    std::cout << "Edge tracker: " << nb_reinit << " reinitializations, " << nb_sampling << " samplings, "
+              << nb_reused_sampling << " reused samplings" << std::endl;
+
+    // Restarting the tracker releases the moving edges of the lines
+    tracker.initFromPose(I, cMo);
+    tracker.track(I);
+
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string directory = "C:/temp";
+#else
+    std::string directory = "/tmp";
+#endif
+    directory = vpIoTools::createFilePath(directory, "visp_testMbtMeLineSampling");
+    if (!vpIoTools::checkDirectory(directory)) {
+      vpIoTools::makeDirectory(directory);
+    }
+
+    vpImage<unsigned char> I;
+    buildImage(I);
+
+    if (!testMeLine(I) || !testEdgeTracker(I, directory)) {
+      return EXIT_FAILURE;
+    }
+
+    vpIoTools::remove(directory);
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testMbtMeLineSampling is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
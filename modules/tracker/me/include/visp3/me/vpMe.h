@@ -82,6 +82,8 @@ private:
   //frame borders which may cause Get_Sampling_Grid to refuse
   //the that extremity
   int strip;
+  //! Maximal displacement in pixels of the extremities of a line below which its previous sites are reused
+  double sample_reuse_threshold;
   //int graph ;
   vpMatrix *mask ; //! Array of matrices defining the different masks (one for every angle step).
 
@@ -268,6 +270,30 @@ public:
     \return Value of sample_step.
   */
   inline double getSampleStep() const { return sample_step ; }
+
+  /*!
+    Return the maximal displacement in pixels of the extremities of a line
+    below which the sites of its previous sampling are reused.
+
+    \return Value of sample_reuse_threshold.
+
+    \sa setSampleReuseThreshold()
+  */
+  inline double getSampleReuseThreshold() const { return sample_reuse_threshold ; }
+
+  /*!
+    Set the maximal displacement in pixels of the extremities of a line below
+    which the sites of its previous sampling are reused instead of sampling
+    the line again. The reused sites keep the position found in the previous
+    images and are tracked again in the current image.
+
+    This is only used by the lines of the model-based edge tracker, when they
+    are initialized or resampled. A value lower or equal to 0, the default,
+    disables the reuse.
+
+    \param t : new threshold in pixels.
+  */
+  void setSampleReuseThreshold(const double &t) { sample_reuse_threshold = t ; }
   
   /*!
     Set the number of pixels that are ignored around the image borders.
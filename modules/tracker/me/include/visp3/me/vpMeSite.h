@@ -95,6 +95,14 @@ public:
   int i_1, j_1 ;
   double ifloat, jfloat ;
   unsigned char v ;
+
+private:
+  // Display type and state, stored on one byte each next to v to keep the
+  // sites compact
+  unsigned char selectDisplay ;
+  unsigned char state;
+
+public:
   int mask_sign ;
   // Angle of tangent at site
   double alpha;
@@ -104,10 +112,6 @@ public:
   double normGradient ;
   // Uncertainty of point given as a probability between 0 and 1
   double weight;
-  
-private:
-  vpMeSiteDisplayType selectDisplay ;
-  vpMeSiteState state;
 
 public:
   void init() ;
@@ -145,7 +149,7 @@ public:
   inline double getAlpha() const { return alpha; }
   
   
-  void setDisplay(vpMeSiteDisplayType select) { selectDisplay = select ; }
+  void setDisplay(vpMeSiteDisplayType select) { selectDisplay = (unsigned char)select ; }
   
   /*!
     Get the i coordinate (integer)
@@ -183,7 +187,7 @@ public:
     \sa vpMeSiteState
   */
   void setState(const vpMeSiteState &flag){ 
-    state = flag; 
+    state = (unsigned char)flag; 
     
     #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     suppress = (int)flag;
@@ -195,7 +199,7 @@ public:
 
     \return flag corresponding to vpMeSiteState
   */
-  inline vpMeSiteState getState() const { return state; }
+  inline vpMeSiteState getState() const { return (vpMeSiteState)state; }
   
   /*!
     Set the weight of the site
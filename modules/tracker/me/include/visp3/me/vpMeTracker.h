@@ -52,6 +52,7 @@
 #include <math.h>
 #include <iostream>
 #include <list>
+#include <vector>
 
 /*!
   \class vpMeTracker
@@ -60,6 +61,14 @@
   \brief Contains abstract elements for a Distance to Feature type feature.
 
   2D state = list of points, 3D state = feature
+
+  The moving edges sites are stored contiguously in a std::vector accessed
+  with getMeSites(). The index of a site in this vector does not change until
+  the sites are sampled again or suppressed with suppressPoints(), which
+  removes all the suppressed sites in a single pass keeping the order of the
+  others. getMeList() still gives access to the sites as a std::list: this
+  list is a copy of the sites, and the modifications made on it are taken into
+  account the next time the sites are accessed by the tracker.
 */
 class VISP_EXPORT vpMeTracker : public vpTracker
 {
@@ -69,7 +78,7 @@ public:
 protected:
 #endif
   //! Tracking dependent variables/functions
-  //! List of tracked moving edges points.
+  //! List of tracked moving edges points, only kept up to date by getMeList().
   std::list<vpMeSite> list ;
   //! Moving edges initialisation parameters
   vpMe *me ;
@@ -78,6 +87,10 @@ protected:
   
 protected:
   vpMeSite::vpMeSiteDisplayType selectDisplay ;
+  //! Tracked moving edges points.
+  std::vector<vpMeSite> meSites;
+  //! True when the list returned by getMeList() has to be copied back into meSites.
+  bool meListView;
 
 public:
   // Constructor/Destructor
@@ -91,6 +104,8 @@ public:
   //! Track sampled pixels.
   void track(const vpImage<unsigned char>& I);
 
+  unsigned int suppressPoints();
+
   unsigned int numberOfSignal() ;
   unsigned int totalNumberOfSignal() ;
   
@@ -146,15 +161,32 @@ public:
   
     \param l : list of Moving Edges.
   */
-  void setMeList(const std::list<vpMeSite> &l) { list = l; }
- 
+  void setMeList(const std::list<vpMeSite> &l) { meSites.assign(l.begin(), l.end()); meListView = false; }
+
   /*!
-    Return the list of moving edges
-  
-    \return List of Moving Edges.
+    Set the moving edges.
+
+    \param sites : Moving Edges.
+  */
+  void setMeSites(const std::vector<vpMeSite> &sites) { meSites = sites; meListView = false; }
+
+  std::list<vpMeSite>& getMeList();
+  std::list<vpMeSite> getMeList() const;
+
+  /*!
+    Return the moving edges, stored contiguously. The index of a site does
+    not change until the sites are sampled again or suppressed.
+
+    \return Moving Edges.
   */
-  inline std::list<vpMeSite>& getMeList() { return list; }
-  inline std::list<vpMeSite> getMeList() const { return list; }
+  inline std::vector<vpMeSite>& getMeSites()
+  {
+    if (meListView) {
+      meSites.assign(list.begin(), list.end());
+      meListView = false;
+    }
+    return meSites;
+  }
   
   /*!
     Return the number of points that has not been suppressed.
@@ -146,6 +146,7 @@ public:
   void globalCurveApprox(vpList<vpMeSite>& l_crossingPoints, unsigned int n);
   void globalCurveApprox(const std::list<vpImagePoint>& l_crossingPoints, unsigned int n);
   void globalCurveApprox(const std::list<vpMeSite>& l_crossingPoints, unsigned int n);
+  void globalCurveApprox(const std::vector<vpMeSite>& l_crossingPoints, unsigned int n);
   void globalCurveApprox(unsigned int n);
 };
 
@@ -398,12 +398,13 @@ vpMe::print( )
   std::cout<<" Sample step......................"<<sample_step<<" pixels"<<std::endl ;
   std::cout<<" Strip............................"<<strip<<" pixels  "<<std::endl ;
   std::cout<<" Min_Samplestep..................."<<min_samplestep<<" pixels  "<<std::endl ;
+  std::cout<<" Sample reuse threshold..........."<<sample_reuse_threshold<<" pixels  "<<std::endl ;
 }
 
 vpMe::vpMe()
   : threshold(1500), mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0),
     range(4), sample_step(10), ntotal_sample(0), points_to_track(500), mask_size(5),
-    n_mask(180), strip(2), mask(NULL)
+    n_mask(180), strip(2), sample_reuse_threshold(0), mask(NULL)
 {
   //ntotal_sample = 0; // not sure that it is used
   //points_to_track = 500; // not sure that it is used
@@ -415,7 +416,7 @@ vpMe::vpMe()
 vpMe::vpMe(const vpMe &me)
   : threshold(1500), mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0),
     range(4), sample_step(10), ntotal_sample(0), points_to_track(500), mask_size(5),
-    n_mask(180), strip(2), mask(NULL)
+    n_mask(180), strip(2), sample_reuse_threshold(0), mask(NULL)
 {
   *this = me;
 }
@@ -440,6 +441,7 @@ vpMe& vpMe::operator=(const vpMe &me)
   ntotal_sample = me.ntotal_sample;
   points_to_track = me.points_to_track;
   strip = me.strip ;
+  sample_reuse_threshold = me.sample_reuse_threshold ;
   
   initMask() ;
   return *this;
@@ -466,6 +468,7 @@ vpMe& vpMe::operator=(const vpMe &&me)
   ntotal_sample = std::move(me.ntotal_sample);
   points_to_track = std::move(me.points_to_track);
   strip = std::move(me.strip);
+  sample_reuse_threshold = std::move(me.sample_reuse_threshold);
 
   initMask() ;
   return *this;
@@ -131,7 +131,7 @@ vpMeEllipse::vpMeEllipse(const vpMeEllipse &meellipse)
 */
 vpMeEllipse::~vpMeEllipse()
 {
-  list.clear();
+  meSites.clear();
   angle.clear();
 }
 
@@ -171,7 +171,8 @@ vpMeEllipse::sample(const vpImage<unsigned char> & I)
   getParameters();
 
   // Delete old list
-  list.clear();
+  std::vector<vpMeSite> &sites = getMeSites();
+  sites.clear();
 
   angle.clear();
 
@@ -205,7 +206,7 @@ vpMeEllipse::sample(const vpImage<unsigned char> & I)
       {
         vpDisplay::displayCross(I,iP11, 5, vpColor::blue);
       }
-      list.push_back(pix);
+      sites.push_back(pix);
       angle.push_back(k);
     }
     k += incr;
@@ -365,16 +366,14 @@ vpMeEllipse::computeAngle(vpImagePoint pt1, vpImagePoint pt2)
 void
 vpMeEllipse::updateTheta()
 {
-  vpMeSite p_me;
   double theta;
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
-    p_me = *it;
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::iterator it=sites.begin(); it!=sites.end(); ++it){
     vpImagePoint iP;
-    iP.set_i(p_me.ifloat);
-    iP.set_j(p_me.jfloat);
+    iP.set_i(it->ifloat);
+    iP.set_j(it->jfloat);
     computeTheta(theta, K, iP);
-    p_me.alpha = theta;
-    *it = p_me;
+    it->alpha = theta;
   }
 }
 
@@ -385,20 +384,18 @@ void
 vpMeEllipse::suppressPoints()
 {
   // Loop through list of sites to track
-  std::list<vpMeSite>::iterator itList = list.begin();
-  for(std::list<double>::iterator it=angle.begin(); it!=angle.end(); ){
-    vpMeSite s = *itList;//current reference pixel
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
+  std::vector<vpMeSite>::const_iterator itList = getMeSites().begin();
+  for(std::list<double>::iterator it=angle.begin(); it!=angle.end(); ++itList){
+    if (itList->getState() != vpMeSite::NO_SUPPRESSION)
     {
-      itList = list.erase(itList);
       it = angle.erase(it);
     }
     else
     {
-      ++itList;
       ++it;
     }
   }
+  vpMeTracker::suppressPoints();
 }
 
 
@@ -435,6 +432,7 @@ vpMeEllipse::seekExtremities(const vpImage<unsigned char>  &I)
 
   double incr = vpMath::rad(2.0);
 
+  std::vector<vpMeSite> &sites = getMeSites();
   if (alpha2-alpha1 < 2*M_PI-vpMath::rad(6.0))
   {
     vpMeSite P;
@@ -457,7 +455,7 @@ vpMeEllipse::seekExtremities(const vpImage<unsigned char>  &I)
 
         if (P.getState() == vpMeSite::NO_SUPPRESSION)
         {
-          list.push_back(P);
+          sites.push_back(P);
           angle.push_back(k);
           if (vpDEBUG_ENABLE(3)) {
             ip.set_i( P.i );
@@ -494,7 +492,7 @@ vpMeEllipse::seekExtremities(const vpImage<unsigned char>  &I)
 
         if (P.getState() == vpMeSite::NO_SUPPRESSION)
         {
-          list.push_back(P);
+          sites.push_back(P);
           angle.push_back(k);
           if (vpDEBUG_ENABLE(3)) {
             ip.set_i( P.i );
@@ -538,8 +536,9 @@ vpMeEllipse::setExtremities()
   // Loop through list of sites to track
   std::list<double>::const_iterator itAngle = angle.begin();
 
-  for(std::list<vpMeSite>::const_iterator itList=list.begin(); itList!=list.end(); ++itList){
-    vpMeSite s = *itList;//current reference pixel
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::const_iterator itList=sites.begin(); itList!=sites.end(); ++itList){
+    const vpMeSite &s = *itList;//current reference pixel
     double alpha = *itAngle;
     if (alpha < alphamin)
     {
@@ -592,7 +591,8 @@ vpMeEllipse::leastSquare()
   w =1;
   unsigned int nos_1 = numberOfSignal();
 
-  if (list.size() < 3)
+  std::vector<vpMeSite> &sites = getMeSites();
+  if (sites.size() < 3)
   {
     throw(vpException(vpException::dimensionError,
                       "Not enought moving edges to track the ellipse"));
@@ -602,7 +602,7 @@ vpMeEllipse::leastSquare()
   vpColVector x(5);
 
   unsigned int k =0;
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
     p_me = *it;
     if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
     {
@@ -639,7 +639,7 @@ vpMeEllipse::leastSquare()
   }
 
   k =0;
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+  for(std::vector<vpMeSite>::iterator it=sites.begin(); it!=sites.end(); ++it){
     p_me = *it;
     if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
     {
@@ -140,7 +140,7 @@ vpMeLine::vpMeLine(const vpMeLine &meline)
 */
 vpMeLine::~vpMeLine()
 {
-  list.clear();
+  meSites.clear();
 }
 
 /*!
@@ -191,7 +191,9 @@ vpMeLine::sample(const vpImage<unsigned char>& I)
   double js = PExt[1].jfloat;
 
   // Delete old list
-  list.clear();
+  std::vector<vpMeSite> &sites = getMeSites();
+  sites.clear();
+  sites.reserve((size_t)vpMath::round(n_sample) + 1);
 
   // sample positions at i*me->getSampleStep() interval along the
   // line_p, starting at PSiteExt[0]
@@ -213,7 +215,7 @@ vpMeLine::sample(const vpImage<unsigned char>& I)
         vpDisplay::displayCross(I, ip, 2, vpColor::blue);
       }
 
-      list.push_back(pix);
+      sites.push_back(pix);
     }
     is += stepi;
     js += stepj;
@@ -240,7 +242,7 @@ vpMeLine::sample(const vpImage<unsigned char>& I)
 void
 vpMeLine::display(const vpImage<unsigned char>&I, vpColor col)
 {
-  vpMeLine::display(I,PExt[0],PExt[1],list,a,b,c,col);
+  vpMeLine::display(I,PExt[0],PExt[1],getMeSites(),a,b,c,col);
 }
 
 
@@ -308,7 +310,8 @@ vpMeLine::leastSquare()
   unsigned int nos_1 = 0 ;
   double distance = 100;
 
-  if (list.size() <= 2 || numberOfSignal() <= 2)
+  std::vector<vpMeSite> &sites = getMeSites();
+  if (sites.size() <= 2 || numberOfSignal() <= 2)
   {
     //vpERROR_TRACE("Not enough point") ;
     vpCDEBUG(1) << "Not enough point";
@@ -322,7 +325,7 @@ vpMeLine::leastSquare()
   {
     nos_1 = numberOfSignal() ;
     unsigned int k =0 ;
-    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
       {
@@ -355,7 +358,7 @@ vpMeLine::leastSquare()
     }
 
     k =0 ;
-    for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::iterator it=sites.begin(); it!=sites.end(); ++it){
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
       {
@@ -387,7 +390,7 @@ vpMeLine::leastSquare()
   {
     nos_1 = numberOfSignal() ;
     unsigned int k =0 ;
-    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
       {
@@ -420,7 +423,7 @@ vpMeLine::leastSquare()
     }
 
     k =0 ;
-    for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+    for(std::vector<vpMeSite>::iterator it=sites.begin(); it!=sites.end(); ++it){
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION)
       {
@@ -521,15 +524,7 @@ vpMeLine::initTracking(const vpImage<unsigned char> &I,
 void
 vpMeLine::suppressPoints()
 {
-  // Loop through list of sites to track
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ){
-    vpMeSite s = *it;//current reference pixel
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      it = list.erase(it);
-    else
-      ++it;
-  }
+  vpMeTracker::suppressPoints();
 }
 
 
@@ -546,8 +541,9 @@ vpMeLine::setExtremities()
 
 
   // Loop through list of sites to track
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
-    vpMeSite s = *it;//current reference pixel
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
+    const vpMeSite &s = *it;//current reference pixel
     if (s.ifloat < imin)
     {
       imin = s.ifloat ;
@@ -568,8 +564,8 @@ vpMeLine::setExtremities()
 
   if (fabs(imin-imax) < 25)
   {
-    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
-      vpMeSite s = *it;//current reference pixel
+    for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
+      const vpMeSite &s = *it;//current reference pixel
       if (s.jfloat < jmin)
       {
         imin = s.ifloat ;
@@ -645,6 +641,7 @@ vpMeLine::seekExtremities(const vpImage<unsigned char> &I)
   unsigned int  memory_range = me->getRange() ;
   me->setRange(1);
 
+  std::vector<vpMeSite> &sites = getMeSites();
   vpImagePoint ip;
 
   for (int i=0 ; i < 3 ; i++)
@@ -658,7 +655,7 @@ vpMeLine::seekExtremities(const vpImage<unsigned char> &I)
 
       if (P.getState() == vpMeSite::NO_SUPPRESSION)
       {
-        list.push_back(P);
+        sites.push_back(P);
         if (vpDEBUG_ENABLE(3)) {
           ip.set_i( P.i );
           ip.set_j( P.j );
@@ -689,7 +686,7 @@ vpMeLine::seekExtremities(const vpImage<unsigned char> &I)
 
       if (P.getState() == vpMeSite::NO_SUPPRESSION)
       {
-        list.push_back(P);
+        sites.push_back(P);
         if (vpDEBUG_ENABLE(3)) {
           ip.set_i( P.i );
           ip.set_j( P.j );
@@ -769,8 +766,6 @@ vpMeLine::reSample(const vpImage<unsigned char> &I)
 void
 vpMeLine::updateDelta()
 {
-  vpMeSite p_me ;
-
   double angle_ = delta + M_PI/2;
   double diff = 0;
 
@@ -792,11 +787,10 @@ vpMeLine::updateDelta()
 
   angle_1 = angle_;
 
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
-    p_me = *it;
-    p_me.alpha = delta ;
-    p_me.mask_sign = sign;
-    *it = p_me;
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(std::vector<vpMeSite>::iterator it=sites.begin(); it!=sites.end(); ++it){
+    it->alpha = delta ;
+    it->mask_sign = sign;
   }
   delta_1 = delta;
 }
@@ -1442,3 +1436,84 @@ void vpMeLine::display(const vpImage<vpRGBa>& I,const vpMeSite &PExt1, const vpM
   vpDisplay::displayCross(I, ip1, 10, vpColor::green,thickness);
 }
 
+/*!
+  Display of a moving line thanks to its equation parameters and its extremities with all the sites.
+
+  \param I : The image used as background.
+
+  \param PExt1 : First extrimity
+
+  \param PExt2 : Second extrimity
+
+  \param sites : vpMeSite vector
+
+  \param A : Parameter a of the line equation a*i + b*j + c = 0
+
+  \param B : Parameter b of the line equation a*i + b*j + c = 0
+
+  \param C : Parameter c of the line equation a*i + b*j + c = 0
+
+  \param color : Color used to display the line.
+
+  \param thickness : Thickness of the line.
+*/
+void vpMeLine::display(const vpImage<unsigned char>& I,const vpMeSite &PExt1, const vpMeSite &PExt2,
+                       const std::vector<vpMeSite> &sites,
+                       const double &A, const double &B, const double &C,
+                       const vpColor &color,  unsigned int thickness)
+{
+  vpImagePoint ip;
+
+  for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
+    ip.set_i( it->ifloat );
+    ip.set_j( it->jfloat );
+
+    if (it->getState() == vpMeSite::M_ESTIMATOR)
+      vpDisplay::displayCross(I, ip, 5, vpColor::green,thickness);
+    else
+      vpDisplay::displayCross(I, ip, 5, color,thickness);
+  }
+
+  vpMeLine::display(I, PExt1, PExt2, A, B, C, color, thickness);
+}
+
+/*!
+  Display of a moving line thanks to its equation parameters and its extremities with all the sites.
+
+  \param I : The image used as background.
+
+  \param PExt1 : First extrimity
+
+  \param PExt2 : Second extrimity
+
+  \param sites : vpMeSite vector
+
+  \param A : Parameter a of the line equation a*i + b*j + c = 0
+
+  \param B : Parameter b of the line equation a*i + b*j + c = 0
+
+  \param C : Parameter c of the line equation a*i + b*j + c = 0
+
+  \param color : Color used to display the line.
+
+  \param thickness : Thickness of the line.
+*/
+void vpMeLine::display(const vpImage<vpRGBa>& I,const vpMeSite &PExt1, const vpMeSite &PExt2,
+                       const std::vector<vpMeSite> &sites,
+                       const double &A, const double &B, const double &C,
+                       const vpColor &color,  unsigned int thickness)
+{
+  vpImagePoint ip;
+
+  for(std::vector<vpMeSite>::const_iterator it=sites.begin(); it!=sites.end(); ++it){
+    ip.set_i( it->ifloat );
+    ip.set_j( it->jfloat );
+
+    if (it->getState() == vpMeSite::M_ESTIMATOR)
+      vpDisplay::displayCross(I, ip, 5, vpColor::green,thickness);
+    else
+      vpDisplay::displayCross(I, ip, 5, color,thickness);
+  }
+
+  vpMeLine::display(I, PExt1, PExt2, A, B, C, color, thickness);
+}
@@ -317,7 +317,8 @@ vpMeNurbs::sample(const vpImage<unsigned char>& I)
   double step = 1.0 / (double)me->getPointsToTrack();
 
   // Delete old list
-  list.clear();
+  std::vector<vpMeSite> &sites = getMeSites();
+  sites.clear();
 
   vpImagePoint ip;
   double u = 0.0;
@@ -336,7 +337,7 @@ vpMeNurbs::sample(const vpImage<unsigned char>& I)
       pix.init(pt[0].get_i(), pt[0].get_j(), delta) ;
       pix.setDisplay(selectDisplay) ;
 
-      list.push_back(pix);
+      sites.push_back(pix);
       pt_1 = pt[0];
     }
     u = u+step;
@@ -354,16 +355,7 @@ vpMeNurbs::sample(const vpImage<unsigned char>& I)
 void
 vpMeNurbs::suppressPoints()
 {
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ){
-    vpMeSite s = *it;//current reference pixel
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-    {
-      it = list.erase(it);
-    }
-    else
-      ++it;
-  }
+  vpMeTracker::suppressPoints();
 }
 
 
@@ -377,14 +369,15 @@ vpMeNurbs::updateDelta()
   double u = 0.0;
   double d = 1e6;
   double d_1 = 1e6;
-  std::list<vpMeSite>::iterator it=list.begin();
+  std::vector<vpMeSite> &sites = getMeSites();
+  std::vector<vpMeSite>::iterator it=sites.begin();
   
   vpImagePoint Cu;
   vpImagePoint* der = NULL;
   double step = 0.01;
-  while (u < 1 && it!=list.end())
+  while (u < 1 && it!=sites.end())
   {
-    vpMeSite s = *it;
+    vpMeSite &s = *it;
     vpImagePoint pt(s.i,s.j);
     while (d <= d_1 && u<1)
     {
@@ -401,7 +394,6 @@ vpMeNurbs::updateDelta()
       //vpDisplay::displayCross(I,toto,4,vpColor::red);
     
     s.alpha = computeDelta(der[1].get_i(),der[1].get_j());
-    *it = s;
     ++it;
     d = 1e6;
     d_1 = 1.5e6;
@@ -434,12 +426,13 @@ vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
   double threshold = 3*me->getSampleStep();
   double sample_step = me->getSampleStep();
   vpImagePoint pt;
+  std::vector<vpMeSite> &sites = getMeSites();
   if ( d > threshold /*|| (list.firstValue()).mask_sign != (list.lastValue()).mask_sign*/)
   {
     vpMeSite P ;
     
     //Init vpMeSite
-    P.init(begin[0].get_i(), begin[0].get_j(), (list.front()).alpha, 0, (list.front()).mask_sign) ;
+    P.init(begin[0].get_i(), begin[0].get_j(), (sites.front()).alpha, 0, (sites.front()).mask_sign) ;
     P.setDisplay(selectDisplay) ;
 
     //Set the range
@@ -448,6 +441,7 @@ vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
     
     //Point at the beginning of the list
     bool beginPtAdded = false;
+    std::vector<vpMeSite> beginSites;
     vpImagePoint pt_max = begin[0];
     double angle = atan2(begin[1].get_i(),begin[1].get_j());
     double co = vpMath::abs(cos(angle));
@@ -466,7 +460,7 @@ vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
 
         if (P.getState() == vpMeSite::NO_SUPPRESSION)
         {
-          list.push_front(P) ;
+          beginSites.push_back(P) ;
           beginPtAdded = true;
           pt_max = pt;
           if (vpDEBUG_ENABLE(3)) {
@@ -481,9 +475,11 @@ vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
       }
     }
     
+    // The last point found is the first one of the edge
+    sites.insert(sites.begin(), beginSites.rbegin(), beginSites.rend());
     if (!beginPtAdded) beginPtFound++;
 
-    P.init(end[0].get_i(), end[0].get_j(), (list.back()).alpha, 0, (list.back()).mask_sign);
+    P.init(end[0].get_i(), end[0].get_j(), (sites.back()).alpha, 0, (sites.back()).mask_sign);
     P.setDisplay(selectDisplay);
     
     bool endPtAdded = false;
@@ -504,7 +500,7 @@ vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
 
         if (P.getState() == vpMeSite::NO_SUPPRESSION)
         {
-          list.push_back(P) ;
+          sites.push_back(P) ;
           endPtAdded = true;
           if (vpDEBUG_ENABLE(3)) {
             vpDisplay::displayCross(I, pt, 5, vpColor::blue) ;
@@ -522,7 +518,7 @@ vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
   }
   else
   {
-    list.pop_front();
+    sites.erase(sites.begin());
   }
   /*if(begin != NULL)*/ delete[] begin;
   /*if(end != NULL)  */ delete[] end;
@@ -549,9 +545,10 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 #endif
 {
 #if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x030000))
-  vpMeSite pt = list.front();
+  std::vector<vpMeSite> &sites = getMeSites();
+  vpMeSite pt = sites.front();
   vpImagePoint firstPoint(pt.ifloat,pt.jfloat);
-  pt = list.back();
+  pt = sites.back();
   vpImagePoint lastPoint(pt.ifloat,pt.jfloat);
   if (beginPtFound >=3 && farFromImageEdge(I, firstPoint))
   {
@@ -630,22 +627,19 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
     
     if (findCenterPoint(&ip_edges_list))
     {
-      for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); /*++it*/){
-        vpMeSite s = *it;
-        vpImagePoint iP(s.ifloat,s.jfloat);
-        if (inRectangle(iP,rect))
-          it = list.erase(it) ;
-        else
-          break;
-      }
+      std::vector<vpMeSite>::iterator it=sites.begin();
+      while (it!=sites.end() && inRectangle(vpImagePoint(it->ifloat,it->jfloat),rect))
+        ++it;
+      sites.erase(sites.begin(), it);
 
-      std::list<vpMeSite>::iterator itList=list.begin();
+      // Index of the first site that is not in the sub image
+      size_t itList = 0;
       double convlt;
       double delta = 0;
       int nbr = 0;
       std::list<vpMeSite> addedPt;
       for(std::list<vpImagePoint>::const_iterator itEdges=ip_edges_list.begin(); itEdges!=ip_edges_list.end(); ++itEdges){
-        vpMeSite s = *itList;
+        vpMeSite s = sites[itList];
         vpImagePoint iPtemp = *itEdges + topLeft;
         vpMeSite pix;
         pix.init(iPtemp.get_i(), iPtemp.get_j(), delta);
@@ -663,8 +657,7 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
             findAngle(I, iPtemp, me, delta, convlt);
             pix.init(iPtemp.get_i(), iPtemp.get_j(), delta, convlt);
             pix.setDisplay(selectDisplay);
-            --itList;
-            list.insert(itList, pix);
+            sites.insert(sites.begin() + (std::ptrdiff_t)itList, pix);
             ++itList;
             addedPt.push_front(pix);
             nbr++;
@@ -674,13 +667,9 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 
       unsigned int  memory_range = me->getRange();
       me->setRange(3);
-      std::list<vpMeSite>::iterator itList2=list.begin();
       for (int j = 0; j < nbr; j++)
       {
-        vpMeSite s = *itList2;
-        s.track(I,me,false);
-        *itList2 = s;
-        ++itList2;
+        sites[(size_t)j].track(I,me,false);
       }
       me->setRange(memory_range);
     }
@@ -769,29 +758,26 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
     
     if (findCenterPoint(&ip_edges_list))
     {
-//      list.end();
       vpMeSite s;
-      while(true)//{//!list.outside())
+      while(!sites.empty())
       {
-        s = list.back();//list.value() ;
+        s = sites.back();
         vpImagePoint iP(s.ifloat,s.jfloat);
         if (inRectangle(iP,rect))
         {
-          list.erase(list.end()) ;
-//          list.end();
+          sites.pop_back() ;
         }
         else
           break;
       }
 
-      std::list<vpMeSite>::iterator itList = list.end();
-      --itList; // Move on the last element
+      size_t itList = sites.size() - 1; // Index of the last element
       double convlt;
       double delta;
       int nbr = 0;
       std::list<vpMeSite> addedPt;
       for(std::list<vpImagePoint>::const_iterator itEdges=ip_edges_list.begin(); itEdges!=ip_edges_list.end(); ++itEdges){
-        s = *itList;
+        s = sites[itList];
         vpImagePoint iPtemp = *itEdges + topLeft;
         vpMeSite pix;
         pix.init(iPtemp.get_i(), iPtemp.get_j(), 0);
@@ -809,7 +795,7 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
             findAngle(I, iPtemp, me, delta, convlt);
             pix.init(iPtemp.get_i(), iPtemp.get_j(), delta, convlt);
             pix.setDisplay(selectDisplay);
-            list.push_back(pix);
+            sites.push_back(pix);
             addedPt.push_back(pix);
             nbr++;
           }
@@ -818,14 +804,9 @@ vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
       
       unsigned int  memory_range = me->getRange();
       me->setRange(3);
-      std::list<vpMeSite>::iterator itList2 = list.end();
-      --itList2; // Move to the last element
       for (int j = 0; j < nbr; j++)
       {
-        vpMeSite me_s = *itList2;
-        me_s.track(I,me,false);
-        *itList2 = me_s;
-        --itList2;
+        sites[sites.size() - 1 - (size_t)j].track(I,me,false);
       }
       me->setRange(memory_range);
     }
@@ -878,18 +859,20 @@ vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
   
   int n = (int)numberOfSignal();
   
-//  list.front();
-  std::list<vpMeSite>::iterator it=list.begin();
-  std::list<vpMeSite>::iterator itNext=list.begin();
-  ++itNext;
+  // The sites are copied in a new vector with the sites added between them,
+  // which avoids moving the following sites at each insertion
+  std::vector<vpMeSite> &sites = getMeSites();
+  std::vector<vpMeSite> resampled;
+  resampled.reserve(sites.size());
+  size_t k = 0;
 
   unsigned int range_tmp = me->getRange();
   me->setRange(2);
 
-  while(itNext!=list.end() && n <= me->getPointsToTrack())
+  while(k+1 < sites.size() && n <= me->getPointsToTrack())
   {
-    vpMeSite s = *it;//current reference pixel
-    vpMeSite s_next = *itNext;//current reference pixel
+    const vpMeSite &s = sites[k];//current reference pixel
+    const vpMeSite &s_next = sites[k+1];//current reference pixel
     
     double d = vpMeSite::sqrDistance(s,s_next);
     if(d > 4 * vpMath::sqr(me->getSampleStep()) && d < 1600)
@@ -946,7 +929,7 @@ vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
             pix.track(I,me,false);
             if (pix.getState() == vpMeSite::NO_SUPPRESSION)
             {
-              list.insert(it, pix);
+              resampled.push_back(pix);
               iP_1 = iP[0];
             }
           }
@@ -957,9 +940,11 @@ vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
         }
       }
     }
-    ++it;
-    ++itNext;
+    resampled.push_back(s);
+    k++;
   }
+  resampled.insert(resampled.end(), sites.begin() + (std::ptrdiff_t)k, sites.end());
+  sites.swap(resampled);
   me->setRange(range_tmp);
 }
 
@@ -992,27 +977,22 @@ vpMeNurbs::supressNearPoints()
       list.next() ;
   }
 #endif
-  std::list<vpMeSite>::const_iterator it=list.begin();
-  std::list<vpMeSite>::iterator itNext=list.begin();
-  ++itNext;
-  for(;itNext!=list.end();){
-    vpMeSite s = *it;//current reference pixel
-    vpMeSite s_next = *itNext;//current reference pixel
+  std::vector<vpMeSite> &sites = getMeSites();
+  size_t next = 1;
+  while(next < sites.size()){
+    const vpMeSite &s = sites[next-1];//current reference pixel
+    vpMeSite &s_next = sites[next];//current reference pixel
 
     if(vpMeSite::sqrDistance(s,s_next) < vpMath::sqr(me->getSampleStep())){
       s_next.setState(vpMeSite::TOO_NEAR);
           
-      *itNext = s_next;
-      ++it;
-      ++itNext;
-      if(itNext!=list.end()){
-        ++it;
-        ++itNext;
+      ++next;
+      if(next < sites.size()){
+        ++next;
       }
     }
     else{
-      ++it;
-      ++itNext;
+      ++next;
     }
   }
 }
@@ -1035,12 +1015,12 @@ vpMeNurbs::track(const vpImage<unsigned char> &I)
   //Suppressions des points ejectes par le tracking
   suppressPoints();
 
-  if (list.size() == 1)
+  if (getMeSites().size() == 1)
     throw(vpTrackingException(vpTrackingException::notEnoughPointError, "Not enough valid me to track"));
 
   //Recalcule les parametres
 //  nurbs.globalCurveInterp(list);
-  nurbs.globalCurveApprox(list,nbControlPoints);
+  nurbs.globalCurveApprox(getMeSites(),nbControlPoints);
   
   //On resample localement
   localReSample(I);
@@ -1050,7 +1030,7 @@ vpMeNurbs::track(const vpImage<unsigned char> &I)
     seekExtremitiesCanny(I);
 
 //   nurbs.globalCurveInterp(list);
-  nurbs.globalCurveApprox(list,nbControlPoints);
+  nurbs.globalCurveApprox(getMeSites(),nbControlPoints);
   
   double u = 0.0;
   vpImagePoint pt;
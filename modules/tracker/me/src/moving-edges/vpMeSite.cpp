@@ -96,8 +96,8 @@ vpMeSite::init()
 }
 
 vpMeSite::vpMeSite()
-  : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), mask_sign(1), alpha(0.),
-    convlt(0.), normGradient(0), weight(1), selectDisplay(NONE), state(NO_SUPPRESSION)
+  : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), selectDisplay(NONE), state(NO_SUPPRESSION),
+    mask_sign(1), alpha(0.), convlt(0.), normGradient(0), weight(1)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , suppress(0)
 #endif
@@ -105,8 +105,8 @@ vpMeSite::vpMeSite()
 }
 
 vpMeSite::vpMeSite(double ip, double jp)
-  : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), mask_sign(1), alpha(0.),
-    convlt(0.), normGradient(0), weight(1), selectDisplay(NONE), state(NO_SUPPRESSION)
+  : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), selectDisplay(NONE), state(NO_SUPPRESSION),
+    mask_sign(1), alpha(0.), convlt(0.), normGradient(0), weight(1)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , suppress(0)
 #endif
@@ -121,8 +121,8 @@ vpMeSite::vpMeSite(double ip, double jp)
   Copy constructor.
 */
 vpMeSite::vpMeSite (const vpMeSite &mesite)
-  : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), mask_sign(1), alpha(0.),
-    convlt(0.), normGradient(0), weight(1), selectDisplay(NONE), state(NO_SUPPRESSION)
+  : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), selectDisplay(NONE), state(NO_SUPPRESSION),
+    mask_sign(1), alpha(0.), convlt(0.), normGradient(0), weight(1)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , suppress(0)
 #endif
@@ -258,7 +258,7 @@ vpMeSite::getQueryList(const vpImage<unsigned char> &I, const int range)
     // Copy parent's convolution
     vpMeSite pel ;
     pel.init(ii, jj, alpha, convlt,mask_sign) ;
-    pel.setDisplay(selectDisplay) ;// Display
+    pel.setDisplay((vpMeSiteDisplayType)selectDisplay) ;// Display
 
     // Add site to the query list
     list_query_pixels[n] = pel ;
@@ -636,7 +636,7 @@ VISP_EXPORT std::ostream& operator<<(std::ostream& os, vpMeSite& vpMeS)
 
 void vpMeSite::display(const vpImage<unsigned char>& I)
 {
-    vpMeSite::display(I,ifloat,jfloat,state);
+    vpMeSite::display(I,ifloat,jfloat,getState());
 }
 
 //Static functions
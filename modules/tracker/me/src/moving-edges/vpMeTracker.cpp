@@ -62,7 +62,7 @@ vpMeTracker::init()
 }
 
 vpMeTracker::vpMeTracker()
-  : list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE)
+  : list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE), meSites(), meListView(false)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
   , query_range (0), display_point(false)
 #endif
@@ -72,7 +72,7 @@ vpMeTracker::vpMeTracker()
 
 vpMeTracker::vpMeTracker(const vpMeTracker& meTracker)
   : vpTracker(meTracker),
-    list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE)
+    list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE), meSites(), meListView(false)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , query_range (0), display_point(false)
 #endif
@@ -80,7 +80,8 @@ vpMeTracker::vpMeTracker(const vpMeTracker& meTracker)
   init();
 
   me = meTracker.me;
-  list = meTracker.list;
+  meSites = meTracker.meListView ? std::vector<vpMeSite>(meTracker.list.begin(), meTracker.list.end())
+                                 : meTracker.meSites;
   nGoodElement = meTracker.nGoodElement;
   init_range = meTracker.init_range;
   selectDisplay = meTracker.selectDisplay;
@@ -97,7 +98,9 @@ vpMeTracker::vpMeTracker(const vpMeTracker& meTracker)
 void vpMeTracker::reset()
 {
   nGoodElement = 0;
+  meSites.clear();
   list.clear();
+  meListView = false;
 }
 
 vpMeTracker::~vpMeTracker()
@@ -108,7 +111,8 @@ vpMeTracker::~vpMeTracker()
 vpMeTracker&
 vpMeTracker::operator = (vpMeTracker& p_me)
 {
-  list = p_me.list;
+  meSites = p_me.getMeSites();
+  meListView = false;
   me = p_me.me;
   selectDisplay = p_me.selectDisplay;
   init_range = p_me.init_range;
@@ -130,14 +134,72 @@ vpMeTracker::numberOfSignal()
   unsigned int number_signal=0;
 
   // Loop through all the points tracked from the contour
-  number_signal = static_cast<unsigned int>(std::count_if(list.begin(), list.end(), isSuppressZero));
+  std::vector<vpMeSite> &sites = getMeSites();
+  number_signal = static_cast<unsigned int>(std::count_if(sites.begin(), sites.end(), isSuppressZero));
   return number_signal;
 }
 
 unsigned int
 vpMeTracker::totalNumberOfSignal()
 {
-  return (unsigned int)list.size();
+  return (unsigned int)getMeSites().size();
+}
+
+/*!
+  Return the list of moving edges. This list is a copy of the sites returned
+  by getMeSites() that is built when needed: the modifications made on the
+  returned list are taken into account the next time the sites are accessed
+  by the tracker.
+
+  \return List of Moving Edges.
+*/
+std::list<vpMeSite> &
+vpMeTracker::getMeList()
+{
+  if (!meListView) {
+    list.assign(meSites.begin(), meSites.end());
+    meListView = true;
+  }
+  return list;
+}
+
+/*!
+  Return a copy of the list of moving edges.
+
+  \return List of Moving Edges.
+*/
+std::list<vpMeSite>
+vpMeTracker::getMeList() const
+{
+  if (meListView) {
+    return list;
+  }
+  return std::list<vpMeSite>(meSites.begin(), meSites.end());
+}
+
+/*!
+  Remove the sites that are suppressed (their state is not
+  vpMeSite::NO_SUPPRESSION) in a single pass, keeping the order of the other
+  sites.
+
+  \return The number of removed sites.
+*/
+unsigned int
+vpMeTracker::suppressPoints()
+{
+  std::vector<vpMeSite> &sites = getMeSites();
+  size_t n = 0;
+  for (size_t k = 0; k < sites.size(); k++) {
+    if (sites[k].getState() == vpMeSite::NO_SUPPRESSION) {
+      if (n != k) {
+        sites[n] = sites[k];
+      }
+      n++;
+    }
+  }
+  unsigned int nbSuppressed = (unsigned int)(sites.size() - n);
+  sites.erase(sites.begin() + (std::ptrdiff_t)n, sites.end());
+  return nbSuppressed;
 }
 
 int
@@ -188,8 +250,9 @@ vpMeTracker::initTracking(const vpImage<unsigned char>& I)
   vpImagePoint ip1, ip2;
 
   // Loop through list of sites to track
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
-    vpMeSite refp = *it;//current reference pixel
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(size_t k = 0; k < sites.size(); k++){
+    vpMeSite &refp = sites[k];//current reference pixel
 
     d++ ;
     // If element hasn't been suppressed
@@ -222,7 +285,6 @@ vpMeTracker::initTracking(const vpImage<unsigned char>& I)
       }
     }
 #endif
-    *it = refp;
   }
 
   /*
@@ -264,7 +326,8 @@ vpMeTracker::track(const vpImage<unsigned char>& I)
       "Moving edges not initialized")) ;
   }
 
-  if (list.empty())
+  std::vector<vpMeSite> &sites = getMeSites();
+  if (sites.empty())
   {
     vpDERROR_TRACE(2, "Tracking error: too few pixel to track");
     throw(vpTrackingException(vpTrackingException::notEnoughPointError,
@@ -276,8 +339,8 @@ vpMeTracker::track(const vpImage<unsigned char>& I)
   nGoodElement=0;
   //  int d =0;
   // Loop through list of sites to track
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
-    vpMeSite s = *it;//current reference pixel
+  for(size_t k = 0; k < sites.size(); k++){
+    vpMeSite &s = sites[k];//current reference pixel
 
     //    d++ ;
     // If element hasn't been suppressed
@@ -315,7 +378,6 @@ vpMeTracker::track(const vpImage<unsigned char>& I)
 #endif
 
       }
-      *it = s;
     }
   }
 }
@@ -338,12 +400,12 @@ vpMeTracker::display(const vpImage<unsigned char>& I)
 #if (DEBUG_LEVEL1)
   {
     std::cout <<"begin vpMeTracker::displayList() " << std::endl ;
-    std::cout<<" There are "<<list.size()<< " sites in the list " << std::endl ;
+    std::cout<<" There are "<<getMeSites().size()<< " sites in the list " << std::endl ;
   }
 #endif
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
-    vpMeSite p_me = *it;
-    p_me.display(I);
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(size_t k = 0; k < sites.size(); k++){
+    sites[k].display(I);
   }
 }
 
@@ -356,16 +418,15 @@ vpMeTracker::display(const vpImage<unsigned char>& I)
 void
 vpMeTracker::display(const vpImage<unsigned char>& I,vpColVector &w, unsigned int &index_w)
 {
-  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
-    vpMeSite P = *it;
+  std::vector<vpMeSite> &sites = getMeSites();
+  for(size_t k = 0; k < sites.size(); k++){
+    vpMeSite &P = sites[k];
 
     if(P.getState() == vpMeSite::NO_SUPPRESSION)
     {
       P.weight = w[index_w];
       index_w++;
     }
-
-    *it = P;
   }
   display(I);
 }
@@ -1065,6 +1065,33 @@ void vpNurbs::globalCurveApprox(const std::list<vpMeSite> &l_crossingPoints, uns
 }
 
 
+/*!
+
+  Method which enables to compute a NURBS curve approximating a set of
+  data points.
+
+  The data points are approximated thanks to a least square method.
+
+  The result of the method is composed by a knot vector, a set of
+  control points and a set of associated weights.
+
+  \param l_crossingPoints : The vector of data points which have to be
+  interpolated.
+
+  \param n : The desired number of control points. This parameter \e n
+  must be under or equal to the number of data points.
+*/
+void vpNurbs::globalCurveApprox(const std::vector<vpMeSite> &l_crossingPoints, unsigned int n)
+{
+  std::vector<vpImagePoint> v_crossingPoints;
+  v_crossingPoints.reserve(l_crossingPoints.size());
+  for(std::vector<vpMeSite>::const_iterator it=l_crossingPoints.begin(); it!=l_crossingPoints.end(); ++it){
+    v_crossingPoints.push_back(vpImagePoint(it->ifloat, it->jfloat));
+  }
+  globalCurveApprox(v_crossingPoints, p, n, knots, controlPoints, weights);
+}
+
+
 /*!
   Method which enables to compute a NURBS curve approximating a set of data points.
   
@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the storage of the moving edges sites.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMeSites.cpp
+
+  Test the storage of the moving edges sites of vpMeTracker: the sites are
+  accessed with getMeSites(), suppressPoints() removes the suppressed sites
+  keeping the order of the others, and the modifications made on the list
+  returned by getMeList() are taken into account by the tracker.
+*/
+
+#include <cmath>
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/me/vpMeLine.h>
+
+namespace {
+  // Vertical edge between a dark and a bright area
+  void buildImage(vpImage<unsigned char> &I, const unsigned int edge)
+  {
+    I.resize(240, 320, 50);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = edge; j < I.getWidth(); j++) {
+        I[i][j] = 200;
+      }
+    }
+  }
+
+  bool checkSites(vpMeLine &line, const double j)
+  {
+    std::vector<vpMeSite> &sites = line.getMeSites();
+    if (sites.size() < 20) {
+      std::cerr << "Bad number of sites: " << sites.size() << std::endl;
+      return false;
+    }
+    for (size_t k = 0; k < sites.size(); k++) {
+      if (sites[k].getState() == vpMeSite::NO_SUPPRESSION && std::fabs(sites[k].jfloat - j) > 1.5) {
+        std::cerr << "Site " << k << " is not on the edge: " << sites[k].jfloat << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    vpImage<unsigned char> I;
+    buildImage(I, 100);
+
+    vpMe me;
+    me.setRange(10);
+    me.setThreshold(1000);
+    me.setSampleStep(5);
+
+    vpMeLine line;
+    line.setMe(&me);
+    line.initTracking(I, vpImagePoint(40, 100), vpImagePoint(200, 100));
+    if (!checkSites(line, 100)) {
+      return EXIT_FAILURE;
+    }
+
+    buildImage(I, 104);
+    line.track(I);
+    if (!checkSites(line, 104)) {
+      return EXIT_FAILURE;
+    }
+
+    // Modifications of the compatibility list
+    std::vector<vpMeSite> sites = line.getMeSites();
+    unsigned int nbSignal = line.numberOfSignal();
+    std::list<vpMeSite> &list = line.getMeList();
+    if (list.size() != sites.size()) {
+      std::cerr << "Bad list size" << std::endl;
+      return EXIT_FAILURE;
+    }
+    list.front().setState(vpMeSite::M_ESTIMATOR);
+    list.back().setState(vpMeSite::CONSTRAST);
+    if (line.numberOfSignal() != nbSignal - 2 || line.getMeSites().front().getState() != vpMeSite::M_ESTIMATOR) {
+      std::cerr << "The modifications of the list have been lost" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (line.getMeList().size() != sites.size() || line.getMeList().back().getState() != vpMeSite::CONSTRAST) {
+      std::cerr << "The list has not been updated" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Suppression of the sites
+    line.getMeSites()[sites.size() / 2].setState(vpMeSite::THRESHOLD);
+    unsigned int nbSuppressed = line.vpMeTracker::suppressPoints();
+    std::vector<vpMeSite> &remaining = line.getMeSites();
+    if (nbSuppressed != 3 || remaining.size() != sites.size() - 3) {
+      std::cerr << "Bad number of suppressed sites: " << nbSuppressed << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (size_t k = 0, l = 1; k < remaining.size(); k++, l++) {
+      if (l == sites.size() / 2) {
+        l++;
+      }
+      if (remaining[k].ifloat != sites[l].ifloat || remaining[k].jfloat != sites[l].jfloat) {
+        std::cerr << "The order of the sites has changed" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << remaining.size() << " sites of " << sizeof(vpMeSite) << " bytes" << std::endl;
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testMeSites is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -119,6 +119,7 @@ class VISP_EXPORT vpTemplateTracker
     unsigned int                nbIteration;
     bool                        useCompositionnal;
     bool                        useInverse;
+    bool                        useSinglePrecisionFilter;
 
     vpTemplateTrackerWarp      *Warp;
     //Parametre de deplacement
@@ -172,7 +173,8 @@ class VISP_EXPORT vpTemplateTracker
         blur(false), useBrent(false), nbIterBrent(0), taillef(0), fgG(NULL), fgdG(NULL),
         ratioPixelIn(0), mod_i(0), mod_j(0), nbParam(), lambdaDep(0), iterationMax(0),
         iterationGlobale(0), diverge(false), nbIteration(0), useCompositionnal(false),
-        useInverse(false), Warp(NULL), p(), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_()
+        useInverse(false), useSinglePrecisionFilter(false), Warp(NULL), p(), dp(), X1(), X2(), dW(), BI(), dIx(),
+        dIy(), zoneRef_()
     {}
     vpTemplateTracker(vpTemplateTrackerWarp *_warp);
     virtual        ~vpTemplateTracker();
@@ -251,6 +253,12 @@ class VISP_EXPORT vpTemplateTracker
     void    setThresholdGradient(double threshold){thresholdGradient=threshold;}
     /*! By default Brent usage is disabled. */
     void    setUseBrent(bool b){useBrent = b;}
+    /*!
+      Compute the blurred image and its gradients with the single precision
+      filters of vpImageFilter, that are faster than the double precision
+      ones. By default the double precision filters are used.
+     */
+    void    setUseSinglePrecisionFilter(bool b){useSinglePrecisionFilter = b;}
     
     void    track(const vpImage<unsigned char> &I);
     void    trackRobust(const vpImage<unsigned char> &I);
@@ -259,7 +267,9 @@ class VISP_EXPORT vpTemplateTracker
 
     void            computeOptimalBrentGain(const vpImage<unsigned char> &I,vpColVector &tp,double tMI,vpColVector &direction,double &alpha);
     virtual double  getCost(const vpImage<unsigned char> &I, const vpColVector &tp) = 0;
-    void            getGaussianBluredImage(const vpImage<unsigned char> &I){ vpImageFilter::filter(I, BI,fgG,taillef); }
+    void            getGaussianBluredImage(const vpImage<unsigned char> &I){ getGaussianBluredImage(I, BI); }
+    void            getGaussianBluredImage(const vpImage<unsigned char> &I, vpImage<double> &GI);
+    void            getGradients(const vpImage<unsigned char> &I, vpImage<double> &Ix, vpImage<double> &Iy);
     virtual void    initHessienDesired(const vpImage<unsigned char> &I)=0;
     virtual void    initHessienDesiredPyr(const vpImage<unsigned char> &I);
     virtual void    initPyramidal(unsigned int nbLvl,unsigned int l0);
@@ -103,9 +103,8 @@ compoInitialised=true;
 void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if(blur)
-    vpImageFilter::filter(I, BI,fgG,taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
+    getGaussianBluredImage(I);
+  getGradients(I, dIx, dIy);
 
   double IW,dIWx,dIWy;
   double Tij;
@@ -51,7 +51,7 @@ vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
     costFunctionVerification(false), blur(true), useBrent(false), nbIterBrent(3),
     taillef(7), fgG(NULL), fgdG(NULL), ratioPixelIn(0), mod_i(1), mod_j(1), nbParam(0),
     lambdaDep(0.001), iterationMax(30), iterationGlobale(0), diverge(false), nbIteration(0),
-    useCompositionnal(true), useInverse(false), Warp(_warp), p(0), dp(), X1(), X2(),
+    useCompositionnal(true), useInverse(false), useSinglePrecisionFilter(false), Warp(_warp), p(0), dp(), X1(), X2(),
     dW(), BI(), dIx(), dIy(), zoneRef_()
 {
   nbParam = Warp->getNbParam() ;
@@ -77,6 +77,58 @@ void vpTemplateTracker::setGaussianFilterSize(unsigned int new_taill)
   vpImageFilter::getGaussianDerivativeKernel(fgdG, taillef) ;
 }
 
+namespace {
+  void convert(const vpImage<float> &src, vpImage<double> &dest)
+  {
+    dest.resize(src.getHeight(), src.getWidth());
+    for (unsigned int i = 0; i < src.getSize(); i++)
+      dest.bitmap[i] = src.bitmap[i];
+  }
+}
+
+/*!
+  Blur an image with the Gaussian kernel of the tracker, in single precision
+  if setUseSinglePrecisionFilter() has been called.
+
+  \param I : Input image.
+  \param GI : Blurred image.
+ */
+void vpTemplateTracker::getGaussianBluredImage(const vpImage<unsigned char> &I, vpImage<double> &GI)
+{
+  if (useSinglePrecisionFilter) {
+    vpImage<float> GIf;
+    vpImageFilter::filter(I, GIf, fgG, taillef);
+    convert(GIf, GI);
+  }
+  else {
+    vpImageFilter::filter(I, GI, fgG, taillef);
+  }
+}
+
+/*!
+  Compute the gradients of an image with the Gaussian and Gaussian derivative
+  kernels of the tracker, in single precision if setUseSinglePrecisionFilter()
+  has been called.
+
+  \param I : Input image.
+  \param Ix : Gradient along X.
+  \param Iy : Gradient along Y.
+ */
+void vpTemplateTracker::getGradients(const vpImage<unsigned char> &I, vpImage<double> &Ix, vpImage<double> &Iy)
+{
+  if (useSinglePrecisionFilter) {
+    vpImage<float> If;
+    vpImageFilter::getGradXGauss2D(I, If, fgG, fgdG, taillef);
+    convert(If, Ix);
+    vpImageFilter::getGradYGauss2D(I, If, fgG, fgdG, taillef);
+    convert(If, Iy);
+  }
+  else {
+    vpImageFilter::getGradXGauss2D(I, Ix, fgG, fgdG, taillef);
+    vpImageFilter::getGradYGauss2D(I, Iy, fgG, fgdG, taillef);
+  }
+}
+
 void vpTemplateTracker::initTracking(const vpImage<unsigned char>& I, vpTemplateTrackerZone &zone)
 {
   // 	std::cout<<"\tInitialise reference..."<<std::endl;
@@ -112,9 +164,8 @@ void vpTemplateTracker::initTracking(const vpImage<unsigned char>& I, vpTemplate
   vpTemplateTrackerPoint pt;
   //vpTemplateTrackerZPoint ptZ;
   vpImage<double> GaussI ;
-  vpImageFilter::filter(I, GaussI,fgG,taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
+  getGaussianBluredImage(I, GaussI);
+  getGradients(I, dIx, dIy);
 
   unsigned int cpt_point=0;
   templateSelectSize=0;
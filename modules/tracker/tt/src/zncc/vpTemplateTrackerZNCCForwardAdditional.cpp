@@ -47,9 +47,8 @@ vpTemplateTrackerZNCCForwardAdditional::vpTemplateTrackerZNCCForwardAdditional(v
 void vpTemplateTrackerZNCCForwardAdditional::initHessienDesired(const vpImage<unsigned char> &I)
 {
   if(blur)
-    vpImageFilter::filter(I, BI,fgG,taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
+    getGaussianBluredImage(I);
+  getGradients(I, dIx, dIy);
 
   vpImage<double> dIxx,dIxy,dIyx,dIyy;
   vpImageFilter::getGradX(dIx, dIxx, fgdG,taillef);
@@ -157,9 +156,8 @@ void vpTemplateTrackerZNCCForwardAdditional::initHessienDesired(const vpImage<un
 void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if(blur)
-    vpImageFilter::filter(I, BI,fgG,taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
+    getGaussianBluredImage(I);
+  getGradients(I, dIx, dIy);
 
   /*vpImage<double> dIxx,dIxy,dIyx,dIyy;
   getGradX(dIx, dIxx, fgdG,taillef);
@@ -51,8 +51,7 @@ vpTemplateTrackerZNCCInverseCompositional::vpTemplateTrackerZNCCInverseCompositi
 void vpTemplateTrackerZNCCInverseCompositional::initCompInverse(const vpImage<unsigned char> &I)
 {
   //std::cout<<"Initialise precomputed value of Compositionnal Inverse"<<std::endl;
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
+  getGradients(I, dIx, dIy);
 
   for(unsigned int point=0;point<templateSize;point++)
   {
@@ -79,9 +78,8 @@ void vpTemplateTrackerZNCCInverseCompositional::initHessienDesired(const vpImage
   initCompInverse(I);
 
   if(blur)
-    vpImageFilter::filter(I, BI,fgG,taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
+    getGaussianBluredImage(I);
+  getGradients(I, dIx, dIy);
 
   vpImage<double> dIxx,dIxy,dIyx,dIyy;
   vpImageFilter::getGradX(dIx, dIxx, fgdG,taillef);
@@ -243,7 +241,7 @@ void vpTemplateTrackerZNCCInverseCompositional::initHessienDesired(const vpImage
 void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if(blur)
-    vpImageFilter::filter(I, BI,fgG,taillef);
+    getGaussianBluredImage(I);
 
   //double erreur=0;
   vpColVector dpinv(nbParam);
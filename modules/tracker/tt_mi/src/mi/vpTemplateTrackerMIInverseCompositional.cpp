@@ -90,8 +90,7 @@ void vpTemplateTrackerMIInverseCompositional::initCompInverse(const vpImage<unsi
 {
   ptTemplateSupp=new vpTemplateTrackerPointSuppMIInv[templateSize];
 
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG,fgdG,taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG,fgdG,taillef);
+  getGradients(I, dIx, dIy);
 
   if(ApproxHessian!=HESSIAN_NONSECOND && ApproxHessian!=HESSIAN_0 && ApproxHessian!=HESSIAN_NEW && ApproxHessian!=HESSIAN_YOUCEF)
   {
@@ -147,7 +146,7 @@ void vpTemplateTrackerMIInverseCompositional::initHessienDesired(const vpImage<u
   //erreur=0;
 
   if(blur)
-    vpImageFilter::filter(I, BI,fgG,taillef);
+    getGaussianBluredImage(I);
 
   zeroProbabilities();
   Warp->computeCoeff(p);
@@ -241,7 +240,7 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
   dW=0;
 
   if(blur)
-    vpImageFilter::filter(I, BI,fgG,taillef);
+    getGaussianBluredImage(I);
 
   lambda=lambdaDep;
   double MI=0,MIprec=-1000;
@@ -309,7 +309,9 @@ class VISP_EXPORT vpHomography : public vpArray2D<double>
                        double &residual,
                        unsigned int nbInliersConsensus,
                        double threshold,
-                       bool normalization=true);
+                       bool normalization=true,
+                       int nbThreads=1,
+                       long seed=0);
 
     static vpImagePoint project(const vpCameraParameters &cam, const vpHomography &bHa, const vpImagePoint &iPa);
     static vpPoint project(const vpHomography &bHa, const vpPoint &Pa);
@@ -49,8 +49,10 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/vision/vpBasicKeyPoint.h>
+#include <visp3/vision/vpLshIndex.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpPointSet.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPixelMeterConversion.h>
@@ -332,6 +334,10 @@ public:
                                            std::vector<vpImagePoint> &candidates, const std::vector<vpPolygon> &polygons,
                                            const std::vector<std::vector<vpPoint> > &roisPt, std::vector<vpPoint> &points, cv::Mat *descriptors=NULL);
 
+  static void compute3DForPointsInPolygons(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
+                                           std::vector<vpImagePoint> &candidates, const std::vector<vpPolygon> &polygons,
+                                           const std::vector<std::vector<vpPoint> > &roisPt, vpPointSet &points, cv::Mat *descriptors=NULL);
+
   static void compute3DForPointsOnCylinders(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
                                             std::vector<cv::KeyPoint> &candidates, const std::vector<vpCylinder> &cylinders,
                                             const std::vector<std::vector<std::vector<vpImagePoint> > > &vectorOfCylinderRois,
@@ -813,10 +819,15 @@ public:
        - BruteForce-Hamming
        - BruteForce-Hamming(2)
        - FlannBased
+       - LSH-Hamming (native ViSP multi-probe LSH index, see vpLshIndex)
 
      L1 and L2 norms are preferable choices for SIFT and SURF descriptors, NORM_HAMMING should be used with ORB,
      BRISK and BRIEF, NORM_HAMMING2 should be used with ORB when WTA_K==3 or 4.
 
+     Contrary to FlannBased, the LSH-Hamming index is updated incrementally when train keypoints are appended
+     and its queries are done in parallel when OpenMP is available. It is not used when matching train keypoints
+     to query keypoints (see setMatchingTrainToQuery()).
+
      \param matcherName : Name of the matcher.
    */
   inline void setMatcher(const std::string &matcherName) {
@@ -824,6 +835,9 @@ public:
     initMatcher(m_matcherName);
   }
 
+  void setLshIndexParameters(const unsigned int nbTables, const unsigned int keySize,
+                             const unsigned int multiProbeLevel, const int nbThreads=0);
+
   /*!
     Set the filtering method to eliminate false matching.
     The different methods are:
@@ -1051,6 +1065,8 @@ private:
   vpImageFormatType m_imageFormat;
   //! List of k-nearest neighbors for each detected keypoints (if the method chosen is based upon on knn).
   std::vector<std::vector<cv::DMatch> > m_knnMatches;
+  //! Native LSH index of the train descriptors, used with the LSH-Hamming matcher.
+  vpLshIndex m_lshIndex;
   //! Map descriptor enum type to string.
   std::map<vpFeatureDescriptorType, std::string> m_mapOfDescriptorNames;
   //! Map detector enum type to string.
@@ -1118,6 +1134,8 @@ private:
   bool m_useConsensusPercentage;
   //! Flag set if a knn matching method must be used.
   bool m_useKnn;
+  //! Flag set if the native LSH index is used to match query descriptors to train descriptors.
+  bool m_useLshIndex;
   //! Flag set if we want to match the train keypoints to the query keypoints, useful when there is only one train image
   //! because it reduces the number of possible false matches (by default it is the inverse because normally there are multiple
   //! train images of different views of the object)
@@ -1144,6 +1162,10 @@ private:
 
   void initFeatureNames();
 
+  void matchLshIndex(const cv::Mat &queryDescriptors, const unsigned int k);
+
+  void updateLshIndex(const bool append);
+
   inline size_t myKeypointHash(const cv::KeyPoint &kp) {
     size_t _Val = 2166136261U, scale = 16777619U;
     Cv32suf u;
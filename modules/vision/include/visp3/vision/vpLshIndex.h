@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Multi-probe LSH index for binary descriptors.
+ *
+ *****************************************************************************/
+#ifndef __vpLshIndex_h__
+#define __vpLshIndex_h__
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpLshIndex
+  \ingroup group_vision_keypoints
+
+  \brief Incremental multi-probe Locality Sensitive Hashing index for binary
+  descriptors (ORB, BRISK, BRIEF, FREAK, ...) compared with the Hamming
+  distance.
+
+  Each of the nbTables hash tables uses as key a fixed random subset of
+  keySize bits of the descriptor. A query looks in the bucket of its own key
+  and, with multi-probe, in all the buckets whose key differs by at most
+  multiProbeLevel bits. The candidates are then ranked with a popcount based
+  Hamming distance.
+
+  Contrary to the FLANN LSH index, descriptors can be appended with add()
+  without rebuilding the tables. Buckets are stored as chained lists in flat
+  arrays so that adding a descriptor is O(nbTables). The per thread buffers
+  used by the queries are kept from one call to the other, so that queries
+  only allocate memory when the index grew. Consequently knnSearch() and
+  ratioMatch() must not be called concurrently on the same index. When OpenMP
+  is available, queries are dispatched on several threads (see
+  setNbThreads()).
+
+  The following example matches query descriptors to train descriptors with
+  a ratio test:
+  \code
+#include <visp3/vision/vpLshIndex.h>
+
+int main()
+{
+  std::vector<unsigned char> train, query; // 32 bytes per descriptor
+  // ... fill train and query
+  vpLshIndex index;
+  index.add(&train[0], (unsigned int)train.size()/32, 32);
+
+  std::vector<int> trainIdx;
+  std::vector<unsigned int> distances;
+  index.ratioMatch(&query[0], (unsigned int)query.size()/32, 0.8, trainIdx, distances);
+}
+  \endcode
+
+  vpKeyPoint uses this index when the matcher name is set to "LSH-Hamming"
+  with vpKeyPoint::setMatcher().
+*/
+class VISP_EXPORT vpLshIndex
+{
+public:
+  vpLshIndex(const unsigned int nbTables=8, const unsigned int keySize=16, const unsigned int multiProbeLevel=2,
+             const long seed=0);
+  virtual ~vpLshIndex() {}
+
+  void add(const unsigned char * const descriptors, const unsigned int nbDescriptors, const unsigned int descriptorSize);
+  void clear();
+
+  /*!
+    Return the size in bytes of the indexed descriptors, 0 if the index is empty.
+  */
+  inline unsigned int getDescriptorSize() const {
+    return m_descriptorSize;
+  }
+
+  /*!
+    Return the number of hash tables.
+  */
+  inline unsigned int getNbTables() const {
+    return m_nbTables;
+  }
+
+  /*!
+    Return the number of threads used by knnSearch() and ratioMatch().
+  */
+  inline int getNbThreads() const {
+    return m_nbThreads;
+  }
+
+  static unsigned int hammingDistance(const unsigned char * const a, const unsigned char * const b, const unsigned int size);
+
+  void knnSearch(const unsigned char * const queries, const unsigned int nbQueries, const unsigned int k,
+                 std::vector<int> &trainIdx, std::vector<unsigned int> &distances) const;
+
+  void ratioMatch(const unsigned char * const queries, const unsigned int nbQueries, const double ratio,
+                  std::vector<int> &trainIdx, std::vector<unsigned int> &distances) const;
+
+  /*!
+    Set the number of threads used to process the queries. With a value
+    lower or equal to 0, OpenMP chooses the number of threads.
+    Without OpenMP, queries are always processed sequentially.
+
+    \param nbThreads : Number of threads.
+  */
+  inline void setNbThreads(const int nbThreads) {
+    m_nbThreads = nbThreads;
+  }
+
+  /*!
+    Return the number of indexed descriptors.
+  */
+  inline unsigned int size() const {
+    return m_nbDescriptors;
+  }
+
+private:
+  unsigned int computeKey(const unsigned char * const descriptor, const unsigned int table) const;
+  void initBitSelection(const unsigned int descriptorSize);
+  void searchOne(const unsigned char * const query, const unsigned int k, std::vector<unsigned int> &stamps,
+                 const unsigned int stamp, int * const idx, unsigned int * const dist) const;
+
+  //! Number of hash tables
+  unsigned int m_nbTables;
+  //! Number of bits of a key
+  unsigned int m_keySize;
+  //! Maximal number of flipped bits for the probed buckets
+  unsigned int m_multiProbeLevel;
+  //! Seed used to select the descriptor bits of the keys
+  long m_seed;
+  //! Number of threads used for the queries
+  int m_nbThreads;
+  //! Size of a descriptor in bytes
+  unsigned int m_descriptorSize;
+  //! Number of indexed descriptors
+  unsigned int m_nbDescriptors;
+  //! Copy of the indexed descriptors, stored contiguously
+  std::vector<unsigned char> m_descriptors;
+  //! For each table and each key bit, byte index in the descriptor
+  std::vector<unsigned int> m_bitBytes;
+  //! For each table and each key bit, bit mask in the byte
+  std::vector<unsigned char> m_bitMasks;
+  //! Xor masks applied to a key to get the probed buckets
+  std::vector<unsigned int> m_probeMasks;
+  //! For each table and each key, index of the last descriptor added in the bucket or -1
+  std::vector<int> m_heads;
+  //! For each table and each descriptor, index of the previous descriptor in the same bucket or -1
+  std::vector<int> m_next;
+  //! Per thread marker of the candidates already checked for the current query
+  mutable std::vector<std::vector<unsigned int> > m_stamps;
+  //! Per thread stamp of the current query
+  mutable std::vector<unsigned int> m_stampCounters;
+};
+
+#endif
@@ -51,6 +51,7 @@
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/vision/vpHomography.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpPointSet.h>
 #include <visp3/core/vpRGBa.h>
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
 #  include <visp3/core/vpList.h>
@@ -210,10 +211,12 @@ public:
   virtual ~vpPose() ;
   void addPoint(const vpPoint& P) ;
   void addPoints(const std::vector<vpPoint>& lP);
+  void addPoints(const vpPointSet &points);
   void clearPoint() ;
 
   bool computePose(vpPoseMethodType method, vpHomogeneousMatrix &cMo, bool (*func)(vpHomogeneousMatrix *)=NULL) ;
   double computeResidual(const vpHomogeneousMatrix &cMo) const ;
+  static double computeResidual(const vpHomogeneousMatrix &cMo, const vpPointSet &points) ;
   bool coplanar(int &coplanar_plane_type) ;
   void displayModel(vpImage<unsigned char> &I,
                     vpCameraParameters &cam,
@@ -322,6 +322,104 @@ vpHomography::initRansac(unsigned int n,
   }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace {
+  // Same test than isColinear() for points with homogeneous coordinates (x, y, 1)
+  inline bool isColinearPoint(double x1, double y1, double x2, double y2, double x3, double y3)
+  {
+    double c = (x2-x1)*(y3-y1) - (y2-y1)*(x3-x1);
+    return (c*c < vpEps);
+  }
+
+  bool isDegenerateSample(const std::vector<double> &xb, const std::vector<double> &yb,
+                          const std::vector<double> &xa, const std::vector<double> &ya,
+                          const unsigned int *ind)
+  {
+    for (unsigned int i = 0; i < 2; i++) {
+      for (unsigned int j = i+1; j < 3; j++) {
+        for (unsigned int k = j+1; k < 4; k++) {
+          if (isColinearPoint(xa[ind[i]], ya[ind[i]], xa[ind[j]], ya[ind[j]], xa[ind[k]], ya[ind[k]]))
+            return true;
+          if (isColinearPoint(xb[ind[i]], yb[ind[i]], xb[ind[j]], yb[ind[j]], xb[ind[k]], yb[ind[k]]))
+            return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Squared transfer error of the point b in image a with the normalized homography H (row-major)
+  inline double transferError2(const double *H, double xb, double yb, double xa, double ya)
+  {
+    double w = H[6]*xb + H[7]*yb + H[8];
+    double ex = xa - (H[0]*xb + H[1]*yb + H[2]) / w;
+    double ey = ya - (H[3]*xb + H[4]*yb + H[5]) / w;
+    return ex*ex + ey*ey;
+  }
+
+  // Estimator of an homography from 4 points used by vpRansac
+  class vpHomographyEstimator
+  {
+  public:
+    vpHomographyEstimator(const std::vector<double> &xb_, const std::vector<double> &yb_,
+                          const std::vector<double> &xa_, const std::vector<double> &ya_,
+                          double threshold_, bool normalization_)
+      : xb(xb_), yb(yb_), xa(xa_), ya(ya_), threshold(threshold_), normalization(normalization_)
+    {
+    }
+
+    bool degenerateConfiguration(const unsigned int *ind) const
+    {
+      return isDegenerateSample(xb, yb, xa, ya, ind);
+    }
+
+    bool fit(const unsigned int *ind, vpColVector &M, vpColVector &) const
+    {
+      std::vector<double> xa_rand(4), ya_rand(4), xb_rand(4), yb_rand(4);
+      for(unsigned int i = 0; i < 4; i++)
+      {
+        xa_rand[i] = xa[ind[i]];
+        ya_rand[i] = ya[ind[i]];
+        xb_rand[i] = xb[ind[i]];
+        yb_rand[i] = yb[ind[i]];
+      }
+
+      vpHomography H;
+      try {
+        vpHomography::DLT(xb_rand, yb_rand, xa_rand, ya_rand, H, normalization);
+      }
+      catch(...) {
+        return false;
+      }
+      H /= H[2][2] ;
+
+      M.resize(9, false);
+      for (unsigned int i = 0; i < 9; i++)
+        M[i] = H.data[i];
+
+      // Computing Residual on the samples
+      double r = 0;
+      for (unsigned int i = 0; i < 4; i++)
+        r += transferError2(M.data, xb_rand[i], yb_rand[i], xa_rand[i], ya_rand[i]);
+      r = sqrt(r/4);
+
+      // The hypothesis is only scored if it fits its own samples
+      return (r < threshold);
+    }
+
+    bool isInlier(const vpColVector &M, const vpColVector &, unsigned int i, double t) const
+    {
+      return transferError2(M.data, xb[i], yb[i], xa[i], ya[i]) <= t*t;
+    }
+
+  private:
+    const std::vector<double> &xb, &yb, &xa, &ya;
+    double threshold;
+    bool normalization;
+  };
+}
+#endif //#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
 
   From couples of matched points \f$^a{\bf p}=(x_a,y_a,1)\f$ in image a
@@ -329,6 +427,12 @@ vpHomography::initRansac(unsigned int n,
   homography matrix by resolving \f$^a{\bf p} = ^a{\bf H}_b\; ^b{\bf p}\f$
   using Ransac algorithm.
 
+  The number of trials is adapted to the ratio of inliers of the best
+  homography found so far, and the verification of an hypothesis is stopped
+  as soon as it cannot have more inliers than the best one. When OpenMP is
+  available, the hypotheses are fitted and verified in parallel by batches;
+  the result does not depend on the number of threads.
+
   \param xb, yb : Coordinates vector of matched points in image b. These coordinates are expressed in meters.
   \param xa, ya : Coordinates vector of matched points in image a. These coordinates are expressed in meters.
   \param aHb : Estimated homography that relies the transformation from image a to image b.
@@ -345,6 +449,12 @@ vpHomography::initRansac(unsigned int n,
   \param normalization : When set to true, the coordinates of the points are normalized. The normalization
   carried out is the one preconized by Hartley.
 
+  \param nbThreads : Number of threads used when OpenMP is available. A value lower or equal to 0 lets
+  OpenMP choose the number of threads.
+
+  \param seed : Seed of the random selection of the samples. With 0 the seed is initialized from the current
+  time. With a given seed, the result does not depend on the number of threads.
+
   \return true if the homography could be computed, false otherwise.
 
 */
@@ -355,7 +465,9 @@ bool vpHomography::ransac(const std::vector<double> &xb, const std::vector<doubl
                           double &residual,
                           unsigned int nbInliersConsensus,
                           double threshold,
-                          bool normalization)
+                          bool normalization,
+                          int nbThreads,
+                          long seed)
 {
   unsigned int n = (unsigned int)xb.size();
   if (yb.size() != n || xa.size() != n || ya.size() != n)
@@ -366,133 +478,28 @@ bool vpHomography::ransac(const std::vector<double> &xb, const std::vector<doubl
   if(n<4)
     throw(vpException(vpException::fatalError, "There must be at least 4 matched points"));
 
-  vpUniRand random((const long)time(NULL)) ;
-
-  std::vector<unsigned int> best_consensus;
-  std::vector<unsigned int> cur_consensus;
-  std::vector<unsigned int> cur_outliers;
-  std::vector<unsigned int> cur_randoms;
-
-  std::vector<unsigned int> rand_ind;
-
-  unsigned int nbMinRandom = 4 ;
-  unsigned int ransacMaxTrials = 1000;
-  unsigned int maxDegenerateIter = 1000;
-
-  unsigned int nbTrials = 0;
-  unsigned int nbDegenerateIter = 0;
-  unsigned int nbInliers = 0;
-
-  bool foundSolution = false;
-
-  std::vector<double> xa_rand(nbMinRandom);
-  std::vector<double> ya_rand(nbMinRandom);
-  std::vector<double> xb_rand(nbMinRandom);
-  std::vector<double> yb_rand(nbMinRandom);
-
-  if (inliers.size() != n)
-    inliers.resize(n);
-
-  while (nbTrials < ransacMaxTrials && nbInliers < nbInliersConsensus)
-  {
-    cur_outliers.clear();
-    cur_randoms.clear();
-
-    bool degenerate = true;
-    while(degenerate == true){
-      std::vector<bool> usedPt(n, false);
-
-      rand_ind.clear();
-      for(unsigned int i = 0; i < nbMinRandom; i++)
-      {
-        // Generate random indicies in the range 0..n
-        unsigned int r = (unsigned int)ceil(random()*n) -1;
-        while(usedPt[r]) {
-          r = (unsigned int)ceil(random()*n) -1;
-        }
-        usedPt[r] = true;
-        rand_ind.push_back(r);
-
-        xa_rand[i] = xa[r];
-        ya_rand[i] = ya[r];
-        xb_rand[i] = xb[r];
-        yb_rand[i] = yb[r];
-      }
-
-      try{
-        if (! vpHomography::degenerateConfiguration(xb_rand, yb_rand, xa_rand, ya_rand)) {
-          vpHomography::DLT(xb_rand, yb_rand, xa_rand, ya_rand, aHb, normalization);
-         degenerate = false;
-        }
-      }
-      catch(...){
-        degenerate = true;
-      }
-
-      nbDegenerateIter ++;
-
-      if (nbDegenerateIter > maxDegenerateIter){
-        vpERROR_TRACE("Unable to select a nondegenerate data set");
-        throw(vpException(vpException::fatalError, "Unable to select a nondegenerate data set"));
-      }
-    }
+  vpUniRand random(seed != 0 ? seed : (long)time(NULL)) ;
 
-    aHb /= aHb[2][2] ;
+  const unsigned int nbMinRandom = 4 ;
+  const int ransacMaxTrials = 1000;
 
-    // Computing Residual
-    double r = 0;
-    vpColVector a(3), b(3), c(3) ;
-    for (unsigned int i=0 ; i < nbMinRandom ; i++) {
-      a[0] = xa_rand[i] ; a[1] = ya_rand[i] ; a[2] = 1 ;
-      b[0] = xb_rand[i] ; b[1] = yb_rand[i] ; b[2] = 1 ;
+  vpHomographyEstimator estimator(xb, yb, xa, ya, threshold, normalization);
+  vpColVector bestH;
+  bool foundSolution = vpRansac<vpHomography>::ransac(estimator, n, nbMinRandom, threshold, bestH, inliers,
+                                                      nbInliersConsensus, ransacMaxTrials, nbThreads, random);
 
-      c = aHb*b; c /= c[2] ;
-      r += (a-c).sumSquare() ;
-      //cout << "point " <<i << "  " << (a-c).sumSquare()  <<endl ;;
-    }
+  if (!foundSolution)
+    inliers.assign(n, false);
 
-    // Finding inliers & ouliers
-    r = sqrt(r/nbMinRandom);
-    //std::cout << "Candidate residual: " << r << std::endl;
-    if (r < threshold)
+  if(foundSolution){
+    std::vector<unsigned int> best_consensus;
+    for (unsigned int i = 0; i < n; i++)
     {
-      unsigned int nbInliersCur = 0;
-      for (unsigned int i = 0; i < n ; i++)
-      {
-        a[0] = xa[i] ; a[1] = ya[i] ; a[2] = 1 ;
-        b[0] = xb[i] ; b[1] = yb[i] ; b[2] = 1 ;
-
-        c = aHb*b ; c /= c[2] ;
-        double error = sqrt((a-c).sumSquare()) ;
-        if(error <= threshold){
-          nbInliersCur++;
-          cur_consensus.push_back(i);
-          inliers[i] = true;
-        }
-        else{
-          cur_outliers.push_back(i);
-          inliers[i] = false;
-        }
-      }
-      //std::cout << "nb inliers that matches: " << nbInliersCur << std::endl;
-      if(nbInliersCur > nbInliers)
-      {
-        foundSolution = true;
-        best_consensus = cur_consensus;
-        nbInliers = nbInliersCur;
-      }
-
-      cur_consensus.clear();
-    }
-
-    nbTrials++;
-    if(nbTrials >= ransacMaxTrials){
-      vpERROR_TRACE("Ransac reached the maximum number of trials");
-      foundSolution = true;
+      if (inliers[i])
+        best_consensus.push_back(i);
     }
-  }
+    unsigned int nbInliers = (unsigned int)best_consensus.size();
 
-  if(foundSolution){
     if(nbInliers >= nbInliersConsensus)
     {
       std::vector<double> xa_best(best_consensus.size());
@@ -512,14 +519,8 @@ bool vpHomography::ransac(const std::vector<double> &xb, const std::vector<doubl
       aHb /= aHb[2][2];
 
       residual = 0 ;
-      vpColVector a(3), b(3), c(3);
-      for (unsigned int i=0 ; i < best_consensus.size() ; i++) {
-        a[0] = xa_best[i] ; a[1] = ya_best[i] ; a[2] = 1 ;
-        b[0] = xb_best[i] ; b[1] = yb_best[i] ; b[2] = 1 ;
-
-        c = aHb*b ; c /= c[2] ;
-        residual += (a-c).sumSquare() ;
-      }
+      for (unsigned int i=0 ; i < best_consensus.size() ; i++)
+        residual += transferError2(aHb.data, xb_best[i], yb_best[i], xa_best[i], ya_best[i]);
 
       residual = sqrt(residual/best_consensus.size());
       return true;
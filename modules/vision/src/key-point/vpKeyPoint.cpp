@@ -304,7 +304,7 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(),
     m_detectors(), m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
+    m_imageFormat(jpgImageFormat), m_knnMatches(), m_lshIndex(), m_mapOfImageId(), m_mapOfImages(),
     m_matcher(), m_matcherName(matcherName),
     m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
     m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100), m_objectFilteredPoints(),
@@ -316,7 +316,7 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
     m_useBruteForceCrossCheck(true),
 #endif
     m_useConsensusPercentage(false),
-    m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
+    m_useKnn(false), m_useLshIndex(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
 
@@ -339,7 +339,7 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(),
     m_detectors(), m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
+    m_imageFormat(jpgImageFormat), m_knnMatches(), m_lshIndex(), m_mapOfImageId(), m_mapOfImages(),
     m_matcher(), m_matcherName(matcherName),
     m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
     m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100), m_objectFilteredPoints(),
@@ -351,7 +351,7 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
     m_useBruteForceCrossCheck(true),
 #endif
     m_useConsensusPercentage(false),
-    m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
+    m_useKnn(false), m_useLshIndex(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
 
@@ -374,7 +374,7 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(detectorNames),
     m_detectors(), m_extractionTime(0.), m_extractorNames(extractorNames), m_extractors(), m_filteredMatches(),
-    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
+    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_lshIndex(), m_mapOfImageId(), m_mapOfImages(),
     m_matcher(),
     m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
     m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100), m_objectFilteredPoints(),
@@ -386,7 +386,7 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
     m_useBruteForceCrossCheck(true),
 #endif
     m_useConsensusPercentage(false),
-    m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
+    m_useKnn(false), m_useLshIndex(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
   init();
@@ -536,6 +536,7 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I,
   //Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  updateLshIndex(false);
 
   return static_cast<unsigned int>(m_trainKeyPoints.size());
 }
@@ -637,6 +638,7 @@ void vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const std::vect
   //Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  updateLshIndex(append);
 
   _reference_computed = true;
 }
@@ -827,6 +829,74 @@ void vpKeyPoint::compute3DForPointsInPolygons(const vpHomogeneousMatrix &cMo, co
   }
 }
 
+/*!
+   Keep only keypoints located on faces and compute for those keypoints the 3D coordinate in the world/object frame given the 2D image coordinate
+   and under the assumption that the point is located on a plane.
+
+   Contrary to the other versions of this function, the plane equation of each face and the inverse of the pose are
+   computed only once, and the 3D points are stored in a vpPointSet so that no vpPoint is created.
+
+   A face with less than 3 points does not define a plane: it is skipped and the keypoints inside it can still be
+   associated to one of the next faces. The other versions of this function expect at least 3 points per face.
+
+   \param cMo : Homogeneous matrix between the world and the camera frames.
+   \param cam : Camera parameters.
+   \param candidates : In input, list of vpImagePoint located in the whole image, in output, list of vpImagePoint only located
+   on planes.
+   \param polygons : List of 2D polygons representing the projection of the faces in the image plane.
+   \param  roisPt : List of faces, with the 3D coordinates known in the camera frame.
+   \param points : Output set of 3D points located only on faces, with their coordinates in the world/object frame, in the
+   camera frame and in the image plane.
+   \param descriptors : Optional parameter, pointer to the descriptors to filter
+ */
+void vpKeyPoint::compute3DForPointsInPolygons(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
+    std::vector<vpImagePoint> &candidates, const std::vector<vpPolygon> &polygons,
+    const std::vector<std::vector<vpPoint> > &roisPt, vpPointSet &points, cv::Mat *descriptors) {
+
+  std::vector<vpImagePoint> candidatesToCheck = candidates;
+  candidates.clear();
+  points.clear();
+  cv::Mat desc;
+
+  vpHomogeneousMatrix oMc = cMo.inverse();
+  std::vector<bool> alreadyOnFace(candidatesToCheck.size(), false);
+
+  for (size_t cpt1 = 0; cpt1 < polygons.size(); cpt1++) {
+    if (roisPt[cpt1].size() < 3) {
+      continue;
+    }
+    vpPlane Po(roisPt[cpt1][0], roisPt[cpt1][1], roisPt[cpt1][2]);
+
+    for (size_t i = 0; i < candidatesToCheck.size(); i++) {
+      if (alreadyOnFace[i] || !polygons[cpt1].isInside(candidatesToCheck[i])) {
+        continue;
+      }
+      alreadyOnFace[i] = true;
+      candidates.push_back(candidatesToCheck[i]);
+
+      double xc = 0.0, yc = 0.0;
+      vpPixelMeterConversion::convertPoint(cam, candidatesToCheck[i], xc, yc);
+      double Z = -Po.getD() / (Po.getA() * xc + Po.getB() * yc + Po.getC());
+      double X = xc * Z;
+      double Y = yc * Z;
+
+      points.addPoint(oMc[0][0]*X + oMc[0][1]*Y + oMc[0][2]*Z + oMc[0][3],
+                      oMc[1][0]*X + oMc[1][1]*Y + oMc[1][2]*Z + oMc[1][3],
+                      oMc[2][0]*X + oMc[2][1]*Y + oMc[2][2]*Z + oMc[2][3]);
+      points.setCameraCoordinates(points.size()-1, X, Y, Z);
+      points.setImageCoordinates(points.size()-1, xc, yc);
+
+      if(descriptors != NULL) {
+        desc.push_back(descriptors->row((int) i));
+      }
+    }
+  }
+
+  if(descriptors != NULL) {
+    desc.copyTo(*descriptors);
+  }
+}
+
 /*!
    Keep only keypoints located on cylinders and compute the 3D coordinates in the world/object frame given the 2D image coordinates.
 
@@ -2319,10 +2389,23 @@ void vpKeyPoint::initMatcher(const std::string &matcherName) {
       m_matcher = new cv::FlannBasedMatcher(new cv::flann::KDTreeIndexParams());
 #endif
     }
+  } else if(matcherName == "LSH-Hamming") {
+    if(descriptorType != CV_8U) {
+      throw vpException(vpException::fatalError, "The LSH-Hamming matcher requires binary descriptors (CV_8U) !");
+    }
+
+    //The native LSH index is used for the query to train matching, the brute force matcher
+    //is kept for the train to query matching
+    m_matcher = cv::DescriptorMatcher::create("BruteForce-Hamming");
   } else {
     m_matcher = cv::DescriptorMatcher::create(matcherName);
   }
 
+  m_useLshIndex = (matcherName == "LSH-Hamming");
+  if(m_useLshIndex && _reference_computed) {
+    updateLshIndex(false);
+  }
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
   if(m_matcher != NULL && !m_useKnn && matcherName == "BruteForce") {
     m_matcher->set("crossCheck", m_useBruteForceCrossCheck);
@@ -2337,6 +2420,50 @@ void vpKeyPoint::initMatcher(const std::string &matcherName) {
   }
 }
 
+/*!
+   Set the parameters of the native LSH index used with the LSH-Hamming matcher (see vpLshIndex).
+   The index is rebuilt from the current train descriptors.
+
+   \param nbTables : Number of hash tables.
+   \param keySize : Number of bits of the hash keys (between 1 and 24).
+   \param multiProbeLevel : Maximal number of bits that differ between the query key and the probed keys.
+   \param nbThreads : Number of threads used for the queries (OpenMP default if <= 0).
+ */
+void vpKeyPoint::setLshIndexParameters(const unsigned int nbTables, const unsigned int keySize,
+                                       const unsigned int multiProbeLevel, const int nbThreads) {
+  m_lshIndex = vpLshIndex(nbTables, keySize, multiProbeLevel);
+  m_lshIndex.setNbThreads(nbThreads);
+  if(m_useLshIndex && _reference_computed) {
+    updateLshIndex(false);
+  }
+}
+
+/*!
+   Add the train descriptors that are not yet in the native LSH index.
+
+   \param append : If false, the index is rebuilt from all the train descriptors.
+ */
+void vpKeyPoint::updateLshIndex(const bool append) {
+  if(!m_useLshIndex) {
+    return;
+  }
+
+  if(!append || m_lshIndex.size() > (unsigned int) m_trainDescriptors.rows) {
+    m_lshIndex.clear();
+  }
+
+  unsigned int start = m_lshIndex.size();
+  if(m_trainDescriptors.rows > (int) start) {
+    if(m_trainDescriptors.type() != CV_8U) {
+      throw vpException(vpException::fatalError, "The LSH-Hamming matcher requires binary descriptors (CV_8U) !");
+    }
+
+    cv::Mat newDescriptors = m_trainDescriptors.rowRange((int) start, m_trainDescriptors.rows).clone();
+    m_lshIndex.add(newDescriptors.ptr<unsigned char>(0), (unsigned int) newDescriptors.rows,
+                   (unsigned int) newDescriptors.cols);
+  }
+}
+
 /*!
    Insert a reference image and a current image side-by-side.
 
@@ -2928,6 +3055,7 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
   //Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  updateLshIndex(append);
 
   //Set _reference_computed to true as we load a learning file
   _reference_computed = true;
@@ -2966,6 +3094,11 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
         m_knnMatches.push_back(tmp);
       }
 
+      matches.resize(m_knnMatches.size());
+      std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
+    } else if(m_useLshIndex) {
+      //Match query descriptors to train descriptors with the native LSH index
+      matchLshIndex(queryDescriptors, 2);
       matches.resize(m_knnMatches.size());
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     } else {
@@ -2986,6 +3119,14 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       for(std::vector<cv::DMatch>::const_iterator it = matchesTmp.begin(); it != matchesTmp.end(); ++it) {
         matches.push_back(cv::DMatch(it->trainIdx, it->queryIdx, it->distance));
       }
+    } else if(m_useLshIndex) {
+      //Match query descriptors to train descriptors with the native LSH index
+      matchLshIndex(queryDescriptors, 1);
+      for(std::vector<std::vector<cv::DMatch> >::const_iterator it = m_knnMatches.begin(); it != m_knnMatches.end(); ++it) {
+        if(!it->empty()) {
+          matches.push_back((*it)[0]);
+        }
+      }
     } else {
       //Match query descriptors to train descriptors
       m_matcher->match(queryDescriptors, matches);
@@ -2994,6 +3135,42 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
   elapsedTime = vpTime::measureTimeMs() - t;
 }
 
+/*!
+   Match the query descriptors to the train descriptors with the native LSH index and store the
+   results in m_knnMatches. Query descriptors without any candidate are discarded.
+
+   \param queryDescriptors : Query descriptors.
+   \param k : Number of nearest neighbors to search.
+ */
+void vpKeyPoint::matchLshIndex(const cv::Mat &queryDescriptors, const unsigned int k) {
+  m_knnMatches.clear();
+  if(queryDescriptors.empty() || m_lshIndex.size() == 0) {
+    return;
+  }
+
+  if(queryDescriptors.type() != CV_8U || (unsigned int) queryDescriptors.cols != m_lshIndex.getDescriptorSize()) {
+    throw vpException(vpException::badValue, "Query descriptors are not compatible with the LSH index !");
+  }
+
+  cv::Mat queryDescriptorsContinuous = queryDescriptors.isContinuous() ? queryDescriptors : queryDescriptors.clone();
+  std::vector<int> trainIdx;
+  std::vector<unsigned int> distances;
+  m_lshIndex.knnSearch(queryDescriptorsContinuous.ptr<unsigned char>(0), (unsigned int) queryDescriptors.rows, k,
+                       trainIdx, distances);
+
+  m_knnMatches.reserve((size_t) queryDescriptors.rows);
+  for(int i = 0; i < queryDescriptors.rows; i++) {
+    std::vector<cv::DMatch> knn;
+    for(unsigned int j = 0; j < k && trainIdx[(size_t) i*k + j] >= 0; j++) {
+      knn.push_back(cv::DMatch(i, trainIdx[(size_t) i*k + j], (float) distances[(size_t) i*k + j]));
+    }
+
+    if(!knn.empty()) {
+      m_knnMatches.push_back(knn);
+    }
+  }
+}
+
 /*!
    Match keypoints detected in the image with those built in the reference list.
 
@@ -3647,7 +3824,7 @@ void vpKeyPoint::reset() {
   m_detectionScore = 0.15; m_detectionThreshold = 100.0; m_detectionTime = 0.0; m_detectorNames.clear();
   m_detectors.clear(); m_extractionTime = 0.0; m_extractorNames.clear(); m_extractors.clear(); m_filteredMatches.clear();
   m_filterType = ratioDistanceThreshold;
-  m_imageFormat = jpgImageFormat; m_knnMatches.clear(); m_mapOfImageId.clear(); m_mapOfImages.clear();
+  m_imageFormat = jpgImageFormat; m_knnMatches.clear(); m_lshIndex = vpLshIndex(); m_mapOfImageId.clear(); m_mapOfImages.clear();
   m_matcher = cv::Ptr<cv::DescriptorMatcher>(); m_matcherName = "BruteForce-Hamming";
   m_matches.clear(); m_matchingFactorThreshold = 2.0; m_matchingRatioThreshold = 0.85; m_matchingTime = 0.0;
   m_matchRansacKeyPointsToPoints.clear(); m_nbRansacIterations = 200; m_nbRansacMinInlierCount = 100;
@@ -3661,7 +3838,7 @@ void vpKeyPoint::reset() {
 #endif
   m_useConsensusPercentage = false;
   m_useKnn = true; //as m_filterType == ratioDistanceThreshold
-  m_useMatchTrainToQuery = false; m_useRansacVVS = true; m_useSingleMatchFilter = true;
+  m_useLshIndex = false; m_useMatchTrainToQuery = false; m_useRansacVVS = true; m_useSingleMatchFilter = true;
 
   m_detectorNames.push_back("ORB");
   m_extractorNames.push_back("ORB");
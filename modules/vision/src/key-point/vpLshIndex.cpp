@@ -0,0 +1,377 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Multi-probe LSH index for binary descriptors.
+ *
+ *****************************************************************************/
+
+#include <string.h>     // memcpy
+#include <algorithm>
+#include <stdint.h>     // uint64_t
+#include <limits>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpLshIndex.h>
+
+#if defined(VISP_HAVE_OPENMP)
+#  include <omp.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+#  include <intrin.h>
+#endif
+
+namespace {
+  inline unsigned int popCount64(const uint64_t v) {
+#if defined(__GNUC__)
+    //Translated into a single POPCNT instruction when the target supports it
+    return (unsigned int) __builtin_popcountll(v);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+    return (unsigned int) __popcnt64(v);
+#else
+    uint64_t x = v - ((v >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (unsigned int) ((x * 0x0101010101010101ULL) >> 56);
+#endif
+  }
+
+  //Append to masks all the keySize bits masks with exactly nbBits bits set, starting at bit start
+  void generateProbeMasks(const unsigned int keySize, const unsigned int start, const unsigned int nbBits,
+                          const unsigned int mask, std::vector<unsigned int> &masks) {
+    if (nbBits == 0) {
+      masks.push_back(mask);
+      return;
+    }
+
+    for (unsigned int i = start; i + nbBits <= keySize; i++) {
+      generateProbeMasks(keySize, i+1, nbBits-1, mask | (1U << i), masks);
+    }
+  }
+}
+
+/*!
+  Create an empty index.
+
+  \param nbTables : Number of hash tables. More tables increase the recall and the memory footprint.
+  \param keySize : Number of descriptor bits used as key in each table, between 1 and 24. A table
+  holds 2^keySize buckets.
+  \param multiProbeLevel : Keys that differ from the query key by at most this number of bits are
+  also probed. 0 disables multi-probe.
+  \param seed : Seed of the random selection of the key bits.
+*/
+vpLshIndex::vpLshIndex(const unsigned int nbTables, const unsigned int keySize, const unsigned int multiProbeLevel,
+                       const long seed)
+  : m_nbTables(nbTables), m_keySize(keySize), m_multiProbeLevel(multiProbeLevel), m_seed(seed), m_nbThreads(0),
+    m_descriptorSize(0), m_nbDescriptors(0), m_descriptors(), m_bitBytes(), m_bitMasks(), m_probeMasks(),
+    m_heads(), m_next(), m_stamps(), m_stampCounters()
+{
+  if (m_nbTables == 0) {
+    throw vpException(vpException::badValue, "The number of LSH tables must be greater than 0");
+  }
+
+  if (m_keySize == 0 || m_keySize > 24) {
+    throw vpException(vpException::badValue, "The LSH key size (%d) must be between 1 and 24 bits", m_keySize);
+  }
+
+  if (m_multiProbeLevel > m_keySize) {
+    m_multiProbeLevel = m_keySize;
+  }
+
+  //Probe first the bucket of the query, then the ones at 1 bit, 2 bits, ...
+  for (unsigned int level = 0; level <= m_multiProbeLevel; level++) {
+    generateProbeMasks(m_keySize, 0, level, 0, m_probeMasks);
+  }
+}
+
+/*!
+  Append descriptors to the index. Descriptors are copied, their index in
+  the search results is their rank of insertion since the last call to clear().
+
+  \param descriptors : Pointer to nbDescriptors contiguous descriptors.
+  \param nbDescriptors : Number of descriptors to add.
+  \param descriptorSize : Size in bytes of a descriptor. It must be the same for all the calls since the last
+  call to clear().
+*/
+void vpLshIndex::add(const unsigned char * const descriptors, const unsigned int nbDescriptors,
+                     const unsigned int descriptorSize) {
+  if (nbDescriptors == 0) {
+    return;
+  }
+
+  if (descriptorSize == 0) {
+    throw vpException(vpException::badValue, "The descriptor size must be greater than 0");
+  }
+
+  if (m_nbDescriptors == 0 && m_descriptorSize != descriptorSize) {
+    initBitSelection(descriptorSize);
+  } else if (m_descriptorSize != descriptorSize) {
+    throw vpException(vpException::dimensionError, "Cannot add descriptors of %d bytes in an index of %d bytes descriptors",
+                      descriptorSize, m_descriptorSize);
+  }
+
+  m_descriptors.insert(m_descriptors.end(), descriptors, descriptors + (size_t) nbDescriptors*descriptorSize);
+  m_next.resize((size_t) (m_nbDescriptors+nbDescriptors) * m_nbTables);
+
+  const size_t nbBuckets = (size_t) 1 << m_keySize;
+  for (unsigned int i = 0; i < nbDescriptors; i++) {
+    const unsigned int idx = m_nbDescriptors + i;
+    const unsigned char * const descriptor = &m_descriptors[(size_t) idx*m_descriptorSize];
+
+    for (unsigned int t = 0; t < m_nbTables; t++) {
+      int &head = m_heads[t*nbBuckets + computeKey(descriptor, t)];
+      m_next[(size_t) idx*m_nbTables + t] = head;
+      head = (int) idx;
+    }
+  }
+
+  m_nbDescriptors += nbDescriptors;
+}
+
+/*!
+  Remove all the descriptors from the index.
+*/
+void vpLshIndex::clear() {
+  m_descriptorSize = 0;
+  m_nbDescriptors = 0;
+  m_descriptors.clear();
+  m_bitBytes.clear();
+  m_bitMasks.clear();
+  m_heads.clear();
+  m_next.clear();
+  m_stamps.clear();
+  m_stampCounters.clear();
+}
+
+unsigned int vpLshIndex::computeKey(const unsigned char * const descriptor, const unsigned int table) const {
+  const unsigned int * const bytes = &m_bitBytes[table*m_keySize];
+  const unsigned char * const masks = &m_bitMasks[table*m_keySize];
+
+  unsigned int key = 0;
+  for (unsigned int b = 0; b < m_keySize; b++) {
+    if (descriptor[bytes[b]] & masks[b]) {
+      key |= 1U << b;
+    }
+  }
+
+  return key;
+}
+
+/*!
+  Compute the Hamming distance between two binary descriptors.
+
+  \param a : First descriptor.
+  \param b : Second descriptor.
+  \param size : Size in bytes of the descriptors.
+  \return The number of different bits.
+*/
+unsigned int vpLshIndex::hammingDistance(const unsigned char * const a, const unsigned char * const b,
+                                         const unsigned int size) {
+  unsigned int dist = 0;
+  unsigned int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t va, vb;
+    memcpy(&va, a+i, sizeof(uint64_t));
+    memcpy(&vb, b+i, sizeof(uint64_t));
+    dist += popCount64(va ^ vb);
+  }
+
+  for (; i < size; i++) {
+    dist += popCount64((uint64_t) (a[i] ^ b[i]));
+  }
+
+  return dist;
+}
+
+void vpLshIndex::initBitSelection(const unsigned int descriptorSize) {
+  const unsigned int nbBits = descriptorSize*8;
+  if (nbBits < m_keySize) {
+    throw vpException(vpException::dimensionError, "Descriptors of %d bits are too small for %d bits LSH keys",
+                      nbBits, m_keySize);
+  }
+
+  m_descriptorSize = descriptorSize;
+  m_bitBytes.resize(m_nbTables*m_keySize);
+  m_bitMasks.resize(m_nbTables*m_keySize);
+
+  //Partial Fisher-Yates shuffle to pick m_keySize distinct bits per table
+  vpUniRand random(m_seed);
+  std::vector<unsigned int> bits(nbBits);
+  for (unsigned int t = 0; t < m_nbTables; t++) {
+    for (unsigned int i = 0; i < nbBits; i++) {
+      bits[i] = i;
+    }
+
+    for (unsigned int b = 0; b < m_keySize; b++) {
+      unsigned int r = b + (unsigned int) (random() * (nbBits - b));
+      if (r >= nbBits) {
+        r = nbBits-1;
+      }
+      std::swap(bits[b], bits[r]);
+
+      m_bitBytes[t*m_keySize + b] = bits[b] / 8;
+      m_bitMasks[t*m_keySize + b] = (unsigned char) (1U << (bits[b] % 8));
+    }
+  }
+
+  m_heads.assign((size_t) m_nbTables << m_keySize, -1);
+}
+
+/*!
+  Search the k nearest neighbors of each query descriptor among the indexed
+  descriptors.
+
+  \param queries : Pointer to nbQueries contiguous descriptors of getDescriptorSize() bytes.
+  \param nbQueries : Number of query descriptors.
+  \param k : Number of neighbors to search.
+  \param trainIdx : Output array of nbQueries*k indexes. The neighbors of the query q are stored
+  from trainIdx[q*k], sorted by increasing distance. When less than k candidates were found, the
+  remaining indexes are set to -1.
+  \param distances : Output array of nbQueries*k Hamming distances, corresponding to trainIdx.
+*/
+void vpLshIndex::knnSearch(const unsigned char * const queries, const unsigned int nbQueries, const unsigned int k,
+                           std::vector<int> &trainIdx, std::vector<unsigned int> &distances) const {
+  trainIdx.assign((size_t) nbQueries*k, -1);
+  distances.assign((size_t) nbQueries*k, std::numeric_limits<unsigned int>::max());
+
+  if (m_nbDescriptors == 0 || nbQueries == 0 || k == 0) {
+    return;
+  }
+
+#if defined(VISP_HAVE_OPENMP)
+  int nbThreads = m_nbThreads > 0 ? m_nbThreads : omp_get_max_threads();
+#else
+  int nbThreads = 1;
+#endif
+
+  //Per thread markers of the candidates already checked, kept from one call to the other. The buffers only
+  //grow with the index, and since the stamps always increase they only have to be cleared when the counter wraps.
+  if (m_stamps.size() < (size_t) nbThreads) {
+    m_stamps.resize((size_t) nbThreads);
+    m_stampCounters.resize((size_t) nbThreads, 0);
+  }
+  for (int i = 0; i < nbThreads; i++) {
+    if (m_stamps[(size_t) i].size() < m_nbDescriptors) {
+      m_stamps[(size_t) i].resize(m_nbDescriptors, 0);
+    }
+  }
+
+#if defined(VISP_HAVE_OPENMP)
+  #pragma omp parallel num_threads(nbThreads)
+#endif
+  {
+#if defined(VISP_HAVE_OPENMP)
+    const size_t tid = (size_t) omp_get_thread_num();
+#else
+    const size_t tid = 0;
+#endif
+    std::vector<unsigned int> &stamps = m_stamps[tid];
+    unsigned int &stamp = m_stampCounters[tid];
+
+#if defined(VISP_HAVE_OPENMP)
+    #pragma omp for schedule(dynamic, 32)
+#endif
+    for (int q = 0; q < (int) nbQueries; q++) {
+      if (++stamp == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        stamp = 1;
+      }
+      searchOne(queries + (size_t) q*m_descriptorSize, k, stamps, stamp,
+                &trainIdx[(size_t) q*k], &distances[(size_t) q*k]);
+    }
+  }
+}
+
+/*!
+  Match each query descriptor to its nearest indexed descriptor and keep the
+  match only if it is discriminant enough, that is if the distance to the
+  nearest neighbor is lower than ratio times the distance to the second
+  nearest neighbor.
+
+  \param queries : Pointer to nbQueries contiguous descriptors of getDescriptorSize() bytes.
+  \param nbQueries : Number of query descriptors.
+  \param ratio : Ratio threshold, typically between 0.7 and 0.85.
+  \param trainIdx : Output array of nbQueries indexes, -1 for the rejected queries.
+  \param distances : Output array of nbQueries Hamming distances to the nearest neighbor.
+*/
+void vpLshIndex::ratioMatch(const unsigned char * const queries, const unsigned int nbQueries, const double ratio,
+                            std::vector<int> &trainIdx, std::vector<unsigned int> &distances) const {
+  std::vector<int> knnIdx;
+  std::vector<unsigned int> knnDistances;
+  knnSearch(queries, nbQueries, 2, knnIdx, knnDistances);
+
+  trainIdx.resize(nbQueries);
+  distances.resize(nbQueries);
+  for (unsigned int q = 0; q < nbQueries; q++) {
+    trainIdx[q] = knnIdx[2*q];
+    distances[q] = knnDistances[2*q];
+
+    //A single candidate cannot be validated by the ratio test
+    if (knnIdx[2*q+1] < 0 || knnDistances[2*q] >= ratio*knnDistances[2*q+1]) {
+      trainIdx[q] = -1;
+    }
+  }
+}
+
+void vpLshIndex::searchOne(const unsigned char * const query, const unsigned int k, std::vector<unsigned int> &stamps,
+                           const unsigned int stamp, int * const idx, unsigned int * const dist) const {
+  const size_t nbBuckets = (size_t) 1 << m_keySize;
+  unsigned int nbFound = 0;
+
+  for (unsigned int t = 0; t < m_nbTables; t++) {
+    const unsigned int key = computeKey(query, t);
+    const int * const heads = &m_heads[t*nbBuckets];
+
+    for (std::vector<unsigned int>::const_iterator it = m_probeMasks.begin(); it != m_probeMasks.end(); ++it) {
+      for (int cur = heads[key ^ *it]; cur >= 0; cur = m_next[(size_t) cur*m_nbTables + t]) {
+        if (stamps[(size_t) cur] == stamp) {
+          continue;
+        }
+        stamps[(size_t) cur] = stamp;
+
+        unsigned int d = hammingDistance(query, &m_descriptors[(size_t) cur*m_descriptorSize], m_descriptorSize);
+        if (nbFound == k && d >= dist[k-1]) {
+          continue;
+        }
+
+        //Insertion in the sorted list of the k best candidates
+        unsigned int pos = nbFound < k ? nbFound++ : k-1;
+        while (pos > 0 && dist[pos-1] > d) {
+          dist[pos] = dist[pos-1];
+          idx[pos] = idx[pos-1];
+          pos--;
+        }
+        dist[pos] = d;
+        idx[pos] = cur;
+      }
+    }
+  }
+}
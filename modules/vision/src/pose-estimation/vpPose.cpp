@@ -160,6 +160,27 @@ vpPose::addPoints(const std::vector<vpPoint> &lP) {
   npt = (unsigned int) listP.size();
 }
 
+/*!
+  Add (append) a set of points in the array of points.
+
+  The pose estimation methods work on a list of vpPoint, so each point of
+  the set is converted to a vpPoint. This method is only a convenience for
+  code that already stores its points in a vpPointSet.
+
+  \param  points : Set of points to add (append). The coordinates in the
+  object frame and in the image plane of each point must be initialized.
+*/
+void
+vpPose::addPoints(const vpPointSet &points) {
+  vpPoint P;
+  for (unsigned int i = 0; i < points.size(); i++) {
+    points.getPoint(i, P);
+    listP.push_back(P);
+    listOfPoints.push_back(P);
+  }
+  npt = (unsigned int) listP.size();
+}
+
 void 
 vpPose::setDistanceToPlaneForCoplanarityTest(double d)
 {
@@ -349,6 +370,34 @@ vpPose::computeResidual(const vpHomogeneousMatrix &cMo) const
 
 
 
+/*!
+  Compute and return the sum of squared residuals expressed in meter^2 for
+  the pose matrix \e cMo and a set of points.
+
+  \param cMo : Input pose. The matrix that defines the pose to be tested.
+  \param points : Points with their coordinates in the object frame and their
+  measured coordinates in the image plane. Their coordinates in the camera
+  frame are not modified.
+
+  \return The value of the sum of squared residuals in meter^2.
+*/
+double
+vpPose::computeResidual(const vpHomogeneousMatrix &cMo, const vpPointSet &points)
+{
+  double residual_ = 0 ;
+  const double *oX = points.get_oX(), *oY = points.get_oY(), *oZ = points.get_oZ() ;
+  const double *x = points.get_x(), *y = points.get_y() ;
+  for (unsigned int i = 0; i < points.size(); i++)
+  {
+    double X = cMo[0][0]*oX[i] + cMo[0][1]*oY[i] + cMo[0][2]*oZ[i] + cMo[0][3] ;
+    double Y = cMo[1][0]*oX[i] + cMo[1][1]*oY[i] + cMo[1][2]*oZ[i] + cMo[1][3] ;
+    double Z = cMo[2][0]*oX[i] + cMo[2][1]*oY[i] + cMo[2][2]*oZ[i] + cMo[2][3] ;
+
+    residual_ += vpMath::sqr(x[i]-X/Z) + vpMath::sqr(y[i]-Y/Z) ;
+  }
+  return residual_ ;
+}
+
 /*!
   Compute the pose according to the desired method which are:
   - vpPose::LAGRANGE: Linear Lagrange approach (test is done to switch between planar and
@@ -42,6 +42,7 @@
 
 #include <visp3/vision/vpPose.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpPointSet.h>
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpRobust.h>
 
@@ -71,18 +72,15 @@ vpPose::poseVirtualVS(vpHomogeneousMatrix & cMo)
     vpColVector sd(2*nb),s(2*nb) ;
     vpColVector v ;
     
-    vpPoint P;
-    std::list<vpPoint> lP ;
+    // points stored as arrays to project them all at once
+    vpPointSet lP(listP) ;
 
     // create sd
     unsigned int k =0 ;
-    for (std::list<vpPoint>::const_iterator it = listP.begin(); it != listP.end(); ++it)
+    for (k = 0; k < nb; k++)
     {
-      P = *it;
-      sd[2*k] = P.get_x() ;
-      sd[2*k+1] = P.get_y() ;
-      lP.push_back(P);
-      k ++;
+      sd[2*k] = lP.get_x(k) ;
+      sd[2*k+1] = lP.get_y(k) ;
     }
 
     vpHomogeneousMatrix cMoPrev = cMo;
@@ -92,19 +90,17 @@ vpPose::poseVirtualVS(vpHomogeneousMatrix & cMo)
     {      
       residu_1 = r ;
 
+      // forward projection of the 3D model for a given pose
+      // change frame coordinates
+      // perspective projection
+      lP.track(cMo) ;
+
       // Compute the interaction matrix and the error
-      k =0 ;
-      for (std::list<vpPoint>::const_iterator it = lP.begin(); it != lP.end(); ++it)
+      for (k = 0; k < nb; k++)
       {
-        P = *it;
-        // forward projection of the 3D model for a given pose
-        // change frame coordinates
-        // perspective projection
-        P.track(cMo) ;
-
-        double x = s[2*k] = P.get_x();  /* point projected from cMo */
-        double y = s[2*k+1] = P.get_y();
-        double Z = P.get_Z() ;
+        double x = s[2*k] = lP.get_x(k);  /* point projected from cMo */
+        double y = s[2*k+1] = lP.get_y(k);
+        double Z = lP.get_Z(k) ;
         L[2*k][0] = -1/Z  ;
         L[2*k][1] = 0 ;
         L[2*k][2] = x/Z ;
@@ -118,8 +114,6 @@ vpPose::poseVirtualVS(vpHomogeneousMatrix & cMo)
         L[2*k+1][3] = 1+y*y ;
         L[2*k+1][4] = -x*y ;
         L[2*k+1][5] = -x ;
-
-        k+=1 ;
       }
       err = s - sd ;
 
@@ -179,19 +173,15 @@ vpPose::poseVirtualVSrobust(vpHomogeneousMatrix & cMo)
     vpColVector sd(2*nb),s(2*nb) ;
     vpColVector v ;
 
-    listP.front() ;
-    vpPoint P;
-    std::list<vpPoint> lP ;
+    // points stored as arrays to project them all at once
+    vpPointSet lP(listP) ;
 
     // create sd
     unsigned int k_ =0 ;
-    for (std::list<vpPoint>::const_iterator it = listP.begin(); it != listP.end(); ++it)
+    for (k_ = 0; k_ < nb; k_++)
     {
-      P = *it;
-      sd[2*k_] = P.get_x() ;
-      sd[2*k_+1] = P.get_y() ;
-      lP.push_back(P) ;
-      k_ ++;
+      sd[2*k_] = lP.get_x(k_) ;
+      sd[2*k_+1] = lP.get_y(k_) ;
     }
     int iter = 0 ;
     res.resize(s.getRows()/2) ;
@@ -204,19 +194,17 @@ vpPose::poseVirtualVSrobust(vpHomogeneousMatrix & cMo)
     {
       residu_1 = r ;
 
+      // forward projection of the 3D model for a given pose
+      // change frame coordinates
+      // perspective projection
+      lP.track(cMo) ;
+
       // Compute the interaction matrix and the error
-      k_ =0 ;
-      for (std::list<vpPoint>::const_iterator it = lP.begin(); it != lP.end(); ++it)
+      for (k_ = 0; k_ < nb; k_++)
       {
-        P = *it;
-        // forward projection of the 3D model for a given pose
-        // change frame coordinates
-        // perspective projection
-        P.track(cMo) ;
-
-        double x = s[2*k_] = P.get_x();  // point projected from cMo
-        double y = s[2*k_+1] = P.get_y();
-        double Z = P.get_Z() ;
+        double x = s[2*k_] = lP.get_x(k_);  // point projected from cMo
+        double y = s[2*k_+1] = lP.get_y(k_);
+        double Z = lP.get_Z(k_) ;
         L[2*k_][0] = -1/Z  ;
         L[2*k_][1] = 0 ;
         L[2*k_][2] = x/Z ;
@@ -230,9 +218,6 @@ vpPose::poseVirtualVSrobust(vpHomogeneousMatrix & cMo)
         L[2*k_+1][3] = 1+y*y ;
         L[2*k_+1][4] = -x*y ;
         L[2*k_+1][5] = -x ;
-
-        k_ ++;
-
       }
       error = s - sd ;
 
@@ -0,0 +1,196 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test robust homography estimation with RANSAC.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testHomographyRansac.cpp
+
+  Test robust homography estimation with vpHomography::ransac() and the
+  generic vpRansac template, sequential and multi-threaded.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpRansac.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpHomography.h>
+
+namespace {
+  const unsigned int nbPoints = 400;
+  const unsigned int nbOutliers = 120;
+
+  void createData(std::vector<double> &xb, std::vector<double> &yb, std::vector<double> &xa, std::vector<double> &ya,
+                  std::vector<bool> &isInlier)
+  {
+    vpHomography aHb;
+    aHb[0][0] = 1.1; aHb[0][1] = 0.05; aHb[0][2] = 0.02;
+    aHb[1][0] = -0.03; aHb[1][1] = 0.95; aHb[1][2] = -0.01;
+    aHb[2][0] = 0.1; aHb[2][1] = -0.05; aHb[2][2] = 1.;
+
+    vpUniRand random(7);
+    xb.resize(nbPoints); yb.resize(nbPoints); xa.resize(nbPoints); ya.resize(nbPoints);
+    isInlier.resize(nbPoints);
+    for (unsigned int i = 0; i < nbPoints; i++) {
+      xb[i] = random() - 0.5;
+      yb[i] = random() - 0.5;
+      double w = aHb[2][0]*xb[i] + aHb[2][1]*yb[i] + aHb[2][2];
+      xa[i] = (aHb[0][0]*xb[i] + aHb[0][1]*yb[i] + aHb[0][2]) / w;
+      ya[i] = (aHb[1][0]*xb[i] + aHb[1][1]*yb[i] + aHb[1][2]) / w;
+      isInlier[i] = true;
+
+      if (i % (nbPoints / nbOutliers) == 0 && i / (nbPoints / nbOutliers) < nbOutliers) {
+        // Outliers are moved far from their true location
+        xa[i] += 0.1 + 0.2*random();
+        ya[i] -= 0.1 + 0.2*random();
+        isInlier[i] = false;
+      }
+    }
+  }
+
+  bool isEqual(const vpColVector &a, const vpColVector &b)
+  {
+    if (a.getRows() != b.getRows())
+      return false;
+    for (unsigned int i = 0; i < a.getRows(); i++) {
+      if (a[i] != b[i])
+        return false;
+    }
+    return true;
+  }
+
+  bool checkInliers(const std::vector<bool> &inliers, const std::vector<bool> &isInlier)
+  {
+    for (size_t i = 0; i < inliers.size(); i++) {
+      if (inliers[i] != isInlier[i]) {
+        std::cerr << "Bad inlier classification for point " << i << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    std::vector<double> xb, yb, xa, ya;
+    std::vector<bool> isInlier;
+    createData(xb, yb, xa, ya, isInlier);
+
+    // With a fixed seed, the consensus and the model must not depend on the number of threads
+    const long seed = 1234;
+    int nbThreads[2] = {1, 4};
+    std::vector<bool> inliersRef;
+    vpHomography aHbRef;
+    for (unsigned int k = 0; k < 2; k++) {
+      vpHomography aHb;
+      std::vector<bool> inliers;
+      double residual = 0;
+      double t = vpTime::measureTimeMs();
+      bool ok = vpHomography::ransac(xb, yb, xa, ya, aHb, inliers, residual, nbPoints - nbOutliers, 1e-4, true,
+                                     nbThreads[k], seed);
+      t = vpTime::measureTimeMs() - t;
+
+      std::cout << "vpHomography::ransac() with " << nbThreads[k] << " thread(s): " << t << " ms, residual: "
+                << residual << std::endl;
+      if (!ok || !checkInliers(inliers, isInlier) || residual > 1e-6) {
+        std::cerr << "vpHomography::ransac() failed" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      if (k == 0) {
+        inliersRef = inliers;
+        aHbRef = aHb;
+      }
+      else {
+        if (inliers != inliersRef) {
+          std::cerr << "vpHomography::ransac() consensus depends on the number of threads" << std::endl;
+          return EXIT_FAILURE;
+        }
+        for (unsigned int i = 0; i < 9; i++) {
+          if (aHb.data[i] != aHbRef.data[i]) {
+            std::cerr << "vpHomography::ransac() model depends on the number of threads" << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+    // Generic template, data coded as expected by vpHomography::computeTransformation()
+    vpColVector x(4*nbPoints);
+    for (unsigned int i = 0; i < nbPoints; i++) {
+      x[2*i] = xb[i];
+      x[2*i+1] = yb[i];
+      x[2*nbPoints+2*i] = xa[i];
+      x[2*nbPoints+2*i+1] = ya[i];
+    }
+
+    vpColVector MRef, inliersColRef;
+    for (unsigned int k = 0; k < 2; k++) {
+      vpColVector M, inliers;
+      double t = vpTime::measureTimeMs();
+      vpRansac<vpHomography>::ransac(nbPoints, x, 4, 1e-4, M, inliers, nbPoints - nbOutliers, 0.0, 10000, nbThreads[k],
+                                     seed);
+      t = vpTime::measureTimeMs() - t;
+      std::cout << "vpRansac<vpHomography>::ransac() with " << nbThreads[k] << " thread(s): " << t << " ms" << std::endl;
+
+      std::vector<bool> inliers_bool(nbPoints);
+      for (unsigned int i = 0; i < nbPoints; i++) {
+        inliers_bool[i] = inliers.getRows() == nbPoints && inliers[i] > 0.5;
+      }
+      if (!checkInliers(inliers_bool, isInlier)) {
+        std::cerr << "vpRansac<vpHomography>::ransac() failed" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      if (k == 0) {
+        MRef = M;
+        inliersColRef = inliers;
+      }
+      else if (!isEqual(M, MRef) || !isEqual(inliers, inliersColRef)) {
+        std::cerr << "vpRansac<vpHomography>::ransac() result depends on the number of threads" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testHomographyRansac is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,241 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test recall and throughput of vpLshIndex against brute force matching.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testLshIndex.cpp
+
+  \brief Test recall and throughput of vpLshIndex against brute force matching.
+*/
+
+#include <iostream>
+#include <limits>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/io/vpParseArgv.h>
+#include <visp3/vision/vpLshIndex.h>
+
+// List of allowed command line options
+#define GETOPTARGS  "cdn:h"
+
+void usage(const char *name, const char *badparam, unsigned int nbTrain);
+bool getOptions(int argc, const char **argv, unsigned int &nbTrain);
+
+/*
+  Print the program options.
+
+  \param name : Program name.
+  \param badparam : Bad parameter name.
+  \param nbTrain : Number of train descriptors.
+ */
+void usage(const char *name, const char *badparam, unsigned int nbTrain)
+{
+  fprintf(stdout, "\n\
+Test recall and throughput of vpLshIndex against brute force matching.\n\
+\n\
+SYNOPSIS\n\
+  %s [-n <nb train descriptors>] [-h]\n", name);
+
+  fprintf(stdout, "\n\
+OPTIONS:                                               Default\n\
+  -n <nb train descriptors>                            %u\n\
+     Number of random train descriptors.\n\
+\n\
+  -h\n\
+     Print the help.\n\n", nbTrain);
+
+  if (badparam)
+    fprintf(stdout, "\nERROR: Bad parameter [%s]\n", badparam);
+}
+
+/*!
+  Set the program options.
+
+  \param argc : Command line number of parameters.
+  \param argv : Array of command line parameters.
+  \param nbTrain : Number of train descriptors.
+  \return false if the program has to be stopped, true otherwise.
+*/
+bool getOptions(int argc, const char **argv, unsigned int &nbTrain)
+{
+  const char *optarg_;
+  int c;
+  while ((c = vpParseArgv::parse(argc, argv, GETOPTARGS, &optarg_)) > 1) {
+
+    switch (c) {
+    case 'n': nbTrain = (unsigned int) atoi(optarg_); break;
+    case 'h': usage(argv[0], NULL, nbTrain); return false; break;
+
+    case 'c':
+    case 'd':
+      break;
+
+    default:
+      usage(argv[0], optarg_, nbTrain);
+      return false; break;
+    }
+  }
+
+  if ((c == 1) || (c == -1)) {
+    // standalone param or error
+    usage(argv[0], NULL, nbTrain);
+    std::cerr << "ERROR: " << std::endl;
+    std::cerr << "  Bad argument " << optarg_ << std::endl << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, const char ** argv) {
+  try {
+    unsigned int nbTrain = 20000;
+
+    // Read the command line options
+    if (getOptions(argc, argv, nbTrain) == false) {
+      return EXIT_FAILURE;
+    }
+
+    const unsigned int descriptorSize = 32; // ORB like descriptors
+    const unsigned int nbQueries = 2000;
+    const unsigned int nbFlippedBits = 12;
+
+    vpUniRand random(42);
+    std::vector<unsigned char> train((size_t) nbTrain*descriptorSize);
+    for (size_t i = 0; i < train.size(); i++) {
+      train[i] = (unsigned char) (random() * 256);
+    }
+
+    // Queries are noisy copies of random train descriptors
+    std::vector<unsigned char> queries((size_t) nbQueries*descriptorSize);
+    for (unsigned int q = 0; q < nbQueries; q++) {
+      unsigned int idx = (unsigned int) (random() * nbTrain) % nbTrain;
+      for (unsigned int b = 0; b < descriptorSize; b++) {
+        queries[q*descriptorSize + b] = train[(size_t) idx*descriptorSize + b];
+      }
+      for (unsigned int f = 0; f < nbFlippedBits; f++) {
+        unsigned int bit = (unsigned int) (random() * descriptorSize*8) % (descriptorSize*8);
+        queries[q*descriptorSize + bit/8] ^= (unsigned char) (1 << (bit%8));
+      }
+    }
+
+    // Brute force reference
+    double t = vpTime::measureTimeMs();
+    std::vector<int> bfIdx(nbQueries, -1);
+    for (unsigned int q = 0; q < nbQueries; q++) {
+      unsigned int bestDist = std::numeric_limits<unsigned int>::max();
+      for (unsigned int i = 0; i < nbTrain; i++) {
+        unsigned int d = vpLshIndex::hammingDistance(&queries[q*descriptorSize], &train[(size_t) i*descriptorSize],
+            descriptorSize);
+        if (d < bestDist) {
+          bestDist = d;
+          bfIdx[q] = (int) i;
+        }
+      }
+    }
+    double tBruteForce = vpTime::measureTimeMs() - t;
+
+    // Index built incrementally in two chunks
+    vpLshIndex index;
+    t = vpTime::measureTimeMs();
+    index.add(&train[0], nbTrain/2, descriptorSize);
+    index.add(&train[(size_t) (nbTrain/2)*descriptorSize], nbTrain - nbTrain/2, descriptorSize);
+    double tBuild = vpTime::measureTimeMs() - t;
+
+    if (index.size() != nbTrain) {
+      std::cerr << "Bad number of indexed descriptors: " << index.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::vector<int> trainIdx;
+    std::vector<unsigned int> distances;
+    t = vpTime::measureTimeMs();
+    index.knnSearch(&queries[0], nbQueries, 2, trainIdx, distances);
+    double tLsh = vpTime::measureTimeMs() - t;
+
+    unsigned int nbGood = 0;
+    for (unsigned int q = 0; q < nbQueries; q++) {
+      if (trainIdx[2*q] == bfIdx[q]) {
+        nbGood++;
+      }
+      if (trainIdx[2*q+1] >= 0 && distances[2*q] > distances[2*q+1]) {
+        std::cerr << "knn results are not sorted for query " << q << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    double recall = nbGood / (double) nbQueries;
+
+    std::cout << "Train descriptors: " << nbTrain << " ; queries: " << nbQueries << std::endl;
+    std::cout << "Brute force: " << tBruteForce << " ms" << std::endl;
+    std::cout << "LSH build: " << tBuild << " ms ; LSH knn search: " << tLsh << " ms" << std::endl;
+    std::cout << "Speed-up: " << tBruteForce / tLsh << " ; recall: " << recall << std::endl;
+
+    if (recall < 0.9) {
+      std::cerr << "LSH recall is too low!" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The ratio test must keep only discriminant matches
+    std::vector<int> ratioIdx;
+    std::vector<unsigned int> ratioDistances;
+    index.ratioMatch(&queries[0], nbQueries, 0.8, ratioIdx, ratioDistances);
+    unsigned int nbRatioMatches = 0;
+    for (unsigned int q = 0; q < nbQueries; q++) {
+      if (ratioIdx[q] >= 0) {
+        nbRatioMatches++;
+        if (ratioDistances[q] >= 0.8*distances[2*q+1]) {
+          std::cerr << "Bad ratio test for query " << q << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    std::cout << "Matches kept by the ratio test: " << nbRatioMatches << std::endl;
+
+    // Clearing the index must allow to change the descriptor size
+    index.clear();
+    index.add(&train[0], nbTrain/2, descriptorSize/2);
+    if (index.size() != nbTrain/2 || index.getDescriptorSize() != descriptorSize/2) {
+      std::cerr << "Bad index state after clear()" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testLshIndex is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
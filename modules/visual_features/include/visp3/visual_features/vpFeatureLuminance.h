@@ -38,6 +38,8 @@
 #ifndef vpFeatureLuminance_h
 #define vpFeatureLuminance_h
 
+#include <vector>
+
 #include <visp3/core/vpMatrix.h>
 #include <visp3/visual_features/vpBasicFeature.h>
 #include <visp3/core/vpImage.h>
@@ -50,12 +52,16 @@
   For more details see \cite Collewet08c.
 */
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#if defined(VISP_BUILD_DEPRECATED_FUNCTIONS) && !defined(DOXYGEN_SHOULD_SKIP_THIS)
 
 /*!
   \class vpLuminance
   \brief Class that defines the luminance and gradient of a point
 
+  \deprecated This class is no more used by vpFeatureLuminance that stores
+  the luminance, the gradient and the coordinates of the pixels in separate
+  arrays. It is only kept for backward compatibility.
+
   \sa vpFeatureLuminance
 */
 class VISP_EXPORT vpLuminance
@@ -75,6 +81,24 @@ class VISP_EXPORT vpLuminance
   \brief Class that defines the image luminance visual feature
 
   For more details see \cite Collewet08c.
+
+  The normalized coordinates and the image gradient of the pixels are stored
+  as separate contiguous arrays. For direct visual servoing, the products
+  \f$ {\bf L}^\top {\bf L} \f$ and \f$ {\bf L}^\top {\bf e} \f$ required by
+  a Gauss-Newton or Levenberg-Marquardt control law can be computed with
+  interactionProduct() without building the \f$ N \times 6 \f$
+  interaction matrix:
+  \code
+  vpFeatureLuminance sI, sId;
+  // ... init() and buildFrom() both features
+  vpMatrix Hsd;
+  vpColVector error, LtE;
+  sId.interactionProduct(Hsd);              // Hsd = Lsd^T Lsd
+  sI.error(sId, error);
+  sId.interactionProduct(error, LtE);       // LtE = Lsd^T error
+  double lambda = 30;
+  vpColVector v = -lambda * Hsd.inverseByLU() * LtE;
+  \endcode
 */
 
 class VISP_EXPORT vpFeatureLuminance : public vpBasicFeature
@@ -91,8 +115,14 @@ class VISP_EXPORT vpFeatureLuminance : public vpBasicFeature
   //! Border size.
   unsigned int bord ;
   
-  //! Store the image (as a vector with intensity and gradient I, Ix, Iy) 
-  vpLuminance *pixInfo ;
+  //! Normalized x coordinate of the pixels
+  std::vector<double> m_x ;
+  //! Normalized y coordinate of the pixels
+  std::vector<double> m_y ;
+  //! Image gradient along x, scaled by px
+  std::vector<double> m_Ix ;
+  //! Image gradient along y, scaled by py
+  std::vector<double> m_Iy ;
   int  firstTimeIn  ;
 
  public:
@@ -126,6 +156,9 @@ class VISP_EXPORT vpFeatureLuminance : public vpBasicFeature
   void init(unsigned int _nbr, unsigned int _nbc, double _Z) ;
   vpMatrix  interaction(const unsigned int select = FEATURE_ALL);
   void      interaction(vpMatrix &L);
+  void      interactionProduct(vpMatrix &LtL) const;
+  void      interactionProduct(const vpColVector &e, vpColVector &LtE) const;
+  void      interactionProduct(const vpColVector &e, vpMatrix &LtL, vpColVector &LtE) const;
 
   vpFeatureLuminance &operator=(const vpFeatureLuminance& f) ;
 
@@ -134,6 +167,8 @@ class VISP_EXPORT vpFeatureLuminance : public vpBasicFeature
   void setCameraParameters(vpCameraParameters &_cam)  ;
   void set_Z(const double Z) ;
 
+ private:
+  void computeInteractionProduct(const vpColVector *e, vpMatrix *LtL, vpColVector *LtE) const;
 
  public:
   vpCameraParameters cam ;
@@ -91,12 +91,12 @@ vpFeatureLuminance::init(unsigned int _nbr, unsigned int _nbc, double _Z)
   dim_s = (nbr-2*bord)*(nbc-2*bord) ;
 
   s.resize(dim_s) ;
-  
-  if (pixInfo != NULL)
-    delete [] pixInfo;
 
-  pixInfo = new vpLuminance[dim_s] ;
-  
+  m_x.resize(dim_s) ;
+  m_y.resize(dim_s) ;
+  m_Ix.resize(dim_s) ;
+  m_Iy.resize(dim_s) ;
+
   Z = _Z ;
 }
 
@@ -104,7 +104,7 @@ vpFeatureLuminance::init(unsigned int _nbr, unsigned int _nbc, double _Z)
   Default constructor that build a visual feature.
 */
 vpFeatureLuminance::vpFeatureLuminance()
-  : Z(1), nbr(0), nbc(0), bord(10), pixInfo(NULL), firstTimeIn(0), cam()
+  : Z(1), nbr(0), nbc(0), bord(10), m_x(), m_y(), m_Ix(), m_Iy(), firstTimeIn(0), cam()
 {
     nbParameters = 1;
     dim_s = 0 ;
@@ -117,7 +117,7 @@ vpFeatureLuminance::vpFeatureLuminance()
  Copy constructor.
  */
 vpFeatureLuminance::vpFeatureLuminance(const vpFeatureLuminance& f)
-  : vpBasicFeature(f), Z(1), nbr(0), nbc(0), bord(10), pixInfo(NULL), firstTimeIn(0), cam()
+  : vpBasicFeature(f), Z(1), nbr(0), nbc(0), bord(10), m_x(), m_y(), m_Ix(), m_Iy(), firstTimeIn(0), cam()
 {
   *this = f;
 }
@@ -133,11 +133,10 @@ vpFeatureLuminance &vpFeatureLuminance::operator=(const vpFeatureLuminance& f)
   bord = f.bord;
   firstTimeIn = f.firstTimeIn;
   cam = f.cam;
-  if (pixInfo)
-    delete [] pixInfo;
-  pixInfo = new vpLuminance[dim_s] ;
-  for(unsigned int i=0; i< dim_s; i++)
-    pixInfo[i] = f.pixInfo[i];
+  m_x = f.m_x;
+  m_y = f.m_y;
+  m_Ix = f.m_Ix;
+  m_Iy = f.m_Iy;
   return (*this);
 }
 
@@ -146,7 +145,6 @@ vpFeatureLuminance &vpFeatureLuminance::operator=(const vpFeatureLuminance& f)
 */
 vpFeatureLuminance::~vpFeatureLuminance() 
 {
-  if (pixInfo != NULL) delete [] pixInfo ;
 }
 
 /*!
@@ -183,68 +181,52 @@ vpFeatureLuminance::setCameraParameters(vpCameraParameters &_cam)
 
 /*!
 
-  Build a luminance feature directly from the image
+  Build a luminance feature directly from the image.
+
+  The normalized coordinates of the pixels are computed only once with a
+  batched conversion. The image gradient is then computed row by row with
+  vpImageFilter::derivativeFilterXRow() and
+  vpImageFilter::derivativeFilterYRow() that apply the same filter than
+  vpImageFilter::derivativeFilterX() and vpImageFilter::derivativeFilterY()
+  on contiguous pixels so that the compiler can vectorize the loops.
 */
 
 void
 vpFeatureLuminance::buildFrom(vpImage<unsigned char> &I)
 {
-  unsigned int l = 0;
-  double Ix,Iy ;
-
   double px = cam.get_px() ;
   double py = cam.get_py() ;
 
-
   if (firstTimeIn==0)
-    { 
-      firstTimeIn=1 ;
-      l =0 ;
-      for (unsigned int i=bord; i < nbr-bord ; i++)
-	{
-	  //   cout << i << endl ;
-	  for (unsigned int j = bord ; j < nbc-bord; j++)
-	    {	double x=0,y=0;
-	      vpPixelMeterConversion::convertPoint(cam,
-						   j,i,
-						   x,y)  ;
-	    
-	      pixInfo[l].x = x;
-	      pixInfo[l].y = y;
-
-	      pixInfo[l].Z   = Z ;
-
-	      l++;
-	    }
-	}
+  {
+    firstTimeIn=1 ;
+    unsigned int l = 0;
+    for (unsigned int i=bord; i < nbr-bord ; i++) {
+      for (unsigned int j = bord ; j < nbc-bord; j++) {
+        m_x[l] = j;
+        m_y[l] = i;
+        l++;
+      }
     }
+    if (dim_s > 0)
+      vpPixelMeterConversion::convertPoints(cam, &m_x[0], &m_y[0], &m_x[0], &m_y[0], dim_s) ;
+  }
 
-  l= 0 ;
+  const unsigned int width = nbc-2*bord;
   for (unsigned int i=bord; i < nbr-bord ; i++)
-    {
-      //   cout << i << endl ;
-      for (unsigned int j = bord ; j < nbc-bord; j++)
-	{
-	  // cout << dim_s <<" " <<l <<"  " <<i << "  " << j <<endl ;
-          Ix =  px * vpImageFilter::derivativeFilterX(I,i,j) ;
-	  Iy =  py * vpImageFilter::derivativeFilterY(I,i,j) ;
-	  
-	  // Calcul de Z
-	  
-	  pixInfo[l].I  =  I[i][j] ;
-	  s[l]  =  I[i][j] ;
-	  pixInfo[l].Ix  = Ix;
-	  pixInfo[l].Iy  = Iy;
-	  
-	  l++;
-	}
-    }
-
+  {
+    const unsigned int l = (i-bord)*width;
+    const unsigned char *r = I[i] + bord;
+    double *sl = s.data + l;
+    for (unsigned int j = 0 ; j < width; j++)
+      sl[j] = r[j] ;
+
+    vpImageFilter::derivativeFilterXRow(I, i, bord, width, &m_Ix[0] + l, px);
+    vpImageFilter::derivativeFilterYRow(I, i, bord, width, &m_Iy[0] + l, py);
+  }
 }
 
 
-
-
 /*!
 
   Compute and return the interaction matrix \f$ L_I \f$. The computation is made
@@ -255,14 +237,14 @@ vpFeatureLuminance::interaction(vpMatrix &L)
 {  
   L.resize(dim_s,6) ;
 
+  const double Zinv = 1 / Z;
   for(unsigned int m = 0; m< L.getRows(); m++)
   {
-    double Ix = pixInfo[m].Ix;
-    double Iy = pixInfo[m].Iy;
+    double Ix = m_Ix[m];
+    double Iy = m_Iy[m];
 
-    double x = pixInfo[m].x ;
-    double y = pixInfo[m].y ;
-    double Zinv =  1 / pixInfo[m].Z;
+    double x = m_x[m] ;
+    double y = m_y[m] ;
 
     {
       L[m][0] = Ix * Zinv;
@@ -275,6 +257,118 @@ vpFeatureLuminance::interaction(vpMatrix &L)
   }
 }
 
+/*!
+  Compute \f$ {\bf L}^\top {\bf L} \f$ where \f$ \bf L \f$ is the
+  interaction matrix of the feature, without building \f$ \bf L \f$.
+
+  \param LtL : Resulting \f$ 6 \times 6 \f$ matrix.
+
+  \sa interaction(vpMatrix &)
+*/
+void
+vpFeatureLuminance::interactionProduct(vpMatrix &LtL) const
+{
+  computeInteractionProduct(NULL, &LtL, NULL);
+}
+
+/*!
+  Compute \f$ {\bf L}^\top {\bf e} \f$ where \f$ \bf L \f$ is the
+  interaction matrix of the feature, without building \f$ \bf L \f$.
+
+  \param e : Error vector of size getDimension(), usually computed with error().
+  \param LtE : Resulting 6-dimension vector.
+*/
+void
+vpFeatureLuminance::interactionProduct(const vpColVector &e, vpColVector &LtE) const
+{
+  computeInteractionProduct(&e, NULL, &LtE);
+}
+
+/*!
+  Compute in a single pass \f$ {\bf L}^\top {\bf L} \f$ and
+  \f$ {\bf L}^\top {\bf e} \f$ where \f$ \bf L \f$ is the interaction matrix
+  of the feature, without building \f$ \bf L \f$.
+
+  \param e : Error vector of size getDimension(), usually computed with error().
+  \param LtL : Resulting \f$ 6 \times 6 \f$ matrix.
+  \param LtE : Resulting 6-dimension vector.
+*/
+void
+vpFeatureLuminance::interactionProduct(const vpColVector &e, vpMatrix &LtL, vpColVector &LtE) const
+{
+  computeInteractionProduct(&e, &LtL, &LtE);
+}
+
+/*!
+  Accumulate the interaction matrix products. Each row of the interaction
+  matrix is computed on the fly and only the upper triangular part of
+  \f$ {\bf L}^\top {\bf L} \f$ is accumulated.
+
+  \param e : Error vector, used only when \e LtE is not NULL.
+  \param LtL : If not NULL, resulting \f$ 6 \times 6 \f$ matrix.
+  \param LtE : If not NULL, resulting 6-dimension vector.
+*/
+void
+vpFeatureLuminance::computeInteractionProduct(const vpColVector *e, vpMatrix *LtL, vpColVector *LtE) const
+{
+  if (LtE != NULL && e->getRows() != dim_s) {
+    throw vpException(vpException::dimensionError,
+                      "Error vector size (%d) is different from the feature dimension (%d)",
+                      e->getRows(), dim_s);
+  }
+
+  double H[21];
+  double g[6];
+  for (unsigned int k = 0; k < 21; k++)
+    H[k] = 0;
+  for (unsigned int k = 0; k < 6; k++)
+    g[k] = 0;
+
+  const double Zinv = 1 / Z;
+  double L[6];
+  for (unsigned int m = 0; m < dim_s; m++)
+  {
+    double Ix = m_Ix[m];
+    double Iy = m_Iy[m];
+    double x = m_x[m];
+    double y = m_y[m];
+
+    L[0] = Ix * Zinv;
+    L[1] = Iy * Zinv;
+    L[2] = -(x*Ix+y*Iy)*Zinv;
+    L[3] = -Ix*x*y-(1+y*y)*Iy;
+    L[4] = (1+x*x)*Ix + Iy*x*y;
+    L[5] = Iy*x-Ix*y;
+
+    if (LtL != NULL) {
+      unsigned int k = 0;
+      for (unsigned int i = 0; i < 6; i++)
+        for (unsigned int j = i; j < 6; j++)
+          H[k++] += L[i]*L[j];
+    }
+    if (LtE != NULL) {
+      double em = (*e)[m];
+      for (unsigned int i = 0; i < 6; i++)
+        g[i] += L[i]*em;
+    }
+  }
+
+  if (LtL != NULL) {
+    LtL->resize(6, 6, false);
+    unsigned int k = 0;
+    for (unsigned int i = 0; i < 6; i++) {
+      for (unsigned int j = i; j < 6; j++) {
+        (*LtL)[i][j] = (*LtL)[j][i] = H[k++];
+      }
+    }
+  }
+  if (LtE != NULL) {
+    LtE->resize(6, false);
+    for (unsigned int i = 0; i < 6; i++)
+      (*LtE)[i] = g[i];
+  }
+}
+
 /*!
   Compute and return the interaction matrix \f$ L_I \f$. The computation is made
   thanks to the values of the luminance features \f$ I \f$
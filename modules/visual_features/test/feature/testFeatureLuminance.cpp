@@ -0,0 +1,175 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the luminance visual feature and its interaction matrix products.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testFeatureLuminance.cpp
+
+  \brief Test the luminance visual feature and its interaction matrix products
+  against the explicit interaction matrix.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/visual_features/vpFeatureLuminance.h>
+
+namespace {
+  void buildImage(vpImage<unsigned char> &I, double phase)
+  {
+    vpUniRand random(17);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double val = 128 + 60*sin(0.07*j + phase)*cos(0.05*i) + 20*random();
+        I[i][j] = (unsigned char) vpMath::round(val);
+      }
+    }
+  }
+
+  bool compare(const vpMatrix &A, const vpMatrix &B, double eps)
+  {
+    for (unsigned int i = 0; i < A.getRows(); i++) {
+      for (unsigned int j = 0; j < A.getCols(); j++) {
+        if (std::fabs(A[i][j] - B[i][j]) > eps * std::max(1.0, std::fabs(B[i][j])))
+          return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  try {
+    vpImage<unsigned char> I(240, 320), Id(240, 320);
+    buildImage(I, 0.3);
+    buildImage(Id, 0.);
+
+    vpCameraParameters cam(600, 600, 160, 120);
+    double Z = 0.8;
+
+    vpFeatureLuminance sI, sId;
+    sI.init(I.getHeight(), I.getWidth(), Z);
+    sI.setCameraParameters(cam);
+    sId.init(Id.getHeight(), Id.getWidth(), Z);
+    sId.setCameraParameters(cam);
+
+    double t = vpTime::measureTimeMs();
+    sI.buildFrom(I);
+    sId.buildFrom(Id);
+    std::cout << "buildFrom(): " << (vpTime::measureTimeMs() - t) / 2 << " ms" << std::endl;
+
+    // The interaction matrix must rely on the gradient given by vpImageFilter
+    vpMatrix L;
+    sI.interaction(L);
+    unsigned int bord = 10;
+    unsigned int width = I.getWidth() - 2*bord;
+    for (unsigned int i = bord; i < I.getHeight() - bord; i += 7) {
+      for (unsigned int j = bord; j < I.getWidth() - bord; j += 5) {
+        double x = 0, y = 0;
+        vpPixelMeterConversion::convertPoint(cam, j, i, x, y);
+        double Ix = cam.get_px() * vpImageFilter::derivativeFilterX(I, i, j);
+        double Iy = cam.get_py() * vpImageFilter::derivativeFilterY(I, i, j);
+        unsigned int m = (i - bord)*width + (j - bord);
+        if (!vpMath::equal(L[m][0], Ix / Z, 1e-9) || !vpMath::equal(L[m][1], Iy / Z, 1e-9)
+            || !vpMath::equal(L[m][5], Iy*x - Ix*y, 1e-9)) {
+          std::cerr << "Bad interaction matrix row for pixel (" << i << ", " << j << ")" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    vpColVector e;
+    sI.error(sId, e);
+
+    t = vpTime::measureTimeMs();
+    vpMatrix LtL_ref = L.AtA();
+    vpColVector LtE_ref = L.t() * e;
+    double tRef = vpTime::measureTimeMs() - t;
+
+    vpMatrix LtL;
+    vpColVector LtE;
+    t = vpTime::measureTimeMs();
+    sI.interactionProduct(e, LtL, LtE);
+    double tProduct = vpTime::measureTimeMs() - t;
+
+    std::cout << "L^T L and L^T e from L: " << tRef << " ms ; with interactionProduct(): " << tProduct << " ms" << std::endl;
+
+    if (!compare(LtL, LtL_ref, 1e-9) || !compare(LtE, LtE_ref, 1e-9)) {
+      std::cerr << "Bad interaction matrix products" << std::endl;
+      std::cerr << "LtL:\n" << LtL << "\nexpected:\n" << LtL_ref << std::endl;
+      std::cerr << "LtE:\n" << LtE.t() << "\nexpected:\n" << LtE_ref.t() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpMatrix LtL2;
+    vpColVector LtE2;
+    sI.interactionProduct(LtL2);
+    sI.interactionProduct(e, LtE2);
+    if (!compare(LtL2, LtL, 0) || !compare(LtE2, LtE, 0)) {
+      std::cerr << "Inconsistent interaction matrix products" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A copy must give the same products
+    vpFeatureLuminance sCopy(sI);
+    sCopy.interactionProduct(LtL2);
+    if (!compare(LtL2, LtL, 0)) {
+      std::cerr << "Bad copy of the luminance feature" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    bool dimensionError = false;
+    try {
+      sI.interactionProduct(vpColVector(3), LtE2);
+    } catch(vpException &) {
+      dimensionError = true;
+    }
+    if (!dimensionError) {
+      std::cerr << "An exception is expected with a bad error vector size" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testFeatureLuminance is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}
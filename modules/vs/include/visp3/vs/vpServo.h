@@ -481,6 +481,10 @@ public:
    */
   void computeProjectionOperators();
 
+  void computePrimaryTask();
+  void updateError();
+  void updateInteractionMatrix();
+
   public:
   //! Interaction matrix
   vpMatrix L ;
@@ -611,6 +615,23 @@ public:
 
   //! A diag matrix used to determine which are the degrees of freedom that are controlled in the camera frame
   vpMatrix cJc;
+
+  /*
+    Buffers reused from one iteration to the other
+  */
+
+  //! Product of the twist transformation matrix and the robot Jacobian.
+  vpMatrix cVaJe;
+  //! Product of cJc and cVaJe, used when cJc is not the identity.
+  vpMatrix cJcVaJe;
+  //! Task Jacobian for which J1p, sv, WpW and rankJ1 were last computed with the pseudo inverse.
+  vpMatrix J1_cache;
+  //! Interaction matrix computed with the desired features in MEAN mode.
+  vpMatrix Lstar;
+  //! Product \f${J_1}^{+}(s-s*)\f$ used when the task Jacobian is not full rank.
+  vpColVector J1pError;
+  //! Product \f${J_1}^\top(s-s*)\f$ used to compute the large projection operator.
+  vpColVector J1tError;
 } ;
 
 #endif
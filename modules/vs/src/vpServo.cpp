@@ -40,6 +40,7 @@
 
 #include <visp3/vs/vpServo.h>
 
+#include <cstring>
 #include <sstream>
 
 // Exception
@@ -72,7 +73,7 @@ vpServo::vpServo()
     cVf(), init_cVf(false), fVe(), init_fVe(false), eJe(), init_eJe(false), fJe(), init_fJe(false),
     errorComputed(false), interactionMatrixComputed(false), dim_task(0), taskWasKilled(false),
     forceInteractionMatrixComputation(false), WpW(), I_WpW(), P(), sv(), mu(4.), e1_initial(),
-    iscJcIdentity(true), cJc(6,6)
+    iscJcIdentity(true), cJc(6,6), cVaJe(), cJcVaJe(), J1_cache(), Lstar(), J1pError(), J1tError()
 {
   cJc.eye();
 }
@@ -97,7 +98,7 @@ vpServo::vpServo(vpServoType servo_type)
     cVf(), init_cVf(false), fVe(), init_fVe(false), eJe(), init_eJe(false), fJe(), init_fJe(false),
     errorComputed(false), interactionMatrixComputed(false), dim_task(0), taskWasKilled(false),
     forceInteractionMatrixComputation(false), WpW(), I_WpW(), P(), sv(), mu(4), e1_initial(),
-    iscJcIdentity(true), cJc(6,6)
+    iscJcIdentity(true), cJc(6,6), cVaJe(), cJcVaJe(), J1_cache(), Lstar(), J1pError(), J1tError()
 {
   cJc.eye();
 }
@@ -170,6 +171,7 @@ void vpServo::init()
   forceInteractionMatrixComputation = false;
 
   rankJ1 = 0;
+  J1_cache.resize(0, 0);
 }
 
 /*!
@@ -667,6 +669,17 @@ static void computeInteractionMatrixFromList  (const std::list<vpBasicFeature *>
   \return The interaction matrix \f${\widehat {\bf L}}_e\f$ used in the control law specified using setServo().
 */
 vpMatrix vpServo::computeInteractionMatrix()
+{
+  updateInteractionMatrix();
+  return L ;
+}
+
+/*!
+  Update the interaction matrix \f${\widehat {\bf L}}_e\f$ stored in L
+  without returning a copy of it. The memory of L is reused from one call to
+  the other as long as the task dimension does not change.
+*/
+void vpServo::updateInteractionMatrix()
 {
   try {
 
@@ -711,7 +724,6 @@ vpMatrix vpServo::computeInteractionMatrix()
       break ;
     case MEAN:
     {
-      vpMatrix Lstar (L.getRows(), L.getCols());
       try
       {
         computeInteractionMatrixFromList(this ->featureList,
@@ -723,7 +735,9 @@ vpMatrix vpServo::computeInteractionMatrix()
       {
         throw ;
       }
-      L = (L+Lstar)/2;
+      // In place mean to avoid temporary matrices
+      for (unsigned int i = 0; i < L.size(); i++)
+        L.data[i] = (L.data[i] + Lstar.data[i]) / 2;
 
       dim_task = L.getRows() ;
       interactionMatrixComputed = true ;
@@ -740,7 +754,6 @@ vpMatrix vpServo::computeInteractionMatrix()
   {
     throw ;
   }
-  return L ;
 }
 
 /*!
@@ -752,6 +765,17 @@ vpMatrix vpServo::computeInteractionMatrix()
 
 */
 vpColVector vpServo::computeError()
+{
+  updateError();
+  return error ;
+}
+
+/*!
+  Update the error \f$\bf e =(s - s^*)\f$ stored in error without returning
+  a copy of it. The memory of the error vector is reused from one call to the
+  other as long as the task dimension does not change.
+*/
+void vpServo::updateError()
 {
   if (featureList.empty())
   {
@@ -858,7 +882,6 @@ vpColVector vpServo::computeError()
   {
     throw ;
   }
-  return error ;
 }
 
 bool vpServo::testInitialization()
@@ -957,9 +980,6 @@ vpColVector vpServo::computeControlLaw()
 
   try
   {
-    vpVelocityTwistMatrix cVa ; // Twist transformation matrix
-    vpMatrix aJe ;      // Jacobian
-
     if (iteration==0)
     {
       if (testInitialization() == false) {
@@ -974,101 +994,12 @@ vpColVector vpServo::computeControlLaw()
       vpERROR_TRACE("All the matrices are not correctly updated") ;
     }
 
-    // test if all the required initialization have been done
-    switch (servoType)
-    {
-    case NONE :
-      vpERROR_TRACE("No control law have been yet defined") ;
-      throw(vpServoException(vpServoException::servoError,
-                             "No control law have been yet defined")) ;
-      break ;
-    case EYEINHAND_CAMERA:
-    case EYEINHAND_L_cVe_eJe:
-    case EYETOHAND_L_cVe_eJe:
-
-      cVa = cVe ;
-      aJe = eJe ;
-
-      init_cVe = false ;
-      init_eJe = false ;
-      break ;
-    case  EYETOHAND_L_cVf_fVe_eJe:
-      cVa = cVf*fVe ;
-      aJe = eJe ;
-      init_fVe = false ;
-      init_eJe = false ;
-      break ;
-    case EYETOHAND_L_cVf_fJe    :
-      cVa = cVf ;
-      aJe = fJe ;
-      init_fJe = false ;
-      break ;
-    }
-
-    computeInteractionMatrix() ;
-    computeError() ;
-
-    // compute  task Jacobian
-    if(iscJcIdentity)
-      J1 = L*cVa*aJe ;
-    else
-      J1 = L*cJc*cVa*aJe ;
-
-    // handle the eye-in-hand eye-to-hand case
-    J1 *= signInteractionMatrix ;
-
-    // pseudo inverse of the task Jacobian
-    // and rank of the task Jacobian
-    // the image of J1 is also computed to allows the computation
-    // of the projection operator
-    vpMatrix imJ1t, imJ1 ;
-    bool imageComputed = false ;
-
-    if (inversionType==PSEUDO_INVERSE)
-    {
-      rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t) ;
-
-      imageComputed = true ;
-    }
-    else
-      J1p = J1.t() ;
-
-    if (rankJ1 == J1.getCols())
-    {
-      /* if no degrees of freedom remains (rank J1 = ndof)
-       WpW = I, multiply by WpW is useless
-    */
-      e1 = J1p*error ;// primary task
-
-      WpW.eye(J1.getCols(), J1.getCols()) ;
-    }
-    else
-    {
-      if (imageComputed!=true)
-      {
-        vpMatrix Jtmp ;
-        // image of J1 is computed to allows the computation
-        // of the projection operator
-        rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t) ;
-      }
-      WpW = imJ1t*imJ1t.t() ;
-
-#ifdef DEBUG
-      std::cout << "rank J1: " << rankJ1 << std::endl;
-      imJ1t.print(std::cout, 10, "imJ1t");
-      imJ1.print(std::cout, 10, "imJ1");
-
-      WpW.print(std::cout, 10, "WpW");
-      J1.print(std::cout, 10, "J1");
-      J1p.print(std::cout, 10, "J1p");
-#endif
-      e1 = WpW*J1p*error ;
-    }
-    e = - lambda(e1) * e1 ;
-
-    vpMatrix I ;
+    computePrimaryTask() ;
 
-    I.eye(J1.getCols(),J1.getCols()) ;
+    double gain = lambda(e1) ;
+    e.resize(e1.getRows(), false) ;
+    for (unsigned int i = 0; i < e1.getRows(); i++)
+      e[i] = - gain * e1[i] ;
 
     computeProjectionOperators();
 
@@ -1116,9 +1047,6 @@ vpColVector vpServo::computeControlLaw(double t)
 
   try
   {
-    vpVelocityTwistMatrix cVa ; // Twist transformation matrix
-    vpMatrix aJe ;      // Jacobian
-
     if (iteration==0)
     {
       if (testInitialization() == false) {
@@ -1133,93 +1061,7 @@ vpColVector vpServo::computeControlLaw(double t)
       vpERROR_TRACE("All the matrices are not correctly updated") ;
     }
 
-    // test if all the required initialization have been done
-    switch (servoType)
-    {
-    case NONE :
-      vpERROR_TRACE("No control law have been yet defined") ;
-      throw(vpServoException(vpServoException::servoError,
-                             "No control law have been yet defined")) ;
-      break ;
-    case EYEINHAND_CAMERA:
-    case EYEINHAND_L_cVe_eJe:
-    case EYETOHAND_L_cVe_eJe:
-
-      cVa = cVe ;
-      aJe = eJe ;
-
-      init_cVe = false ;
-      init_eJe = false ;
-      break ;
-    case  EYETOHAND_L_cVf_fVe_eJe:
-      cVa = cVf*fVe ;
-      aJe = eJe ;
-      init_fVe = false ;
-      init_eJe = false ;
-      break ;
-    case EYETOHAND_L_cVf_fJe    :
-      cVa = cVf ;
-      aJe = fJe ;
-      init_fJe = false ;
-      break ;
-    }
-
-    computeInteractionMatrix() ;
-    computeError() ;
-
-    // compute  task Jacobian
-    J1 = L*cVa*aJe ;
-
-    // handle the eye-in-hand eye-to-hand case
-    J1 *= signInteractionMatrix ;
-
-    // pseudo inverse of the task Jacobian
-    // and rank of the task Jacobian
-    // the image of J1 is also computed to allows the computation
-    // of the projection operator
-    vpMatrix imJ1t, imJ1 ;
-    bool imageComputed = false ;
-
-    if (inversionType==PSEUDO_INVERSE)
-    {
-      rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t) ;
-
-      imageComputed = true ;
-    }
-    else
-      J1p = J1.t() ;
-
-    if (rankJ1 == J1.getCols())
-    {
-      /* if no degrees of freedom remains (rank J1 = ndof)
-       WpW = I, multiply by WpW is useless
-    */
-      e1 = J1p*error ;// primary task
-
-      WpW.eye(J1.getCols(), J1.getCols()) ;
-    }
-    else
-    {
-      if (imageComputed!=true)
-      {
-        vpMatrix Jtmp ;
-        // image of J1 is computed to allows the computation
-        // of the projection operator
-        rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t) ;
-      }
-      WpW = imJ1t*imJ1t.t() ;
-
-#ifdef DEBUG
-      std::cout << "rank J1 " << rankJ1 <<std::endl ;
-      std::cout << "imJ1t"<<std::endl  << imJ1t ;
-      std::cout << "imJ1"<<std::endl  << imJ1 ;
-
-      std::cout << "WpW" <<std::endl <<WpW  ;
-      std::cout << "J1" <<std::endl <<J1  ;
-      std::cout << "J1p" <<std::endl <<J1p  ;
-#endif
-      e1 = WpW*J1p*error ;
-    }
+    computePrimaryTask() ;
 
     // memorize the initial e1 value if the function is called the first time or if the time given as parameter is equal to 0.
     if (iteration==0 || std::fabs(t) < std::numeric_limits<double>::epsilon()) {
@@ -1229,11 +1071,11 @@ vpColVector vpServo::computeControlLaw(double t)
     if (e1_initial.getRows() != e1.getRows())
       e1_initial = e1;
 
-    e = - lambda(e1) * e1 + lambda(e1) * e1_initial*exp(-mu*t);
-
-    vpMatrix I ;
-
-    I.eye(J1.getCols(), J1.getCols()) ;
+    double gain = lambda(e1) ;
+    double decay = exp(-mu*t) ;
+    e.resize(e1.getRows(), false) ;
+    for (unsigned int i = 0; i < e1.getRows(); i++)
+      e[i] = - gain * e1[i] + gain * e1_initial[i] * decay ;
 
     computeProjectionOperators() ;
   }
@@ -1279,9 +1121,6 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
 
   try
   {
-    vpVelocityTwistMatrix cVa ; // Twist transformation matrix
-    vpMatrix aJe ;      // Jacobian
-
     if (iteration==0)
     {
       if (testInitialization() == false) {
@@ -1296,50 +1135,123 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
       vpERROR_TRACE("All the matrices are not correctly updated") ;
     }
 
-    // test if all the required initialization have been done
-    switch (servoType)
-    {
-    case NONE :
-      vpERROR_TRACE("No control law have been yet defined") ;
-      throw(vpServoException(vpServoException::servoError,
-                             "No control law have been yet defined")) ;
-      break ;
-    case EYEINHAND_CAMERA:
-    case EYEINHAND_L_cVe_eJe:
-    case EYETOHAND_L_cVe_eJe:
+    computePrimaryTask() ;
 
-      cVa = cVe ;
-      aJe = eJe ;
+    // memorize the initial e1 value if the function is called the first time or if the time given as parameter is equal to 0.
+    if (iteration==0 || std::fabs(t) < std::numeric_limits<double>::epsilon()) {
+      e1_initial = e1;
+    }
+    // Security check. If size of e1_initial and e1 differ, that means that e1_initial was not set
+    if (e1_initial.getRows() != e1.getRows())
+      e1_initial = e1;
 
-      init_cVe = false ;
-      init_eJe = false ;
-      break ;
-    case  EYETOHAND_L_cVf_fVe_eJe:
-      cVa = cVf*fVe ;
-      aJe = eJe ;
-      init_fVe = false ;
-      init_eJe = false ;
-      break ;
-    case EYETOHAND_L_cVf_fJe    :
-      cVa = cVf ;
-      aJe = fJe ;
-      init_fJe = false ;
-      break ;
+    if (e_dot_init.getRows() != e1.getRows()) {
+      throw(vpException(vpException::dimensionError,
+                        "Bad size of the initial task derivative")) ;
     }
+    double gain = lambda(e1) ;
+    double decay = exp(-mu*t) ;
+    e.resize(e1.getRows(), false) ;
+    for (unsigned int i = 0; i < e1.getRows(); i++)
+      e[i] = - gain * e1[i] + (e_dot_init[i] + gain * e1_initial[i]) * decay ;
+
+    computeProjectionOperators();
+  }
+  catch(...) {
+    throw;
+  }
+
+  iteration++ ;
+  return e ;
+}
+
+/*!
+  Compute the task Jacobian \f${\bf J}_1\f$, its pseudo inverse and the
+  primary task \f${\bf e}_1\f$ in the buffers of the class.
+
+  When the pseudo inverse is used and the task Jacobian did not change since
+  the last call, which is the case with a DESIRED interaction matrix and
+  constant twist and robot Jacobian matrices, the singular value
+  decomposition is not done again and the previous pseudo inverse, rank and
+  projection operator are reused.
+*/
+void vpServo::computePrimaryTask()
+{
+  const vpArray2D<double> *cVa = &cVe ; // Twist transformation matrix
+  const vpMatrix *aJe = &eJe ;          // Jacobian
+  vpVelocityTwistMatrix cVfVe ;
+
+  // test if all the required initialization have been done
+  switch (servoType)
+  {
+  case NONE :
+    vpERROR_TRACE("No control law have been yet defined") ;
+    throw(vpServoException(vpServoException::servoError,
+                           "No control law have been yet defined")) ;
+    break ;
+  case EYEINHAND_CAMERA:
+  case EYEINHAND_L_cVe_eJe:
+  case EYETOHAND_L_cVe_eJe:
 
-    computeInteractionMatrix() ;
-    computeError() ;
+    cVa = &cVe ;
+    aJe = &eJe ;
+
+    init_cVe = false ;
+    init_eJe = false ;
+    break ;
+  case  EYETOHAND_L_cVf_fVe_eJe:
+    cVfVe = cVf*fVe ;
+    cVa = &cVfVe ;
+    aJe = &eJe ;
+    init_fVe = false ;
+    init_eJe = false ;
+    break ;
+  case EYETOHAND_L_cVf_fJe    :
+    cVa = &cVf ;
+    aJe = &fJe ;
+    init_fJe = false ;
+    break ;
+  }
 
-    // compute  task Jacobian
-    J1 = L*cVa*aJe ;
+  updateInteractionMatrix() ;
+  updateError() ;
 
-    // handle the eye-in-hand eye-to-hand case
+  // compute  task Jacobian J1 = L cJc cVa aJe, the 6 x n product being
+  // computed first to keep the number of operations linear in the task size
+  unsigned int n = aJe->getCols() ;
+  if (cVa->getCols() != aJe->getRows()) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot compute the task Jacobian: bad robot Jacobian size")) ;
+  }
+  cVaJe.resize(6, n, false) ;
+  for (unsigned int i = 0; i < 6; i++) {
+    for (unsigned int j = 0; j < n; j++) {
+      double sum = 0 ;
+      for (unsigned int k = 0; k < aJe->getRows(); k++)
+        sum += (*cVa)[i][k] * (*aJe)[k][j] ;
+      cVaJe[i][j] = sum ;
+    }
+  }
+  if (! iscJcIdentity) {
+    vpMatrix::mult2Matrices(cJc, cVaJe, cJcVaJe) ;
+    vpMatrix::mult2Matrices(L, cJcVaJe, J1) ;
+  }
+  else
+    vpMatrix::mult2Matrices(L, cVaJe, J1) ;
+
+  // handle the eye-in-hand eye-to-hand case
+  if (signInteractionMatrix != 1)
     J1 *= signInteractionMatrix ;
 
-    // pseudo inverse of the task Jacobian
-    // and rank of the task Jacobian
-    // the image of J1 is also computed to allows the computation
-    // of the projection operator
+  // pseudo inverse of the task Jacobian
+  // and rank of the task Jacobian
+  // the image of J1 is also computed to allows the computation
+  // of the projection operator
+  bool cached = (inversionType==PSEUDO_INVERSE)
+      && (J1_cache.getRows() == J1.getRows()) && (J1_cache.getCols() == J1.getCols())
+      && (J1.size() > 0) && (memcmp(J1_cache.data, J1.data, J1.size()*sizeof(double)) == 0) ;
+
+  if (! cached) {
     vpMatrix imJ1t, imJ1 ;
     bool imageComputed = false ;
 
@@ -1357,8 +1269,6 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
       /* if no degrees of freedom remains (rank J1 = ndof)
        WpW = I, multiply by WpW is useless
     */
-      e1 = J1p*error ;// primary task
-
       WpW.eye(J1.getCols(), J1.getCols()) ;
     }
     else
@@ -1373,52 +1283,44 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
       WpW = imJ1t*imJ1t.t() ;
 
 #ifdef DEBUG
-      std::cout << "rank J1 " << rankJ1 <<std::endl ;
-      std::cout << "imJ1t"<<std::endl  << imJ1t ;
-      std::cout << "imJ1"<<std::endl  << imJ1 ;
+      std::cout << "rank J1: " << rankJ1 << std::endl;
+      imJ1t.print(std::cout, 10, "imJ1t");
+      imJ1.print(std::cout, 10, "imJ1");
 
-      std::cout << "WpW" <<std::endl <<WpW  ;
-      std::cout << "J1" <<std::endl <<J1  ;
-      std::cout << "J1p" <<std::endl <<J1p  ;
+      WpW.print(std::cout, 10, "WpW");
+      J1.print(std::cout, 10, "J1");
+      J1p.print(std::cout, 10, "J1p");
 #endif
-      e1 = WpW*J1p*error ;
     }
 
-    // memorize the initial e1 value if the function is called the first time or if the time given as parameter is equal to 0.
-    if (iteration==0 || std::fabs(t) < std::numeric_limits<double>::epsilon()) {
-      e1_initial = e1;
-    }
-    // Security check. If size of e1_initial and e1 differ, that means that e1_initial was not set
-    if (e1_initial.getRows() != e1.getRows())
-      e1_initial = e1;
-
-    e = - lambda(e1) * e1 + (e_dot_init + lambda(e1) * e1_initial)*exp(-mu*t);
-
-    vpMatrix I ;
-
-    I.eye(J1.getCols(), J1.getCols()) ;
+    if (inversionType==PSEUDO_INVERSE)
+      J1_cache = J1 ;
+    else
+      J1_cache.resize(0, 0) ;
+  }
 
-    computeProjectionOperators();
+  if (rankJ1 == J1.getCols())
+  {
+    vpMatrix::multMatrixVector(J1p, error, e1) ; // primary task
   }
-  catch(...) {
-    throw;
+  else
+  {
+    vpMatrix::multMatrixVector(J1p, error, J1pError) ;
+    vpMatrix::multMatrixVector(WpW, J1pError, e1) ;
   }
-
-  iteration++ ;
-  return e ;
 }
 
 void vpServo::computeProjectionOperators()
 {
   // Initialization
   unsigned int n = J1.getCols();
-  P.resize(n,n);
-
-  vpMatrix I;
-  I.eye(n);
+  P.resize(n,n,false);
 
   //Compute classical projection operator
-  I_WpW = (I - WpW) ;
+  I_WpW.resize(n,n,false);
+  for (unsigned int i = 0; i < n; i++)
+    for (unsigned int j = 0; j < n; j++)
+      I_WpW[i][j] = (i == j ? 1. : 0.) - WpW[i][j];
 
   // Compute gain depending by the task error to ensure a smooth change between the operators.
   double e0_ = 0.1;
@@ -1433,17 +1335,25 @@ void vpServo::computeProjectionOperators()
   else
     sig = 0.0;
 
-  vpMatrix J1t = J1.transpose();
-
-  double pp = (error.t() * (J1 * J1t) * error);
-
-  vpMatrix  ee_t(n,n);
-  ee_t =  error * error.t();
-
-  vpMatrix P_norm_e(n,n);
-  P_norm_e = I - (1.0 / pp ) * J1t * ee_t * J1;
-
-  P = sig * P_norm_e + (1 - sig) * I_WpW;
+  // Since J1^T e e^T J1 = (J1^T e) (J1^T e)^T and e^T J1 J1^T e = |J1^T e|^2,
+  // the large projection operator only needs the n-dimension vector J1^T e
+  J1tError.resize(n, false);
+  for (unsigned int j = 0; j < n; j++) {
+    double sum = 0;
+    for (unsigned int i = 0; i < J1.getRows(); i++)
+      sum += J1[i][j] * error[i];
+    J1tError[j] = sum;
+  }
+  double pp = J1tError.sumSquare();
+
+  for (unsigned int i = 0; i < n; i++) {
+    for (unsigned int j = 0; j < n; j++) {
+      double P_norm_e = 0.;
+      if (sig > 0.)
+        P_norm_e = (i == j ? 1. : 0.) - J1tError[i] * J1tError[j] / pp;
+      P[i][j] = sig * P_norm_e + (1 - sig) * I_WpW[i][j];
+    }
+  }
 
   return;
 }
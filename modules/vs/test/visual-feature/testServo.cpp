@@ -0,0 +1,417 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the vpServo control laws with a direct computation.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testServo.cpp
+
+  Compare the velocities computed by vpServo with an image-based visual
+  servoing task on four points with a direct computation of the control law,
+  for the different interaction matrix types. The projection operators, the
+  secondary tasks, the continuous control laws and the changes of
+  interaction matrix type and inversion are also checked against a direct
+  computation.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/visual_features/vpFeatureBuilder.h>
+#include <visp3/visual_features/vpFeaturePoint.h>
+#include <visp3/vs/vpServo.h>
+
+namespace {
+  bool isEqual(const vpColVector &a, const vpColVector &b, double eps = 1e-9)
+  {
+    if (a.getRows() != b.getRows())
+      return false;
+    for (unsigned int i = 0; i < a.getRows(); i++) {
+      if (std::fabs(a[i] - b[i]) > eps * vpMath::maximum(1., std::fabs(b[i])))
+        return false;
+    }
+    return true;
+  }
+
+  bool isEqual(const vpMatrix &A, const vpMatrix &B, double eps = 1e-9)
+  {
+    if (A.getRows() != B.getRows() || A.getCols() != B.getCols())
+      return false;
+    for (unsigned int i = 0; i < A.getRows(); i++) {
+      for (unsigned int j = 0; j < A.getCols(); j++) {
+        if (std::fabs(A[i][j] - B[i][j]) > eps * vpMath::maximum(1., std::fabs(B[i][j])))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  // Create the features of points on a circle seen from cMo, and the desired ones seen from cdMo
+  void createFeatures(unsigned int nbPoints, const vpHomogeneousMatrix &cMo, const vpHomogeneousMatrix &cdMo,
+                      std::vector<vpPoint> &point, std::vector<vpFeaturePoint> &p, std::vector<vpFeaturePoint> &pd)
+  {
+    point.clear();
+    for (unsigned int i = 0; i < nbPoints; i++) {
+      double a = 2*M_PI*i / nbPoints;
+      point.push_back(vpPoint(0.1*cos(a), 0.1*sin(a), 0.02*sin(3*a)));
+    }
+    p.resize(nbPoints);
+    pd.resize(nbPoints);
+    for (unsigned int i = 0; i < nbPoints; i++) {
+      point[i].track(cdMo);
+      vpFeatureBuilder::create(pd[i], point[i]);
+      point[i].track(cMo);
+      vpFeatureBuilder::create(p[i], point[i]);
+    }
+  }
+
+  void updateFeatures(const vpHomogeneousMatrix &cMo, std::vector<vpPoint> &point, std::vector<vpFeaturePoint> &p)
+  {
+    for (size_t i = 0; i < point.size(); i++) {
+      point[i].track(cMo);
+      vpFeatureBuilder::create(p[i], point[i]);
+    }
+  }
+
+  // Interaction matrix and error computed directly from the features
+  void computeReferenceTask(const std::vector<vpFeaturePoint> &p, const std::vector<vpFeaturePoint> &pd,
+                            vpServo::vpServoIteractionMatrixType type, vpMatrix &Le, vpColVector &e)
+  {
+    unsigned int nbPoints = (unsigned int)p.size();
+    vpMatrix L(2*nbPoints, 6), Ld(2*nbPoints, 6);
+    e.resize(2*nbPoints);
+    for (unsigned int i = 0; i < nbPoints; i++) {
+      vpFeaturePoint s = p[i], sd = pd[i];
+      L.insert(s.interaction(), 2*i, 0);
+      Ld.insert(sd.interaction(), 2*i, 0);
+      e.insert(2*i, s.error(sd));
+    }
+    Le = Ld;
+    if (type == vpServo::CURRENT)
+      Le = L;
+    else if (type == vpServo::MEAN)
+      Le = (L + Ld) / 2;
+  }
+
+  // Control law, projection operators and secondary tasks as computed before the buffers were reused
+  void computeReferenceControlLaw(const vpMatrix &J1, const vpColVector &error, vpColVector &e1, vpMatrix &WpW,
+                                  vpMatrix &I_WpW, vpMatrix &P)
+  {
+    unsigned int n = J1.getCols();
+    vpMatrix J1p, imJ1, imJ1t;
+    vpColVector sv;
+    unsigned int rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t);
+    if (rankJ1 == n) {
+      WpW.eye(n, n);
+      e1 = J1p * error;
+    }
+    else {
+      WpW = imJ1t * imJ1t.t();
+      e1 = WpW * J1p * error;
+    }
+
+    vpMatrix I;
+    I.eye(n);
+    I_WpW = I - WpW;
+
+    double e0_ = 0.1, e1_ = 0.7, sig = 0.0;
+    double norm_e = error.euclideanNorm();
+    if (norm_e > e1_)
+      sig = 1.0;
+    else if (e0_ <= norm_e && norm_e <= e1_)
+      sig = 1.0 / (1.0 + exp(-12.0 * ((norm_e-e0_)/((e1_-e0_))) + 6.0));
+
+    vpMatrix J1t = J1.transpose();
+    double pp = (error.t() * (J1 * J1t) * error);
+    vpMatrix ee_t = error * error.t();
+    vpMatrix P_norm_e = I - (1.0 / pp) * J1t * ee_t * J1;
+    P = sig * P_norm_e + (1 - sig) * I_WpW;
+  }
+
+  bool runServo(vpServo::vpServoIteractionMatrixType type, unsigned int nbPoints, double &time)
+  {
+    vpHomogeneousMatrix cdMo(0, 0, 0.75, 0, 0, 0);
+    vpHomogeneousMatrix cMo(0.15, -0.1, 1., vpMath::rad(10), vpMath::rad(-10), vpMath::rad(50));
+    std::vector<vpPoint> point;
+    std::vector<vpFeaturePoint> p, pd;
+    createFeatures(nbPoints, cMo, cdMo, point, p, pd);
+
+    vpServo task;
+    task.setServo(vpServo::EYEINHAND_CAMERA);
+    task.setInteractionMatrixType(type);
+    double lambda = 0.5;
+    task.setLambda(lambda);
+    for (unsigned int i = 0; i < nbPoints; i++)
+      task.addFeature(p[i], pd[i]);
+
+    bool ok = true;
+    time = 0;
+    for (unsigned int iter = 0; iter < 50 && ok; iter++) {
+      updateFeatures(cMo, point, p);
+
+      double t = vpTime::measureTimeMs();
+      vpColVector v = task.computeControlLaw();
+      time += vpTime::measureTimeMs() - t;
+
+      // Direct computation of the control law
+      vpMatrix Le;
+      vpColVector e;
+      computeReferenceTask(p, pd, type, Le, e);
+      vpColVector v_ref = -lambda * Le.pseudoInverse(1e-6) * e;
+
+      if (!isEqual(v, v_ref)) {
+        std::cerr << "Bad velocity at iteration " << iter << ": " << v.t() << " instead of " << v_ref.t() << std::endl;
+        ok = false;
+      }
+
+      cMo = vpExponentialMap::direct(v, 0.04).inverse() * cMo;
+    }
+    task.kill();
+    return ok;
+  }
+
+  // A single point leaves 4 free degrees of freedom: check the projection operators and the secondary tasks
+  bool runSecondaryTask()
+  {
+    vpHomogeneousMatrix cdMo(0, 0, 0.75, 0, 0, 0);
+    vpHomogeneousMatrix cMo(0.15, -0.1, 1., vpMath::rad(10), vpMath::rad(-10), vpMath::rad(50));
+    std::vector<vpPoint> point;
+    std::vector<vpFeaturePoint> p, pd;
+    createFeatures(1, cMo, cdMo, point, p, pd);
+
+    vpServo task;
+    task.setServo(vpServo::EYEINHAND_CAMERA);
+    task.setInteractionMatrixType(vpServo::CURRENT);
+    double lambda = 0.5;
+    task.setLambda(lambda);
+    task.addFeature(p[0], pd[0]);
+
+    vpColVector e2(6), de2dt(6);
+    for (unsigned int i = 0; i < 6; i++) {
+      e2[i] = 0.1 * (i + 1);
+      de2dt[i] = 0.05 * (6.0 - i);
+    }
+
+    bool ok = true;
+    for (unsigned int iter = 0; iter < 30 && ok; iter++) {
+      updateFeatures(cMo, point, p);
+      vpColVector v = task.computeControlLaw();
+
+      vpMatrix Le, WpW, I_WpW, P;
+      vpColVector e, e1;
+      computeReferenceTask(p, pd, vpServo::CURRENT, Le, e);
+      computeReferenceControlLaw(Le, e, e1, WpW, I_WpW, P);
+
+      if (task.rankJ1 != 2 || !isEqual(v, -lambda * e1) || !isEqual(task.getWpW(), WpW)
+          || !isEqual(task.getI_WpW(), I_WpW) || !isEqual(task.getLargeP(), P)) {
+        std::cerr << "Bad control law or projection operators at iteration " << iter << std::endl;
+        ok = false;
+      }
+      else if (!isEqual(task.secondaryTask(de2dt), I_WpW * de2dt)
+               || !isEqual(task.secondaryTask(de2dt, true), P * de2dt)
+               || !isEqual(task.secondaryTask(e2, de2dt), -lambda * I_WpW * e2 + I_WpW * de2dt)
+               || !isEqual(task.secondaryTask(e2, de2dt, true), -lambda * P * e2 + P * de2dt)) {
+        std::cerr << "Bad secondary task at iteration " << iter << std::endl;
+        ok = false;
+      }
+
+      v += task.secondaryTask(e2, de2dt, true);
+      cMo = vpExponentialMap::direct(v, 0.04).inverse() * cMo;
+    }
+    task.kill();
+    return ok;
+  }
+
+  // Continuous control laws with a camera degree of freedom that is not controlled (cJc not identity)
+  bool runContinuousControlLaw(bool withInitialDerivative)
+  {
+    vpHomogeneousMatrix cdMo(0, 0, 0.75, 0, 0, 0);
+    vpHomogeneousMatrix cMo(0.15, -0.1, 1., vpMath::rad(10), vpMath::rad(-10), vpMath::rad(50));
+    std::vector<vpPoint> point;
+    std::vector<vpFeaturePoint> p, pd;
+    createFeatures(4, cMo, cdMo, point, p, pd);
+
+    vpServo task;
+    task.setServo(vpServo::EYEINHAND_CAMERA);
+    task.setInteractionMatrixType(vpServo::DESIRED);
+    double lambda = 0.5, mu = 4.;
+    task.setLambda(lambda);
+    task.setMu(mu);
+    vpColVector dof(6, 1);
+    dof[5] = 0; // wz is not controlled
+    task.setCameraDoF(dof);
+    for (unsigned int i = 0; i < 4; i++)
+      task.addFeature(p[i], pd[i]);
+
+    vpMatrix cJc;
+    cJc.eye(6);
+    cJc[5][5] = 0;
+
+    vpColVector e_dot_init(6);
+    for (unsigned int i = 0; i < 6; i++)
+      e_dot_init[i] = 0.01 * (i + 1);
+
+    bool ok = true;
+    vpColVector e1_initial;
+    for (unsigned int iter = 0; iter < 30 && ok; iter++) {
+      updateFeatures(cMo, point, p);
+      double t = iter * 0.04;
+      vpColVector v = withInitialDerivative ? task.computeControlLaw(t, e_dot_init) : task.computeControlLaw(t);
+
+      vpMatrix Le, WpW, I_WpW, P;
+      vpColVector e, e1;
+      computeReferenceTask(p, pd, vpServo::DESIRED, Le, e);
+      computeReferenceControlLaw(Le * cJc, e, e1, WpW, I_WpW, P);
+      if (iter == 0)
+        e1_initial = e1;
+
+      vpColVector v_ref;
+      if (withInitialDerivative)
+        v_ref = - lambda * e1 + (e_dot_init + lambda * e1_initial) * exp(-mu * t);
+      else
+        v_ref = - lambda * e1 + lambda * e1_initial * exp(-mu * t);
+
+      if (task.rankJ1 != 5 || !isEqual(v, v_ref) || !isEqual(task.getI_WpW(), I_WpW)
+          || !isEqual(task.getLargeP(), P)) {
+        std::cerr << "Bad continuous control law at iteration " << iter << ": " << v.t() << " instead of "
+                  << v_ref.t() << std::endl;
+        ok = false;
+      }
+
+      cMo = vpExponentialMap::direct(v, 0.04).inverse() * cMo;
+    }
+    task.kill();
+    return ok;
+  }
+
+  // The cached pseudo inverse must not survive a change of interaction matrix type or of inversion
+  bool runInteractionMatrixTypeChanges()
+  {
+    vpHomogeneousMatrix cdMo(0, 0, 0.75, 0, 0, 0);
+    vpHomogeneousMatrix cMo(0.15, -0.1, 1., vpMath::rad(10), vpMath::rad(-10), vpMath::rad(50));
+    std::vector<vpPoint> point;
+    std::vector<vpFeaturePoint> p, pd;
+    createFeatures(4, cMo, cdMo, point, p, pd);
+
+    vpServo task;
+    task.setServo(vpServo::EYEINHAND_CAMERA);
+    double lambda = 0.5;
+    task.setLambda(lambda);
+    for (unsigned int i = 0; i < 4; i++)
+      task.addFeature(p[i], pd[i]);
+
+    // The desired interaction matrix is only computed once, unless its computation is forced
+    vpServo::vpServoIteractionMatrixType types[] = {vpServo::DESIRED, vpServo::DESIRED, vpServo::DESIRED,
+                                                    vpServo::CURRENT, vpServo::CURRENT, vpServo::MEAN,
+                                                    vpServo::DESIRED};
+    vpServo::vpServoInversionType inversions[] = {vpServo::PSEUDO_INVERSE, vpServo::TRANSPOSE,
+                                                  vpServo::PSEUDO_INVERSE, vpServo::PSEUDO_INVERSE,
+                                                  vpServo::TRANSPOSE, vpServo::PSEUDO_INVERSE,
+                                                  vpServo::PSEUDO_INVERSE};
+    bool ok = true;
+    for (unsigned int iter = 0; iter < 42 && ok; iter++) {
+      vpServo::vpServoIteractionMatrixType type = types[iter / 6];
+      vpServo::vpServoInversionType inversion = inversions[iter / 6];
+      if (iter % 6 == 0) {
+        task.setInteractionMatrixType(type, inversion);
+        task.setForceInteractionMatrixComputation(iter >= 36);
+      }
+
+      updateFeatures(cMo, point, p);
+      vpColVector v = task.computeControlLaw();
+
+      vpMatrix Le;
+      vpColVector e;
+      computeReferenceTask(p, pd, type, Le, e);
+      vpColVector v_ref;
+      if (inversion == vpServo::PSEUDO_INVERSE)
+        v_ref = -lambda * Le.pseudoInverse(1e-6) * e;
+      else
+        v_ref = -lambda * Le.t() * e;
+
+      if (!isEqual(v, v_ref)) {
+        std::cerr << "Bad velocity at iteration " << iter << ": " << v.t() << " instead of " << v_ref.t() << std::endl;
+        ok = false;
+      }
+
+      cMo = vpExponentialMap::direct(v, 0.04).inverse() * cMo;
+    }
+    task.kill();
+    return ok;
+  }
+}
+
+int main()
+{
+  try {
+    const char *names[] = {"DESIRED", "CURRENT", "MEAN"};
+    vpServo::vpServoIteractionMatrixType types[] = {vpServo::DESIRED, vpServo::CURRENT, vpServo::MEAN};
+    for (unsigned int k = 0; k < 3; k++) {
+      double time;
+      if (! runServo(types[k], 4, time)) {
+        std::cerr << "Bad control law with a " << names[k] << " interaction matrix" << std::endl;
+        return EXIT_FAILURE;
+      }
+      double timeLarge;
+      if (! runServo(types[k], 100, timeLarge)) {
+        std::cerr << "Bad control law with a " << names[k] << " interaction matrix and 100 points" << std::endl;
+        return EXIT_FAILURE;
+      }
+      std::cout << names[k] << ": mean control law time " << time / 50 << " ms with 4 points, "
+                << timeLarge / 50 << " ms with 100 points" << std::endl;
+    }
+
+    if (! runSecondaryTask()) {
+      std::cerr << "Bad projection operators or secondary task" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (! runContinuousControlLaw(false) || ! runContinuousControlLaw(true)) {
+      std::cerr << "Bad continuous control law" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (! runInteractionMatrixTypeChanges()) {
+      std::cerr << "Bad control law after a change of interaction matrix type or inversion" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch(vpException &e) {
+    std::cerr << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testServo is ok!" << std::endl;
+  return EXIT_SUCCESS;
+}